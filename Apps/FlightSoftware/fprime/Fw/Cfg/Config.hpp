@@ -74,6 +74,10 @@
 #define FwPrmIdType U32                     //!< Type representation for a parameter id
 #endif
 
+#ifndef FwTlmPacketizeIdType
+#define FwTlmPacketizeIdType U16            //!< Packetized telemetry packet id
+#endif
+
 // How big the size of a buffer (or string) representation is
 #ifndef FwBuffSizeType
 #define FwBuffSizeType U16                  //!< Type representation for storing a buffer or string size
@@ -197,6 +201,45 @@
 #define FW_QUEUE_NAME_MAX_SIZE               80   //!< Max size of message queue name
 #endif
 
+// Specifies how many different message priorities a queue can hold when
+// Os::Queue is built from Os/Linux/RingQueue.cpp
+#ifndef FW_QUEUE_RING_PRIORITIES
+#define FW_QUEUE_RING_PRIORITIES              8   //!< Priorities per queue for the ring queue
+#endif
+
+// Active and queued components serialize async port, command and internal interface messages in
+// place in a slot reserved in the queue, and dispatch them from the slot, instead of copying each
+// message into and out of the queue. Needs Os::Queue from Os/Pthreads/Queue.cpp with the priority
+// buffer queue.
+#ifndef FW_QUEUE_ZERO_COPY
+#define FW_QUEUE_ZERO_COPY                    0   //!< Indicates whether component messages are serialized in place in the queue
+#endif
+
+// Active and queued components take up to this many messages off their queue at once, and dispatch
+// them one at a time from a copy, so the queue is locked once per batch instead of once per message.
+// A message sent while a batch is being dispatched waits for the rest of the batch, even if it has a
+// higher priority. Each component holds a copy of up to this many messages. Set to 1 to receive one
+// message at a time. Can't be used with FW_QUEUE_ZERO_COPY.
+#ifndef FW_QUEUE_DISPATCH_BATCH
+#define FW_QUEUE_DISPATCH_BATCH               1   //!< Most messages a component takes off its queue at once
+#endif
+
+// Each Os::Queue counts messages sent, messages not sent because the queue was full and messages
+// received, and counts the time from send to receive of each message in a histogram. Read them with
+// Os::Queue::getStats(). The queues in Os/Pthreads and Os/FreeRTOS time messages. The other queues
+// only count them.
+#ifndef FW_QUEUE_INSTRUMENTATION
+#define FW_QUEUE_INSTRUMENTATION              0   //!< Indicates whether queues keep send, receive and latency statistics
+#endif
+
+#if FW_QUEUE_INSTRUMENTATION
+// Specifies how many power of two buckets the queue latency histogram has. The last bucket counts
+// messages that took 2^(FW_QUEUE_LATENCY_BUCKETS-2) usec or longer.
+#ifndef FW_QUEUE_LATENCY_BUCKETS
+#define FW_QUEUE_LATENCY_BUCKETS              24  //!< Buckets in the queue latency histogram
+#endif
+#endif
+
 // Specifies the size of the string holding the task name for active components and tasks
 #ifndef FW_TASK_NAME_MAX_SIZE
 #define FW_TASK_NAME_MAX_SIZE               80    //!< Max size of task name
@@ -278,6 +321,17 @@
 #define FW_LOG_TEXT_BUFFER_SIZE              256   //!< Max size of string for text log message
 #endif
 
+// Queue text log event arguments and format the text on the thread of an Fw::TextLogQueue owner
+// (e.g. Svc::DeferredTextLogger) instead of the thread of the caller. Events are formatted
+// right away if there is no queue, the queue is full, or the arguments don't fit in an Fw::LogBuffer.
+#ifndef FW_TEXT_LOG_DEFERRED
+#define FW_TEXT_LOG_DEFERRED                 0     //!< Indicates whether text log formatting is deferred
+#endif
+
+#ifndef FW_TEXT_LOG_QUEUE_DEPTH
+#define FW_TEXT_LOG_QUEUE_DEPTH              64    //!< Events waiting to be formatted. Must be a power of two
+#endif
+
 // Define if serializables have toString() method. Turning off will save code space and
 // string constants. Must be enabled if text logging enabled
 #ifndef FW_SERIALIZABLE_TO_STRING
@@ -25,6 +25,8 @@ namespace Fw {
                 FW_PACKET_FILE, // !< File type - incoming and outgoing
                 FW_PACKET_PACKETIZED_TLM, // !< Packetized telemetry packet type
                 FW_PACKET_IDLE, // !< Idle packet
+                FW_PACKET_LOG_BATCH, // !< Several log packets, each preceded by its 32-bit length
+                FW_PACKET_COMMAND_BATCH, // !< Several command packets, each preceded by its 32-bit length - incoming
                 FW_PACKET_UNKNOWN = 0xFF // !< Unknown packet
             } ComPacketType;
 
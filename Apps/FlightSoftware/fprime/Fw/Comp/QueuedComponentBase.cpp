@@ -9,15 +9,27 @@ namespace Fw {
 
 #if FW_OBJECT_NAMES
     QueuedComponentBase::QueuedComponentBase(const char* name) : PassiveComponentBase(name),m_msgsDropped(0) {
-
+#if FW_QUEUE_DISPATCH_BATCH > 1
+        this->m_batchBuff = 0;
+        this->m_batchMsgSize = 0;
+        this->m_batchCount = 0;
+        this->m_batchNext = 0;
+#endif
     }
 #else    
     QueuedComponentBase::QueuedComponentBase() : PassiveComponentBase(),m_msgsDropped(0) {
-
+#if FW_QUEUE_DISPATCH_BATCH > 1
+        this->m_batchBuff = 0;
+        this->m_batchMsgSize = 0;
+        this->m_batchCount = 0;
+        this->m_batchNext = 0;
+#endif
     }
 #endif
     QueuedComponentBase::~QueuedComponentBase() {
-
+#if FW_QUEUE_DISPATCH_BATCH > 1
+        delete[] this->m_batchBuff;
+#endif
     }
     
     void QueuedComponentBase::init(NATIVE_INT_TYPE instance) {
@@ -40,6 +52,15 @@ namespace Fw {
         char queueNameChar[FW_QUEUE_NAME_MAX_SIZE];
         (void)snprintf(queueNameChar,sizeof(queueNameChar),"CompQ_%d",Os::Queue::getNumQueues());
         queueName = queueNameChar;
+#endif
+#if FW_QUEUE_DISPATCH_BATCH > 1
+        // Room for a batch of the largest message
+        delete[] this->m_batchBuff;
+        this->m_batchBuff = new U8[FW_QUEUE_DISPATCH_BATCH * msgSize];
+        FW_ASSERT(this->m_batchBuff);
+        this->m_batchMsgSize = msgSize;
+        this->m_batchCount = 0;
+        this->m_batchNext = 0;
 #endif
     	return this->m_queue.create(queueName, depth, msgSize);
     }
@@ -52,4 +73,28 @@ namespace Fw {
         this->m_msgsDropped++;
     }
 
+#if FW_QUEUE_DISPATCH_BATCH > 1
+    Os::Queue::QueueStatus QueuedComponentBase::receiveBatched(Fw::ExternalSerializeBuffer &msg, NATIVE_INT_TYPE &priority, Os::Queue::QueueBlocking block) {
+
+        // Only go to the queue when the last batch has been dispatched
+        if (this->m_batchNext == this->m_batchCount) {
+            this->m_batchCount = 0;
+            this->m_batchNext = 0;
+            Os::Queue::QueueStatus stat = this->m_queue.receiveMany(this->m_batchBuff, this->m_batchMsgSize, FW_QUEUE_DISPATCH_BATCH,
+                    this->m_batchSizes, this->m_batchPriorities, this->m_batchCount, block);
+            if (stat != Os::Queue::QUEUE_OK) {
+                return stat;
+            }
+        }
+
+        // Deserialize from the copy in the batch
+        NATIVE_INT_TYPE next = this->m_batchNext++;
+        msg.setExtBuffer(&this->m_batchBuff[next * this->m_batchMsgSize], this->m_batchMsgSize);
+        Fw::SerializeStatus stat = msg.setBuffLen(this->m_batchSizes[next]);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == stat, stat);
+        priority = this->m_batchPriorities[next];
+        return Os::Queue::QUEUE_OK;
+    }
+#endif
+
 }
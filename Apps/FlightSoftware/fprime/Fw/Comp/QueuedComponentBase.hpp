@@ -16,6 +16,9 @@
 #include <Os/Task.hpp>
 #include <Fw/Cfg/Config.hpp>
 
+#if FW_QUEUE_DISPATCH_BATCH > 1 && FW_QUEUE_ZERO_COPY
+#error "FW_QUEUE_DISPATCH_BATCH can't be used with FW_QUEUE_ZERO_COPY"
+#endif
 
 namespace Fw {
     class QueuedComponentBase : public PassiveComponentBase {
@@ -46,8 +49,19 @@ namespace Fw {
 #endif
             NATIVE_INT_TYPE getNumMsgsDropped(void); //!< return number of messages dropped
             void incNumMsgDropped(void); //!< increment the number of messages dropped
+#if FW_QUEUE_DISPATCH_BATCH > 1
+            Os::Queue::QueueStatus receiveBatched(Fw::ExternalSerializeBuffer &msg, NATIVE_INT_TYPE &priority, Os::Queue::QueueBlocking block); //!< receive the next message, taking a batch off the queue when the last one is used up
+#endif
         PRIVATE:
             NATIVE_INT_TYPE m_msgsDropped; //!< number of messages dropped from full queue
+#if FW_QUEUE_DISPATCH_BATCH > 1
+            U8* m_batchBuff; //!< messages taken off the queue and not yet dispatched
+            NATIVE_INT_TYPE m_batchMsgSize; //!< size of each message in m_batchBuff
+            NATIVE_INT_TYPE m_batchSizes[FW_QUEUE_DISPATCH_BATCH];
+            NATIVE_INT_TYPE m_batchPriorities[FW_QUEUE_DISPATCH_BATCH];
+            NATIVE_INT_TYPE m_batchCount; //!< number of messages in the batch
+            NATIVE_INT_TYPE m_batchNext; //!< next message in the batch to dispatch
+#endif
     };
 
 }
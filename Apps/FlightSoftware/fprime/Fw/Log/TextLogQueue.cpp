@@ -0,0 +1,99 @@
+#include <Fw/Log/TextLogQueue.hpp>
+#include <Fw/Types/Assert.hpp>
+
+namespace Fw {
+
+    TextLogQueue* volatile TextLogQueue::s_queue = 0;
+
+    TextLogQueue::TextLogQueue(void) {
+        this->m_ring.setup(this->m_slots,FW_TEXT_LOG_QUEUE_DEPTH);
+    }
+
+    TextLogQueue::~TextLogQueue(void) {
+        // stop the generated code from using a deleted queue
+        (void)__sync_bool_compare_and_swap(&s_queue,this,0);
+    }
+
+    void TextLogQueue::setQueue(TextLogQueue* queue) {
+        s_queue = queue;
+        __sync_synchronize();
+    }
+
+    bool TextLogQueue::queueText(
+            OutputLogTextPort* port,
+            TextLogFormatter formatter,
+            const char* objName,
+            FwEventIdType id,
+            Time& timeTag,
+            TextLogSeverity severity,
+            const LogBuffer& args) {
+
+        TextLogQueue* queue = s_queue;
+        if (0 == queue) {
+            return false;
+        }
+        return queue->put(port,formatter,objName,id,timeTag,severity,args);
+    }
+
+    bool TextLogQueue::put(
+            OutputLogTextPort* port,
+            TextLogFormatter formatter,
+            const char* objName,
+            FwEventIdType id,
+            Time& timeTag,
+            TextLogSeverity severity,
+            const LogBuffer& args) {
+
+        FW_ASSERT(port);
+        FW_ASSERT(formatter);
+
+        U32 pos;
+        Entry* entry = this->m_ring.claim(pos);
+        if (0 == entry) {
+            return false;
+        }
+
+        entry->port = port;
+        entry->formatter = formatter;
+        entry->objName = objName;
+        entry->id = id;
+        entry->timeTag = timeTag;
+        entry->severity = severity;
+        entry->args = args;
+        this->m_ring.publish(pos);
+
+        return true;
+    }
+
+    NATIVE_UINT_TYPE TextLogQueue::drain(NATIVE_UINT_TYPE maxEvents) {
+
+        NATIVE_UINT_TYPE events = 0;
+        TextLogString text;
+
+        while (events < maxEvents) {
+            // empty, or the caller that claimed the entry hasn't finished with it
+            Entry* entry = this->m_ring.front();
+            if (0 == entry) {
+                break;
+            }
+
+            entry->args.resetDeser();
+            entry->formatter(entry->objName,entry->args,text);
+            entry->port->invoke(entry->id,entry->timeTag,entry->severity,text);
+
+            this->m_ring.pop();
+            events++;
+        }
+
+        return events;
+    }
+
+    U32 TextLogQueue::getOverflows(void) const {
+        return this->m_ring.getOverflows();
+    }
+
+    U32 TextLogQueue::getHighWater(void) const {
+        return this->m_ring.getHighWater();
+    }
+
+}
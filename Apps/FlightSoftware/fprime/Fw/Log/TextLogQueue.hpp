@@ -0,0 +1,92 @@
+/*
+ * TextLogQueue.hpp
+ *
+ * Description:
+ * Queue of events waiting to be formatted as text. When FW_TEXT_LOG_DEFERRED
+ * is set, the generated log functions put the event arguments here instead of
+ * formatting the text with snprintf on the caller's thread. The thread that
+ * owns the queue formats the text with the same format string and calls the
+ * component's text log port, so the text is the same as before.
+ *
+ * Any number of threads can add events without taking a lock. Only one
+ * thread can take them.
+ */
+#ifndef FW_TEXT_LOG_QUEUE_HPP
+#define FW_TEXT_LOG_QUEUE_HPP
+
+#include <Fw/Cfg/Config.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+#include <Fw/Types/MpscRing.hpp>
+#include <Fw/Time/Time.hpp>
+#include <Fw/Log/LogBuffer.hpp>
+#include <Fw/Log/TextLogString.hpp>
+#include <Fw/Log/LogTextPortAc.hpp>
+
+namespace Fw {
+
+    //! Formats the text of an event from its queued arguments. Generated for each event.
+    typedef void (*TextLogFormatter)(const char* objName, LogBuffer& args, TextLogString& text);
+
+    class TextLogQueue {
+        public:
+
+            TextLogQueue(void);
+            ~TextLogQueue(void);
+
+            //! Sets the queue the generated log functions use. NULL turns queueing off.
+            static void setQueue(TextLogQueue* queue);
+
+            //! Called by the generated log functions. Returns false if the event
+            //! wasn't queued, in which case the caller formats the text itself.
+            static bool queueText(
+                    OutputLogTextPort* port, //!< port to send the text on
+                    TextLogFormatter formatter, //!< formats the text
+                    const char* objName, //!< component name, or NULL
+                    FwEventIdType id,
+                    Time& timeTag,
+                    TextLogSeverity severity,
+                    const LogBuffer& args //!< arguments for the formatter
+                    );
+
+            //! Adds an event. Returns false if the queue is full.
+            bool put(
+                    OutputLogTextPort* port,
+                    TextLogFormatter formatter,
+                    const char* objName,
+                    FwEventIdType id,
+                    Time& timeTag,
+                    TextLogSeverity severity,
+                    const LogBuffer& args
+                    );
+
+            //! Formats and sends up to maxEvents events. Only one thread may call this.
+            NATIVE_UINT_TYPE drain(NATIVE_UINT_TYPE maxEvents);
+
+            U32 getOverflows(void) const; //!< events not queued because the queue was full
+            U32 getHighWater(void) const; //!< most events waiting at once
+
+        private:
+
+            struct Entry {
+                OutputLogTextPort* port;
+                TextLogFormatter formatter;
+                const char* objName;
+                FwEventIdType id;
+                Time timeTag;
+                TextLogSeverity severity;
+                LogBuffer args;
+            };
+
+            MpscRing<Entry>::Slot m_slots[FW_TEXT_LOG_QUEUE_DEPTH];
+            MpscRing<Entry> m_ring;
+
+            static TextLogQueue* volatile s_queue; //!< queue used by the generated code
+
+            // not copyable
+            TextLogQueue(const TextLogQueue&);
+            TextLogQueue& operator=(const TextLogQueue&);
+    };
+
+}
+
+#endif
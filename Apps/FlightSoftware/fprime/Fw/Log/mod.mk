@@ -20,12 +20,14 @@ SRC = \
 	LogPacket.cpp \
 	LogString.cpp \
 	TextLogString.cpp \
+	TextLogQueue.cpp \
 	AmpcsEvrLogPacket.cpp
 	
 HDR = LogBuffer.hpp \
 	LogPacket.hpp \
 	LogString.hpp \
 	TextLogString.hpp \
+	TextLogQueue.hpp \
 	AmpcsEvrLogPacket.hpp
 
 SUBDIRS = test
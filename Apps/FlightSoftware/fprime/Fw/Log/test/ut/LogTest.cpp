@@ -2,6 +2,9 @@
 #include <Fw/Log/LogPacket.hpp>
 #include <Fw/Com/ComBuffer.hpp>
 #include <Fw/Log/LogString.hpp>
+#include <Fw/Log/TextLogQueue.hpp>
+#include <Fw/Comp/PassiveComponentBase.hpp>
+#include <stdio.h>
 
 TEST(FwLogTest,LogPacketSerialize) {
 
@@ -44,6 +47,104 @@ TEST(FwLogTest,LogPacketSerialize) {
     ASSERT_EQ(str1,str2);
 }
 
+namespace {
+
+    // receives the text formatted by the queue
+    class TextLogReceiver : public Fw::PassiveComponentBase {
+        public:
+#if FW_OBJECT_NAMES == 1
+            TextLogReceiver(void) : Fw::PassiveComponentBase("TextLogReceiver"), m_count(0) {
+            }
+#else
+            TextLogReceiver(void) : Fw::PassiveComponentBase(), m_count(0) {
+            }
+#endif
+
+            static void textIn(Fw::PassiveComponentBase* callComp, NATIVE_INT_TYPE portNum,
+                    FwEventIdType id, Fw::Time &timeTag, Fw::TextLogSeverity severity, Fw::TextLogString &text) {
+                TextLogReceiver* comp = static_cast<TextLogReceiver*>(callComp);
+                comp->m_count++;
+                comp->m_id = id;
+                comp->m_timeTag = timeTag;
+                comp->m_severity = severity;
+                comp->m_text = text;
+            }
+
+            NATIVE_UINT_TYPE m_count;
+            FwEventIdType m_id;
+            Fw::Time m_timeTag;
+            Fw::TextLogSeverity m_severity;
+            Fw::TextLogString m_text;
+    };
+
+    void formatValue(const char* objName, Fw::LogBuffer& args, Fw::TextLogString& text) {
+        U32 value = 0;
+        EXPECT_EQ(Fw::FW_SERIALIZE_OK,args.deserialize(value));
+        char buff[FW_LOG_TEXT_BUFFER_SIZE];
+        (void)snprintf(buff,sizeof(buff),"(%s) VALUE: %u",objName,value);
+        text = buff;
+    }
+
+    bool queueValue(Fw::OutputLogTextPort& port, U32 value) {
+        Fw::LogBuffer args;
+        EXPECT_EQ(Fw::FW_SERIALIZE_OK,args.serialize(value));
+        Fw::Time timeTag(TB_WORKSTATION_TIME,value,0);
+        return Fw::TextLogQueue::queueText(&port,formatValue,"comp",value,timeTag,Fw::TEXT_LOG_ACTIVITY_HI,args);
+    }
+
+}
+
+TEST(FwLogTest,TextLogQueue) {
+
+    TextLogReceiver receiver;
+    Fw::InputLogTextPort inPort;
+    inPort.init();
+    inPort.addCallComp(&receiver,TextLogReceiver::textIn);
+    Fw::OutputLogTextPort outPort;
+    outPort.init();
+    outPort.addCallPort(&inPort);
+
+    // not queued until a queue is set
+    ASSERT_FALSE(queueValue(outPort,1));
+
+    static Fw::TextLogQueue queue;
+    Fw::TextLogQueue::setQueue(&queue);
+
+    // events are formatted and sent in order when drained
+    for (U32 value = 1; value <= 5; value++) {
+        ASSERT_TRUE(queueValue(outPort,value));
+    }
+    ASSERT_EQ(0u,receiver.m_count);
+    ASSERT_EQ(2u,queue.drain(2));
+    ASSERT_EQ(2u,receiver.m_count);
+    ASSERT_EQ(2u,receiver.m_id);
+    ASSERT_EQ(3u,queue.drain(10));
+    ASSERT_EQ(5u,receiver.m_count);
+    ASSERT_EQ(5u,receiver.m_id);
+    ASSERT_EQ(Fw::Time(TB_WORKSTATION_TIME,5,0),receiver.m_timeTag);
+    ASSERT_EQ(Fw::TEXT_LOG_ACTIVITY_HI,receiver.m_severity);
+    ASSERT_STREQ("(comp) VALUE: 5",receiver.m_text.toChar());
+    ASSERT_EQ(0u,queue.drain(10));
+
+    // a full queue turns events away so the caller can format them
+    for (U32 value = 0; value < FW_TEXT_LOG_QUEUE_DEPTH; value++) {
+        ASSERT_TRUE(queueValue(outPort,value));
+    }
+    ASSERT_FALSE(queueValue(outPort,FW_TEXT_LOG_QUEUE_DEPTH));
+    ASSERT_EQ(1u,queue.getOverflows());
+    ASSERT_EQ(static_cast<U32>(FW_TEXT_LOG_QUEUE_DEPTH),queue.getHighWater());
+    ASSERT_EQ(static_cast<NATIVE_UINT_TYPE>(FW_TEXT_LOG_QUEUE_DEPTH),queue.drain(2*FW_TEXT_LOG_QUEUE_DEPTH));
+    ASSERT_EQ(FW_TEXT_LOG_QUEUE_DEPTH - 1u,receiver.m_id);
+
+    // entries are reused after wrapping
+    ASSERT_TRUE(queueValue(outPort,100));
+    ASSERT_EQ(1u,queue.drain(10));
+    ASSERT_EQ(100u,receiver.m_id);
+
+    Fw::TextLogQueue::setQueue(NULL);
+    ASSERT_FALSE(queueValue(outPort,101));
+}
+
 int main(int argc, char* argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -7,7 +7,7 @@
 
 TEST_SRC = LogTest.cpp
 
-TEST_MODS = Fw/Log Fw/Com Fw/Types Fw/Obj Fw/Port Fw/Time gtest
+TEST_MODS = Fw/Log Fw/Com Fw/Comp Fw/Types Fw/Obj Fw/Port Fw/Time gtest
 
 
 COMPARGS = -I$(CURDIR)/test/ut/Handcode
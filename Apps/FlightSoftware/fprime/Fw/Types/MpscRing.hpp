@@ -0,0 +1,151 @@
+/*
+ * MpscRing.hpp
+ *
+ * Description:
+ * Bounded multi-producer, single-consumer ring. Any number of threads can
+ * put entries without taking a lock. Only one thread can take them.
+ *
+ * Each slot has a sequence number that says which position it is free or
+ * full for, so a producer claims a slot with one compare and swap on the
+ * tail and the consumer never writes anything a producer reads other than
+ * the sequence. The storage is given to setup(), so rings of different
+ * depths have the same type and can be kept in an array.
+ *
+ * A producer calls claim(), fills the entry in place and calls publish().
+ * The consumer calls front(), uses the entry and calls pop().
+ */
+#ifndef FW_MPSC_RING_HPP
+#define FW_MPSC_RING_HPP
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <Fw/Types/Assert.hpp>
+
+namespace Fw {
+
+    template <typename T>
+    class MpscRing {
+        public:
+
+            struct Slot {
+                volatile U32 sequence; //!< position + 1 when full, position + depth when emptied
+                T entry;
+            };
+
+            MpscRing(void) :
+                m_slots(0),
+                m_depth(0),
+                m_head(0),
+                m_tail(0),
+                m_highWater(0),
+                m_overflows(0) {
+            }
+
+            //! Gives the ring its storage and empties it. Not thread safe.
+            void setup(Slot* slots, U32 depth) {
+                FW_ASSERT(slots);
+                // positions wrap, so the depth has to divide 2^32
+                FW_ASSERT((depth != 0) and (0 == (depth & (depth - 1))),depth);
+
+                this->m_slots = slots;
+                this->m_depth = depth;
+                this->m_head = 0;
+                this->m_tail = 0;
+                this->m_highWater = 0;
+                this->m_overflows = 0;
+                for (U32 slot = 0; slot < depth; slot++) {
+                    slots[slot].sequence = slot;
+                }
+            }
+
+            //! Claims the next position. Returns the entry to fill, or NULL if the
+            //! ring is full. The caller must publish() the position when done.
+            T* claim(U32& pos) {
+                FW_ASSERT(this->m_slots);
+
+                // a slot is free for position pos when its sequence is pos
+                pos = this->m_tail;
+                while (true) {
+                    Slot& slot = this->m_slots[pos & (this->m_depth - 1)];
+                    I32 diff = static_cast<I32>(slot.sequence - pos);
+                    if (0 == diff) {
+                        if (__sync_bool_compare_and_swap(&this->m_tail,pos,pos + 1)) {
+                            return &slot.entry;
+                        }
+                    } else if (diff < 0) {
+                        // still holds an entry from the last time around, so the ring is full
+                        (void)__sync_fetch_and_add(&this->m_overflows,1);
+                        return 0;
+                    }
+                    pos = this->m_tail;
+                }
+            }
+
+            //! Hands a filled entry to the consumer
+            void publish(U32 pos) {
+                Slot& slot = this->m_slots[pos & (this->m_depth - 1)];
+                FW_ASSERT(slot.sequence == pos,slot.sequence,pos);
+                // make the contents visible before the consumer sees the sequence
+                __sync_synchronize();
+                slot.sequence = pos + 1;
+
+                // count is approximate if the consumer is emptying the ring at the same time
+                U32 waiting = pos + 1 - this->m_head;
+                U32 highWater = this->m_highWater;
+                while ((waiting > highWater) and (waiting <= this->m_depth)) {
+                    if (__sync_bool_compare_and_swap(&this->m_highWater,highWater,waiting)) {
+                        break;
+                    }
+                    highWater = this->m_highWater;
+                }
+            }
+
+            //! Oldest entry, or NULL if the ring is empty or the producer that
+            //! claimed it hasn't published it yet. Consumer only.
+            T* front(void) {
+                Slot& slot = this->m_slots[this->m_head & (this->m_depth - 1)];
+                if (slot.sequence != this->m_head + 1) {
+                    return 0;
+                }
+                __sync_synchronize();
+                return &slot.entry;
+            }
+
+            //! Gives the entry returned by front() back for the next time around. Consumer only.
+            void pop(void) {
+                U32 pos = this->m_head;
+                Slot& slot = this->m_slots[pos & (this->m_depth - 1)];
+                FW_ASSERT(slot.sequence == pos + 1,slot.sequence,pos);
+                __sync_synchronize();
+                slot.sequence = pos + this->m_depth;
+                this->m_head = pos + 1;
+            }
+
+            U32 getDepth(void) const {
+                return this->m_depth;
+            }
+
+            U32 getHighWater(void) const { //!< most entries waiting at once
+                return this->m_highWater;
+            }
+
+            U32 getOverflows(void) const { //!< claims that failed because the ring was full
+                return this->m_overflows;
+            }
+
+        private:
+
+            Slot* m_slots; //!< storage given to setup()
+            U32 m_depth; //!< number of slots. Power of two
+            volatile U32 m_head; //!< next position to take. Only changed by the consumer
+            volatile U32 m_tail; //!< next position to claim
+            volatile U32 m_highWater;
+            volatile U32 m_overflows;
+
+            // not copyable
+            MpscRing(const MpscRing&);
+            MpscRing& operator=(const MpscRing&);
+    };
+
+}
+
+#endif
@@ -38,7 +38,8 @@ HDR = \
 	InternalInterfaceString.hpp \
 	CAssert.hpp \
 	MemAllocator.hpp \
-	MallocAllocator.hpp
+	MallocAllocator.hpp \
+	MpscRing.hpp
 
 #	FwStructSerializable.hpp
 
@@ -6,6 +6,8 @@
 #include <Fw/Types/EightyCharString.hpp>
 #include <Fw/Types/InternalInterfaceString.hpp>
 #include <Fw/Types/PolyType.hpp>
+#include <Fw/Types/MpscRing.hpp>
+#include <Os/Task.hpp>
 
 #include <stdio.h>
 #include <string.h>
@@ -806,6 +808,109 @@ TEST(TypesTest,StringFormatTest) {
     printf("Formatted: %s\n",str.toChar());
 }
 
+TEST(TypesTest,MpscRingTest) {
+
+    Fw::MpscRing<U32>::Slot slots[4];
+    Fw::MpscRing<U32> ring;
+    ring.setup(slots,FW_NUM_ARRAY_ELEMENTS(slots));
+    ASSERT_EQ(ring.getDepth(),(U32)4);
+    ASSERT_TRUE(0 == ring.front());
+
+    // fill it. The fifth claim fails and is counted
+    U32 pos;
+    for (U32 entry = 0; entry < 4; entry++) {
+        U32* value = ring.claim(pos);
+        ASSERT_TRUE(value != 0);
+        ASSERT_EQ(pos,entry);
+        *value = entry + 10;
+        ring.publish(pos);
+    }
+    ASSERT_TRUE(0 == ring.claim(pos));
+    ASSERT_EQ(ring.getOverflows(),(U32)1);
+    ASSERT_EQ(ring.getHighWater(),(U32)4);
+
+    // entries come out in order
+    for (U32 entry = 0; entry < 4; entry++) {
+        U32* value = ring.front();
+        ASSERT_TRUE(value != 0);
+        ASSERT_EQ(*value,entry + 10);
+        ring.pop();
+    }
+    ASSERT_TRUE(0 == ring.front());
+
+    // a claimed entry isn't taken until it is published, and holds up the ones after it
+    U32 first;
+    U32* value = ring.claim(first);
+    *value = 1;
+    value = ring.claim(pos);
+    *value = 2;
+    ring.publish(pos);
+    ASSERT_TRUE(0 == ring.front());
+    ring.publish(first);
+    ASSERT_EQ(*ring.front(),(U32)1);
+    ring.pop();
+    ASSERT_EQ(*ring.front(),(U32)2);
+    ring.pop();
+    ASSERT_TRUE(0 == ring.front());
+}
+
+// producers put their index in the high byte and a count in the low bytes
+static const U32 MPSC_PRODUCERS = 4;
+static const U32 MPSC_ENTRIES = 20000;
+static Fw::MpscRing<U32> mpscRing;
+
+static void mpscProducer(void* ptr) {
+    U32 producer = *static_cast<U32*>(ptr);
+    for (U32 count = 0; count < MPSC_ENTRIES; count++) {
+        U32 pos;
+        U32* value;
+        while (0 == (value = mpscRing.claim(pos))) {
+            // full. Let the consumer run
+            (void)Os::Task::delay(0);
+        }
+        *value = (producer << 24) | count;
+        mpscRing.publish(pos);
+    }
+}
+
+TEST(TypesTest,MpscRingThreadTest) {
+
+    static Fw::MpscRing<U32>::Slot slots[16];
+    mpscRing.setup(slots,FW_NUM_ARRAY_ELEMENTS(slots));
+
+    Os::Task tasks[MPSC_PRODUCERS];
+    U32 producers[MPSC_PRODUCERS];
+    for (U32 producer = 0; producer < MPSC_PRODUCERS; producer++) {
+        producers[producer] = producer;
+        Fw::EightyCharString name;
+        name.format("MPSC%d",producer);
+        ASSERT_EQ(tasks[producer].start(name,producer,0,64*1024,mpscProducer,&producers[producer]),Os::Task::TASK_OK);
+    }
+
+    // each producer's entries come out in the order it put them
+    U32 next[MPSC_PRODUCERS] = {0};
+    for (U32 taken = 0; taken < MPSC_PRODUCERS * MPSC_ENTRIES; ) {
+        U32* value = mpscRing.front();
+        if (0 == value) {
+            (void)Os::Task::delay(0);
+            continue;
+        }
+        U32 producer = *value >> 24;
+        ASSERT_LT(producer,MPSC_PRODUCERS);
+        ASSERT_EQ(*value & 0xFFFFFF,next[producer]);
+        next[producer]++;
+        mpscRing.pop();
+        taken++;
+    }
+
+    for (U32 producer = 0; producer < MPSC_PRODUCERS; producer++) {
+        ASSERT_EQ(tasks[producer].join(0),Os::Task::TASK_OK);
+        ASSERT_EQ(next[producer],MPSC_ENTRIES);
+    }
+    ASSERT_TRUE(0 == mpscRing.front());
+    ASSERT_LE(mpscRing.getHighWater(),(U32)16);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
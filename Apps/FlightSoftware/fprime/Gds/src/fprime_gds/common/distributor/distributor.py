@@ -48,6 +48,9 @@ class Distributor(object):
 
         self.__decoders = {key.name: [] for key in list(data_desc_type.DataDescType)}
 
+        # Descriptors already reported as having no registered decoder
+        self.__unhandled = set()
+
         # Internal buffer for un distributed data
         self.__buf = b""
         #Setup key framing
@@ -199,11 +202,59 @@ class Distributor(object):
         (leftover_data, raw_msgs) = self.parse_into_raw_msgs_api(self.__buf)
         self.__buf = leftover_data
 
+        self.distribute_raw_msgs(raw_msgs)
+
+
+    def split_batch(self, msg):
+        """
+        Split the body of a log batch into raw messages. The body has no
+        framing key, just length-prefixed log packets.
+
+        Args:
+            msg (bytearray): Batch body after the descriptor
+
+        Returns:
+            A list of raw messages. A partial message at the end is dropped.
+        """
+        raw_msgs = []
+        offset = 0
+        while len(msg) - offset >= self.len_obj.getSize():
+            self.len_obj.deserialize(msg, offset)
+            end = offset + self.len_obj.getSize() + self.len_obj.val
+            if end > len(msg):
+                break
+            raw_msgs.append(msg[offset:end])
+            offset = end
+        return raw_msgs
+
+
+    def distribute_raw_msgs(self, raw_msgs):
+        """
+        Pass raw messages to the decoders registered for their descriptors.
+        A log batch holds raw messages of its own, which are passed on
+        individually.
+
+        Args:
+            raw_msgs (list): Raw messages, each with a length and descriptor
+                             header.
+        """
         for raw_msg in raw_msgs:
             (length, data_desc, msg) = self.parse_raw_msg_api(raw_msg)
 
             data_desc_key = data_desc_type.DataDescType(data_desc).name
 
+            if data_desc_key == "FW_PACKET_LOG_BATCH":
+                self.distribute_raw_msgs(self.split_batch(msg))
+                continue
+
+            if not self.__decoders[data_desc_key]:
+                # Report each undecoded type once instead of dropping it silently
+                if data_desc_key not in self.__unhandled:
+                    self.__unhandled.add(data_desc_key)
+                    print("Distributor warning: no decoder registered for %s, "
+                          "dropping these messages"%data_desc_key)
+                continue
+
             for d in self.__decoders[data_desc_key]:
                 d.data_callback(msg)
 
@@ -35,6 +35,10 @@ Serialized command format:
     | Argument n value               |
     +--------------------------------+
 
+A batch of commands (see encode_batch_api) has the same header. Its descriptor
+type is FW_PACKET_COMMAND_BATCH = 7, followed by each command as a 4 byte
+length and then the descriptor type, op code and arguments above.
+
 @date Created July 9, 2018
 @author R. Joseph Paetz
 
@@ -95,10 +99,55 @@ class CmdEncoder(encoder.Encoder):
             Encoded version of the data argument as binary data
         '''
         # TODO we should be able to handle multiple destinations, not just FSW
-        cmd_temp = data.get_template()
+        desc = U32Type( 0x5A5A5A5A ).serialize()
+
+        packet = self.encode_packet(data)
+
+        self.len_obj.val = len(packet)
+        length = self.len_obj.serialize()
+
+        binary_data = (desc + length + packet)
+
+        return binary_data
 
+
+    def encode_batch_api(self, data_list):
+        '''
+        Encodes several CmdData objects as one batch packet. The flight
+        software dispatches the commands in order, each with its own status.
+
+        Args:
+            data_list: List of CmdData objects to encode
+
+        Returns:
+            Encoded batch as binary data
+        '''
         desc = U32Type( 0x5A5A5A5A ).serialize()
 
+        packet = U32Type(DataDescType["FW_PACKET_COMMAND_BATCH"].value).serialize()
+        for data in data_list:
+            cmd_packet = self.encode_packet(data)
+            packet += U32Type(len(cmd_packet)).serialize() + cmd_packet
+
+        self.len_obj.val = len(packet)
+        length = self.len_obj.serialize()
+
+        return desc + length + packet
+
+
+    def encode_packet(self, data):
+        '''
+        Encodes the command packet of a CmdData object: the descriptor type,
+        op code and arguments.
+
+        Args:
+            data: CmdData object to encode
+
+        Returns:
+            The command packet as binary data
+        '''
+        cmd_temp = data.get_template()
+
         descriptor = U32Type(DataDescType["FW_PACKET_COMMAND"].value).serialize()
 
         op_code = U32Type(cmd_temp.get_op_code()).serialize()
@@ -107,11 +156,5 @@ class CmdEncoder(encoder.Encoder):
         for arg in data.get_args():
             arg_data += arg.serialize()
 
-        length_val = len(descriptor) + len(op_code) + len(arg_data)
-        self.len_obj.val = length_val
-        length = self.len_obj.serialize()
-
-        binary_data = (desc + length + descriptor + op_code + arg_data)
-
-        return binary_data
+        return descriptor + op_code + arg_data
 
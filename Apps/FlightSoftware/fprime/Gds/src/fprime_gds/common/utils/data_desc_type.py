@@ -16,6 +16,10 @@ DataDescType = Enum("DataDescType",
                       "FW_PACKET_PACKETIZED_TLM": 4,
                       # Idle packet
                       "FW_PACKET_IDLE": 5,
+                      # Several log packets, each preceded by its length
+                      "FW_PACKET_LOG_BATCH": 6,
+                      # Several command packets, each preceded by its length
+                      "FW_PACKET_COMMAND_BATCH": 7,
                       # Unknown packet
                       "FW_PACKET_UNKNOWN": 0xFF})
 
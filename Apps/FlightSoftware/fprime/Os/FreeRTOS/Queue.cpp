@@ -15,6 +15,13 @@ using namespace std;
 
 namespace Os {
 
+#if FW_QUEUE_INSTRUMENTATION
+    // Each item holds the time it was sent between its size and its data:
+    static const NATIVE_INT_TYPE STAMP_SIZE = sizeof(IntervalTimer::RawTime);
+#else
+    static const NATIVE_INT_TYPE STAMP_SIZE = 0;
+#endif
+
     Queue::Queue() :
         m_handle(NULL) {
     }
@@ -24,7 +31,7 @@ namespace Os {
         m_name += name;
 
         QueueHandle_t queueHandle;
-        queueHandle = xQueueCreate(depth, msgSize + sizeof(msgSize));
+        queueHandle = xQueueCreate(depth, msgSize + sizeof(msgSize) + STAMP_SIZE);
 
         #ifdef USE_TRACE_FACILITY
             vTraceSetQueueName(queueHandle, m_name.toChar());
@@ -40,12 +47,23 @@ namespace Os {
 
         Queue::s_numQueues++;
 
-        m_msgBuffer = (U8 *) pvPortMalloc(msgSize + sizeof(msgSize));
+        m_msgBuffer = (U8 *) pvPortMalloc(msgSize + sizeof(msgSize) + STAMP_SIZE);
+
+#if FW_QUEUE_REGISTRATION
+        if (this->s_queueRegistry) {
+            this->s_queueRegistry->regQueue(this);
+        }
+#endif
 
         return QUEUE_OK;
     }
 
     Queue::~Queue(){
+#if FW_QUEUE_REGISTRATION
+        if (this->s_queueRegistry) {
+            this->s_queueRegistry->unregQueue(this);
+        }
+#endif
         if(m_handle){
             vQueueDelete((QueueHandle_t) m_handle);
         }
@@ -67,12 +85,20 @@ namespace Os {
         }
 
         m_msgBuffer[0] = size;
-        memcpy(m_msgBuffer + sizeof(size), buffer, size);
+#if FW_QUEUE_INSTRUMENTATION
+        IntervalTimer::RawTime sendTime;
+        IntervalTimer::getRawTime(sendTime);
+        memcpy(m_msgBuffer + sizeof(size), &sendTime, STAMP_SIZE);
+#endif
+        memcpy(m_msgBuffer + sizeof(size) + STAMP_SIZE, buffer, size);
 
         // if (size != getMsgSize()) return QUEUE_SIZE_MISMATCH
         if (block == QUEUE_NONBLOCKING){
             if (xQueueSendToBack(queueHandle, (void*) m_msgBuffer, (TickType_t)0) == errQUEUE_FULL){
                 // printf("QUEUE IS FULL\n");
+#if FW_QUEUE_INSTRUMENTATION
+                this->countSend(QUEUE_FULL);
+#endif
                 return QUEUE_FULL;
             }
         }
@@ -83,6 +109,10 @@ namespace Os {
             }
         }
 
+#if FW_QUEUE_INSTRUMENTATION
+        this->countSend(QUEUE_OK);
+        this->m_stats.countDepth(uxQueueMessagesWaiting(queueHandle));
+#endif
         return QUEUE_OK;
     }
 
@@ -120,7 +150,12 @@ namespace Os {
 
 
         actualSize = m_msgBuffer[0];
-        memcpy(buffer, m_msgBuffer + sizeof(actualSize), actualSize);
+        memcpy(buffer, m_msgBuffer + sizeof(actualSize) + STAMP_SIZE, actualSize);
+#if FW_QUEUE_INSTRUMENTATION
+        IntervalTimer::RawTime sendTime;
+        memcpy(&sendTime, m_msgBuffer + sizeof(actualSize), STAMP_SIZE);
+        this->m_stats.countReceive(sendTime);
+#endif
 
 
         return QUEUE_OK;
@@ -137,8 +172,13 @@ namespace Os {
 
     NATIVE_INT_TYPE Queue::getMaxMsgs(void) const
     {
+#if FW_QUEUE_INSTRUMENTATION
+        // FreeRTOS queues don't keep a high water mark, so use the one counted on send:
+        return this->m_stats.getMaxDepth();
+#else
         // FW_ASSERT(0);
         return 0;
+#endif
     }
 
     NATIVE_INT_TYPE Queue::getQueueSize(void) const
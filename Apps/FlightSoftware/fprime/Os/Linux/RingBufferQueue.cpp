@@ -0,0 +1,452 @@
+#include <Os/Linux/RingBufferQueue.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <sched.h>
+#include <unistd.h>
+#include <string.h>
+#include <new>
+
+namespace Os {
+
+    namespace {
+
+        // waits for another thread that is part way through a put or take spin this many times
+        // before giving up the processor, in case that thread isn't running
+        const U32 SPINS_BEFORE_YIELD = 64;
+
+        // loads and stores that order the ring contents without a full barrier
+        U32 loadAcquire(volatile U32* word) {
+            return __atomic_load_n(word,__ATOMIC_ACQUIRE);
+        }
+
+        void storeRelease(volatile U32* word, U32 value) {
+            __atomic_store_n(word,value,__ATOMIC_RELEASE);
+        }
+
+        void relax(U32& spins) {
+            if (++spins > SPINS_BEFORE_YIELD) {
+                (void)sched_yield();
+            }
+        }
+
+        // A wait word is set while a thread is asleep, or about to sleep, on it. The first thread
+        // to clear it wakes one sleeper, so the others that follow don't make the system call.
+        // The woken thread sets it again and passes the wake on if there are more sleepers and
+        // the queue can still take them.
+
+        //! Sets the word before the caller looks at the queue one last time. Also a full barrier.
+        void prepareWait(volatile U32* word) {
+            (void)__atomic_exchange_n(word,1,__ATOMIC_SEQ_CST);
+        }
+
+        //! Sleeps unless the word has been cleared. Returns early on a signal.
+        void wait(volatile U32* word) {
+            (void)syscall(SYS_futex,const_cast<U32*>(word),FUTEX_WAIT_PRIVATE,1,NULL,NULL,0);
+        }
+
+        //! Wakes a thread asleep on the word. The caller needs a full barrier since changing the queue.
+        void wake(volatile U32* word) {
+            if ((0 != *word) and (0 != __atomic_exchange_n(word,0,__ATOMIC_SEQ_CST))) {
+                (void)syscall(SYS_futex,const_cast<U32*>(word),FUTEX_WAKE_PRIVATE,1,NULL,NULL,0);
+            }
+        }
+
+    }
+
+    RingBufferQueue::RingBufferQueue(void) :
+        m_data(0),
+        m_sizes(0),
+#if FW_QUEUE_INSTRUMENTATION
+        m_sendTimes(0),
+#endif
+        m_lanes(0),
+        m_numLanes(0),
+        m_depth(0),
+        m_msgSize(0),
+        m_count(0),
+        m_maxCount(0),
+        m_emptyWait(0),
+        m_fullWait(0),
+        m_emptySleepers(0),
+        m_fullSleepers(0) {
+        this->m_free.cells = 0;
+    }
+
+    RingBufferQueue::~RingBufferQueue(void) {
+        this->finalize();
+    }
+
+    bool RingBufferQueue::create(NATIVE_UINT_TYPE depth, NATIVE_UINT_TYPE msgSize, NATIVE_UINT_TYPE priorities) {
+
+        FW_ASSERT(depth > 0);
+        FW_ASSERT(priorities > 0);
+
+        // queue is already set up. destroy it and try again
+        this->finalize();
+
+        // ring positions wrap, so the ring size has to divide 2^32
+        U32 ringSize = 1;
+        while (ringSize < depth) {
+            ringSize <<= 1;
+        }
+
+        this->m_data = new (std::nothrow) U8[depth * msgSize];
+        this->m_sizes = new (std::nothrow) NATIVE_UINT_TYPE[depth];
+        this->m_lanes = new (std::nothrow) Lane[priorities];
+        if ((0 == this->m_data) or (0 == this->m_sizes) or (0 == this->m_lanes)) {
+            this->finalize();
+            return false;
+        }
+#if FW_QUEUE_INSTRUMENTATION
+        this->m_sendTimes = new (std::nothrow) IntervalTimer::RawTime[depth];
+        if (0 == this->m_sendTimes) {
+            this->finalize();
+            return false;
+        }
+#endif
+        for (NATIVE_UINT_TYPE lane = 0; lane < priorities; lane++) {
+            this->m_lanes[lane].state = LANE_FREE;
+            this->m_lanes[lane].priority = 0;
+            this->m_lanes[lane].ring.cells = 0;
+        }
+        this->m_numLanes = priorities;
+
+        if (not this->setupRing(this->m_free,ringSize)) {
+            this->finalize();
+            return false;
+        }
+        for (NATIVE_UINT_TYPE lane = 0; lane < priorities; lane++) {
+            if (not this->setupRing(this->m_lanes[lane].ring,ringSize)) {
+                this->finalize();
+                return false;
+            }
+        }
+
+        // every slot starts out free
+        for (U32 slot = 0; slot < depth; slot++) {
+            put(this->m_free,slot);
+        }
+
+        this->m_depth = depth;
+        this->m_msgSize = msgSize;
+        this->m_count = 0;
+        this->m_maxCount = 0;
+        return true;
+    }
+
+    bool RingBufferQueue::setupRing(Ring& ring, U32 size) {
+        ring.cells = new (std::nothrow) Cell[size];
+        if (0 == ring.cells) {
+            return false;
+        }
+        // a cell is free for position pos when its sequence is pos
+        for (U32 cell = 0; cell < size; cell++) {
+            ring.cells[cell].sequence = cell;
+            ring.cells[cell].slot = 0;
+        }
+        ring.mask = size - 1;
+        ring.head = 0;
+        ring.tail = 0;
+        return true;
+    }
+
+    void RingBufferQueue::finalize(void) {
+        if (this->m_lanes) {
+            for (NATIVE_UINT_TYPE lane = 0; lane < this->m_numLanes; lane++) {
+                delete[] this->m_lanes[lane].ring.cells;
+            }
+        }
+        delete[] this->m_lanes;
+        delete[] this->m_free.cells;
+        delete[] this->m_sizes;
+        delete[] this->m_data;
+#if FW_QUEUE_INSTRUMENTATION
+        delete[] this->m_sendTimes;
+        this->m_sendTimes = 0;
+#endif
+        this->m_lanes = 0;
+        this->m_free.cells = 0;
+        this->m_sizes = 0;
+        this->m_data = 0;
+        this->m_numLanes = 0;
+        this->m_depth = 0;
+        this->m_msgSize = 0;
+    }
+
+    void RingBufferQueue::put(Ring& ring, U32 slot) {
+        U32 pos = ring.tail;
+        U32 spins = 0;
+        Cell* cell;
+        while (true) {
+            cell = &ring.cells[pos & ring.mask];
+            I32 diff = static_cast<I32>(loadAcquire(&cell->sequence) - pos);
+            if (0 == diff) {
+                if (__sync_bool_compare_and_swap(&ring.tail,pos,pos + 1)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the ring has room for every slot, so it is never full. The cell still holds
+                // a slot from the last time around because a taker has claimed it and is
+                // about to give the cell back, so wait for it.
+                relax(spins);
+            }
+            pos = ring.tail;
+        }
+        cell->slot = slot;
+        // the slot is visible before the taker sees the sequence
+        storeRelease(&cell->sequence,pos + 1);
+    }
+
+    bool RingBufferQueue::take(Ring& ring, U32& slot) {
+        U32 pos = ring.head;
+        U32 spins = 0;
+        Cell* cell;
+        while (true) {
+            cell = &ring.cells[pos & ring.mask];
+            I32 diff = static_cast<I32>(loadAcquire(&cell->sequence) - (pos + 1));
+            if (0 == diff) {
+                if (__sync_bool_compare_and_swap(&ring.head,pos,pos + 1)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                if (ring.tail == pos) {
+                    return false;
+                }
+                // a putter has claimed the cell and is about to fill it, and anything
+                // put after it is behind it, so wait for it
+                relax(spins);
+            }
+            pos = ring.head;
+        }
+        slot = cell->slot;
+        // give the cell back for the next time around
+        storeRelease(&cell->sequence,pos + ring.mask + 1);
+        return true;
+    }
+
+    RingBufferQueue::Lane* RingBufferQueue::getLane(NATIVE_INT_TYPE priority) {
+
+        // lanes are claimed in order, so the used ones come first. The priority of a
+        // used lane is seen along with its state.
+        NATIVE_UINT_TYPE used = 0;
+        while ((used < this->m_numLanes) and (LANE_USED == loadAcquire(&this->m_lanes[used].state))) {
+            used++;
+        }
+        for (NATIVE_UINT_TYPE lane = 0; lane < used; lane++) {
+            if (this->m_lanes[lane].priority == priority) {
+                return &this->m_lanes[lane];
+            }
+        }
+
+        // claim the next lane, unless another sender claims it for the same priority first
+        for (NATIVE_UINT_TYPE lane = used; lane < this->m_numLanes; lane++) {
+            Lane& next = this->m_lanes[lane];
+            if (__sync_bool_compare_and_swap(&next.state,LANE_FREE,LANE_CLAIMING)) {
+                next.priority = priority;
+                storeRelease(&next.state,LANE_USED);
+                return &next;
+            }
+            // the claiming sender only sets the priority
+            U32 spins = 0;
+            while (LANE_USED != loadAcquire(&next.state)) {
+                relax(spins);
+            }
+            if (next.priority == priority) {
+                return &next;
+            }
+        }
+
+        return 0;
+    }
+
+    Queue::QueueStatus RingBufferQueue::send(const U8* buffer, NATIVE_UINT_TYPE size, NATIVE_INT_TYPE priority, Queue::QueueBlocking block) {
+
+        FW_ASSERT(buffer);
+        FW_ASSERT(size <= this->m_msgSize,size,this->m_msgSize);
+
+        Lane* lane = this->getLane(priority);
+        if (0 == lane) {
+            return Queue::QUEUE_INVALID_PRIORITY;
+        }
+
+        U32 slot;
+        bool slept = false;
+        while (not take(this->m_free,slot)) {
+            if (Queue::QUEUE_NONBLOCKING == block) {
+                return Queue::QUEUE_FULL;
+            }
+            // look again after saying we're waiting, so a receiver freeing a slot now wakes us
+            (void)__sync_fetch_and_add(&this->m_fullSleepers,1);
+            prepareWait(&this->m_fullWait);
+            bool taken = take(this->m_free,slot);
+            if (not taken) {
+                wait(&this->m_fullWait);
+                slept = true;
+            }
+            (void)__sync_fetch_and_sub(&this->m_fullSleepers,1);
+            if (taken) {
+                break;
+            }
+        }
+        // a receiver wakes one sender. Pass the wake on if another sender is asleep and
+        // there is another free slot.
+        if (slept and (0 != this->m_fullSleepers)) {
+            prepareWait(&this->m_fullWait);
+            if (this->m_free.tail != this->m_free.head) {
+                wake(&this->m_fullWait);
+            }
+        }
+
+        (void)memcpy(&this->m_data[slot * this->m_msgSize],buffer,size);
+        this->m_sizes[slot] = size;
+#if FW_QUEUE_INSTRUMENTATION
+        IntervalTimer::getRawTime(this->m_sendTimes[slot]);
+#endif
+        put(lane->ring,slot);
+
+        // the count can be taken away before it is added, so it can be briefly negative. The
+        // add is also the barrier before waking a waiting receiver.
+        I32 count = static_cast<I32>(__sync_add_and_fetch(&this->m_count,1));
+        I32 maxCount = static_cast<I32>(this->m_maxCount);
+        while (count > maxCount) {
+            if (__sync_bool_compare_and_swap(&this->m_maxCount,maxCount,count)) {
+                break;
+            }
+            maxCount = static_cast<I32>(this->m_maxCount);
+        }
+
+        wake(&this->m_emptyWait);
+
+        return Queue::QUEUE_OK;
+    }
+
+    Queue::QueueStatus RingBufferQueue::takeMessage(U8* buffer, NATIVE_UINT_TYPE capacity, NATIVE_UINT_TYPE& actualSize, NATIVE_INT_TYPE& priority, IntervalTimer::RawTime* sendTime) {
+
+        actualSize = 0;
+
+        U32 spins = 0;
+        while (true) {
+            NATIVE_UINT_TYPE used = 0;
+            while ((used < this->m_numLanes) and (LANE_USED == loadAcquire(&this->m_lanes[used].state))) {
+                used++;
+            }
+
+            // highest priority lane with a message at its head
+            Lane* best = 0;
+            U32 pos = 0;
+            bool filling = false;
+            for (NATIVE_UINT_TYPE lane = 0; lane < used; lane++) {
+                Ring& ring = this->m_lanes[lane].ring;
+                U32 head = ring.head;
+                if (loadAcquire(&ring.cells[head & ring.mask].sequence) != head + 1) {
+                    filling = filling or (ring.tail != head);
+                } else if ((0 == best) or (this->m_lanes[lane].priority > best->priority)) {
+                    best = &this->m_lanes[lane];
+                    pos = head;
+                }
+            }
+            if (0 == best) {
+                // a sender is part way through putting a message at the head of a lane, and
+                // messages sent after it may be behind it, so only report empty if none is
+                if (filling) {
+                    relax(spins);
+                    continue;
+                }
+                return Queue::QUEUE_NO_MORE_MSGS;
+            }
+
+            // the size is checked before the message is taken, so a message that doesn't fit
+            // stays in the queue. If another receiver takes it first, the swap below fails.
+            Ring& ring = best->ring;
+            Cell& cell = ring.cells[pos & ring.mask];
+            U32 slot = cell.slot;
+            NATIVE_UINT_TYPE size = this->m_sizes[slot];
+            if (size > capacity) {
+                if (ring.head != pos) {
+                    continue;
+                }
+                return Queue::QUEUE_SIZE_MISMATCH;
+            }
+            if (not __sync_bool_compare_and_swap(&ring.head,pos,pos + 1)) {
+                continue;
+            }
+
+            (void)memcpy(buffer,&this->m_data[slot * this->m_msgSize],size);
+            actualSize = size;
+            priority = best->priority;
+#if FW_QUEUE_INSTRUMENTATION
+            if (0 != sendTime) {
+                *sendTime = this->m_sendTimes[slot];
+            }
+#endif
+
+            // give the cell and the slot back. Taking away the count is also the barrier
+            // before waking a waiting sender.
+            storeRelease(&cell.sequence,pos + ring.mask + 1);
+            put(this->m_free,slot);
+            (void)__sync_fetch_and_sub(&this->m_count,1);
+
+            wake(&this->m_fullWait);
+
+            return Queue::QUEUE_OK;
+        }
+    }
+
+    Queue::QueueStatus RingBufferQueue::receive(U8* buffer, NATIVE_UINT_TYPE capacity, NATIVE_UINT_TYPE& actualSize, NATIVE_INT_TYPE& priority, Queue::QueueBlocking block, IntervalTimer::RawTime* sendTime) {
+
+        FW_ASSERT(buffer);
+
+        Queue::QueueStatus status;
+        bool slept = false;
+        while (true) {
+            status = this->takeMessage(buffer,capacity,actualSize,priority,sendTime);
+            if (Queue::QUEUE_NO_MORE_MSGS != status) {
+                break;
+            }
+            if (Queue::QUEUE_NONBLOCKING == block) {
+                return status;
+            }
+            // look again after saying we're waiting, so a sender queueing a message now wakes us
+            (void)__sync_fetch_and_add(&this->m_emptySleepers,1);
+            prepareWait(&this->m_emptyWait);
+            status = this->takeMessage(buffer,capacity,actualSize,priority,sendTime);
+            if (Queue::QUEUE_NO_MORE_MSGS == status) {
+                wait(&this->m_emptyWait);
+                slept = true;
+            }
+            (void)__sync_fetch_and_sub(&this->m_emptySleepers,1);
+            if (Queue::QUEUE_NO_MORE_MSGS != status) {
+                break;
+            }
+        }
+        // a sender wakes one receiver. Pass the wake on if another receiver is asleep and
+        // there is another message.
+        if (slept and (0 != this->m_emptySleepers)) {
+            prepareWait(&this->m_emptyWait);
+            if (0 != this->getCount()) {
+                wake(&this->m_emptyWait);
+            }
+        }
+        return status;
+    }
+
+    NATIVE_UINT_TYPE RingBufferQueue::getCount(void) const {
+        I32 count = static_cast<I32>(this->m_count);
+        return (count > 0) ? count : 0;
+    }
+
+    NATIVE_UINT_TYPE RingBufferQueue::getMaxCount(void) const {
+        return this->m_maxCount;
+    }
+
+    NATIVE_UINT_TYPE RingBufferQueue::getDepth(void) const {
+        return this->m_depth;
+    }
+
+    NATIVE_UINT_TYPE RingBufferQueue::getMsgSize(void) const {
+        return this->m_msgSize;
+    }
+
+}
@@ -0,0 +1,122 @@
+/*
+ * RingBufferQueue.hpp
+ *
+ * Description:
+ * Bounded message queue that senders and receivers use without taking a
+ * lock. It holds the same messages as the pthread BufferQueue: up to depth
+ * messages of up to msgSize bytes, taken highest priority first and in the
+ * order they were sent within a priority.
+ *
+ * The messages are kept in depth fixed slots. Free slots are kept in one
+ * ring, and each priority has a ring of the slots holding its messages. A
+ * ring entry is claimed with a compare and swap on the ring position and
+ * handed over with a sequence number, so a sender or receiver only waits
+ * for another that is part way through copying a slot index. A receiver
+ * sleeps on a futex only when there is no message to take, and a sender
+ * only when a blocking send finds the queue full. The futex is only woken
+ * when a thread has said it is going to sleep.
+ *
+ * A queue holds at most the number of different priorities given to
+ * create(). A priority keeps its ring from the first message sent with it.
+ */
+#ifndef OS_RING_BUFFER_QUEUE_HPP
+#define OS_RING_BUFFER_QUEUE_HPP
+
+#include <Fw/Cfg/Config.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+#include <Os/Queue.hpp>
+#include <Os/IntervalTimer.hpp>
+
+namespace Os {
+
+    class RingBufferQueue {
+        public:
+
+            RingBufferQueue(void);
+            ~RingBufferQueue(void);
+
+            //! Allocates the slots and rings. Returns false if the allocation failed.
+            bool create(
+                    NATIVE_UINT_TYPE depth, //!< most messages held at once
+                    NATIVE_UINT_TYPE msgSize, //!< largest message
+                    NATIVE_UINT_TYPE priorities //!< most different priorities in the queue
+                    );
+
+            //! Copies a message into the queue. A non-blocking send returns
+            //! QUEUE_FULL if there is no free slot. A send with a new priority
+            //! when every ring is in use returns QUEUE_INVALID_PRIORITY.
+            Queue::QueueStatus send(const U8* buffer, NATIVE_UINT_TYPE size, NATIVE_INT_TYPE priority, Queue::QueueBlocking block);
+
+            //! Copies the highest priority message out of the queue. If the
+            //! message is larger than capacity it is left in the queue and
+            //! QUEUE_SIZE_MISMATCH is returned. If sendTime is given and the
+            //! queue is instrumented, it is set to the time the message was sent.
+            Queue::QueueStatus receive(U8* buffer, NATIVE_UINT_TYPE capacity, NATIVE_UINT_TYPE& actualSize, NATIVE_INT_TYPE& priority, Queue::QueueBlocking block, IntervalTimer::RawTime* sendTime = 0);
+
+            NATIVE_UINT_TYPE getCount(void) const; //!< messages in the queue
+            NATIVE_UINT_TYPE getMaxCount(void) const; //!< most messages in the queue at once
+            NATIVE_UINT_TYPE getDepth(void) const;
+            NATIVE_UINT_TYPE getMsgSize(void) const;
+
+        private:
+
+            struct Cell {
+                volatile U32 sequence; //!< position the cell is free or full for
+                U32 slot; //!< slot index held by the cell
+            };
+
+            //! Ring of slot indexes. Sized to a power of two at least the depth,
+            //! so it always has room for every slot.
+            struct Ring {
+                Cell* cells;
+                U32 mask;
+                volatile U32 head; //!< next position to take
+                volatile U32 tail; //!< next position to put
+            };
+
+            enum LaneState {
+                LANE_FREE, //!< no priority yet
+                LANE_CLAIMING, //!< a sender is setting the priority
+                LANE_USED //!< priority is set and never changes
+            };
+
+            struct Lane {
+                volatile U32 state;
+                NATIVE_INT_TYPE priority;
+                Ring ring;
+            };
+
+            bool setupRing(Ring& ring, U32 size);
+            static void put(Ring& ring, U32 slot);
+            static bool take(Ring& ring, U32& slot);
+            Lane* getLane(NATIVE_INT_TYPE priority);
+            Queue::QueueStatus takeMessage(U8* buffer, NATIVE_UINT_TYPE capacity, NATIVE_UINT_TYPE& actualSize, NATIVE_INT_TYPE& priority, IntervalTimer::RawTime* sendTime);
+            void finalize(void);
+
+            U8* m_data; //!< depth slots of msgSize bytes
+            NATIVE_UINT_TYPE* m_sizes; //!< size of the message in each slot
+#if FW_QUEUE_INSTRUMENTATION
+            IntervalTimer::RawTime* m_sendTimes; //!< time the message in each slot was sent
+#endif
+            Ring m_free; //!< slots not holding a message
+            Lane* m_lanes; //!< one ring of full slots per priority
+            NATIVE_UINT_TYPE m_numLanes;
+            NATIVE_UINT_TYPE m_depth;
+            NATIVE_UINT_TYPE m_msgSize;
+            volatile U32 m_count;
+            volatile U32 m_maxCount;
+
+            // futex words, set while a thread is asleep or about to sleep
+            volatile U32 m_emptyWait; //!< receivers waiting for a message
+            volatile U32 m_fullWait; //!< senders waiting for a free slot
+            volatile U32 m_emptySleepers; //!< receivers asleep or about to sleep
+            volatile U32 m_fullSleepers; //!< senders asleep or about to sleep
+
+            // not copyable
+            RingBufferQueue(const RingBufferQueue&);
+            RingBufferQueue& operator=(const RingBufferQueue&);
+    };
+
+}
+
+#endif
@@ -0,0 +1,157 @@
+// ======================================================================
+// \title  RingQueue.cpp
+// \brief  Queue implementation using RingBufferQueue. Senders and
+//         receivers don't take a lock, and only make a system call to
+//         sleep on an empty or full queue, or to wake a thread that is
+//         asleep. This is NOT an IPC queue. It is meant to be used
+//         between threads within the same address space.
+//
+//         It is used in place of Pthreads/Queue.cpp. A queue holds up
+//         to FW_QUEUE_RING_PRIORITIES different message priorities.
+//
+// ======================================================================
+
+#include <Os/Linux/RingBufferQueue.hpp>
+#include <Fw/Cfg/Config.hpp>
+#include <new>
+#include <Os/Queue.hpp>
+
+#if FW_QUEUE_ZERO_COPY
+#error "FW_QUEUE_ZERO_COPY needs Os::Queue from Pthreads/Queue.cpp"
+#endif
+
+namespace Os {
+
+  Queue::Queue() :
+    m_handle((POINTER_CAST) NULL) {
+  }
+
+  Queue::QueueStatus Queue::create(const Fw::StringBase &name, NATIVE_INT_TYPE depth, NATIVE_INT_TYPE msgSize) {
+    RingBufferQueue* queue = (RingBufferQueue*) this->m_handle;
+
+    // Queue has already been created... remove it and try again:
+    if (NULL != queue) {
+        delete queue;
+        queue = NULL;
+        this->m_handle = (POINTER_CAST) NULL;
+    }
+
+    if ((depth <= 0) || (msgSize < 0)) {
+      return QUEUE_UNINITIALIZED;
+    }
+
+    queue = new (std::nothrow) RingBufferQueue;
+    if (NULL == queue) {
+      return QUEUE_UNINITIALIZED;
+    }
+    if( !queue->create(depth, msgSize, FW_QUEUE_RING_PRIORITIES) ) {
+      delete queue;
+      return QUEUE_UNINITIALIZED;
+    }
+    this->m_handle = (POINTER_CAST) queue;
+    this->m_name = name;
+
+#if FW_QUEUE_REGISTRATION
+    if (this->s_queueRegistry) {
+        this->s_queueRegistry->regQueue(this);
+    }
+#endif
+
+    return QUEUE_OK;
+  }
+
+  Queue::~Queue() {
+#if FW_QUEUE_REGISTRATION
+    if (this->s_queueRegistry) {
+        this->s_queueRegistry->unregQueue(this);
+    }
+#endif
+    RingBufferQueue* queue = (RingBufferQueue*) this->m_handle;
+    if (NULL != queue) {
+      delete queue;
+    }
+    this->m_handle = (POINTER_CAST) NULL;
+  }
+
+  Queue::QueueStatus Queue::send(const U8* buffer, NATIVE_INT_TYPE size, NATIVE_INT_TYPE priority, QueueBlocking block) {
+    RingBufferQueue* queue = (RingBufferQueue*) this->m_handle;
+
+    if (NULL == queue) {
+        return QUEUE_UNINITIALIZED;
+    }
+
+    if (NULL == buffer) {
+        return QUEUE_EMPTY_BUFFER;
+    }
+
+    if (size < 0 || (NATIVE_UINT_TYPE) size > queue->getMsgSize()) {
+        return QUEUE_SIZE_MISMATCH;
+    }
+
+    QueueStatus status = queue->send(buffer, size, priority, block);
+#if FW_QUEUE_INSTRUMENTATION
+    this->countSend(status);
+#endif
+    return status;
+  }
+
+  Queue::QueueStatus Queue::receive(U8* buffer, NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE &actualSize, NATIVE_INT_TYPE &priority, QueueBlocking block) {
+    RingBufferQueue* queue = (RingBufferQueue*) this->m_handle;
+
+    if (NULL == queue) {
+        return QUEUE_UNINITIALIZED;
+    }
+
+    // Do not need to check the upper bound of capacity, We don't care
+    // how big the user's buffer is.. as long as it's big enough.
+    if (capacity < 0) {
+        return QUEUE_SIZE_MISMATCH;
+    }
+
+    NATIVE_UINT_TYPE size = 0;
+#if FW_QUEUE_INSTRUMENTATION
+    IntervalTimer::RawTime sendTime;
+    QueueStatus status = queue->receive(buffer, capacity, size, priority, block, &sendTime);
+    if (QUEUE_OK == status) {
+        this->m_stats.countReceive(sendTime);
+    }
+#else
+    QueueStatus status = queue->receive(buffer, capacity, size, priority, block);
+#endif
+    actualSize = (NATIVE_INT_TYPE) size;
+    return status;
+  }
+
+  NATIVE_INT_TYPE Queue::getNumMsgs(void) const {
+    RingBufferQueue* queue = (RingBufferQueue*) this->m_handle;
+    if (NULL == queue) {
+        return 0;
+    }
+    return queue->getCount();
+  }
+
+  NATIVE_INT_TYPE Queue::getMaxMsgs(void) const {
+    RingBufferQueue* queue = (RingBufferQueue*) this->m_handle;
+    if (NULL == queue) {
+        return 0;
+    }
+    return queue->getMaxCount();
+  }
+
+  NATIVE_INT_TYPE Queue::getQueueSize(void) const {
+    RingBufferQueue* queue = (RingBufferQueue*) this->m_handle;
+    if (NULL == queue) {
+        return 0;
+    }
+    return queue->getDepth();
+  }
+
+  NATIVE_INT_TYPE Queue::getMsgSize(void) const {
+    RingBufferQueue* queue = (RingBufferQueue*) this->m_handle;
+    if (NULL == queue) {
+        return 0;
+    }
+    return queue->getMsgSize();
+  }
+
+}
@@ -1,24 +1,43 @@
 #ifndef _LOCKLESS_QUEUE_H_
 #define _LOCKLESS_QUEUE_H_
 
+#include <Fw/Cfg/Config.hpp>
 #include <Fw/Types/BasicTypes.hpp>
 #include <Os/Queue.hpp>
+#include <Os/IntervalTimer.hpp>
 #ifndef BUILD_DARWIN // Allow compiling
 #include <mqueue.h>
 #endif
+#include <pthread.h>
 
 namespace Os {
 
+  // First in, first out queue that any number of threads can send to and
+  // receive from without taking a lock.
+  //
+  // Messages are copied into a ring of cells. Each cell has a sequence
+  // number that says which ring position it is free or full for, and a
+  // sender or receiver claims a position with a compare and swap on the
+  // ring tail or head. A thread that stalled after reading a position can
+  // only win the compare and swap if the position is still current, and
+  // the cell's sequence must still match it, so a cell is never claimed
+  // twice (no ABA on a reused cell).
+  //
+  // Blocking sends and receives only take the mutex when they have to
+  // sleep on a full or empty queue. A sender or receiver only takes the
+  // mutex to wake the other side when a thread is asleep.
   class LocklessQueue {
 
-    typedef struct QueueNode_s {
-      U8                 * data;
+    typedef struct QueueCell_s {
+      volatile U32         sequence; // ring position the cell is free or full for
       NATIVE_INT_TYPE      size;
-      struct QueueNode_s * next;
-    } QueueNode;
-    
+#if FW_QUEUE_INSTRUMENTATION
+      IntervalTimer::RawTime send_time; // time the message was put in the cell
+#endif
+    } QueueCell;
+
   public:
-    
+
     LocklessQueue (NATIVE_INT_TYPE maxmsg, NATIVE_INT_TYPE msgsize);
     ~LocklessQueue();
 
@@ -26,23 +45,50 @@ namespace Os {
     void GetAttr (mq_attr & attr);
 #endif
 
-    Os::Queue::QueueStatus Send (const U8 * buffer, NATIVE_INT_TYPE size);
-    Os::Queue::QueueStatus Receive (U8 * buffer, NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE & size);
+    // QUEUE_FULL if nonblocking and maxmsg messages are in the queue
+    Os::Queue::QueueStatus Send (const U8 * buffer, NATIVE_INT_TYPE size,
+            Queue::QueueBlocking block = Queue::QUEUE_NONBLOCKING);
+    // QUEUE_SIZE_MISMATCH leaves a message larger than capacity in the queue.
+    // If send_time is given and the queue is instrumented, it is set to the
+    // time the message was sent.
+    Os::Queue::QueueStatus Receive (U8 * buffer, NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE & size,
+            Queue::QueueBlocking block = Queue::QUEUE_NONBLOCKING,
+            IntervalTimer::RawTime * send_time = NULL);
+
+    NATIVE_INT_TYPE GetCount (void) const;    // messages in the queue
+    NATIVE_INT_TYPE GetMaxCount (void) const; // most messages in the queue at once
+    NATIVE_INT_TYPE GetDepth (void) const;
+    NATIVE_INT_TYPE GetMsgSize (void) const;
 
   private:
-    bool PopFree (QueueNode ** free_node);
-    void PushFree (QueueNode * my_node);
+    bool Reserve (void);
+    void Publish (const U8 * buffer, NATIVE_INT_TYPE size);
+    Os::Queue::QueueStatus Take (U8 * buffer, NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE & size,
+            IntervalTimer::RawTime * send_time);
 
-    QueueNode *  m_first;   
-    QueueNode *  m_last;    
+    QueueCell *  m_cells;
+    U8        *  m_data;
+    U32          m_mask;        // ring size less one. The ring size is a power of two
+    volatile U32 m_head;        // next position to receive from
+    volatile U32 m_tail;        // next position to send to
 
-    QueueNode *  m_free_head;
+    NATIVE_INT_TYPE m_depth;
+    NATIVE_INT_TYPE m_msgsize;
+    volatile U32 m_count;       // messages sent or being sent, and not yet received
+    volatile U32 m_max_count;
 
-    QueueNode *  m_index;
-    U8        *  m_data;
+    pthread_mutex_t m_mutex;    // only held to sleep or to wake a sleeper
+    pthread_cond_t  m_not_empty;
+    pthread_cond_t  m_not_full;
+    volatile U32 m_recv_waiters;
+    volatile U32 m_send_waiters;
 #ifndef BUILD_DARWIN
     mq_attr      m_attr;
 #endif
+
+    // not copyable
+    LocklessQueue(const LocklessQueue&);
+    LocklessQueue& operator=(const LocklessQueue&);
   };
 
 }
@@ -0,0 +1,148 @@
+// ======================================================================
+// \title  LocklessOsQueue.cpp
+// \brief  Queue implementation using LocklessQueue. Senders and receivers
+//         don't take a lock unless they have to sleep on a full or empty
+//         queue, or wake a thread that is asleep. This is NOT an IPC
+//         queue. It is meant to be used between threads within the same
+//         address space.
+//
+//         It is used in place of Pthreads/Queue.cpp. Messages are
+//         received in the order they were sent: the priority is ignored,
+//         and received messages have priority 0.
+//
+// ======================================================================
+
+#include <Os/LocklessQueue.hpp>
+#include <Os/Queue.hpp>
+
+#if FW_QUEUE_ZERO_COPY
+#error "FW_QUEUE_ZERO_COPY needs Os::Queue from Pthreads/Queue.cpp"
+#endif
+
+namespace Os {
+
+  Queue::Queue() :
+    m_handle((POINTER_CAST) NULL) {
+  }
+
+  Queue::QueueStatus Queue::create(const Fw::StringBase &name, NATIVE_INT_TYPE depth, NATIVE_INT_TYPE msgSize) {
+    LocklessQueue* queue = (LocklessQueue*) this->m_handle;
+
+    // Queue has already been created... remove it and try again:
+    if (NULL != queue) {
+        delete queue;
+        queue = NULL;
+        this->m_handle = (POINTER_CAST) NULL;
+    }
+
+    if ((depth <= 0) || (msgSize < 0)) {
+      return QUEUE_UNINITIALIZED;
+    }
+
+    queue = new LocklessQueue(depth, msgSize);
+    if (NULL == queue) {
+      return QUEUE_UNINITIALIZED;
+    }
+    this->m_handle = (POINTER_CAST) queue;
+    this->m_name = name;
+
+#if FW_QUEUE_REGISTRATION
+    if (this->s_queueRegistry) {
+        this->s_queueRegistry->regQueue(this);
+    }
+#endif
+
+    return QUEUE_OK;
+  }
+
+  Queue::~Queue() {
+#if FW_QUEUE_REGISTRATION
+    if (this->s_queueRegistry) {
+        this->s_queueRegistry->unregQueue(this);
+    }
+#endif
+    LocklessQueue* queue = (LocklessQueue*) this->m_handle;
+    if (NULL != queue) {
+      delete queue;
+    }
+    this->m_handle = (POINTER_CAST) NULL;
+  }
+
+  Queue::QueueStatus Queue::send(const U8* buffer, NATIVE_INT_TYPE size, NATIVE_INT_TYPE priority, QueueBlocking block) {
+    (void) priority; // fifo queue, priority is ignored
+    LocklessQueue* queue = (LocklessQueue*) this->m_handle;
+
+    if (NULL == queue) {
+        return QUEUE_UNINITIALIZED;
+    }
+
+    if (NULL == buffer) {
+        return QUEUE_EMPTY_BUFFER;
+    }
+
+    QueueStatus status = queue->Send(buffer, size, block);
+#if FW_QUEUE_INSTRUMENTATION
+    this->countSend(status);
+#endif
+    return status;
+  }
+
+  Queue::QueueStatus Queue::receive(U8* buffer, NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE &actualSize, NATIVE_INT_TYPE &priority, QueueBlocking block) {
+    LocklessQueue* queue = (LocklessQueue*) this->m_handle;
+
+    if (NULL == queue) {
+        return QUEUE_UNINITIALIZED;
+    }
+
+    // Do not need to check the upper bound of capacity, We don't care
+    // how big the user's buffer is.. as long as it's big enough.
+    if (capacity < 0) {
+        return QUEUE_SIZE_MISMATCH;
+    }
+
+    priority = 0;
+#if FW_QUEUE_INSTRUMENTATION
+    IntervalTimer::RawTime sendTime;
+    QueueStatus status = queue->Receive(buffer, capacity, actualSize, block, &sendTime);
+    if (QUEUE_OK == status) {
+        this->m_stats.countReceive(sendTime);
+    }
+#else
+    QueueStatus status = queue->Receive(buffer, capacity, actualSize, block);
+#endif
+    return status;
+  }
+
+  NATIVE_INT_TYPE Queue::getNumMsgs(void) const {
+    LocklessQueue* queue = (LocklessQueue*) this->m_handle;
+    if (NULL == queue) {
+        return 0;
+    }
+    return queue->GetCount();
+  }
+
+  NATIVE_INT_TYPE Queue::getMaxMsgs(void) const {
+    LocklessQueue* queue = (LocklessQueue*) this->m_handle;
+    if (NULL == queue) {
+        return 0;
+    }
+    return queue->GetMaxCount();
+  }
+
+  NATIVE_INT_TYPE Queue::getQueueSize(void) const {
+    LocklessQueue* queue = (LocklessQueue*) this->m_handle;
+    if (NULL == queue) {
+        return 0;
+    }
+    return queue->GetDepth();
+  }
+
+  NATIVE_INT_TYPE Queue::getMsgSize(void) const {
+    LocklessQueue* queue = (LocklessQueue*) this->m_handle;
+    if (NULL == queue) {
+        return 0;
+    }
+    return queue->GetMsgSize();
+  }
+
+}
@@ -2,9 +2,32 @@
 #include <Fw/Types/Assert.hpp>
 
 #include <fcntl.h>
+#include <sched.h>
 #include <string.h>
 
-#define CAS(a_ptr, a_oldVal, a_newVal) __sync_bool_compare_and_swap(a_ptr, a_oldVal, a_newVal)
+#define CAS(a_ptr, a_oldVal, a_newVal) __sync_val_compare_and_swap(a_ptr, a_oldVal, a_newVal)
+
+// Spins on a cell another thread is part way through copying before giving up the CPU
+#define SPINS_BEFORE_YIELD 64
+
+namespace {
+
+    U32 loadAcquire(const volatile U32* ptr) {
+        return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+    }
+
+    void storeRelease(volatile U32* ptr, U32 value) {
+        __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+    }
+
+    void relax(U32& spins) {
+        if (++spins >= SPINS_BEFORE_YIELD) {
+            spins = 0;
+            (void) sched_yield();
+        }
+    }
+
+}
 
 namespace Os {
 
@@ -16,142 +39,241 @@ namespace Os {
         m_attr.mq_msgsize = msgsize;
         m_attr.mq_curmsgs = 0;
 #endif
-        // Must have at least 2 messages in the queue
-        FW_ASSERT(maxmsg >= 2, maxmsg);
+        FW_ASSERT(maxmsg >= 1, maxmsg);
+        FW_ASSERT(msgsize >= 0, msgsize);
 
-        m_index = new QueueNode[maxmsg]; // Allocate an index entry for each msg
-        m_data = new U8[maxmsg * msgsize];  // Allocate data for each msg
-        FW_ASSERT(m_data != NULL);
+        // Round the ring up to a power of two so a position maps to a cell with a mask
+        U32 ring = 1;
+        while (ring < (U32) maxmsg) {
+            ring <<= 1;
+        }
 
-        for (int i = 0, j = 1; i < maxmsg; i++, j++) {
-            m_index[i].data = &m_data[i * msgsize]; // Assign the data pointer of index to top that msg's buffer
+        m_cells = new QueueCell[ring];
+        m_data = new U8[ring * msgsize];  // Allocate data for each cell
+        FW_ASSERT(m_cells != NULL);
+        FW_ASSERT(m_data != NULL);
 
-            if (j < maxmsg) {           // If we aren't processing the last item
-                m_index[i].next = &m_index[j]; // Chain this item to the next one
-            } else {
-                m_index[i].next = NULL;         // Initialize to NULL otherwise
-            }
+        // Cell i is free for position i
+        for (U32 i = 0; i < ring; i++) {
+            m_cells[i].sequence = i;
+            m_cells[i].size = 0;
         }
 
-        // Assign each of the pointers to the first index element
-        // This one is held in a "dummy" position for now
-        // It will be cleaned up by the producer
-        m_first = &m_index[0];
-        m_last = &m_index[0];
-        m_last->next = NULL;
-
-        // Assign the head of the free list to the second element
-        m_free_head = &m_index[1];
+        m_mask = ring - 1;
+        m_head = 0;
+        m_tail = 0;
+        m_depth = maxmsg;
+        m_msgsize = msgsize;
+        m_count = 0;
+        m_max_count = 0;
+        m_recv_waiters = 0;
+        m_send_waiters = 0;
+
+        int ret;
+        ret = pthread_mutex_init(&m_mutex, NULL);
+        FW_ASSERT(ret == 0, ret);
+        ret = pthread_cond_init(&m_not_empty, NULL);
+        FW_ASSERT(ret == 0, ret);
+        ret = pthread_cond_init(&m_not_full, NULL);
+        FW_ASSERT(ret == 0, ret);
     }
 
     LocklessQueue::~LocklessQueue() {
-        delete[] m_index;
+        (void) pthread_cond_destroy(&m_not_full);
+        (void) pthread_cond_destroy(&m_not_empty);
+        (void) pthread_mutex_destroy(&m_mutex);
+        delete[] m_cells;
         delete[] m_data;
     }
 
 #ifndef BUILD_DARWIN
     void LocklessQueue::GetAttr(mq_attr & attr) {
+        m_attr.mq_curmsgs = GetCount();
         memcpy(&attr, &m_attr, sizeof(mq_attr));
     }
 #endif
 
-    void LocklessQueue::PushFree(QueueNode * my_node) {
-        QueueNode * old_free_head;
+    NATIVE_INT_TYPE LocklessQueue::GetCount(void) const {
+        return m_count;
+    }
 
-        FW_ASSERT(my_node != NULL);
+    NATIVE_INT_TYPE LocklessQueue::GetMaxCount(void) const {
+        return m_max_count;
+    }
 
-        // CAS the node into the free list
-        do {
-            old_free_head = m_free_head;
-            my_node->next = old_free_head;
-        } while (!CAS(&m_free_head, old_free_head, my_node));
+    NATIVE_INT_TYPE LocklessQueue::GetDepth(void) const {
+        return m_depth;
     }
 
-    bool LocklessQueue::PopFree(QueueNode ** free_node) {
-        QueueNode * my_node;
+    NATIVE_INT_TYPE LocklessQueue::GetMsgSize(void) const {
+        return m_msgsize;
+    }
 
-        // CAS a buffer from the free list
+    bool LocklessQueue::Reserve(void) {
+        // Count the message before it is in the ring, so at most
+        // m_depth messages are ever sent or being sent
+        U32 count = m_count;
+        U32 old_count;
         do {
-            my_node = m_free_head;
-
-            if (NULL == my_node) {
+            if (count >= (U32) m_depth) {
                 return false;
             }
+            old_count = count;
+            count = CAS(&m_count, old_count, old_count + 1);
+        } while (count != old_count);
+
+        U32 max_count = m_max_count;
+        while (old_count + 1 > max_count) {
+            U32 seen = CAS(&m_max_count, max_count, old_count + 1);
+            if (seen == max_count) {
+                break;
+            }
+            max_count = seen;
+        }
+        return true;
+    }
 
-        } while (!CAS(&m_free_head, my_node, my_node->next));
+    void LocklessQueue::Publish(const U8 * buffer, NATIVE_INT_TYPE size) {
+        U32 spins = 0;
+        U32 pos = m_tail;
+        QueueCell * cell;
+
+        // CAS the tail forward to claim the cell for its position
+        while (true) {
+            cell = &m_cells[pos & m_mask];
+            I32 diff = (I32) (loadAcquire(&cell->sequence) - pos);
+            if (0 == diff) {
+                U32 seen = CAS(&m_tail, pos, pos + 1);
+                if (seen == pos) {
+                    break;
+                }
+                pos = seen;
+            } else if (diff < 0) {
+                // A receiver is still copying out the message from the last
+                // time round the ring. There is room, since the message was
+                // reserved, so wait for the receiver to free the cell.
+                relax(spins);
+                pos = m_tail;
+            } else {
+                pos = m_tail;
+            }
+        }
 
-        (*free_node) = my_node;
+        // Copy the data into the cell and hand it to receivers
+        memcpy(&m_data[(pos & m_mask) * m_msgsize], buffer, size);
+        cell->size = size;
+#if FW_QUEUE_INSTRUMENTATION
+        IntervalTimer::getRawTime(cell->send_time);
+#endif
+        storeRelease(&cell->sequence, pos + 1);
+    }
 
-        return true;
+    Queue::QueueStatus LocklessQueue::Take(U8 * buffer,
+            NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE & size,
+            IntervalTimer::RawTime * send_time) {
+        U32 pos = m_head;
+
+        // CAS the head forward to claim the cell holding the oldest message
+        while (true) {
+            QueueCell * cell = &m_cells[pos & m_mask];
+            I32 diff = (I32) (loadAcquire(&cell->sequence) - (pos + 1));
+            if (0 == diff) {
+                NATIVE_INT_TYPE msg_size = __atomic_load_n(&cell->size, __ATOMIC_ACQUIRE);
+                if (msg_size > capacity) {
+                    // Only report the size if the message is still the oldest
+                    if (m_head == pos) {
+                        return Queue::QUEUE_SIZE_MISMATCH;
+                    }
+                    pos = m_head;
+                    continue;
+                }
+                U32 seen = CAS(&m_head, pos, pos + 1);
+                if (seen == pos) {
+                    // Copy the data out and free the cell for the next time round the ring
+                    memcpy(buffer, &m_data[(pos & m_mask) * m_msgsize], msg_size);
+                    size = msg_size;
+#if FW_QUEUE_INSTRUMENTATION
+                    if (send_time != NULL) {
+                        *send_time = cell->send_time;
+                    }
+#endif
+                    storeRelease(&cell->sequence, pos + m_mask + 1);
+                    (void) __sync_sub_and_fetch(&m_count, 1);
+                    return Queue::QUEUE_OK;
+                }
+                pos = seen;
+            } else if (diff < 0) {
+                // Empty, or the sender of the oldest message is still copying it in
+                return Queue::QUEUE_NO_MORE_MSGS;
+            } else {
+                pos = m_head;
+            }
+        }
     }
 
     Queue::QueueStatus LocklessQueue::Send(const U8 * buffer,
-            NATIVE_INT_TYPE size) {
-
-        QueueNode * my_node;
-        QueueNode * old_last;
+            NATIVE_INT_TYPE size, Queue::QueueBlocking block) {
 
-#ifndef BUILD_DARWIN
         // Check that the new message will fit in our buffers
-        if (size > m_attr.mq_msgsize) {
+        if (size < 0 || size > m_msgsize) {
             return Queue::QUEUE_SIZE_MISMATCH;
         }
-#endif
 
-        if (!PopFree(&my_node)) {
-            return Queue::QUEUE_FULL;
+        if (!Reserve()) {
+            if (Queue::QUEUE_NONBLOCKING == block) {
+                return Queue::QUEUE_FULL;
+            }
+            // Receivers wake a sender after freeing a message
+            // if they see m_send_waiters set
+            pthread_mutex_lock(&m_mutex);
+            (void) __sync_add_and_fetch(&m_send_waiters, 1);
+            while (!Reserve()) {
+                pthread_cond_wait(&m_not_full, &m_mutex);
+            }
+            (void) __sync_sub_and_fetch(&m_send_waiters, 1);
+            pthread_mutex_unlock(&m_mutex);
         }
 
-        // Copy the data into the buffer
-        memcpy(my_node->data, buffer, size);
-        my_node->size = size;
-        my_node->next = NULL;
-
-        // Publish the node
-        // The m_last pointer is moved before the item is published
-        // All concurrent writers will argue over their order using CAS
-        do {
-            old_last = m_last;
-        } while (!CAS(&m_last, old_last, my_node));
+        Publish(buffer, size);
 
-        old_last->next = my_node;
+        // Pairs with the receiver setting m_recv_waiters before it looks at the ring
+        __sync_synchronize();
+        if (m_recv_waiters != 0) {
+            pthread_mutex_lock(&m_mutex);
+            pthread_cond_signal(&m_not_empty);
+            pthread_mutex_unlock(&m_mutex);
+        }
 
         return Queue::QUEUE_OK;
     }
 
-    // ONLY ONE RECEIVER AT A TIME!!!!
     Queue::QueueStatus LocklessQueue::Receive(U8 * buffer,
-            NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE & size) {
-
-        QueueNode * my_node;
-        QueueNode * old_node;
-
-#ifndef BUILD_DARWIN
-        if (capacity < m_attr.mq_msgsize) {
-            return Queue::QUEUE_SIZE_MISMATCH;
-        }
-#endif
-
-        if (m_first == m_last) {
-            return Queue::QUEUE_NO_MORE_MSGS;
+            NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE & size, Queue::QueueBlocking block,
+            IntervalTimer::RawTime * send_time) {
+
+        Queue::QueueStatus status = Take(buffer, capacity, size, send_time);
+
+        if (Queue::QUEUE_NO_MORE_MSGS == status && Queue::QUEUE_BLOCKING == block) {
+            // Senders wake a receiver after sending a message
+            // if they see m_recv_waiters set
+            pthread_mutex_lock(&m_mutex);
+            (void) __sync_add_and_fetch(&m_recv_waiters, 1);
+            while (Queue::QUEUE_NO_MORE_MSGS == (status = Take(buffer, capacity, size, send_time))) {
+                pthread_cond_wait(&m_not_empty, &m_mutex);
+            }
+            (void) __sync_sub_and_fetch(&m_recv_waiters, 1);
+            pthread_mutex_unlock(&m_mutex);
         }
 
-        old_node = m_first;
-        my_node = m_first->next;
-
-        if (my_node == NULL) {
-            // We may not be fully linked yet, even though "last" has moved
-            return Queue::QUEUE_NO_MORE_MSGS;
+        // The count decrement in Take() pairs with the sender
+        // setting m_send_waiters before it reserves
+        if (Queue::QUEUE_OK == status && m_send_waiters != 0) {
+            pthread_mutex_lock(&m_mutex);
+            pthread_cond_signal(&m_not_full);
+            pthread_mutex_unlock(&m_mutex);
         }
 
-        m_first = m_first->next;
-        PushFree(old_node);
-
-        // Copy the data from the buffer
-        memcpy(buffer, my_node->data, my_node->size);
-        size = my_node->size;
-
-        return Queue::QUEUE_OK;
+        return status;
     }
 
 }
@@ -98,10 +98,21 @@ namespace Os {
         
         Queue::s_numQueues++;
 
+#if FW_QUEUE_REGISTRATION
+        if (this->s_queueRegistry) {
+            this->s_queueRegistry->regQueue(this);
+        }
+#endif
+
         return QUEUE_OK;
     }
 
     Queue::~Queue() {
+#if FW_QUEUE_REGISTRATION
+        if (this->s_queueRegistry) {
+            this->s_queueRegistry->unregQueue(this);
+        }
+#endif
         QueueHandle* queueHandle = (QueueHandle*) this->m_handle;
         delete queueHandle;
         (void) mq_unlink(this->m_name.toChar());
@@ -139,6 +150,9 @@ namespace Os {
                         if (block == QUEUE_NONBLOCKING) {
                             // no more messages. If we are
                             // non-blocking, return
+#if FW_QUEUE_INSTRUMENTATION
+                            this->countSend(QUEUE_FULL);
+#endif
                             return QUEUE_FULL;
                         } else {
                             // Go to sleep until we receive a signal that something was takeng off the queue:
@@ -163,6 +177,10 @@ namespace Os {
             }
         }
        
+#if FW_QUEUE_INSTRUMENTATION
+        this->countSend(QUEUE_OK);
+        this->m_stats.countDepth(this->getNumMsgs());
+#endif
         return QUEUE_OK;
     }
 
@@ -226,6 +244,9 @@ namespace Os {
         }
 
         actualSize = (NATIVE_INT_TYPE) size;
+#if FW_QUEUE_INSTRUMENTATION
+        this->m_stats.countReceive();
+#endif
         return QUEUE_OK;
     }
 
@@ -240,8 +261,13 @@ namespace Os {
     }
 
     NATIVE_INT_TYPE Queue::getMaxMsgs(void) const {
+#if FW_QUEUE_INSTRUMENTATION
+        // Message queues don't keep a high water mark, so use the one counted on send:
+        return this->m_stats.getMaxDepth();
+#else
         //FW_ASSERT(0);
         return 0;
+#endif
     }
 
     NATIVE_INT_TYPE Queue::getQueueSize(void) const {
@@ -0,0 +1,230 @@
+#include <Os/LocklessQueue.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace Os;
+
+#define DEPTH 5
+#define MSG_SIZE 8
+
+#define NUM_SENDERS 4
+#define NUM_RECEIVERS 4
+#define NUM_MSGS 50000 // messages sent by each sender
+#define STOP_SENDER 0xFFFFFFFF // sent once to each receiver after the senders finish
+
+struct TortureMsg {
+  U32 sender;
+  U32 sequence;
+};
+
+struct TortureTest {
+  LocklessQueue* queue;
+  Queue::QueueBlocking block;
+  volatile U32 start;
+  volatile U32 received[NUM_SENDERS][NUM_MSGS];
+};
+
+struct TortureThread {
+  TortureTest* test;
+  U32 id;
+};
+
+Queue::QueueStatus sendMsg(TortureTest* test, const TortureMsg& msg) {
+  Queue::QueueStatus stat;
+  while ((stat = test->queue->Send((const U8*) &msg, sizeof(msg), test->block)) == Queue::QUEUE_FULL) {
+    FW_ASSERT(test->block == Queue::QUEUE_NONBLOCKING);
+    (void) sched_yield();
+  }
+  return stat;
+}
+
+void* runSender(void* ptr) {
+  TortureThread* thread = (TortureThread*) ptr;
+  TortureTest* test = thread->test;
+  while (0 == test->start) {
+  }
+  TortureMsg msg;
+  msg.sender = thread->id;
+  for (U32 ii = 0; ii < NUM_MSGS; ++ii) {
+    msg.sequence = ii;
+    Queue::QueueStatus stat = sendMsg(test, msg);
+    FW_ASSERT(stat == Queue::QUEUE_OK, stat);
+  }
+  return NULL;
+}
+
+void* runReceiver(void* ptr) {
+  TortureThread* thread = (TortureThread*) ptr;
+  TortureTest* test = thread->test;
+  // Each receiver sees a sender's messages in the order they were sent
+  I32 last[NUM_SENDERS];
+  for (U32 ii = 0; ii < NUM_SENDERS; ++ii) {
+    last[ii] = -1;
+  }
+  while (0 == test->start) {
+  }
+  while (true) {
+    TortureMsg msg;
+    NATIVE_INT_TYPE size = 0;
+    Queue::QueueStatus stat = test->queue->Receive((U8*) &msg, sizeof(msg), size, test->block);
+    if (stat == Queue::QUEUE_NO_MORE_MSGS) {
+      FW_ASSERT(test->block == Queue::QUEUE_NONBLOCKING);
+      (void) sched_yield();
+      continue;
+    }
+    FW_ASSERT(stat == Queue::QUEUE_OK, stat);
+    FW_ASSERT(size == sizeof(msg), size);
+    if (msg.sender == STOP_SENDER) {
+      break;
+    }
+    FW_ASSERT(msg.sender < NUM_SENDERS, msg.sender);
+    FW_ASSERT(msg.sequence < NUM_MSGS, msg.sequence);
+    FW_ASSERT((I32) msg.sequence > last[msg.sender], msg.sequence, last[msg.sender]);
+    last[msg.sender] = msg.sequence;
+    (void) __sync_add_and_fetch(&test->received[msg.sender][msg.sequence], 1);
+  }
+  return NULL;
+}
+
+// Every message sent by NUM_SENDERS threads is received exactly once by NUM_RECEIVERS threads
+void torture(NATIVE_INT_TYPE depth, Queue::QueueBlocking block) {
+  printf("Test %d senders and %d receivers, depth %d, %s...\n", NUM_SENDERS, NUM_RECEIVERS, depth,
+      (block == Queue::QUEUE_BLOCKING) ? "blocking" : "nonblocking");
+
+  static TortureTest test;
+  LocklessQueue queue(depth, MSG_SIZE);
+  test.queue = &queue;
+  test.block = block;
+  test.start = 0;
+  memset((void*) test.received, 0, sizeof(test.received));
+
+  pthread_t senders[NUM_SENDERS];
+  pthread_t receivers[NUM_RECEIVERS];
+  TortureThread senderArgs[NUM_SENDERS];
+  TortureThread receiverArgs[NUM_RECEIVERS];
+  for (U32 ii = 0; ii < NUM_SENDERS; ++ii) {
+    senderArgs[ii].test = &test;
+    senderArgs[ii].id = ii;
+    FW_ASSERT(pthread_create(&senders[ii], NULL, runSender, &senderArgs[ii]) == 0);
+  }
+  for (U32 ii = 0; ii < NUM_RECEIVERS; ++ii) {
+    receiverArgs[ii].test = &test;
+    receiverArgs[ii].id = ii;
+    FW_ASSERT(pthread_create(&receivers[ii], NULL, runReceiver, &receiverArgs[ii]) == 0);
+  }
+  __sync_synchronize();
+  test.start = 1;
+
+  for (U32 ii = 0; ii < NUM_SENDERS; ++ii) {
+    FW_ASSERT(pthread_join(senders[ii], NULL) == 0);
+  }
+  TortureMsg stop;
+  stop.sender = STOP_SENDER;
+  stop.sequence = 0;
+  for (U32 ii = 0; ii < NUM_RECEIVERS; ++ii) {
+    Queue::QueueStatus stat = sendMsg(&test, stop);
+    FW_ASSERT(stat == Queue::QUEUE_OK, stat);
+  }
+  for (U32 ii = 0; ii < NUM_RECEIVERS; ++ii) {
+    FW_ASSERT(pthread_join(receivers[ii], NULL) == 0);
+  }
+
+  for (U32 sender = 0; sender < NUM_SENDERS; ++sender) {
+    for (U32 ii = 0; ii < NUM_MSGS; ++ii) {
+      FW_ASSERT(test.received[sender][ii] == 1, sender, ii, test.received[sender][ii]);
+    }
+  }
+  FW_ASSERT(queue.GetCount() == 0, queue.GetCount());
+  FW_ASSERT(queue.GetMaxCount() <= depth, queue.GetMaxCount());
+  printf("Passed.\n");
+}
+
+int main() {
+  printf("Creating queue.\n");
+  NATIVE_INT_TYPE size;
+  Queue::QueueStatus stat;
+  LocklessQueue queue(DEPTH, MSG_SIZE);
+  FW_ASSERT(queue.GetDepth() == DEPTH, queue.GetDepth());
+  FW_ASSERT(queue.GetMsgSize() == MSG_SIZE, queue.GetMsgSize());
+  U8 recv[MSG_SIZE];
+
+  U8 send[MSG_SIZE];
+  for(U32 ii = 0; ii < sizeof(send); ++ii) {
+    send[ii] = ii;
+  }
+
+  printf("Test empty queue...\n");
+  stat = queue.Receive(&recv[0], sizeof(recv), size);
+  FW_ASSERT(stat == Queue::QUEUE_NO_MORE_MSGS, stat);
+  FW_ASSERT(queue.GetCount() == 0, queue.GetCount());
+  printf("Passed.\n");
+
+  printf("Test full queue...\n");
+  for(NATIVE_INT_TYPE ii = 0; ii < DEPTH; ++ii) {
+    printf("Sending %d.\n", ii);
+    send[0] = ii;
+    stat = queue.Send(&send[0], sizeof(send));
+    FW_ASSERT(stat == Queue::QUEUE_OK, stat);
+    FW_ASSERT(queue.GetCount() == ii+1, queue.GetCount());
+    FW_ASSERT(queue.GetMaxCount() == ii+1, queue.GetMaxCount());
+  }
+  stat = queue.Send(&send[0], sizeof(send));
+  FW_ASSERT(stat == Queue::QUEUE_FULL, stat);
+  FW_ASSERT(queue.GetCount() == DEPTH, queue.GetCount());
+  printf("Passed.\n");
+
+  printf("Test weird size...\n");
+  stat = queue.Send(&send[0], MSG_SIZE+1);
+  FW_ASSERT(stat == Queue::QUEUE_SIZE_MISMATCH, stat);
+  stat = queue.Receive(&recv[0], 1, size);
+  FW_ASSERT(stat == Queue::QUEUE_SIZE_MISMATCH, stat);
+  FW_ASSERT(queue.GetCount() == DEPTH, queue.GetCount());
+  printf("Passed.\n");
+
+  printf("Test receive in order...\n");
+  for(NATIVE_INT_TYPE ii = 0; ii < DEPTH; ++ii) {
+    printf("Receiving %d.\n", ii);
+    stat = queue.Receive(&recv[0], sizeof(recv), size);
+    FW_ASSERT(stat == Queue::QUEUE_OK, stat);
+    FW_ASSERT(size == sizeof(recv), size);
+    FW_ASSERT(recv[0] == ii, recv[0], ii);
+    FW_ASSERT(memcmp(&recv[1], &send[1], size-1) == 0);
+    FW_ASSERT(queue.GetCount() == DEPTH-ii-1, queue.GetCount());
+    FW_ASSERT(queue.GetMaxCount() == DEPTH, queue.GetMaxCount());
+  }
+  stat = queue.Receive(&recv[0], sizeof(recv), size);
+  FW_ASSERT(stat == Queue::QUEUE_NO_MORE_MSGS, stat);
+  printf("Passed.\n");
+
+  printf("Test wrapping the ring...\n");
+  for(NATIVE_INT_TYPE ii = 0; ii < DEPTH*10; ++ii) {
+    send[0] = ii;
+    stat = queue.Send(&send[0], ii % (MSG_SIZE+1));
+    FW_ASSERT(stat == Queue::QUEUE_OK, stat);
+    stat = queue.Send(&send[0], ii % (MSG_SIZE+1));
+    FW_ASSERT(stat == Queue::QUEUE_OK, stat);
+    stat = queue.Receive(&recv[0], sizeof(recv), size);
+    FW_ASSERT(stat == Queue::QUEUE_OK, stat);
+    FW_ASSERT(size == ii % (MSG_SIZE+1), size);
+    stat = queue.Receive(&recv[0], sizeof(recv), size);
+    FW_ASSERT(stat == Queue::QUEUE_OK, stat);
+    FW_ASSERT(size == ii % (MSG_SIZE+1), size);
+    if (size > 0) {
+      FW_ASSERT(recv[0] == ii, recv[0], ii);
+    }
+  }
+  FW_ASSERT(queue.GetCount() == 0, queue.GetCount());
+  printf("Passed.\n");
+
+  torture(1, Queue::QUEUE_NONBLOCKING);
+  torture(DEPTH, Queue::QUEUE_NONBLOCKING);
+  torture(1, Queue::QUEUE_BLOCKING);
+  torture(DEPTH, Queue::QUEUE_BLOCKING);
+  torture(64, Queue::QUEUE_BLOCKING);
+
+  printf("Test complete.\n");
+  return 0;
+}
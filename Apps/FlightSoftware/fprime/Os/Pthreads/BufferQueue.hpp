@@ -11,6 +11,10 @@
 // ======================================================================
 
 #include <Fw/Types/BasicTypes.hpp>
+#include <Fw/Cfg/Config.hpp>
+#if FW_QUEUE_INSTRUMENTATION
+#include <Os/IntervalTimer.hpp>
+#endif
 
 // This is a generic buffer queue interface. 
 namespace Os {
@@ -67,9 +71,43 @@ namespace Os {
     //! \param priority the priority of the buffer popped off the queue
     //!
     bool pop(U8* buffer, NATIVE_UINT_TYPE& size, NATIVE_INT_TYPE &priority);
+    //! \brief reserve a buffer on the queue
+    //!
+    //! Take an unused buffer of "msgSize" bytes out of the queue storage so
+    //! the caller can fill it in place. The buffer is not on the queue until
+    //! it is passed to commit(). Returns NULL if the queue is full.
+    //!
+    U8* reserve();
+    //! \brief push a reserved buffer onto the queue
+    //!
+    //! Push a buffer returned by reserve() onto the queue with the specified
+    //! size and priority, without copying it.
+    //!
+    //! \param buffer the buffer returned by reserve()
+    //! \param size the size of the data in buffer
+    //! \param priority the priority of the buffer on the queue
+    //!
+    void commit(U8* buffer, NATIVE_UINT_TYPE size, NATIVE_INT_TYPE priority);
+    //! \brief pop an item off the queue without copying it
+    //!
+    //! Pull an item off of the queue and return its address in the queue
+    //! storage, or NULL if the queue is empty. The buffer stays in use until
+    //! it is passed to release().
+    //!
+    //! \param size the size of the popped buffer
+    //! \param priority the priority of the buffer popped off the queue
+    //!
+    U8* popInPlace(NATIVE_UINT_TYPE& size, NATIVE_INT_TYPE &priority);
+    //! \brief release a buffer
+    //!
+    //! Return a buffer from popInPlace(), or a reserved buffer that will not
+    //! be committed, to the queue storage.
+    //!
+    void release(U8* buffer);
     //! \brief check if the queue is full
     //!
-    //! Is the queue full?
+    //! Is the queue full? Reserved buffers, and buffers popped in place and
+    //! not yet released, take up room on the queue.
     //!
     bool isFull();
     //! \brief check if the queue is empty
@@ -98,6 +136,14 @@ namespace Os {
     //! Get the maximum number of messages allowed on the queue
     //!
     NATIVE_UINT_TYPE getDepth();
+#if FW_QUEUE_INSTRUMENTATION
+    //! \brief Get the time the last popped buffer was pushed
+    //!
+    //! Get the time that the buffer last returned by pop() or popInPlace()
+    //! was pushed or committed onto the queue.
+    //!
+    const IntervalTimer::RawTime& getPushTime();
+#endif
 
     // Internal member functions:
     private:
@@ -116,6 +162,18 @@ namespace Os {
     // Helper function to get the buffer index into the queue for particular
     // queue index.
     NATIVE_UINT_TYPE getBufferIndex(NATIVE_INT_TYPE index);
+    // Take an unused buffer index out of the data structure:
+    NATIVE_UINT_TYPE checkoutBuffer();
+    // Put a filled buffer index into the data structure:
+    void enqueueIndex(NATIVE_UINT_TYPE index, NATIVE_INT_TYPE priority);
+    // Take the next filled buffer index out of the data structure:
+    NATIVE_UINT_TYPE dequeueIndex(NATIVE_INT_TYPE &priority);
+    // Return an unused buffer index to the data structure:
+    void returnBuffer(NATIVE_UINT_TYPE index);
+    // Get the start of the queue storage:
+    U8* getData();
+    // Get the buffer index of a buffer from reserve() or popInPlace():
+    NATIVE_UINT_TYPE getIndexOf(U8* buffer);
 
     // Member variables:
     void* queue; // The queue can be implemented in various ways
@@ -123,5 +181,10 @@ namespace Os {
     NATIVE_UINT_TYPE depth; // Max number of messages on the queue
     NATIVE_UINT_TYPE count; // Current number of messages on the queue
     NATIVE_UINT_TYPE maxCount; // Maximum number of messages ever seen on the queue
+    NATIVE_UINT_TYPE outstanding; // Buffers reserved or popped in place and not yet committed or released
+#if FW_QUEUE_INSTRUMENTATION
+    IntervalTimer::RawTime* pushTimes; // Time each buffer was pushed, by buffer index / buffer stride
+    IntervalTimer::RawTime popPushTime; // Time the last popped buffer was pushed
+#endif
   };
 }
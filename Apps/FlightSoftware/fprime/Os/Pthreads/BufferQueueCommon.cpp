@@ -13,6 +13,7 @@
 // ======================================================================
 
 #include "Os/Pthreads/BufferQueue.hpp"
+#include <Fw/Cfg/Config.hpp>
 #include <Fw/Types/Assert.hpp>
 #include <string.h>
 
@@ -29,10 +30,19 @@ namespace Os {
     this->depth = 0;
     this->count = 0;
     this->maxCount = 0;
+    this->outstanding = 0;
+#if FW_QUEUE_INSTRUMENTATION
+    this->pushTimes = NULL;
+    this->popPushTime.upper = 0;
+    this->popPushTime.lower = 0;
+#endif
   }
 
   BufferQueue::~BufferQueue() {
     this->finalize();
+#if FW_QUEUE_INSTRUMENTATION
+    delete [] this->pushTimes;
+#endif
   }
 
   bool BufferQueue::create(NATIVE_UINT_TYPE depth, NATIVE_UINT_TYPE msgSize) {
@@ -45,6 +55,13 @@ namespace Os {
     // Set member variables:
     this->msgSize = msgSize;
     this->depth = depth;
+#if FW_QUEUE_INSTRUMENTATION
+    delete [] this->pushTimes;
+    this->pushTimes = new IntervalTimer::RawTime[depth];
+    if (NULL == this->pushTimes) {
+      return false;
+    }
+#endif
     return this->initialize(depth, msgSize);
   }
 
@@ -88,8 +105,81 @@ namespace Os {
     return true;
   }
  
+#if FW_QUEUE_ZERO_COPY
+  U8* BufferQueue::reserve() {
+
+    if( this->isFull() ) {
+      return NULL;
+    }
+
+    // Check out a buffer without putting it on the queue:
+    NATIVE_UINT_TYPE index = this->checkoutBuffer();
+    ++this->outstanding;
+    return &this->getData()[index + sizeof(NATIVE_UINT_TYPE)];
+  }
+
+  void BufferQueue::commit(U8* buffer, NATIVE_UINT_TYPE size, NATIVE_INT_TYPE priority) {
+
+    FW_ASSERT(size <= this->msgSize, size, this->msgSize);
+    FW_ASSERT(this->outstanding > 0);
+
+    // Store the size in front of the buffer and queue its index:
+    NATIVE_UINT_TYPE index = this->getIndexOf(buffer);
+    void* dest = &this->getData()[index];
+    void* ptr = memcpy(dest, &size, sizeof(size));
+    FW_ASSERT(ptr == dest);
+#if FW_QUEUE_INSTRUMENTATION
+    IntervalTimer::getRawTime(this->pushTimes[index / (sizeof(NATIVE_UINT_TYPE) + this->msgSize)]);
+#endif
+    this->enqueueIndex(index, priority);
+
+    --this->outstanding;
+    ++this->count;
+    if( this->count > this->maxCount ) {
+      this->maxCount = this->count;
+    }
+  }
+
+  U8* BufferQueue::popInPlace(NATIVE_UINT_TYPE& size, NATIVE_INT_TYPE &priority) {
+
+    if( this->isEmpty() ) {
+      size = 0;
+      return NULL;
+    }
+
+    // Take the index off the queue, but keep the buffer checked out:
+    NATIVE_UINT_TYPE index = this->dequeueIndex(priority);
+    void* source = &this->getData()[index];
+    void* ptr = memcpy(&size, source, sizeof(size));
+    FW_ASSERT(ptr == &size);
+#if FW_QUEUE_INSTRUMENTATION
+    this->popPushTime = this->pushTimes[index / (sizeof(NATIVE_UINT_TYPE) + this->msgSize)];
+#endif
+
+    --this->count;
+    ++this->outstanding;
+    return &this->getData()[index + sizeof(NATIVE_UINT_TYPE)];
+  }
+
+  void BufferQueue::release(U8* buffer) {
+    FW_ASSERT(this->outstanding > 0);
+    this->returnBuffer(this->getIndexOf(buffer));
+    --this->outstanding;
+  }
+
+  NATIVE_UINT_TYPE BufferQueue::getIndexOf(U8* buffer) {
+    // The buffer must be the data part of one of the queue's buffers:
+    NATIVE_UINT_TYPE stride = sizeof(NATIVE_UINT_TYPE) + this->msgSize;
+    FW_ASSERT(buffer >= this->getData() + sizeof(NATIVE_UINT_TYPE));
+    NATIVE_UINT_TYPE index = (buffer - this->getData()) - sizeof(NATIVE_UINT_TYPE);
+    FW_ASSERT(index % stride == 0, index, stride);
+    FW_ASSERT(index / stride < this->depth, index, stride);
+    return index;
+  }
+#endif
+
   bool BufferQueue::isFull() {
-    return (this->count == this->depth);
+    return (this->count + this->outstanding == this->depth);
   }
   
   bool BufferQueue::isEmpty() {
@@ -113,11 +203,22 @@ namespace Os {
     return this->depth; 
   }
 
+#if FW_QUEUE_INSTRUMENTATION
+  const IntervalTimer::RawTime& BufferQueue::getPushTime() {
+    return this->popPushTime;
+  }
+#endif
+
   NATIVE_UINT_TYPE BufferQueue::getBufferIndex(NATIVE_INT_TYPE index) {
     return (index % this->depth) * (sizeof(NATIVE_INT_TYPE) + this->msgSize);
   }
 
   void BufferQueue::enqueueBuffer(const U8* buffer, NATIVE_UINT_TYPE size, U8* data, NATIVE_UINT_TYPE index) {
+#if FW_QUEUE_INSTRUMENTATION
+    // Stamp the buffer with the time it was pushed:
+    IntervalTimer::getRawTime(this->pushTimes[index / (sizeof(NATIVE_INT_TYPE) + this->msgSize)]);
+#endif
+
     // Copy size of buffer onto queue:
     void* dest = &data[index];
     void* ptr = memcpy(dest, &size, sizeof(size));
@@ -151,6 +252,9 @@ namespace Os {
     source = &data[index];
     ptr = memcpy(buffer, source, storedSize);
     FW_ASSERT(ptr == buffer);
+#if FW_QUEUE_INSTRUMENTATION
+    this->popPushTime = this->pushTimes[(index - sizeof(size)) / (sizeof(NATIVE_INT_TYPE) + this->msgSize)];
+#endif
     return true;
   }
 }
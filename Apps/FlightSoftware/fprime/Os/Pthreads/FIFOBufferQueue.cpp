@@ -12,9 +12,16 @@
 // ======================================================================
 
 #include "Os/Pthreads/BufferQueue.hpp"
+#include <Fw/Cfg/Config.hpp>
 #include <Fw/Types/Assert.hpp>
 #include <string.h>
 
+// Messages are reserved and committed in different orders, so they can't
+// be serialized in place in a FIFO ring:
+#if FW_QUEUE_ZERO_COPY
+#error "FW_QUEUE_ZERO_COPY needs PriorityBufferQueue.cpp"
+#endif
+
 // This is a simple FIFO queue implementation which ignores priority
 namespace Os {
 
@@ -15,6 +15,7 @@
 
 #include "Os/Pthreads/BufferQueue.hpp"
 #include "Os/Pthreads/MaxHeap/MaxHeap.hpp"
+#include <Fw/Cfg/Config.hpp>
 #include <Fw/Types/Assert.hpp>
 #include <string.h>
 #include <stdio.h>
@@ -166,4 +167,35 @@ namespace Os {
 
     return true;
   }
+
+#if FW_QUEUE_ZERO_COPY
+  NATIVE_UINT_TYPE BufferQueue::checkoutBuffer() {
+    PriorityQueue* pQueue = static_cast<PriorityQueue*>(this->queue);
+    return checkoutIndex(pQueue, this->depth);
+  }
+
+  void BufferQueue::enqueueIndex(NATIVE_UINT_TYPE index, NATIVE_INT_TYPE priority) {
+    PriorityQueue* pQueue = static_cast<PriorityQueue*>(this->queue);
+    bool ret = pQueue->heap->push(priority, index);
+    FW_ASSERT(ret, ret);
+  }
+
+  NATIVE_UINT_TYPE BufferQueue::dequeueIndex(NATIVE_INT_TYPE &priority) {
+    PriorityQueue* pQueue = static_cast<PriorityQueue*>(this->queue);
+    NATIVE_UINT_TYPE index;
+    bool ret = pQueue->heap->pop(priority, index);
+    FW_ASSERT(ret, ret);
+    return index;
+  }
+
+  void BufferQueue::returnBuffer(NATIVE_UINT_TYPE index) {
+    PriorityQueue* pQueue = static_cast<PriorityQueue*>(this->queue);
+    returnIndex(pQueue, this->depth, index);
+  }
+
+  U8* BufferQueue::getData() {
+    PriorityQueue* pQueue = static_cast<PriorityQueue*>(this->queue);
+    return pQueue->data;
+  }
+#endif
 }
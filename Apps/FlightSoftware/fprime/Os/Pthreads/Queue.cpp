@@ -20,6 +20,11 @@
 #include <pthread.h>
 #include <stdio.h>
 
+// Os/QueueCommon.cpp leaves out its receiveMany when this is set:
+#if !defined(OS_PTHREAD_QUEUE)
+#error "Pthreads/Queue.cpp needs OS_PTHREAD_QUEUE defined"
+#endif
+
 namespace Os {
   
   // A helper class which stores variables for the queue handle.
@@ -45,6 +50,9 @@ namespace Os {
       return queue.create(depth, msgSize);
     }
     BufferQueue queue;
+#if FW_QUEUE_INSTRUMENTATION
+    QueueStats* stats;
+#endif
     pthread_cond_t queueNotEmpty;
     pthread_cond_t queueNotFull;
     pthread_mutex_t queueLock;
@@ -71,7 +79,11 @@ namespace Os {
     if( !queueHandle->create(depth, msgSize) ) {
       return QUEUE_UNINITIALIZED;
     }
+#if FW_QUEUE_INSTRUMENTATION
+    queueHandle->stats = &this->m_stats;
+#endif
     this->m_handle = (POINTER_CAST) queueHandle;
+    this->m_name = name;
 
 #if FW_QUEUE_REGISTRATION
     if (this->s_queueRegistry) {
@@ -83,6 +95,11 @@ namespace Os {
   }
 
   Queue::~Queue() {
+#if FW_QUEUE_REGISTRATION
+    if (this->s_queueRegistry) {
+        this->s_queueRegistry->unregQueue(this);
+    }
+#endif
     // Clean up the queue handle:
     QueueHandle* queueHandle = (QueueHandle*) this->m_handle;
     if (NULL != queueHandle) {
@@ -191,11 +208,18 @@ namespace Os {
         return QUEUE_SIZE_MISMATCH;
     }
 
+    QueueStatus status;
     if( QUEUE_NONBLOCKING == block ) {
-      return sendNonBlock(queueHandle, buffer, size, priority);
+      status = sendNonBlock(queueHandle, buffer, size, priority);
+    }
+    else {
+      status = sendBlock(queueHandle, buffer, size, priority);
     }
 
-    return sendBlock(queueHandle, buffer, size, priority);
+#if FW_QUEUE_INSTRUMENTATION
+    this->countSend(status);
+#endif
+    return status;
   }
 
   Queue::QueueStatus receiveNonBlock(QueueHandle* queueHandle, U8* buffer, NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE &actualSize, NATIVE_INT_TYPE &priority) {
@@ -223,6 +247,9 @@ namespace Os {
         // Pop worked - set the return size and priority:
         actualSize = (NATIVE_INT_TYPE) size;
         priority = pri;
+#if FW_QUEUE_INSTRUMENTATION
+        queueHandle->stats->countReceive(queue->getPushTime());
+#endif
 
         // Pop worked - wake up a thread that might be waiting on 
         // the send end of the queue:
@@ -286,6 +313,9 @@ namespace Os {
         // Pop worked - set the return size and priority:
         actualSize = (NATIVE_INT_TYPE) size;
         priority = pri;
+#if FW_QUEUE_INSTRUMENTATION
+        queueHandle->stats->countReceive(queue->getPushTime());
+#endif
 
         // Pop worked - wake up a thread that might be waiting on 
         // the send end of the queue:
@@ -340,6 +370,256 @@ namespace Os {
       return receiveBlock(queueHandle, buffer, capacity, actualSize, priority);
   }
 
+  Queue::QueueStatus Queue::receiveMany(U8* buffers, NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE maxMsgs, NATIVE_INT_TYPE* actualSizes, NATIVE_INT_TYPE* priorities, NATIVE_INT_TYPE &numMsgs, QueueBlocking block) {
+
+      numMsgs = 0;
+
+      QueueHandle* queueHandle = (QueueHandle*) this->m_handle;
+
+      if (NULL == queueHandle) {
+        return QUEUE_UNINITIALIZED;
+      }
+
+      if ((NULL == buffers) || (NULL == actualSizes) || (NULL == priorities) || (maxMsgs <= 0)) {
+        return QUEUE_EMPTY_BUFFER;
+      }
+
+      // Every message has to fit, so the batch can't stop part way on a big one:
+      if (capacity < this->getMsgSize()) {
+          return QUEUE_SIZE_MISMATCH;
+      }
+
+      BufferQueue* queue = &queueHandle->queue;
+      pthread_cond_t* queueNotEmpty = &queueHandle->queueNotEmpty;
+      pthread_cond_t* queueNotFull = &queueHandle->queueNotFull;
+      pthread_mutex_t* queueLock = &queueHandle->queueLock;
+      NATIVE_INT_TYPE ret;
+
+      ////////////////////////////////
+      // Locked Section
+      ///////////////////////////////
+      ret = pthread_mutex_lock(queueLock);
+      FW_ASSERT(ret == 0, errno);
+      ///////////////////////////////
+
+      // If the queue is empty and blocking, wait until a message is put on the queue:
+      while( queue->isEmpty() && (QUEUE_BLOCKING == block) ) {
+        NATIVE_INT_TYPE ret = pthread_cond_wait(queueNotEmpty, queueLock);
+        FW_ASSERT(ret == 0, errno);
+      }
+
+      // Drain up to maxMsgs items off of the queue:
+      while( numMsgs < maxMsgs ) {
+        NATIVE_UINT_TYPE size = capacity;
+        NATIVE_INT_TYPE pri = 0;
+        if( !queue->pop(&buffers[numMsgs * capacity], size, pri) ) {
+          FW_ASSERT(size == 0, size);
+          break;
+        }
+        actualSizes[numMsgs] = (NATIVE_INT_TYPE) size;
+        priorities[numMsgs] = pri;
+#if FW_QUEUE_INSTRUMENTATION
+        queueHandle->stats->countReceive(queue->getPushTime());
+#endif
+        ++numMsgs;
+      }
+
+      // Pop worked - wake up every thread that might be waiting on
+      // the send end of the queue, since there may be room for more than one:
+      if( numMsgs > 0 ) {
+        NATIVE_INT_TYPE ret = pthread_cond_broadcast(queueNotFull);
+        FW_ASSERT(ret == 0, errno); // If this fails, something horrible happened.
+      }
+
+      ///////////////////////////////
+      ret = pthread_mutex_unlock(queueLock);
+      FW_ASSERT(ret == 0, errno);
+      ////////////////////////////////
+      ///////////////////////////////
+
+      return (numMsgs > 0) ? QUEUE_OK : QUEUE_NO_MORE_MSGS;
+  }
+
+#if FW_QUEUE_ZERO_COPY
+  Queue::QueueStatus Queue::reserve(Fw::ExternalSerializeBuffer &slot, QueueBlocking block) {
+
+      QueueHandle* queueHandle = (QueueHandle*) this->m_handle;
+
+      if (NULL == queueHandle) {
+        return QUEUE_UNINITIALIZED;
+      }
+
+      BufferQueue* queue = &queueHandle->queue;
+      pthread_cond_t* queueNotFull = &queueHandle->queueNotFull;
+      pthread_mutex_t* queueLock = &queueHandle->queueLock;
+      NATIVE_INT_TYPE ret;
+
+      ////////////////////////////////
+      // Locked Section
+      ///////////////////////////////
+      ret = pthread_mutex_lock(queueLock);
+      FW_ASSERT(ret == 0, errno);
+      ///////////////////////////////
+
+      // If the queue is full and blocking, wait until a buffer is released:
+      U8* buffer = queue->reserve();
+      while( (NULL == buffer) && (QUEUE_BLOCKING == block) ) {
+        NATIVE_INT_TYPE ret = pthread_cond_wait(queueNotFull, queueLock);
+        FW_ASSERT(ret == 0, errno);
+        buffer = queue->reserve();
+      }
+
+      ///////////////////////////////
+      ret = pthread_mutex_unlock(queueLock);
+      FW_ASSERT(ret == 0, errno);
+      ////////////////////////////////
+      ///////////////////////////////
+
+      if (NULL == buffer) {
+#if FW_QUEUE_INSTRUMENTATION
+        this->countSend(QUEUE_FULL);
+#endif
+        return QUEUE_FULL;
+      }
+
+      // Serialize straight into the queue storage:
+      slot.setExtBuffer(buffer, queue->getMsgSize());
+      slot.resetSer();
+      return QUEUE_OK;
+  }
+
+  Queue::QueueStatus Queue::commit(Fw::ExternalSerializeBuffer &slot, NATIVE_INT_TYPE priority) {
+
+      QueueHandle* queueHandle = (QueueHandle*) this->m_handle;
+
+      if (NULL == queueHandle) {
+        return QUEUE_UNINITIALIZED;
+      }
+
+      BufferQueue* queue = &queueHandle->queue;
+      pthread_cond_t* queueNotEmpty = &queueHandle->queueNotEmpty;
+      pthread_mutex_t* queueLock = &queueHandle->queueLock;
+      NATIVE_INT_TYPE ret;
+
+      ////////////////////////////////
+      // Locked Section
+      ///////////////////////////////
+      ret = pthread_mutex_lock(queueLock);
+      FW_ASSERT(ret == 0, errno);
+      ///////////////////////////////
+
+      queue->commit(slot.getBuffAddr(), slot.getBuffLength(), priority);
+
+      // Wake up a thread that might be waiting on the other end of the queue:
+      ret = pthread_cond_signal(queueNotEmpty);
+      FW_ASSERT(ret == 0, errno); // If this fails, something horrible happened.
+
+      ///////////////////////////////
+      ret = pthread_mutex_unlock(queueLock);
+      FW_ASSERT(ret == 0, errno);
+      ////////////////////////////////
+      ///////////////////////////////
+
+      // The slot belongs to the queue now:
+      slot.clear();
+#if FW_QUEUE_INSTRUMENTATION
+      this->countSend(QUEUE_OK);
+#endif
+      return QUEUE_OK;
+  }
+
+  Queue::QueueStatus Queue::receiveInPlace(Fw::ExternalSerializeBuffer &slot, NATIVE_INT_TYPE &priority, QueueBlocking block) {
+
+      QueueHandle* queueHandle = (QueueHandle*) this->m_handle;
+
+      if (NULL == queueHandle) {
+        return QUEUE_UNINITIALIZED;
+      }
+
+      BufferQueue* queue = &queueHandle->queue;
+      pthread_cond_t* queueNotEmpty = &queueHandle->queueNotEmpty;
+      pthread_mutex_t* queueLock = &queueHandle->queueLock;
+      NATIVE_INT_TYPE ret;
+
+      NATIVE_UINT_TYPE size = 0;
+      NATIVE_INT_TYPE pri = 0;
+
+      ////////////////////////////////
+      // Locked Section
+      ///////////////////////////////
+      ret = pthread_mutex_lock(queueLock);
+      FW_ASSERT(ret == 0, errno);
+      ///////////////////////////////
+
+      // If the queue is empty and blocking, wait until a message is put on the queue:
+      while( queue->isEmpty() && (QUEUE_BLOCKING == block) ) {
+        NATIVE_INT_TYPE ret = pthread_cond_wait(queueNotEmpty, queueLock);
+        FW_ASSERT(ret == 0, errno);
+      }
+
+      // The slot stays in use until it is released, so no sender is woken here:
+      U8* buffer = queue->popInPlace(size, pri);
+#if FW_QUEUE_INSTRUMENTATION
+      if (NULL != buffer) {
+        queueHandle->stats->countReceive(queue->getPushTime());
+      }
+#endif
+
+      ///////////////////////////////
+      ret = pthread_mutex_unlock(queueLock);
+      FW_ASSERT(ret == 0, errno);
+      ////////////////////////////////
+      ///////////////////////////////
+
+      if (NULL == buffer) {
+        return QUEUE_NO_MORE_MSGS;
+      }
+
+      // Deserialize straight from the queue storage:
+      slot.setExtBuffer(buffer, queue->getMsgSize());
+      Fw::SerializeStatus stat = slot.setBuffLen(size);
+      FW_ASSERT(Fw::FW_SERIALIZE_OK == stat, stat);
+      priority = pri;
+      return QUEUE_OK;
+  }
+
+  Queue::QueueStatus Queue::release(Fw::ExternalSerializeBuffer &slot) {
+
+      QueueHandle* queueHandle = (QueueHandle*) this->m_handle;
+
+      if (NULL == queueHandle) {
+        return QUEUE_UNINITIALIZED;
+      }
+
+      BufferQueue* queue = &queueHandle->queue;
+      pthread_cond_t* queueNotFull = &queueHandle->queueNotFull;
+      pthread_mutex_t* queueLock = &queueHandle->queueLock;
+      NATIVE_INT_TYPE ret;
+
+      ////////////////////////////////
+      // Locked Section
+      ///////////////////////////////
+      ret = pthread_mutex_lock(queueLock);
+      FW_ASSERT(ret == 0, errno);
+      ///////////////////////////////
+
+      queue->release(slot.getBuffAddr());
+
+      // Wake up a thread that might be waiting on the send end of the queue:
+      ret = pthread_cond_signal(queueNotFull);
+      FW_ASSERT(ret == 0, errno); // If this fails, something horrible happened.
+
+      ///////////////////////////////
+      ret = pthread_mutex_unlock(queueLock);
+      FW_ASSERT(ret == 0, errno);
+      ////////////////////////////////
+      ///////////////////////////////
+
+      slot.clear();
+      return QUEUE_OK;
+  }
+#endif
+
   NATIVE_INT_TYPE Queue::getNumMsgs(void) const {
       QueueHandle* queueHandle = (QueueHandle*) this->m_handle;
       if (NULL == queueHandle) {
@@ -1,4 +1,5 @@
 #include "Os/Pthreads/BufferQueue.hpp"
+#include <Fw/Cfg/Config.hpp>
 #include <Fw/Types/Assert.hpp>
 #include <stdio.h>
 #include <string.h>
@@ -130,5 +131,62 @@ int main() {
 
   printf("Passed.\n");
 
+#if FW_QUEUE_ZERO_COPY && PRIORITY_QUEUE
+  printf("Test zero copy...\n");
+  // Fill buffers in place, and make sure reserved and
+  // popped buffers take up room until they are released.
+  BufferQueue queue3;
+  ret = queue3.create(DEPTH, MSG_SIZE);
+  FW_ASSERT(ret, ret);
+  U8* slots[DEPTH];
+  for(NATIVE_UINT_TYPE ii = 0; ii < DEPTH; ++ii) {
+    slots[ii] = queue3.reserve();
+    FW_ASSERT(slots[ii] != NULL);
+    memset(slots[ii], ii, MSG_SIZE);
+    FW_ASSERT(queue3.getCount() == 0, queue3.getCount());
+  }
+  FW_ASSERT(queue3.isFull());
+  FW_ASSERT(queue3.reserve() == NULL);
+  ret = queue3.push(&send[0], sizeof(send), 0);
+  FW_ASSERT(!ret, ret);
+  for(NATIVE_UINT_TYPE ii = 0; ii < DEPTH; ++ii) {
+    queue3.commit(slots[ii], MSG_SIZE - 1, ii);
+    FW_ASSERT(queue3.getCount() == ii+1, queue3.getCount());
+  }
+  FW_ASSERT(queue3.isFull());
+  for(NATIVE_INT_TYPE ii = DEPTH - 1; ii >= 0; --ii) {
+    U8* slot = queue3.popInPlace(size, priority);
+    FW_ASSERT(slot == slots[ii]);
+    FW_ASSERT(size == MSG_SIZE - 1, size);
+    FW_ASSERT(priority == ii, priority, ii);
+    FW_ASSERT(slot[0] == ii, slot[0], ii);
+    if (ii == DEPTH - 1) {
+      // Still full until the buffer is released:
+      FW_ASSERT(queue3.isFull());
+      FW_ASSERT(queue3.reserve() == NULL);
+    }
+    queue3.release(slot);
+    FW_ASSERT(!queue3.isFull());
+    FW_ASSERT(queue3.getCount() == (NATIVE_UINT_TYPE) ii, queue3.getCount());
+  }
+  FW_ASSERT(queue3.popInPlace(size, priority) == NULL);
+  FW_ASSERT(queue3.getMaxCount() == DEPTH, queue3.getMaxCount());
+  // A reserved buffer can be released without committing it:
+  U8* slot = queue3.reserve();
+  FW_ASSERT(slot != NULL);
+  queue3.release(slot);
+  FW_ASSERT(queue3.isEmpty());
+  // Copying and zero copy buffers share the queue:
+  ret = queue3.push(&send[0], sizeof(send), 3);
+  FW_ASSERT(ret, ret);
+  slot = queue3.popInPlace(size, priority);
+  FW_ASSERT(slot != NULL);
+  FW_ASSERT(size == sizeof(send), size);
+  FW_ASSERT(priority == 3, priority);
+  FW_ASSERT(memcmp(slot, send, size) == 0);
+  queue3.release(slot);
+  printf("Passed.\n");
+#endif
+
   printf("Test done.\n");
 }
@@ -5,6 +5,7 @@
 #include <Fw/Obj/ObjBase.hpp>
 #include <Fw/Types/Serializable.hpp>
 #include <Os/QueueString.hpp>
+#include <Os/QueueStats.hpp>
 
 namespace Os {
     // forward declaration for registry
@@ -43,12 +44,29 @@ namespace Os {
             QueueStatus send(const U8* buffer, NATIVE_INT_TYPE size, NATIVE_INT_TYPE priority, QueueBlocking block); //!<  send a message
             QueueStatus receive(U8* buffer, NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE &actualSize, NATIVE_INT_TYPE &priority, QueueBlocking block); //!<  receive a message
 
+            // Receive a batch of raw buffers. Waits for a message if blocking, then receives up to maxMsgs
+            // messages without waiting. Message i goes in &buffers[i*capacity], and capacity must be at least
+            // the queue message size. Returns QUEUE_NO_MORE_MSGS if nonblocking and the queue is empty.
+            QueueStatus receiveMany(U8* buffers, NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE maxMsgs, NATIVE_INT_TYPE* actualSizes, NATIVE_INT_TYPE* priorities, NATIVE_INT_TYPE &numMsgs, QueueBlocking block); //!<  receive up to maxMsgs messages
+
+#if FW_QUEUE_ZERO_COPY
+            // Serialize and deserialize messages in place in a queue slot. A sender reserves a slot,
+            // serializes into it and commits it. A receiver deserializes from the slot and releases it.
+            QueueStatus reserve(Fw::ExternalSerializeBuffer &slot, QueueBlocking block); //!<  reserve an empty slot to serialize a message into
+            QueueStatus commit(Fw::ExternalSerializeBuffer &slot, NATIVE_INT_TYPE priority); //!<  send the message serialized into a reserved slot
+            QueueStatus receiveInPlace(Fw::ExternalSerializeBuffer &slot, NATIVE_INT_TYPE &priority, QueueBlocking block); //!<  receive a message, leaving it in its slot
+            QueueStatus release(Fw::ExternalSerializeBuffer &slot); //!<  give back a received slot, or a reserved slot that won't be committed
+#endif
+
             NATIVE_INT_TYPE getNumMsgs(void) const; //!< get the number of messages in the queue
             NATIVE_INT_TYPE getMaxMsgs(void) const; //!< get the maximum number of messages (high watermark)
             NATIVE_INT_TYPE getQueueSize(void) const; //!< get the queue depth (maximum number of messages queue can hold)
             NATIVE_INT_TYPE getMsgSize(void) const; //!< get the message size (maximum message size queue can hold)
             const QueueString& getName(void); //!< get the queue name
             NATIVE_INT_TYPE getNumQueues(void); //!< get the number of queues in the system
+#if FW_QUEUE_INSTRUMENTATION
+            const QueueStats& getStats(void) const; //!< get the send, receive and latency statistics
+#endif
 #if FW_QUEUE_REGISTRATION
             static void setQueueRegistry(QueueRegistry* reg); // !< set the queue registry
 #endif
@@ -65,6 +83,10 @@ namespace Os {
             static QueueRegistry* s_queueRegistry; //!< pointer to registry
 #endif
             static NATIVE_INT_TYPE s_numQueues; //!< tracks number of queues in the system
+#if FW_QUEUE_INSTRUMENTATION
+            QueueStats m_stats; //!< send, receive and latency statistics
+            void countSend(QueueStatus status); //!< count a send that returned status
+#endif
         private:
             Queue(Queue&); //!<  Disabled copy constructor
             Queue(Queue*); //!<  Disabled copy constructor
@@ -73,6 +95,7 @@ namespace Os {
     class QueueRegistry {
         public:
             virtual void regQueue(Queue* obj)=0; //!< method called by queue init() methods to register a new queue
+            virtual void unregQueue(Queue* obj); //!< method called by queue destructors to remove a queue. Does nothing by default
             virtual ~QueueRegistry(); //!< virtual destructor for registry object
     };
 }
@@ -37,6 +37,35 @@ namespace Os {
         }
     }
 
+#if !defined(OS_PTHREAD_QUEUE)
+    // The pthread queue drains the batch under one lock in Pthreads/Queue.cpp.
+    // The other queues receive one message at a time.
+    Queue::QueueStatus Queue::receiveMany(U8* buffers, NATIVE_INT_TYPE capacity, NATIVE_INT_TYPE maxMsgs, NATIVE_INT_TYPE* actualSizes, NATIVE_INT_TYPE* priorities, NATIVE_INT_TYPE &numMsgs, QueueBlocking block) {
+        numMsgs = 0;
+
+        if ((NULL == buffers) || (NULL == actualSizes) || (NULL == priorities) || (maxMsgs <= 0)) {
+            return QUEUE_EMPTY_BUFFER;
+        }
+
+        // Every message has to fit, so the batch can't stop part way on a big one:
+        if (capacity < this->getMsgSize()) {
+            return QUEUE_SIZE_MISMATCH;
+        }
+
+        // Only the first receive waits.
+        QueueStatus status = this->receive(buffers, capacity, actualSizes[0], priorities[0], block);
+        while (QUEUE_OK == status) {
+            ++numMsgs;
+            if (numMsgs == maxMsgs) {
+                break;
+            }
+            status = this->receive(&buffers[numMsgs * capacity], capacity, actualSizes[numMsgs], priorities[numMsgs], QUEUE_NONBLOCKING);
+        }
+
+        return (numMsgs > 0) ? QUEUE_OK : status;
+    }
+#endif
+
 #if FW_QUEUE_REGISTRATION
 
     void Queue::setQueueRegistry(QueueRegistry* reg) {
@@ -46,6 +75,14 @@ namespace Os {
 
 #endif
 
+    QueueRegistry::~QueueRegistry() {
+    }
+
+    void QueueRegistry::unregQueue(Queue* obj) {
+        // registries that don't keep the queues have nothing to remove
+        (void) obj;
+    }
+
     NATIVE_INT_TYPE Queue::getNumQueues(void) {
         return Queue::s_numQueues;
     }
@@ -54,4 +91,20 @@ namespace Os {
         return this->m_name;
     }
 
+#if FW_QUEUE_INSTRUMENTATION
+
+    const QueueStats& Queue::getStats(void) const {
+        return this->m_stats;
+    }
+
+    void Queue::countSend(QueueStatus status) {
+        if (QUEUE_OK == status) {
+            this->m_stats.countSend();
+        } else if (QUEUE_FULL == status) {
+            this->m_stats.countSendFull();
+        }
+    }
+
+#endif
+
 }
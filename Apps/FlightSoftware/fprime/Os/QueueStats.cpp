@@ -0,0 +1,143 @@
+#include <Os/QueueStats.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#if FW_QUEUE_INSTRUMENTATION
+
+#if (FW_QUEUE_LATENCY_BUCKETS < 2) || (FW_QUEUE_LATENCY_BUCKETS > 32)
+#error "FW_QUEUE_LATENCY_BUCKETS must be from 2 to 32"
+#endif
+
+namespace Os {
+
+    QueueStats::QueueStats(void) :
+        m_sends(0),
+        m_sendsFull(0),
+        m_receives(0),
+        m_maxLatency(0),
+        m_maxDepth(0) {
+        for (NATIVE_UINT_TYPE bucket = 0; bucket < FW_QUEUE_LATENCY_BUCKETS; bucket++) {
+            this->m_latency[bucket] = 0;
+        }
+    }
+
+    void QueueStats::countSend(void) {
+        (void) __sync_add_and_fetch(&this->m_sends, 1);
+    }
+
+    void QueueStats::countSendFull(void) {
+        (void) __sync_add_and_fetch(&this->m_sendsFull, 1);
+    }
+
+    void QueueStats::countReceive(void) {
+        (void) __sync_add_and_fetch(&this->m_receives, 1);
+    }
+
+    void QueueStats::countReceive(const IntervalTimer::RawTime& sendTime) {
+        IntervalTimer::RawTime now;
+        IntervalTimer::getRawTime(now);
+        U32 latency = IntervalTimer::getDiffUsec(now, sendTime);
+
+        (void) __sync_add_and_fetch(&this->m_latency[getBucket(latency)], 1);
+        countMax(&this->m_maxLatency, latency);
+        (void) __sync_add_and_fetch(&this->m_receives, 1);
+    }
+
+    void QueueStats::countDepth(U32 depth) {
+        countMax(&this->m_maxDepth, depth);
+    }
+
+    U32 QueueStats::getSends(void) const {
+        return this->m_sends;
+    }
+
+    U32 QueueStats::getSendsFull(void) const {
+        return this->m_sendsFull;
+    }
+
+    U32 QueueStats::getReceives(void) const {
+        return this->m_receives;
+    }
+
+    U32 QueueStats::getTimedReceives(void) const {
+        U32 total = 0;
+        for (NATIVE_UINT_TYPE bucket = 0; bucket < FW_QUEUE_LATENCY_BUCKETS; bucket++) {
+            total += this->m_latency[bucket];
+        }
+        return total;
+    }
+
+    U32 QueueStats::getLatencyCount(NATIVE_UINT_TYPE bucket) const {
+        FW_ASSERT(bucket < FW_QUEUE_LATENCY_BUCKETS, bucket);
+        return this->m_latency[bucket];
+    }
+
+    U32 QueueStats::getMaxLatency(void) const {
+        return this->m_maxLatency;
+    }
+
+    U32 QueueStats::getMaxDepth(void) const {
+        return this->m_maxDepth;
+    }
+
+    U32 QueueStats::getLatencyPercentile(U32 percent) const {
+        FW_ASSERT(percent <= 100, percent);
+
+        // Copy the buckets, so they add up to the total while senders count more
+        U32 latency[FW_QUEUE_LATENCY_BUCKETS];
+        U32 total = 0;
+        for (NATIVE_UINT_TYPE bucket = 0; bucket < FW_QUEUE_LATENCY_BUCKETS; bucket++) {
+            latency[bucket] = this->m_latency[bucket];
+            total += latency[bucket];
+        }
+        if (0 == total) {
+            return 0;
+        }
+
+        // The bucket holding the message percent of the way through, rounded up
+        U32 wanted = (total / 100) * percent + ((total % 100) * percent + 99) / 100;
+        U32 seen = 0;
+        NATIVE_UINT_TYPE bucket = 0;
+        for (; bucket < FW_QUEUE_LATENCY_BUCKETS - 1; bucket++) {
+            seen += latency[bucket];
+            if (seen >= wanted) {
+                break;
+            }
+        }
+
+        // No message was slower than the longest one
+        U32 limit = getBucketLimit(bucket);
+        U32 maxLatency = this->m_maxLatency;
+        return (limit > maxLatency) ? maxLatency : limit;
+    }
+
+    NATIVE_UINT_TYPE QueueStats::getBucket(U32 latency) {
+        NATIVE_UINT_TYPE bucket = 0;
+        while ((latency != 0) && (bucket < FW_QUEUE_LATENCY_BUCKETS - 1)) {
+            latency >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    void QueueStats::countMax(volatile U32* max, U32 value) {
+        U32 current = *max;
+        while (value > current) {
+            U32 seen = __sync_val_compare_and_swap(max, current, value);
+            if (seen == current) {
+                break;
+            }
+            current = seen;
+        }
+    }
+
+    U32 QueueStats::getBucketLimit(NATIVE_UINT_TYPE bucket) {
+        FW_ASSERT(bucket < FW_QUEUE_LATENCY_BUCKETS, bucket);
+        if (bucket == FW_QUEUE_LATENCY_BUCKETS - 1) {
+            return 0xFFFFFFFF;
+        }
+        return static_cast<U32>(1) << bucket;
+    }
+
+}
+
+#endif
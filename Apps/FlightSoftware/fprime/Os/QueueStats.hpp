@@ -0,0 +1,57 @@
+#ifndef _QueueStats_hpp_
+#define _QueueStats_hpp_
+
+#include <Fw/Cfg/Config.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+#include <Os/IntervalTimer.hpp>
+
+#if FW_QUEUE_INSTRUMENTATION
+
+namespace Os {
+
+    // Counts kept by each Os::Queue. Senders and receivers on any thread
+    // update them with atomic adds, so they are read without the queue lock,
+    // and a reader may see a receive counted before its send.
+    //
+    // The time from send to receive of each message is counted in one of
+    // FW_QUEUE_LATENCY_BUCKETS buckets. Bucket 0 counts messages received in
+    // under 1 usec, bucket b counts messages received in 2^(b-1) to 2^b - 1
+    // usec, and the last bucket counts every message slower than that.
+    class QueueStats {
+        public:
+            QueueStats(void);
+
+            void countSend(void); //!< count a message sent
+            void countSendFull(void); //!< count a message not sent because the queue was full
+            void countReceive(void); //!< count a message received, for queues that don't time messages
+            void countReceive(const IntervalTimer::RawTime& sendTime); //!< count a message received, and the time since it was sent
+            void countDepth(U32 depth); //!< count the number of messages in the queue, for queues that don't keep a high water mark
+
+            U32 getSends(void) const; //!< get the number of messages sent
+            U32 getSendsFull(void) const; //!< get the number of messages not sent because the queue was full
+            U32 getReceives(void) const; //!< get the number of messages received
+            U32 getTimedReceives(void) const; //!< get the number of messages counted in the latency histogram
+            U32 getLatencyCount(NATIVE_UINT_TYPE bucket) const; //!< get the number of messages in a latency bucket
+            U32 getMaxLatency(void) const; //!< get the longest time from send to receive in usec
+            U32 getMaxDepth(void) const; //!< get the most messages counted by countDepth()
+            U32 getLatencyPercentile(U32 percent) const; //!< get the latency in usec that percent of the timed messages were received within, rounded up to a bucket limit
+
+            static NATIVE_UINT_TYPE getBucket(U32 latency); //!< get the bucket a latency in usec is counted in
+            static U32 getBucketLimit(NATIVE_UINT_TYPE bucket); //!< get the first latency in usec past a bucket. The last bucket has no limit, and returns 0xFFFFFFFF
+
+        private:
+            static void countMax(volatile U32* max, U32 value); //!< raise max to value, if value is bigger
+
+            volatile U32 m_sends;
+            volatile U32 m_sendsFull;
+            volatile U32 m_receives;
+            volatile U32 m_maxLatency;
+            volatile U32 m_maxDepth;
+            volatile U32 m_latency[FW_QUEUE_LATENCY_BUCKETS];
+    };
+
+}
+
+#endif
+
+#endif
@@ -8,6 +8,7 @@
 SRC = 			TaskCommon.cpp \
 				TaskString.cpp \
 				QueueCommon.cpp \
+				QueueStats.cpp \
 				QueueString.cpp \
 				IPCQueueCommon.cpp \
 				SimpleQueueRegistry.cpp \
@@ -19,6 +20,7 @@ SRC = 			TaskCommon.cpp \
 HDR = 			Queue.hpp \
 				IPCQueue.hpp \
 				QueueString.hpp \
+				QueueStats.hpp \
 				SimpleQueueRegistry.hpp \
 				Task.hpp \
 				TaskString.hpp \
@@ -46,7 +48,8 @@ SRC_LINUX=      Posix/IPCQueue.cpp \
 				Linux/IntervalTimer.cpp \
 				Posix/Mutex.cpp \
 				Linux/FileSystem.cpp \
-				Posix/LocklessQueue.cpp
+				Posix/LocklessQueue.cpp \
+				Linux/RingBufferQueue.cpp
 
 SRC_DARWIN =    MacOs/IPCQueueStub.cpp \ # NOTE(mereweth) - provide a stub that only works in single-process, not IPC
                	Pthreads/Queue.cpp \
@@ -101,6 +104,12 @@ SRC_RASPIAN =   Pthreads/Queue.cpp \
 				
 
 
+# The pthread queue has its own receiveMany, so Os/QueueCommon.cpp leaves its one out
+COMPARGS_LINUX = -DOS_PTHREAD_QUEUE
+COMPARGS_DARWIN = -DOS_PTHREAD_QUEUE
+COMPARGS_CYGWIN = -DOS_PTHREAD_QUEUE
+COMPARGS_RASPIAN = -DOS_PTHREAD_QUEUE
+
 SUBDIRS = test
 
 # to use Pthread priority queue include:
@@ -115,3 +124,12 @@ SUBDIRS = test
 #        Pthreads/BufferQueueCommon.cpp \
 #        Pthreads/FIFOBufferQueue.cpp \
 
+# to use the lock-free ring queue on Linux, replace Pthreads/Queue.cpp in SRC_LINUX with:
+#        Linux/RingQueue.cpp \
+# and remove -DOS_PTHREAD_QUEUE from COMPARGS_LINUX
+
+# to use the lockless fifo queue, replace Pthreads/Queue.cpp with:
+#        Posix/LocklessOsQueue.cpp \
+# remove -DOS_PTHREAD_QUEUE from COMPARGS for that target, and build the queue UT
+# with -DOS_LOCKLESS_QUEUE so it expects fifo order
+
@@ -6,5 +6,5 @@
 #
 
 
-SUBDIRS = ut
+SUBDIRS = ut perf
 
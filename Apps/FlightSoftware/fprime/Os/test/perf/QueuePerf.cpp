@@ -0,0 +1,277 @@
+/*
+ * QueuePerf.cpp
+ *
+ * Measures message rate and latency through a queue with 1 to 8 sending
+ * threads and one receiving thread, for Os::Queue as built (the pthread
+ * queue unless another is selected), Os::Queue drained with receiveMany(),
+ * RingBufferQueue and LocklessQueue.
+ */
+
+#include <Os/Queue.hpp>
+#include <Os/Linux/RingBufferQueue.hpp>
+#include <Os/LocklessQueue.hpp>
+#include <Os/IntervalTimer.hpp>
+#include <Fw/Types/EightyCharString.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+    const NATIVE_UINT_TYPE PERF_MAX_PRODUCERS = 8;
+    const NATIVE_UINT_TYPE PERF_DEFAULT_MESSAGES = 20000; //!< messages sent by each thread
+    const NATIVE_UINT_TYPE PERF_MAX_MESSAGES = 200000;
+    const NATIVE_UINT_TYPE PERF_QUEUE_DEPTH = 64;
+    const NATIVE_UINT_TYPE PERF_MSG_SIZE = 64;
+    const NATIVE_UINT_TYPE PERF_BATCH = 16; //!< most messages taken by one receiveMany()
+
+    struct Message {
+        Os::IntervalTimer::RawTime sent;
+        U32 producer;
+        U32 sequence;
+    };
+
+    // the queues measured, behind the calls the benchmark needs
+    class PerfQueue {
+        public:
+            virtual ~PerfQueue(void) {}
+            virtual const char* getName(void) const = 0;
+            virtual void send(const U8* buffer, NATIVE_UINT_TYPE size) = 0;
+            virtual NATIVE_UINT_TYPE receive(U8* buffer, NATIVE_UINT_TYPE capacity) = 0;
+    };
+
+    class OsQueue : public PerfQueue {
+        public:
+            OsQueue(void) {
+                Os::Queue::QueueStatus stat = this->m_queue.create(Fw::EightyCharString("PerfQ"),PERF_QUEUE_DEPTH,PERF_MSG_SIZE);
+                FW_ASSERT(Os::Queue::QUEUE_OK == stat,stat);
+            }
+            const char* getName(void) const {
+                return "os_queue";
+            }
+            void send(const U8* buffer, NATIVE_UINT_TYPE size) {
+                Os::Queue::QueueStatus stat = this->m_queue.send(buffer,size,0,Os::Queue::QUEUE_BLOCKING);
+                FW_ASSERT(Os::Queue::QUEUE_OK == stat,stat);
+            }
+            NATIVE_UINT_TYPE receive(U8* buffer, NATIVE_UINT_TYPE capacity) {
+                NATIVE_INT_TYPE size = 0;
+                NATIVE_INT_TYPE priority = 0;
+                Os::Queue::QueueStatus stat = this->m_queue.receive(buffer,capacity,size,priority,Os::Queue::QUEUE_BLOCKING);
+                FW_ASSERT(Os::Queue::QUEUE_OK == stat,stat);
+                return size;
+            }
+        private:
+            Os::Queue m_queue;
+    };
+
+    // Os::Queue, taking up to PERF_BATCH messages at a time and receiving from the copies
+    class OsQueueBatch : public PerfQueue {
+        public:
+            OsQueueBatch(void) :
+                m_count(0),
+                m_next(0) {
+                Os::Queue::QueueStatus stat = this->m_queue.create(Fw::EightyCharString("PerfQ"),PERF_QUEUE_DEPTH,PERF_MSG_SIZE);
+                FW_ASSERT(Os::Queue::QUEUE_OK == stat,stat);
+            }
+            const char* getName(void) const {
+                return "os_queue_batch";
+            }
+            void send(const U8* buffer, NATIVE_UINT_TYPE size) {
+                Os::Queue::QueueStatus stat = this->m_queue.send(buffer,size,0,Os::Queue::QUEUE_BLOCKING);
+                FW_ASSERT(Os::Queue::QUEUE_OK == stat,stat);
+            }
+            NATIVE_UINT_TYPE receive(U8* buffer, NATIVE_UINT_TYPE capacity) {
+                if (this->m_next == this->m_count) {
+                    this->m_next = 0;
+                    Os::Queue::QueueStatus stat = this->m_queue.receiveMany(&this->m_batch[0][0],PERF_MSG_SIZE,PERF_BATCH,
+                            this->m_sizes,this->m_priorities,this->m_count,Os::Queue::QUEUE_BLOCKING);
+                    FW_ASSERT(Os::Queue::QUEUE_OK == stat,stat);
+                }
+                NATIVE_INT_TYPE next = this->m_next++;
+                FW_ASSERT(this->m_sizes[next] <= static_cast<NATIVE_INT_TYPE>(capacity),this->m_sizes[next]);
+                memcpy(buffer,this->m_batch[next],this->m_sizes[next]);
+                return this->m_sizes[next];
+            }
+        private:
+            Os::Queue m_queue;
+            U8 m_batch[PERF_BATCH][PERF_MSG_SIZE];
+            NATIVE_INT_TYPE m_sizes[PERF_BATCH];
+            NATIVE_INT_TYPE m_priorities[PERF_BATCH];
+            NATIVE_INT_TYPE m_count;
+            NATIVE_INT_TYPE m_next;
+    };
+
+    class RingQueue : public PerfQueue {
+        public:
+            RingQueue(void) {
+                FW_ASSERT(this->m_queue.create(PERF_QUEUE_DEPTH,PERF_MSG_SIZE,1));
+            }
+            const char* getName(void) const {
+                return "ring";
+            }
+            void send(const U8* buffer, NATIVE_UINT_TYPE size) {
+                Os::Queue::QueueStatus stat = this->m_queue.send(buffer,size,0,Os::Queue::QUEUE_BLOCKING);
+                FW_ASSERT(Os::Queue::QUEUE_OK == stat,stat);
+            }
+            NATIVE_UINT_TYPE receive(U8* buffer, NATIVE_UINT_TYPE capacity) {
+                NATIVE_UINT_TYPE size = 0;
+                NATIVE_INT_TYPE priority = 0;
+                Os::Queue::QueueStatus stat = this->m_queue.receive(buffer,capacity,size,priority,Os::Queue::QUEUE_BLOCKING);
+                FW_ASSERT(Os::Queue::QUEUE_OK == stat,stat);
+                return size;
+            }
+        private:
+            Os::RingBufferQueue m_queue;
+    };
+
+    class LocklessFifoQueue : public PerfQueue {
+        public:
+            LocklessFifoQueue(void) :
+                m_queue(PERF_QUEUE_DEPTH,PERF_MSG_SIZE) {
+            }
+            const char* getName(void) const {
+                return "lockless";
+            }
+            void send(const U8* buffer, NATIVE_UINT_TYPE size) {
+                Os::Queue::QueueStatus stat = this->m_queue.Send(buffer,size,Os::Queue::QUEUE_BLOCKING);
+                FW_ASSERT(Os::Queue::QUEUE_OK == stat,stat);
+            }
+            NATIVE_UINT_TYPE receive(U8* buffer, NATIVE_UINT_TYPE capacity) {
+                NATIVE_INT_TYPE size = 0;
+                Os::Queue::QueueStatus stat = this->m_queue.Receive(buffer,capacity,size,Os::Queue::QUEUE_BLOCKING);
+                FW_ASSERT(Os::Queue::QUEUE_OK == stat,stat);
+                return size;
+            }
+        private:
+            Os::LocklessQueue m_queue;
+    };
+
+    struct Producer {
+        PerfQueue* queue;
+        U32 id;
+        NATIVE_UINT_TYPE messages;
+        volatile U32* start;
+    };
+
+    void* runProducer(void* ptr) {
+        Producer* producer = static_cast<Producer*>(ptr);
+        U8 buffer[PERF_MSG_SIZE];
+        memset(buffer,0,sizeof(buffer));
+        Message msg;
+        msg.producer = producer->id;
+
+        // all threads start sending together
+        while (0 == *producer->start) {
+        }
+
+        for (NATIVE_UINT_TYPE sequence = 0; sequence < producer->messages; sequence++) {
+            msg.sequence = sequence;
+            Os::IntervalTimer::getRawTime(msg.sent);
+            memcpy(buffer,&msg,sizeof(msg));
+            producer->queue->send(buffer,sizeof(buffer));
+        }
+        return NULL;
+    }
+
+    int compareSamples(const void* a, const void* b) {
+        U32 first = *static_cast<const U32*>(a);
+        U32 second = *static_cast<const U32*>(b);
+        return (first > second) - (first < second);
+    }
+
+    void runPerfTest(PerfQueue& queue, NATIVE_UINT_TYPE numProducers, NATIVE_UINT_TYPE messages, U32* samples) {
+
+        volatile U32 start = 0;
+        Producer producers[PERF_MAX_PRODUCERS];
+        pthread_t threads[PERF_MAX_PRODUCERS];
+        for (NATIVE_UINT_TYPE thread = 0; thread < numProducers; thread++) {
+            producers[thread].queue = &queue;
+            producers[thread].id = thread;
+            producers[thread].messages = messages;
+            producers[thread].start = &start;
+            FW_ASSERT(0 == pthread_create(&threads[thread],NULL,runProducer,&producers[thread]));
+        }
+
+        Os::IntervalTimer::RawTime begin;
+        Os::IntervalTimer::RawTime end;
+        Os::IntervalTimer::RawTime received;
+        U32 next[PERF_MAX_PRODUCERS] = {0};
+        U8 buffer[PERF_MSG_SIZE];
+        Message msg;
+
+        Os::IntervalTimer::getRawTime(begin);
+        __sync_synchronize();
+        start = 1;
+
+        // latency is from just before the send to just after the receive
+        NATIVE_UINT_TYPE total = numProducers * messages;
+        for (NATIVE_UINT_TYPE sample = 0; sample < total; sample++) {
+            NATIVE_UINT_TYPE size = queue.receive(buffer,sizeof(buffer));
+            Os::IntervalTimer::getRawTime(received);
+            FW_ASSERT(sizeof(buffer) == size,size);
+            memcpy(&msg,buffer,sizeof(msg));
+            // each thread's messages arrive in the order sent
+            FW_ASSERT(msg.producer < numProducers,msg.producer);
+            FW_ASSERT(next[msg.producer] == msg.sequence,next[msg.producer],msg.sequence);
+            next[msg.producer]++;
+            samples[sample] = Os::IntervalTimer::getDiffNsec(received,msg.sent);
+        }
+        Os::IntervalTimer::getRawTime(end);
+
+        for (NATIVE_UINT_TYPE thread = 0; thread < numProducers; thread++) {
+            FW_ASSERT(0 == pthread_join(threads[thread],NULL));
+        }
+
+        U32 elapsedUsec = Os::IntervalTimer::getDiffUsec(end,begin);
+        F64 msgsPerSec = (elapsedUsec > 0) ? static_cast<F64>(total)*1.0e6/elapsedUsec : 0.0;
+        qsort(samples,total,sizeof(samples[0]),compareSamples);
+
+        (void)printf("%s,%u,%u,%.0f,%u,%u,%u,%u\n",
+                queue.getName(),
+                static_cast<U32>(numProducers),
+                static_cast<U32>(total),
+                msgsPerSec,
+                samples[(total-1)*50/100],
+                samples[(total-1)*90/100],
+                samples[(total-1)*99/100],
+                samples[total-1]);
+    }
+
+}
+
+#ifdef TGT_OS_TYPE_LINUX
+int main(int argc, char* argv[]) {
+
+    // optional argument is the number of messages each thread sends
+    NATIVE_UINT_TYPE messages = PERF_DEFAULT_MESSAGES;
+    if (argc > 1) {
+        messages = atoi(argv[1]);
+    }
+    if ((messages == 0) or (messages > PERF_MAX_MESSAGES)) {
+        messages = PERF_DEFAULT_MESSAGES;
+    }
+
+    // samples are large, so allocate instead of putting them on the stack
+    U32* samples = new U32[PERF_MAX_PRODUCERS * messages];
+    FW_ASSERT(samples);
+
+    (void)printf("queue,producers,messages,msgs_per_sec,p50_ns,p90_ns,p99_ns,max_ns\n");
+    for (NATIVE_UINT_TYPE producers = 1; producers <= PERF_MAX_PRODUCERS; producers++) {
+        OsQueue osQueue;
+        runPerfTest(osQueue,producers,messages,samples);
+        OsQueueBatch osQueueBatch;
+        runPerfTest(osQueueBatch,producers,messages,samples);
+        RingQueue ringQueue;
+        runPerfTest(ringQueue,producers,messages,samples);
+        LocklessFifoQueue locklessQueue;
+        runPerfTest(locklessQueue,producers,messages,samples);
+    }
+
+    delete[] samples;
+    return 0;
+}
+
+#endif
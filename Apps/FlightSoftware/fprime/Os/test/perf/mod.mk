@@ -0,0 +1,7 @@
+# ----------------------------------------------------------------------
+# mod.mk 
+# ----------------------------------------------------------------------
+
+TEST_SRC =      QueuePerf.cpp
+
+TEST_MODS = Os Fw/Obj Fw/Types Utils/Hash
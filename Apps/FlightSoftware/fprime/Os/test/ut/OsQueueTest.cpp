@@ -14,9 +14,13 @@
 #include <sys/time.h>
 #endif
 
-// Set this to 1 if testing a priority queue
-// Set this to 0 if testing a fifo queue
+// 1 when testing a priority queue, 0 when testing a fifo queue.
+// The lockless queue (OS_LOCKLESS_QUEUE) is a fifo queue.
+#if defined(OS_LOCKLESS_QUEUE)
+#define PRIORITY_QUEUE 0
+#else
 #define PRIORITY_QUEUE 1
+#endif
 
 enum {
         SER_BUFFER_SIZE = 100,
@@ -124,6 +128,8 @@ extern "C" {
     void qtest_nonblock_send(void);
     void qtest_block_send(void);
     void qtest_concurrent(void);
+    void qtest_receive_many(void);
+    void qtest_stats(void);
 }
 
 // Alarm signal handler for waking up a blocked queue:
@@ -391,6 +397,165 @@ void qtest_nonblock_receive(void) {
     printf("-----------------------------\n");
 }
 
+// This test verifies receiving a batch of messages at once
+void qtest_receive_many(void) {
+    printf("-----------------------------\n");
+    printf("---- receive many test ------\n");
+    printf("-----------------------------\n");
+    Os::Queue* testQueue = createTestQueue((char*)"TestQ", SER_BUFFER_SIZE, QUEUE_SIZE);
+    Os::Queue::QueueStatus stat;
+    U8 recvBuffs[QUEUE_SIZE][SER_BUFFER_SIZE];
+    NATIVE_INT_TYPE sizes[QUEUE_SIZE];
+    NATIVE_INT_TYPE prios[QUEUE_SIZE];
+    NATIVE_INT_TYPE numMsgs;
+
+    // TEST 1
+    printf("Testing non-blocking receive many on queue empty...\n");
+    stat = testQueue->receiveMany(&recvBuffs[0][0], SER_BUFFER_SIZE, QUEUE_SIZE, sizes, prios, numMsgs, Os::Queue::QUEUE_NONBLOCKING);
+    FW_ASSERT(stat == Os::Queue::QUEUE_NO_MORE_MSGS, stat);
+    FW_ASSERT(numMsgs == 0, numMsgs);
+    printf("Passed.\n");
+
+    // TEST 2
+    printf("Testing receive many with buffers smaller than a message...\n");
+    MyTestSerializedBuffer sendBuff = getSendBuffer(0);
+    stat = testQueue->send(sendBuff, 0, Os::Queue::QUEUE_NONBLOCKING);
+    FW_ASSERT(stat == Os::Queue::QUEUE_OK, stat);
+    stat = testQueue->receiveMany(&recvBuffs[0][0], SER_BUFFER_SIZE-1, QUEUE_SIZE, sizes, prios, numMsgs, Os::Queue::QUEUE_NONBLOCKING);
+    FW_ASSERT(stat == Os::Queue::QUEUE_SIZE_MISMATCH, stat);
+    FW_ASSERT(testQueue->getNumMsgs() == 1, testQueue->getNumMsgs());
+    drainQueue(testQueue);
+    printf("Passed.\n");
+
+    // TEST 3
+    printf("Test receive many in batches with priorities...\n");
+    I32 sendBuffStart[6] = {11, 45, 70, 123, 200, 400};
+    NATIVE_INT_TYPE priorities[6] = {0, 50, 50, 99, 0, 16};
+    for( I32 ii = 0; ii < 6; ii++ ) {
+      MyTestSerializedBuffer sendBuff2 = getSendBuffer(sendBuffStart[ii]);
+      stat = testQueue->send(sendBuff2, priorities[ii], Os::Queue::QUEUE_NONBLOCKING);
+      FW_ASSERT(stat == Os::Queue::QUEUE_OK, stat);
+    }
+
+#if PRIORITY_QUEUE
+    I32 expectedSendBuffStart[6] = {123, 45, 70, 400, 11, 200};
+    NATIVE_INT_TYPE expectedPriorities[6] = {99, 50, 50, 16, 0, 0};
+#else
+    I32 expectedSendBuffStart[6] = {11, 45, 70, 123, 200, 400};
+    NATIVE_INT_TYPE expectedPriorities[6] = {0, 0, 0, 0, 0, 0};
+#endif
+    // First batch stops at maxMsgs, and the second takes what is left:
+    NATIVE_INT_TYPE maxMsgs[2] = {4, QUEUE_SIZE};
+    NATIVE_INT_TYPE expectedNumMsgs[2] = {4, 2};
+    I32 expected = 0;
+    for( I32 batch = 0; batch < 2; batch++ ) {
+      stat = testQueue->receiveMany(&recvBuffs[0][0], SER_BUFFER_SIZE, maxMsgs[batch], sizes, prios, numMsgs, Os::Queue::QUEUE_BLOCKING);
+      FW_ASSERT(stat == Os::Queue::QUEUE_OK, stat);
+      FW_ASSERT(numMsgs == expectedNumMsgs[batch], numMsgs, expectedNumMsgs[batch]);
+      for( I32 ii = 0; ii < numMsgs; ii++, expected++ ) {
+        MyTestSerializedBuffer expectedSendBuff2 = getSendBuffer(expectedSendBuffStart[expected]);
+        FW_ASSERT(prios[ii] == expectedPriorities[expected], prios[ii], expectedPriorities[expected]);
+        FW_ASSERT(sizes[ii] == (NATIVE_INT_TYPE) expectedSendBuff2.getBuffLength(), sizes[ii]);
+        FW_ASSERT(memcmp(recvBuffs[ii], expectedSendBuff2.getBuffAddr(), sizes[ii]) == 0);
+      }
+    }
+    FW_ASSERT(testQueue->getNumMsgs() == 0, testQueue->getNumMsgs());
+    printf("Passed.\n");
+
+    // TEST 4
+    printf("Testing receive many on a full queue...\n");
+    fillQueue(testQueue);
+    stat = testQueue->receiveMany(&recvBuffs[0][0], SER_BUFFER_SIZE, QUEUE_SIZE, sizes, prios, numMsgs, Os::Queue::QUEUE_NONBLOCKING);
+    FW_ASSERT(stat == Os::Queue::QUEUE_OK, stat);
+    FW_ASSERT(numMsgs == QUEUE_SIZE, numMsgs);
+    FW_ASSERT(testQueue->getNumMsgs() == 0, testQueue->getNumMsgs());
+    printf("Passed.\n");
+
+    delete testQueue;
+    printf("Test complete.\n");
+    printf("-----------------------------\n");
+    printf("-----------------------------\n");
+}
+
+void qtest_stats(void) {
+    printf("-----------------------------\n");
+    printf("---- queue stats test -------\n");
+    printf("-----------------------------\n");
+#if FW_QUEUE_INSTRUMENTATION
+    Os::Queue* testQueue = createTestQueue((char*)"TestQ", SER_BUFFER_SIZE, QUEUE_SIZE);
+    const Os::QueueStats& stats = testQueue->getStats();
+    Os::Queue::QueueStatus stat;
+
+    // TEST 1
+    printf("Testing stats on a new queue...\n");
+    FW_ASSERT(stats.getSends() == 0, stats.getSends());
+    FW_ASSERT(stats.getSendsFull() == 0, stats.getSendsFull());
+    FW_ASSERT(stats.getReceives() == 0, stats.getReceives());
+    FW_ASSERT(stats.getTimedReceives() == 0, stats.getTimedReceives());
+    FW_ASSERT(stats.getMaxLatency() == 0, stats.getMaxLatency());
+    FW_ASSERT(stats.getLatencyPercentile(50) == 0, stats.getLatencyPercentile(50));
+    printf("Passed.\n");
+
+    // TEST 2
+    printf("Testing sends and receives are counted...\n");
+    fillQueue(testQueue);
+    FW_ASSERT(stats.getSends() == QUEUE_SIZE, stats.getSends());
+    FW_ASSERT(stats.getSendsFull() == 1, stats.getSendsFull());
+    FW_ASSERT(testQueue->getMaxMsgs() == QUEUE_SIZE, testQueue->getMaxMsgs());
+    drainQueue(testQueue);
+    FW_ASSERT(stats.getReceives() == QUEUE_SIZE, stats.getReceives());
+    // Queues that don't time messages leave the histogram empty:
+    U32 timed = stats.getTimedReceives();
+    FW_ASSERT((timed == 0) || (timed == QUEUE_SIZE), timed);
+    printf("Passed.\n");
+
+    // TEST 3
+    printf("Testing latency is counted...\n");
+    MyTestSerializedBuffer sendBuff = getSendBuffer(0);
+    MyTestSerializedBuffer recvBuff;
+    NATIVE_INT_TYPE priority;
+    stat = testQueue->send(sendBuff, 0, Os::Queue::QUEUE_NONBLOCKING);
+    FW_ASSERT(stat == Os::Queue::QUEUE_OK, stat);
+    usleep(2000);
+    stat = testQueue->receive(recvBuff, priority, Os::Queue::QUEUE_NONBLOCKING);
+    FW_ASSERT(stat == Os::Queue::QUEUE_OK, stat);
+    FW_ASSERT(stats.getReceives() == QUEUE_SIZE + 1, stats.getReceives());
+    if (timed > 0) {
+      FW_ASSERT(stats.getTimedReceives() == QUEUE_SIZE + 1, stats.getTimedReceives());
+      FW_ASSERT(stats.getMaxLatency() >= 2000, stats.getMaxLatency());
+      // The slow message is the only one in the top percent:
+      FW_ASSERT(stats.getLatencyPercentile(100) == stats.getMaxLatency(), stats.getLatencyPercentile(100));
+      FW_ASSERT(stats.getLatencyPercentile(50) < 2000, stats.getLatencyPercentile(50));
+      U32 bucket = Os::QueueStats::getBucket(stats.getMaxLatency());
+      FW_ASSERT(stats.getLatencyCount(bucket) >= 1, stats.getLatencyCount(bucket));
+    }
+    printf("Passed.\n");
+
+    // TEST 4
+    printf("Testing latency buckets...\n");
+    const U32 last = FW_QUEUE_LATENCY_BUCKETS - 1;
+    FW_ASSERT(Os::QueueStats::getBucket(0) == 0, Os::QueueStats::getBucket(0));
+    FW_ASSERT(Os::QueueStats::getBucket(1) == 1, Os::QueueStats::getBucket(1));
+    FW_ASSERT(Os::QueueStats::getBucket(2) == 2, Os::QueueStats::getBucket(2));
+    FW_ASSERT(Os::QueueStats::getBucket(3) == 2, Os::QueueStats::getBucket(3));
+    FW_ASSERT(Os::QueueStats::getBucket(0xFFFFFFFF) == last, Os::QueueStats::getBucket(0xFFFFFFFF));
+    for( U32 bucket = 0; bucket < last; bucket++ ) {
+      U32 limit = Os::QueueStats::getBucketLimit(bucket);
+      FW_ASSERT(Os::QueueStats::getBucket(limit - 1) == bucket, bucket, limit);
+      FW_ASSERT(Os::QueueStats::getBucket(limit) == bucket + 1, bucket, limit);
+    }
+    FW_ASSERT(Os::QueueStats::getBucketLimit(last) == 0xFFFFFFFF, Os::QueueStats::getBucketLimit(last));
+    printf("Passed.\n");
+
+    delete testQueue;
+    printf("Test complete.\n");
+#else
+    printf("Skipped, FW_QUEUE_INSTRUMENTATION is off.\n");
+#endif
+    printf("-----------------------------\n");
+    printf("-----------------------------\n");
+}
+
 // This test shows the performance of the queue:
 void qtest_performance(void) {
     printf("-----------------------------\n");
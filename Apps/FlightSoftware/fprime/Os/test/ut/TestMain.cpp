@@ -13,6 +13,8 @@ extern "C" {
   void intervalTimerTest(void);
   void fileSystemTest(void);
   void validateFileTest(void);
+  void qtest_receive_many(void);
+  void qtest_stats(void);
 }
 
 void run_test(int test_num)
@@ -49,6 +51,12 @@ void run_test(int test_num)
 		case 9:
 			validateFileTest();
 			break;
+		case 10:
+			qtest_receive_many();
+			break;
+		case 11:
+			qtest_stats();
+			break;
 		default:
 			fprintf(stderr, "Invalid test number: %d\n", test_num);
 			break;
@@ -61,7 +69,7 @@ int main(int argc, char* argv[]) {
   if( argc != 2 ) {
     printf("Running all test cases\n");
 
-    for(int i = 0; i < 10; i++)
+    for(int i = 0; i < 12; i++)
     {
       run_test(i);
     }
@@ -103,6 +103,8 @@ void constructApp(int port_number, char* hostname) {
     chanTlm.init(10,0);
 
     cmdDisp.init(20,0);
+    // ground commands go ahead of sequences
+    cmdDisp.setPortPriority(0,Svc::CommandDispatcherImpl::CMD_PRIORITY_HIGH);
 
     cmdSeq.init(10,0);
     cmdSeq.allocateBuffer(0,seqMallocator,5*1024);
@@ -142,6 +144,7 @@ void constructApp(int port_number, char* hostname) {
     fileDownlink.regCommands();
     health.regCommands();
     rpiDemo.regCommands();
+    chanTlm.regCommands();
 
     // read parameters
     prmDb.readParamFile();
@@ -167,6 +170,7 @@ void constructApp(int port_number, char* hostname) {
 
     // load parameters
     rpiDemo.loadParameters();
+    chanTlm.loadParameters();
 
     // Active component startup
     // start rate groups
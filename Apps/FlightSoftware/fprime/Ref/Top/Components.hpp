@@ -27,6 +27,7 @@ void exitTasks(void);
 #include <Ref/SignalGen/SignalGen.hpp>
 #include <Svc/AssertFatalAdapter/AssertFatalAdapterComponentImpl.hpp>
 #include <Svc/FatalHandler/FatalHandlerComponentImpl.hpp>
+#include <Svc/QueueMonitor/QueueMonitor.hpp>
 #include <Drv/BlockDriver/BlockDriverImpl.hpp>
 
 extern Svc::RateGroupDriverImpl rateGroupDriverComp;
@@ -46,6 +47,7 @@ extern Svc::BufferManager fileUplinkBufferManager;
 extern Svc::AssertFatalAdapterComponentImpl fatalAdapter;
 extern Svc::FatalHandlerComponentImpl fatalHandler;
 extern Svc::HealthImpl health;
+extern Svc::QueueMonitor queueMonitor;
 
 extern Drv::BlockDriverImpl blockDrv;
 
@@ -183,6 +183,8 @@ Svc::FatalHandlerComponentImpl fatalHandler
 #endif
 ;
 
+Svc::QueueMonitor queueMonitor("queueMonitor");
+
 
 #if FW_OBJECT_REGISTRATION == 1
 
@@ -204,6 +206,10 @@ void constructApp(int port_number, char* hostname) {
     Fw::PortBase::setTrace(false);
 #endif    
 
+    // Queues register with the queue monitor when they are created,
+    // so it is initialized before the components that create them
+    queueMonitor.init(0);
+
     // Initialize rate group driver
     rateGroupDriverComp.init();
 
@@ -232,6 +238,8 @@ void constructApp(int port_number, char* hostname) {
     chanTlm.init(10,0);
 
     cmdDisp.init(20,0);
+    // ground commands go ahead of sequences
+    cmdDisp.setPortPriority(1,Svc::CommandDispatcherImpl::CMD_PRIORITY_HIGH);
 
     cmdSeq.init(10,0);
     cmdSeq.allocateBuffer(0,seqMallocator,5*1024);
@@ -271,11 +279,13 @@ void constructApp(int port_number, char* hostname) {
 	SG5.regCommands();
 	health.regCommands();
 	pingRcvr.regCommands();
+    chanTlm.regCommands();
 
     // read parameters
     prmDb.readParamFile();
     recvBuffComp.loadParameters();
     sendBuffComp.loadParameters();
+    chanTlm.loadParameters();
 
     // set health ping entries
 
@@ -8,6 +8,8 @@
 #include <Svc/ActiveLogger/ActiveLoggerImpl.hpp>
 #include <Fw/Types/Assert.hpp>
 #include <Os/File.hpp>
+#include <Fw/Com/ComPacket.hpp>
+#include <string.h>
 
 namespace Svc {
 
@@ -17,13 +19,17 @@ namespace Svc {
     ActiveLoggerImpl::ActiveLoggerImpl() :
         ActiveLoggerComponentBase()
 #endif
-    ,m_fatalHead(0)
-    ,m_warningHiHead(0)
-    ,m_warningLoHead(0)
-    ,m_commandHead(0)
-    ,m_activityHiHead(0)
-    ,m_activityLoHead(0)
-    ,m_diagnosticHead(0)
+    ,m_lanesPending(0)
+    ,m_batchMode(ALOG_BATCH_DEFAULT?BATCH_ENABLED:BATCH_DISABLED)
+    ,m_batchEvents(0)
+    ,m_numIds(0)
+    ,m_usedIdSlots(0)
+    ,m_persistEnabled(false)
+    ,m_persistWritePos(0)
+    ,m_persistSeq(1)
+    ,m_persistStageLen(0)
+    ,m_persistWindowStart(0)
+    ,m_persistWindowLen(0)
     {
         // set input filter defaults
         this->m_inFilterState[INPUT_WARNING_HI].enabled =
@@ -52,7 +58,20 @@ namespace Svc {
         this->m_sendFilterState[SEND_DIAGNOSTIC].enabled =
                 SEND_DIAGNOSTIC_DEFAULT?SEND_ENABLED:SEND_DISABLED;
 
-        memset(m_filteredIDs,0,sizeof(m_filteredIDs));
+        for (NATIVE_UINT_TYPE slot = 0; slot < ALOG_ID_TABLE_SLOTS; slot++) {
+            this->m_ids[slot].id = 0;
+            this->m_ids[slot].filtered = false;
+            this->m_ids[slot].throttle = ALOG_NO_THROTTLE;
+        }
+        memset(this->m_throttles,0,sizeof(this->m_throttles));
+        memset(this->m_reportedDrops,0,sizeof(this->m_reportedDrops));
+
+        this->m_lanes[ALOG_LANE_FATAL].setup(this->m_fatalLane,FW_NUM_ARRAY_ELEMENTS(this->m_fatalLane));
+        this->m_lanes[ALOG_LANE_HIGH].setup(this->m_highLane,FW_NUM_ARRAY_ELEMENTS(this->m_highLane));
+        this->m_lanes[ALOG_LANE_MID].setup(this->m_midLane,FW_NUM_ARRAY_ELEMENTS(this->m_midLane));
+        this->m_lanes[ALOG_LANE_LOW].setup(this->m_lowLane,FW_NUM_ARRAY_ELEMENTS(this->m_lowLane));
+
+        this->initHistories();
 
     }
 
@@ -71,56 +90,90 @@ namespace Svc {
         // make sure ID is not zero. Zero is reserved for ID filter.
         FW_ASSERT(id != 0);
 
+        NATIVE_UINT_TYPE lane = ALOG_LANE_LOW;
         switch (severity) {
             case Fw::LOG_FATAL: // always pass FATAL
+                lane = ALOG_LANE_FATAL;
                 break;
             case Fw::LOG_WARNING_HI:
                 if (this->m_inFilterState[INPUT_WARNING_HI].enabled == INPUT_DISABLED) {
                    return;
                 }
+                lane = ALOG_LANE_HIGH;
                 break;
             case Fw::LOG_WARNING_LO:
                 if (this->m_inFilterState[INPUT_WARNING_LO].enabled == INPUT_DISABLED) {
                     return;
                 }
+                lane = ALOG_LANE_MID;
                 break;
             case Fw::LOG_COMMAND:
                 if (this->m_inFilterState[INPUT_COMMAND].enabled == INPUT_DISABLED) {
                     return;
                 }
+                lane = ALOG_LANE_MID;
                 break;
             case Fw::LOG_ACTIVITY_HI:
                 if (this->m_inFilterState[INPUT_ACTIVITY_HI].enabled == INPUT_DISABLED) {
                     return;
                 }
+                lane = ALOG_LANE_MID;
                 break;
             case Fw::LOG_ACTIVITY_LO:
                 if (this->m_inFilterState[INPUT_ACTIVITY_LO].enabled == INPUT_DISABLED) {
                     return;
                 }
+                lane = ALOG_LANE_LOW;
                 break;
             case Fw::LOG_DIAGNOSTIC:
                 if (this->m_inFilterState[INPUT_DIAGNOSTIC].enabled == INPUT_DISABLED) {
                     return;
                 }
+                lane = ALOG_LANE_LOW;
                 break;
             default:
                 FW_ASSERT(0,static_cast<NATIVE_INT_TYPE>(severity));
                 return;
         }
 
-        // check ID filters
-        for (NATIVE_INT_TYPE entry = 0; entry < TELEM_ID_FILTER_SIZE; entry++) {
-            if (
-              (m_filteredIDs[entry] == id) &&
-              (severity != Fw::LOG_FATAL)
-              ) {
-                return;
+        // check ID filters and throttles. FATAL always passes.
+        if (severity != Fw::LOG_FATAL) {
+            NATIVE_INT_TYPE slot = this->findId(id);
+            if (slot != ALOG_NO_ID) {
+                if (this->m_ids[slot].filtered) {
+                    return;
+                }
+                NATIVE_INT_TYPE throttle = this->m_ids[slot].throttle;
+                if (throttle != ALOG_NO_THROTTLE) {
+                    U32 suppressed = 0;
+                    if (not this->throttleEvent(throttle,timeTag,suppressed)) {
+                        return;
+                    }
+                    // first event through after a burst was dropped
+                    if (suppressed != 0) {
+                        this->log_WARNING_LO_ALOG_ID_EVENTS_SUPPRESSED(id,suppressed);
+                    }
+                }
             }
         }
 
-        // send event to the logger thread
-        this->loqQueue_internalInterfaceInvoke(id,timeTag,static_cast<QueueLogSeverity>(severity),args);
+        // put event in its lane and wake up the logger thread. One message covers
+        // every event put in the lanes until the thread empties them.
+        if (this->putLane(lane,id,timeTag,severity,args)) {
+            if (__sync_bool_compare_and_swap(&this->m_lanesPending,0,1)) {
+                NATIVE_INT_TYPE dropped = this->getNumMsgsDropped();
+                this->laneReady_internalInterfaceInvoke(lane);
+                // the queue was full and the message was dropped, so let the next
+                // event send another one. Run also empties the lanes, which covers
+                // a drop that wasn't seen here.
+                if (this->getNumMsgsDropped() != dropped) {
+                    this->m_lanesPending = 0;
+                }
+            }
+        } else if (Fw::LOG_FATAL == severity) {
+            // a FATAL is never dropped. The lane only fills if the logger thread is stuck.
+            FW_ASSERT(0,id);
+        }
 
         // if connected, announce the FATAL
         if (Fw::LOG_FATAL == severity) {
@@ -130,7 +183,87 @@ namespace Svc {
         }
     }
 
-    void ActiveLoggerImpl::loqQueue_internalInterfaceHandler(FwEventIdType id, Fw::Time &timeTag, QueueLogSeverity severity, Fw::LogBuffer &args) {
+    void ActiveLoggerImpl::laneReady_internalInterfaceHandler(U32 lane) {
+        FW_ASSERT(lane < ALOG_NUM_LANES,lane);
+        this->drainLanes();
+    }
+
+    bool ActiveLoggerImpl::putLane(NATIVE_UINT_TYPE lane, FwEventIdType id, Fw::Time& timeTag, Fw::LogSeverity severity, Fw::LogBuffer& args) {
+
+        FW_ASSERT(lane < ALOG_NUM_LANES,lane);
+
+        // no entry means the lane is full. The ring counts the drop.
+        U32 pos;
+        LaneEntry* entry = this->m_lanes[lane].claim(pos);
+        if (0 == entry) {
+            return false;
+        }
+
+        entry->id = id;
+        entry->timeTag = timeTag;
+        entry->severity = severity;
+        entry->args = args;
+        this->m_lanes[lane].publish(pos);
+        return true;
+    }
+
+    bool ActiveLoggerImpl::takeLane(NATIVE_UINT_TYPE lane) {
+
+        FW_ASSERT(lane < ALOG_NUM_LANES,lane);
+
+        // empty, or the caller that claimed it hasn't finished. That caller sends a message when done.
+        LaneEntry* entry = this->m_lanes[lane].front();
+        if (0 == entry) {
+            return false;
+        }
+
+        this->storeEvent(entry->id,entry->timeTag,entry->severity,entry->args);
+        this->m_lanes[lane].pop();
+        return true;
+    }
+
+    void ActiveLoggerImpl::drainLanes(void) {
+
+        // clear first, so an event put in a lane after this sends another message
+        this->m_lanesPending = 0;
+        __sync_synchronize();
+
+        // take one event at a time from the highest lane that has one, so
+        // higher severities put in while draining go ahead of lower ones
+        bool stored = true;
+        while (stored) {
+            stored = false;
+            for (NATIVE_UINT_TYPE lane = 0; lane < ALOG_NUM_LANES; lane++) {
+                if (this->takeLane(lane)) {
+                    stored = true;
+                    break;
+                }
+            }
+        }
+
+        this->writeLaneTlm();
+    }
+
+    void ActiveLoggerImpl::writeLaneTlm(void) {
+        this->tlmWrite_ALOG_HIGH_LANE_HWM(this->m_lanes[ALOG_LANE_HIGH].getHighWater());
+        this->tlmWrite_ALOG_MID_LANE_HWM(this->m_lanes[ALOG_LANE_MID].getHighWater());
+        this->tlmWrite_ALOG_LOW_LANE_HWM(this->m_lanes[ALOG_LANE_LOW].getHighWater());
+        this->tlmWrite_ALOG_HIGH_LANE_DROPS(this->m_lanes[ALOG_LANE_HIGH].getOverflows());
+        this->tlmWrite_ALOG_MID_LANE_DROPS(this->m_lanes[ALOG_LANE_MID].getOverflows());
+        this->tlmWrite_ALOG_LOW_LANE_DROPS(this->m_lanes[ALOG_LANE_LOW].getOverflows());
+    }
+
+    void ActiveLoggerImpl::reportLaneDrops(void) {
+        for (NATIVE_UINT_TYPE lane = 0; lane < ALOG_NUM_LANES; lane++) {
+            U32 drops = this->m_lanes[lane].getOverflows();
+            if (drops != this->m_reportedDrops[lane]) {
+                this->log_WARNING_HI_ALOG_LANE_OVERFLOW(lane,drops - this->m_reportedDrops[lane]);
+                this->m_reportedDrops[lane] = drops;
+            }
+        }
+    }
+
+    void ActiveLoggerImpl::storeEvent(FwEventIdType id, Fw::Time &timeTag, Fw::LogSeverity severity, Fw::LogBuffer &args) {
 
         // Serialize event
         this->m_logPacket.setId(id);
@@ -140,49 +273,45 @@ namespace Svc {
         Fw::SerializeStatus stat = this->m_logPacket.serialize(this->m_comBuffer);
         FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,static_cast<NATIVE_INT_TYPE>(stat));
 
+        // a FATAL is written to the ring right away, since a reset may follow
+        this->persistEvent(Fw::LOG_FATAL == severity);
+
         switch (severity) {
-            case QUEUE_LOG_FATAL: // always pass FATAL
-                this->m_fatalCb[this->m_fatalHead] = this->m_comBuffer;
-                this->m_fatalHead = (this->m_fatalHead + 1)%FW_NUM_ARRAY_ELEMENTS(this->m_fatalCb);
+            case Fw::LOG_FATAL: // always pass FATAL
+                this->storeHistory(ALOG_HISTORY_FATAL,this->m_comBuffer);
                 break;
-            case QUEUE_LOG_WARNING_HI:
-                this->m_warningHiCb[this->m_warningHiHead] = this->m_comBuffer;
-                this->m_warningHiHead = (this->m_warningHiHead + 1)%FW_NUM_ARRAY_ELEMENTS(this->m_warningHiCb);
+            case Fw::LOG_WARNING_HI:
+                this->storeHistory(ALOG_HISTORY_WARNING_HI,this->m_comBuffer);
                 if (this->m_sendFilterState[SEND_WARNING_HI].enabled == SEND_DISABLED) {
                    return;
                 }
                 break;
-            case QUEUE_LOG_WARNING_LO:
-                this->m_warningLoCb[this->m_warningLoHead] = this->m_comBuffer;
-                this->m_warningLoHead = (this->m_warningLoHead + 1)%FW_NUM_ARRAY_ELEMENTS(this->m_warningLoCb);
+            case Fw::LOG_WARNING_LO:
+                this->storeHistory(ALOG_HISTORY_WARNING_LO,this->m_comBuffer);
                 if (this->m_sendFilterState[SEND_WARNING_LO].enabled == SEND_DISABLED) {
                     return;
                 }
                 break;
-            case QUEUE_LOG_COMMAND:
-                this->m_commandCb[this->m_commandHead] = this->m_comBuffer;
-                this->m_commandHead = (this->m_commandHead + 1)%FW_NUM_ARRAY_ELEMENTS(this->m_commandCb);
+            case Fw::LOG_COMMAND:
+                this->storeHistory(ALOG_HISTORY_COMMAND,this->m_comBuffer);
                 if (this->m_sendFilterState[SEND_COMMAND].enabled == SEND_DISABLED) {
                     return;
                 }
                 break;
-            case QUEUE_LOG_ACTIVITY_HI:
-                this->m_activityHiCb[this->m_activityHiHead] = this->m_comBuffer;
-                this->m_activityHiHead = (this->m_activityHiHead + 1)%FW_NUM_ARRAY_ELEMENTS(this->m_activityHiCb);
+            case Fw::LOG_ACTIVITY_HI:
+                this->storeHistory(ALOG_HISTORY_ACTIVITY_HI,this->m_comBuffer);
                 if (this->m_sendFilterState[SEND_ACTIVITY_HI].enabled == SEND_DISABLED) {
                     return;
                 }
                 break;
-            case QUEUE_LOG_ACTIVITY_LO:
-                this->m_activityLoCb[this->m_activityLoHead] = this->m_comBuffer;
-                this->m_activityLoHead = (this->m_activityLoHead + 1)%FW_NUM_ARRAY_ELEMENTS(this->m_activityLoCb);
+            case Fw::LOG_ACTIVITY_LO:
+                this->storeHistory(ALOG_HISTORY_ACTIVITY_LO,this->m_comBuffer);
                 if (this->m_sendFilterState[SEND_ACTIVITY_LO].enabled == SEND_DISABLED) {
                     return;
                 }
                 break;
-            case QUEUE_LOG_DIAGNOSTIC:
-                this->m_diagnosticCb[this->m_diagnosticHead] = this->m_comBuffer;
-                this->m_diagnosticHead = (this->m_diagnosticHead + 1)%FW_NUM_ARRAY_ELEMENTS(this->m_diagnosticCb);
+            case Fw::LOG_DIAGNOSTIC:
+                this->storeHistory(ALOG_HISTORY_DIAGNOSTIC,this->m_comBuffer);
                 if (this->m_sendFilterState[SEND_DIAGNOSTIC].enabled == SEND_DISABLED) {
                     return;
                 }
@@ -192,9 +321,175 @@ namespace Svc {
                 return;
         }
 
-        if (this->isConnected_PktSend_OutputPort(0)) {
+        // the most severe events aren't held in a batch
+        this->sendEvent((Fw::LOG_FATAL == severity) or (Fw::LOG_WARNING_HI == severity));
+    }
+
+    void ActiveLoggerImpl::initHistories(void) {
+
+        static const struct {
+            U32 arenaSize;
+            U32 depth;
+        } sizes[ALOG_NUM_HISTORIES] = {
+            {FATAL_EVENT_HISTORY_BYTES,FATAL_EVENT_CB_DEPTH},
+            {WARNING_HI_EVENT_HISTORY_BYTES,WARNING_HI_EVENT_CB_DEPTH},
+            {WARNING_LO_EVENT_HISTORY_BYTES,WARNING_LO_EVENT_CB_DEPTH},
+            {COMMAND_EVENT_HISTORY_BYTES,COMMAND_EVENT_CB_DEPTH},
+            {ACTIVITY_HI_EVENT_HISTORY_BYTES,ACTIVITY_HI_EVENT_CB_DEPTH},
+            {ACTIVITY_LO_EVENT_HISTORY_BYTES,ACTIVITY_LO_EVENT_CB_DEPTH},
+            {DIAGNOSTIC_EVENT_HISTORY_BYTES,DIAGNOSTIC_EVENT_CB_DEPTH}
+        };
+
+        U32 arenaOffset = 0;
+        U32 recordOffset = 0;
+        for (NATIVE_UINT_TYPE history = 0; history < ALOG_NUM_HISTORIES; history++) {
+            // any event has to fit, and offsets have to fit in a record
+            FW_ASSERT(sizes[history].arenaSize >= FW_COM_BUFFER_MAX_SIZE,history,sizes[history].arenaSize);
+            FW_ASSERT(sizes[history].arenaSize <= 0xFFFF,history,sizes[history].arenaSize);
+            FW_ASSERT(sizes[history].depth > 0,history);
+
+            History& h = this->m_history[history];
+            h.arena = &this->m_historyArena[arenaOffset];
+            h.arenaSize = sizes[history].arenaSize;
+            h.records = &this->m_historyRecords[recordOffset];
+            h.depth = sizes[history].depth;
+            h.first = 0;
+            h.count = 0;
+            h.tail = 0;
+            arenaOffset += h.arenaSize;
+            recordOffset += h.depth;
+        }
+        FW_ASSERT(arenaOffset == sizeof(this->m_historyArena),arenaOffset);
+        FW_ASSERT(recordOffset == FW_NUM_ARRAY_ELEMENTS(this->m_historyRecords),recordOffset);
+    }
+
+    void ActiveLoggerImpl::storeHistory(NATIVE_UINT_TYPE history, const Fw::ComBuffer& event) {
+
+        FW_ASSERT(history < ALOG_NUM_HISTORIES,history);
+        History& h = this->m_history[history];
+        U32 size = event.getBuffLength();
+        FW_ASSERT(size <= h.arenaSize,size,h.arenaSize);
+
+        if (h.count == h.depth) {
+            this->dropOldestHistory(history);
+        }
+
+        // records aren't split, so if it doesn't fit at the end start over at the
+        // beginning. Records left past the tail are the oldest, so they go first.
+        U32 start = h.tail;
+        if (start + size > h.arenaSize) {
+            while ((h.count > 0) and (h.records[h.first].offset >= h.tail)) {
+                this->dropOldestHistory(history);
+            }
+            start = 0;
+        }
+        // remove the oldest records until the new one has room
+        while (h.count > 0) {
+            const HistoryRecord& oldest = h.records[h.first];
+            if ((oldest.offset >= start + size) or (oldest.offset + oldest.size <= start)) {
+                break;
+            }
+            this->dropOldestHistory(history);
+        }
+
+        (void)memcpy(&h.arena[start],event.getBuffAddr(),size);
+        HistoryRecord& rec = h.records[(h.first + h.count) % h.depth];
+        rec.offset = static_cast<U16>(start);
+        rec.size = static_cast<U16>(size);
+        h.count++;
+        h.tail = start + size;
+    }
+
+    void ActiveLoggerImpl::dropOldestHistory(NATIVE_UINT_TYPE history) {
+
+        FW_ASSERT(history < ALOG_NUM_HISTORIES,history);
+        History& h = this->m_history[history];
+        FW_ASSERT(h.count > 0,history);
+        h.first = (h.first + 1) % h.depth;
+        h.count--;
+    }
+
+    void ActiveLoggerImpl::sendEvent(bool flushNow) {
+
+        if (not this->isConnected_PktSend_OutputPort(0)) {
+            return;
+        }
+
+        if (BATCH_DISABLED == this->m_batchMode) {
             this->PktSend_out(0, this->m_comBuffer,0);
+            return;
+        }
+
+        // each event is its 32-bit length followed by the log packet
+        U32 eventSize = this->m_comBuffer.getBuffLength();
+        NATIVE_UINT_TYPE recordSize = sizeof(eventSize) + eventSize;
+        if (recordSize > this->m_batchBuffer.getBuffCapacity() - this->m_batchBuffer.getBuffLength()) {
+            this->flushBatch();
+        }
+        if (0 == this->m_batchEvents) {
+            this->m_batchBuffer.resetSer();
+            FwPacketDescriptorType desc = Fw::ComPacket::FW_PACKET_LOG_BATCH;
+            Fw::SerializeStatus stat = this->m_batchBuffer.serialize(desc);
+            FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,static_cast<NATIVE_INT_TYPE>(stat));
+            // an event too big for a batch is sent by itself
+            if (recordSize > this->m_batchBuffer.getBuffCapacity() - this->m_batchBuffer.getBuffLength()) {
+                this->PktSend_out(0, this->m_comBuffer,0);
+                return;
+            }
+        }
+
+        Fw::SerializeStatus stat = this->m_batchBuffer.serialize(eventSize);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,static_cast<NATIVE_INT_TYPE>(stat));
+        stat = this->m_batchBuffer.serialize(this->m_comBuffer.getBuffAddr(),eventSize,true);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,static_cast<NATIVE_INT_TYPE>(stat));
+        this->m_batchEvents++;
+
+        if (flushNow) {
+            this->flushBatch();
+        }
+    }
+
+    void ActiveLoggerImpl::flushBatch(void) {
+
+        if (0 == this->m_batchEvents) {
+            return;
+        }
+        if (this->isConnected_PktSend_OutputPort(0)) {
+            this->PktSend_out(0, this->m_batchBuffer,0);
         }
+        this->m_batchBuffer.resetSer();
+        this->m_batchEvents = 0;
+    }
+
+    void ActiveLoggerImpl::Run_handler(NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+        // pick up anything left if a laneReady message was dropped
+        this->drainLanes();
+        this->reportLaneDrops();
+        this->reportSuppressed(this->getTime());
+        this->flushPersist();
+        this->flushBatch();
+    }
+
+    void ActiveLoggerImpl::ALOG_SET_BATCH_MODE_cmdHandler(
+            FwOpcodeType opCode, //!< The opcode
+            U32 cmdSeq, //!< The command sequence number
+            BatchModeEnabled BatchEnable //!< Batch mode state
+        ) {
+
+        // check parameter
+        switch (BatchEnable) {
+            case BATCH_ENABLED:
+            case BATCH_DISABLED:
+                break;
+            default:
+                this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_VALIDATION_ERROR);
+                return;
+        }
+
+        // send anything held so events stay in order
+        this->flushBatch();
+        this->m_batchMode = BatchEnable;
+        this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
     }
 
     void ActiveLoggerImpl::ALOG_SET_EVENT_REPORT_FILTER_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, InputFilterLevel FilterLevel, InputFilterEnabled FilterEnable) {
@@ -234,217 +529,49 @@ namespace Svc {
             return;
         }
 
+        // file write error reported for each severity
+        static const struct {
+            LogWriteError delimiter;
+            LogWriteError record;
+        } writeErrors[ALOG_NUM_HISTORIES] = {
+            {LOG_WRITE_FATAL_DELIMETER,LOG_WRITE_FATAL_RECORD},
+            {LOG_WRITE_WARNING_HI_DELIMETER,LOG_WRITE_WARNING_HI_RECORD},
+            {LOG_WRITE_WARNING_LO_DELIMETER,LOG_WRITE_WARNING_LO_RECORD},
+            {LOG_WRITE_COMMAND_DELIMETER,LOG_WRITE_COMMAND_RECORD},
+            {LOG_WRITE_ACTIVITY_HI_DELIMETER,LOG_WRITE_ACTIVITY_HI_RECORD},
+            {LOG_WRITE_ACTIVITY_LO_DELIMETER,LOG_WRITE_ACTIVITY_LO_RECORD},
+            {LOG_WRITE_DIAGNOSTIC_DELIMETER,LOG_WRITE_DIAGNOSTIC_RECORD}
+        };
+
         NATIVE_UINT_TYPE numRecords = 0;
 
         NATIVE_INT_TYPE fileWriteSize;
-        // write FATAL
-        for (NATIVE_UINT_TYPE entry = 0; entry < FW_NUM_ARRAY_ELEMENTS(this->m_fatalCb); entry++) {
-
-            // if there is data, write it
-            if (this->m_fatalCb[entry].getBuffLength() != 0) {
-                // write delimiter
-                fileWriteSize = sizeof(delimiter);
-                stat = file.write(&delimiter,fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_FATAL_DELIMETER,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-
-                // write event record
-                fileWriteSize = this->m_fatalCb[entry].getBuffLength();
-                stat = file.write(this->m_fatalCb[entry].getBuffAddr(),fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_FATAL_RECORD,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-                numRecords++;
-            } else {
-                // if the entry is empty, that means it is only a partially filled list, so quit writing
-                break;
-            }
-        }
-
-        // write WARNING HI
-        for (NATIVE_UINT_TYPE entry = 0; entry < FW_NUM_ARRAY_ELEMENTS(this->m_warningHiCb); entry++) {
-            // if there is data, write it
-            if (this->m_warningHiCb[entry].getBuffLength() != 0) {
-                // write delimiter
-                fileWriteSize = sizeof(delimiter);
-                stat = file.write(&delimiter,fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_WARNING_HI_DELIMETER,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-
-                // write event record
-                fileWriteSize = this->m_warningHiCb[entry].getBuffLength();
-                stat = file.write(this->m_warningHiCb[entry].getBuffAddr(),fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_WARNING_HI_RECORD,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-                numRecords++;
-            } else {
-                // if the entry is empty, that means it is only a partially filled list, so quit writing
-                break;
-            }
-        }
-
-        // write WARNING LO
-        for (NATIVE_UINT_TYPE entry = 0; entry < FW_NUM_ARRAY_ELEMENTS(this->m_warningLoCb); entry++) {
-            // if there is data, write it
-            if (this->m_warningLoCb[entry].getBuffLength() != 0) {
-                // write delimiter
-                fileWriteSize = sizeof(delimiter);
-                stat = file.write(&delimiter,fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_WARNING_LO_DELIMETER,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-
-                // write event record
-                fileWriteSize = this->m_warningLoCb[entry].getBuffLength();
-                stat = file.write(this->m_warningLoCb[entry].getBuffAddr(),fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_WARNING_LO_RECORD,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-                numRecords++;
-            } else {
-                // if the entry is empty, that means it is only a partially filled list, so quit writing
-                break;
-            }
-        }
-
-        // write COMMAND
-        for (NATIVE_UINT_TYPE entry = 0; entry < FW_NUM_ARRAY_ELEMENTS(this->m_commandCb); entry++) {
-            // if there is data, write it
-            if (this->m_commandCb[entry].getBuffLength() != 0) {
-                // write delimiter
-                fileWriteSize = sizeof(delimiter);
-                stat = file.write(&delimiter,fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_COMMAND_DELIMETER,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-
-                // write event record
-                fileWriteSize = this->m_commandCb[entry].getBuffLength();
-                stat = file.write(this->m_commandCb[entry].getBuffAddr(),fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_COMMAND_RECORD,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-                numRecords++;
-            } else {
-                // if the entry is empty, that means it is only a partially filled list, so quit writing
-                break;
-            }
-        }
-
-        // write ACTIVITY HI
-        for (NATIVE_UINT_TYPE entry = 0; entry < FW_NUM_ARRAY_ELEMENTS(this->m_activityHiCb); entry++) {
-            // if there is data, write it
-            if (this->m_activityHiCb[entry].getBuffLength() != 0) {
-                // write delimiter
-                fileWriteSize = sizeof(delimiter);
-                stat = file.write(&delimiter,fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_ACTIVITY_HI_DELIMETER,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-
-                // write event record
-                fileWriteSize = this->m_activityHiCb[entry].getBuffLength();
-                stat = file.write(this->m_activityHiCb[entry].getBuffAddr(),fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_ACTIVITY_HI_RECORD,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-                numRecords++;
-            } else {
-                // if the entry is empty, that means it is only a partially filled list, so quit writing
-                break;
-            }
-        }
-
-        // write ACTIVITY LO
-        for (NATIVE_UINT_TYPE entry = 0; entry < FW_NUM_ARRAY_ELEMENTS(this->m_activityLoCb); entry++) {
-            // if there is data, write it
-            if (this->m_activityLoCb[entry].getBuffLength() != 0) {
-                // write delimiter
-                fileWriteSize = sizeof(delimiter);
-                stat = file.write(&delimiter,fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_ACTIVITY_LO_DELIMETER,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
+        // write each severity, oldest event first
+        for (NATIVE_UINT_TYPE history = 0; history < ALOG_NUM_HISTORIES; history++) {
+            const History& h = this->m_history[history];
+            for (U32 record = 0; record < h.count; record++) {
+                const HistoryRecord& rec = h.records[(h.first + record) % h.depth];
 
-                // write event record
-                fileWriteSize = this->m_activityLoCb[entry].getBuffLength();
-                stat = file.write(this->m_activityLoCb[entry].getBuffAddr(),fileWriteSize);
-                if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_ACTIVITY_LO_RECORD,stat);
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
-                    file.close();
-                    return;
-                }
-                numRecords++;
-            } else {
-                // if the entry is empty, that means it is only a partially filled list, so quit writing
-                break;
-            }
-        }
-
-        // write DIAGNOSTIC
-        for (NATIVE_UINT_TYPE entry = 0; entry < FW_NUM_ARRAY_ELEMENTS(this->m_diagnosticCb); entry++) {
-            // if there is data, write it
-            if (this->m_diagnosticCb[entry].getBuffLength() != 0) {
                 // write delimiter
                 fileWriteSize = sizeof(delimiter);
                 stat = file.write(&delimiter,fileWriteSize);
                 if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_DIAGNOSTIC_DELIMETER,stat);
+                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(writeErrors[history].delimiter,stat);
                     this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
                     file.close();
                     return;
                 }
 
                 // write event record
-                fileWriteSize = this->m_diagnosticCb[entry].getBuffLength();
-                stat = file.write(this->m_diagnosticCb[entry].getBuffAddr(),fileWriteSize);
+                fileWriteSize = rec.size;
+                stat = file.write(&h.arena[rec.offset],fileWriteSize);
                 if (stat != Os::File::OP_OK) {
-                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_DIAGNOSTIC_RECORD,stat);
+                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(writeErrors[history].record,stat);
                     this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
                     file.close();
                     return;
                 }
                 numRecords++;
-            } else {
-                // if the entry is empty, that means it is only a partially filled list, so quit writing
-                break;
             }
         }
 
@@ -472,40 +599,34 @@ namespace Svc {
                 return;
         }
 
+        // zero is reserved for empty table slots, and can't be sent as an event anyway
+        if (0 == ID) {
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_VALIDATION_ERROR);
+            return;
+        }
+
         if (ID_ENABLED == IdFilterEnable) { // add ID
-            // search list for existing entry
-            for (NATIVE_INT_TYPE entry = 0; entry < TELEM_ID_FILTER_SIZE; entry++) {
-                if (this->m_filteredIDs[entry] == ID) {
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
-                    this->log_ACTIVITY_HI_ALOG_ID_FILTER_ENABLED(ID);
-                    return;
-                }
-            }
-            // if not already a match, search for an open slot
-            for (NATIVE_INT_TYPE entry = 0; entry < TELEM_ID_FILTER_SIZE; entry++) {
-                if (this->m_filteredIDs[entry] == 0) {
-                    this->m_filteredIDs[entry] = ID;
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
-                    this->log_ACTIVITY_HI_ALOG_ID_FILTER_ENABLED(ID);
-                    return;
-                }
+            NATIVE_INT_TYPE slot = this->claimId(ID);
+            if (ALOG_NO_ID == slot) {
+                // if an empty slot was not found, send an error event
+                this->log_WARNING_LO_ALOG_ID_FILTER_LIST_FULL(ID);
+                this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+                return;
             }
-            // if an empty slot was not found, send an error event
-            this->log_WARNING_LO_ALOG_ID_FILTER_LIST_FULL(ID);
-            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+            this->m_ids[slot].filtered = true;
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
+            this->log_ACTIVITY_HI_ALOG_ID_FILTER_ENABLED(ID);
         } else { // remove ID
-            // search list for existing entry
-            for (NATIVE_INT_TYPE entry = 0; entry < TELEM_ID_FILTER_SIZE; entry++) {
-                if (this->m_filteredIDs[entry] == ID) {
-                    this->m_filteredIDs[entry] = 0; // zero entry
-                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
-                    this->log_ACTIVITY_HI_ALOG_ID_FILTER_REMOVED(ID);
-                    return;
-                }
+            NATIVE_INT_TYPE slot = this->findId(ID);
+            if ((ALOG_NO_ID == slot) or (not this->m_ids[slot].filtered)) {
+                this->log_WARNING_LO_ALOG_ID_FILTER_NOT_FOUND(ID);
+                this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+                return;
             }
-            // if it gets here, wasn't found
-            this->log_WARNING_LO_ALOG_ID_FILTER_NOT_FOUND(ID);
-            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+            this->m_ids[slot].filtered = false;
+            this->releaseId(slot);
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
+            this->log_ACTIVITY_HI_ALOG_ID_FILTER_REMOVED(ID);
         }
 
     }
@@ -524,14 +645,308 @@ namespace Svc {
                     );
         }
 
-        // iterate through ID filter
-        for (NATIVE_INT_TYPE entry = 0; entry < TELEM_ID_FILTER_SIZE; entry++) {
-            if (this->m_filteredIDs[entry] != 0) {
-                this->log_ACTIVITY_HI_ALOG_ID_FILTER_ENABLED(this->m_filteredIDs[entry]);
+        // iterate through ID filters and throttles
+        for (NATIVE_UINT_TYPE slot = 0; slot < ALOG_ID_TABLE_SLOTS; slot++) {
+            if (this->m_ids[slot].filtered) {
+                this->log_ACTIVITY_HI_ALOG_ID_FILTER_ENABLED(this->m_ids[slot].id);
+            }
+        }
+        for (NATIVE_UINT_TYPE throttle = 0; throttle < ALOG_MAX_THROTTLES; throttle++) {
+            const Throttle& bucket = this->m_throttles[throttle];
+            if (bucket.id != 0) {
+                this->log_ACTIVITY_HI_ALOG_ID_THROTTLE_SET(bucket.id,bucket.maxEvents,bucket.windowMs);
+            }
+        }
+
+        this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
+    }
+
+    void ActiveLoggerImpl::ALOG_SET_ID_THROTTLE_cmdHandler(
+            FwOpcodeType opCode, //!< The opcode
+            U32 cmdSeq, //!< The command sequence number
+            U32 ID, //!< ID to throttle
+            U32 MaxEvents, //!< events allowed in a window. 0 removes the throttle
+            U32 WindowMs //!< window length in milliseconds
+        ) {
+
+        if (0 == ID) {
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_VALIDATION_ERROR);
+            return;
+        }
+
+        if (0 == MaxEvents) { // remove throttle
+            NATIVE_INT_TYPE slot = this->findId(ID);
+            if ((ALOG_NO_ID == slot) or (ALOG_NO_THROTTLE == this->m_ids[slot].throttle)) {
+                this->log_WARNING_LO_ALOG_ID_FILTER_NOT_FOUND(ID);
+                this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+                return;
+            }
+            Throttle& bucket = this->m_throttles[this->m_ids[slot].throttle];
+            this->m_ids[slot].throttle = ALOG_NO_THROTTLE;
+            this->releaseId(slot);
+            // report what was dropped since the last event passed
+            U32 suppressed = bucket.suppressed;
+            bucket.id = 0;
+            if (suppressed != 0) {
+                this->log_WARNING_LO_ALOG_ID_EVENTS_SUPPRESSED(ID,suppressed);
+            }
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
+            this->log_ACTIVITY_HI_ALOG_ID_THROTTLE_REMOVED(ID);
+            return;
+        }
+
+        // each event must cost at least a microsecond of the window
+        if (  (0 == WindowMs) or
+              (WindowMs > ALOG_MAX_THROTTLE_WINDOW_MS) or
+              (MaxEvents > WindowMs*1000)) {
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_VALIDATION_ERROR);
+            return;
+        }
+
+        NATIVE_INT_TYPE slot = this->claimId(ID);
+        if (ALOG_NO_ID == slot) {
+            this->log_WARNING_LO_ALOG_ID_THROTTLE_LIST_FULL(ID);
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+            return;
+        }
+
+        NATIVE_INT_TYPE throttle = this->m_ids[slot].throttle;
+        if (ALOG_NO_THROTTLE == throttle) {
+            for (NATIVE_INT_TYPE entry = 0; entry < ALOG_MAX_THROTTLES; entry++) {
+                if (0 == this->m_throttles[entry].id) {
+                    throttle = entry;
+                    break;
+                }
+            }
+            if (ALOG_NO_THROTTLE == throttle) {
+                this->releaseId(slot);
+                this->log_WARNING_LO_ALOG_ID_THROTTLE_LIST_FULL(ID);
+                this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+                return;
             }
         }
 
+        // A caller could be in the bucket. The fields are single words, so at
+        // worst one event is checked against the old setting.
+        Throttle& bucket = this->m_throttles[throttle];
+        bucket.id = ID;
+        bucket.maxEvents = MaxEvents;
+        bucket.windowMs = WindowMs;
+        bucket.windowUs = WindowMs*1000;
+        bucket.costUs = bucket.windowUs/MaxEvents;
+        bucket.started = false;
+        bucket.suppressed = 0;
+        __sync_synchronize();
+        this->m_ids[slot].throttle = throttle;
+
         this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
+        this->log_ACTIVITY_HI_ALOG_ID_THROTTLE_SET(ID,MaxEvents,WindowMs);
+    }
+
+    bool ActiveLoggerImpl::throttleEvent(NATIVE_INT_TYPE throttle, const Fw::Time& timeTag, U32& suppressed) {
+
+        FW_ASSERT((throttle >= 0) and (throttle < ALOG_MAX_THROTTLES),throttle);
+        Throttle& bucket = this->m_throttles[throttle];
+
+        // if another caller is updating the bucket, let the event through rather than wait
+        if (not __sync_bool_compare_and_swap(&bucket.busy,0,1)) {
+            return true;
+        }
+
+        U32 seconds = timeTag.getSeconds();
+        U32 useconds = timeTag.getUSeconds();
+
+        if (not bucket.started) {
+            // start with a full bucket
+            bucket.creditUs = bucket.windowUs;
+            bucket.started = true;
+        } else if ((seconds > bucket.lastSeconds) or
+                  ((seconds == bucket.lastSeconds) and (useconds > bucket.lastUSeconds))) {
+            // refill with the time since the last event. Time going backwards adds nothing.
+            U32 elapsedSeconds = seconds - bucket.lastSeconds;
+            U32 elapsedUs = bucket.windowUs;
+            if (elapsedSeconds <= bucket.windowUs/1000000) {
+                elapsedUs = elapsedSeconds*1000000 + useconds - bucket.lastUSeconds;
+            }
+            bucket.creditUs = FW_MIN(bucket.windowUs,bucket.creditUs + FW_MIN(elapsedUs,bucket.windowUs));
+        }
+        bucket.lastSeconds = seconds;
+        bucket.lastUSeconds = useconds;
+
+        bool pass = (bucket.creditUs >= bucket.costUs);
+        if (pass) {
+            bucket.creditUs -= bucket.costUs;
+            suppressed = bucket.suppressed;
+            bucket.suppressed = 0;
+        } else {
+            if (0 == bucket.suppressed) {
+                // start of a burst; Run reports it once a window has passed
+                bucket.suppressedSeconds = seconds;
+                bucket.suppressedUSeconds = useconds;
+            }
+            bucket.suppressed++;
+        }
+
+        __sync_synchronize();
+        bucket.busy = 0;
+
+        return pass;
+    }
+
+    void ActiveLoggerImpl::reportSuppressed(const Fw::Time& now) {
+
+        U32 seconds = now.getSeconds();
+        U32 useconds = now.getUSeconds();
+
+        for (NATIVE_UINT_TYPE throttle = 0; throttle < ALOG_MAX_THROTTLES; throttle++) {
+            Throttle& bucket = this->m_throttles[throttle];
+            if ((0 == bucket.id) or (0 == bucket.suppressed)) {
+                continue;
+            }
+            // a caller is in the bucket, so check again on the next Run
+            if (not __sync_bool_compare_and_swap(&bucket.busy,0,1)) {
+                continue;
+            }
+
+            // report a burst once a window has passed since its first dropped
+            // event, so it isn't held until the next event with the ID passes
+            FwEventIdType id = bucket.id;
+            U32 suppressed = 0;
+            if ((bucket.suppressed != 0) and
+                ((seconds > bucket.suppressedSeconds) or
+                 ((seconds == bucket.suppressedSeconds) and (useconds >= bucket.suppressedUSeconds)))) {
+                U32 elapsedSeconds = seconds - bucket.suppressedSeconds;
+                if ((elapsedSeconds > bucket.windowUs/1000000) or
+                    (elapsedSeconds*1000000 + useconds - bucket.suppressedUSeconds >= bucket.windowUs)) {
+                    suppressed = bucket.suppressed;
+                    bucket.suppressed = 0;
+                }
+            }
+
+            __sync_synchronize();
+            bucket.busy = 0;
+
+            if (suppressed != 0) {
+                this->log_WARNING_LO_ALOG_ID_EVENTS_SUPPRESSED(id,suppressed);
+            }
+        }
+    }
+
+    NATIVE_UINT_TYPE ActiveLoggerImpl::hashId(FwEventIdType id) {
+        // multiplicative hash with Knuth's constant; top bits of the product select the slot
+        return (static_cast<U32>(id) * 2654435761U) >> (32 - ALOG_ID_TABLE_BITS);
+    }
+
+    NATIVE_INT_TYPE ActiveLoggerImpl::findId(FwEventIdType id) {
+
+        NATIVE_UINT_TYPE slot = this->hashId(id);
+        for (NATIVE_UINT_TYPE probe = 0; probe < ALOG_ID_TABLE_SLOTS; probe++) {
+            FwEventIdType entry = this->m_ids[slot].id;
+            if (entry == id) {
+                return slot;
+            }
+            if (0 == entry) {
+                return ALOG_NO_ID;
+            }
+            slot = (slot + 1) & (ALOG_ID_TABLE_SLOTS - 1);
+        }
+        return ALOG_NO_ID;
+    }
+
+    NATIVE_INT_TYPE ActiveLoggerImpl::claimId(FwEventIdType id) {
+
+        FW_ASSERT(id != 0);
+
+        NATIVE_INT_TYPE slot = this->findId(id);
+        if (slot != ALOG_NO_ID) {
+            // an unused slot still holding the ID counts again
+            if ((not this->m_ids[slot].filtered) and (ALOG_NO_THROTTLE == this->m_ids[slot].throttle)) {
+                if (this->m_numIds == TELEM_ID_FILTER_SIZE) {
+                    return ALOG_NO_ID;
+                }
+                this->m_numIds++;
+            }
+            return slot;
+        }
+
+        if (this->m_numIds == TELEM_ID_FILTER_SIZE) {
+            return ALOG_NO_ID;
+        }
+
+        // keep probe chains short by clearing out unused slots when the table gets crowded
+        if (this->m_usedIdSlots >= (ALOG_ID_TABLE_SLOTS*3)/4) {
+            this->compactIds();
+        }
+
+        // reuse the first unused slot on the probe chain, otherwise take the empty slot at the end
+        NATIVE_INT_TYPE freeSlot = ALOG_NO_ID;
+        NATIVE_UINT_TYPE probeSlot = this->hashId(id);
+        for (NATIVE_UINT_TYPE probe = 0; probe < ALOG_ID_TABLE_SLOTS; probe++) {
+            IdEntry& entry = this->m_ids[probeSlot];
+            if (0 == entry.id) {
+                if (ALOG_NO_ID == freeSlot) {
+                    freeSlot = probeSlot;
+                    this->m_usedIdSlots++;
+                }
+                break;
+            }
+            if ((ALOG_NO_ID == freeSlot) and (not entry.filtered) and (ALOG_NO_THROTTLE == entry.throttle)) {
+                freeSlot = probeSlot;
+            }
+            probeSlot = (probeSlot + 1) & (ALOG_ID_TABLE_SLOTS - 1);
+        }
+        // table is never more than 3/4 full, so a slot is always found
+        FW_ASSERT(freeSlot != ALOG_NO_ID,id);
+
+        // Callers looking for the old ID of a reused slot pass it, which is
+        // what they would do anyway since it has no filter or throttle.
+        this->m_ids[freeSlot].id = id;
+        this->m_numIds++;
+        return freeSlot;
+    }
+
+    void ActiveLoggerImpl::releaseId(NATIVE_INT_TYPE slot) {
+
+        FW_ASSERT((slot >= 0) and (slot < ALOG_ID_TABLE_SLOTS),slot);
+        // the ID stays in the slot so probe chains through it aren't broken
+        if ((not this->m_ids[slot].filtered) and (ALOG_NO_THROTTLE == this->m_ids[slot].throttle)) {
+            FW_ASSERT(this->m_numIds > 0);
+            this->m_numIds--;
+        }
+    }
+
+    void ActiveLoggerImpl::compactIds(void) {
+
+        // Save the IDs with a filter or throttle, then put them back in an empty table.
+        // Events that arrive while the table is rebuilt may miss their filter.
+        NATIVE_UINT_TYPE numIds = 0;
+        for (NATIVE_UINT_TYPE slot = 0; slot < ALOG_ID_TABLE_SLOTS; slot++) {
+            IdEntry& entry = this->m_ids[slot];
+            if (entry.filtered or (entry.throttle != ALOG_NO_THROTTLE)) {
+                FW_ASSERT(numIds < TELEM_ID_FILTER_SIZE,numIds);
+                this->m_compactIds[numIds].id = entry.id;
+                this->m_compactIds[numIds].filtered = entry.filtered;
+                this->m_compactIds[numIds].throttle = entry.throttle;
+                numIds++;
+            }
+            entry.id = 0;
+            entry.filtered = false;
+            entry.throttle = ALOG_NO_THROTTLE;
+        }
+        FW_ASSERT(numIds == this->m_numIds,numIds,this->m_numIds);
+
+        for (NATIVE_UINT_TYPE id = 0; id < numIds; id++) {
+            NATIVE_UINT_TYPE slot = this->hashId(this->m_compactIds[id].id);
+            while (this->m_ids[slot].id != 0) {
+                slot = (slot + 1) & (ALOG_ID_TABLE_SLOTS - 1);
+            }
+            // set the state before the ID is visible to callers
+            this->m_ids[slot].filtered = this->m_compactIds[id].filtered;
+            this->m_ids[slot].throttle = this->m_compactIds[id].throttle;
+            __sync_synchronize();
+            this->m_ids[slot].id = this->m_compactIds[id].id;
+        }
+        this->m_usedIdSlots = numIds;
     }
 
     void ActiveLoggerImpl::pingIn_handler(
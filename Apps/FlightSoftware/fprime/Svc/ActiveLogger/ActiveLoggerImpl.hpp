@@ -10,6 +10,9 @@
 
 #include <Svc/ActiveLogger/ActiveLoggerComponentAc.hpp>
 #include <Fw/Log/LogPacket.hpp>
+#include <Fw/Types/EightyCharString.hpp>
+#include <Fw/Types/MpscRing.hpp>
+#include <Os/File.hpp>
 #include <Svc/ActiveLogger/ActiveLoggerImplCfg.hpp>
 
 namespace Svc {
@@ -26,10 +29,15 @@ namespace Svc {
                     NATIVE_INT_TYPE queueDepth, /*!< The queue depth*/
                     NATIVE_INT_TYPE instance /*!< The instance number*/
                     ); //!< initialization function
+            //! Keep a copy of stored events in a ring in a file so they can be dumped
+            //! after a reset. Finds where the last run stopped writing. Call before
+            //! the component thread is started.
+            void setupPersistLog(const char* fileName);
         PROTECTED:
         PRIVATE:
             void LogRecv_handler(NATIVE_INT_TYPE portNum, FwEventIdType id, Fw::Time &timeTag, Fw::LogSeverity severity, Fw::LogBuffer &args);
-            void loqQueue_internalInterfaceHandler(FwEventIdType id, Fw::Time &timeTag, QueueLogSeverity severity, Fw::LogBuffer &args);
+            void laneReady_internalInterfaceHandler(U32 lane);
+            void Run_handler(NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context);
 
             void ALOG_SET_EVENT_REPORT_FILTER_cmdHandler(
                     FwOpcodeType opCode,
@@ -60,6 +68,26 @@ namespace Svc {
                     U32 cmdSeq //!< The command sequence number
                 );
 
+            void ALOG_SET_ID_THROTTLE_cmdHandler(
+                    FwOpcodeType opCode, //!< The opcode
+                    U32 cmdSeq, //!< The command sequence number
+                    U32 ID, //!< ID to throttle
+                    U32 MaxEvents, //!< events allowed in a window. 0 removes the throttle
+                    U32 WindowMs //!< window length in milliseconds
+                );
+
+            void ALOG_DUMP_PERSIST_LOG_cmdHandler(
+                    FwOpcodeType opCode, //!< The opcode
+                    U32 cmdSeq, //!< The command sequence number
+                    const Fw::CmdStringArg& filename //!< The dump file name
+                );
+
+            void ALOG_SET_BATCH_MODE_cmdHandler(
+                    FwOpcodeType opCode, //!< The opcode
+                    U32 cmdSeq, //!< The command sequence number
+                    BatchModeEnabled BatchEnable //!< Batch mode state
+                );
+
             //! Handler implementation for pingIn
             //!
             void pingIn_handler(
@@ -82,31 +110,176 @@ namespace Svc {
             Fw::LogPacket m_logPacket; //!< packet buffer for assembling log packets
             Fw::ComBuffer m_comBuffer; //!< com buffer for sending event buffers
 
-            // Circular buffers for events
-            Fw::ComBuffer m_fatalCb[FATAL_EVENT_CB_DEPTH];
-            NATIVE_UINT_TYPE m_fatalHead;
+            // Severity lanes. Callers put events in a lane, and the component
+            // thread takes them out highest lane first.
+            enum {
+                ALOG_LANE_FATAL, //!< FATAL. Never dropped
+                ALOG_LANE_HIGH, //!< WARNING_HI
+                ALOG_LANE_MID, //!< WARNING_LO, COMMAND and ACTIVITY_HI
+                ALOG_LANE_LOW, //!< ACTIVITY_LO and DIAGNOSTIC
+                ALOG_NUM_LANES
+            };
+
+            struct LaneEntry {
+                FwEventIdType id;
+                Fw::Time timeTag;
+                Fw::LogSeverity severity;
+                Fw::LogBuffer args;
+            };
+
+            Fw::MpscRing<LaneEntry> m_lanes[ALOG_NUM_LANES]; //!< overflows are events dropped when the lane was full
+
+            Fw::MpscRing<LaneEntry>::Slot m_fatalLane[ALOG_LANE_FATAL_DEPTH];
+            Fw::MpscRing<LaneEntry>::Slot m_highLane[ALOG_LANE_HIGH_DEPTH];
+            Fw::MpscRing<LaneEntry>::Slot m_midLane[ALOG_LANE_MID_DEPTH];
+            Fw::MpscRing<LaneEntry>::Slot m_lowLane[ALOG_LANE_LOW_DEPTH];
+            volatile U32 m_lanesPending; //!< a laneReady message has been sent and not handled
+            U32 m_reportedDrops[ALOG_NUM_LANES]; //!< lane drops already reported in ALOG_LANE_OVERFLOW
+
+            bool putLane(NATIVE_UINT_TYPE lane, FwEventIdType id, Fw::Time& timeTag, Fw::LogSeverity severity, Fw::LogBuffer& args);
+            bool takeLane(NATIVE_UINT_TYPE lane); //!< store the oldest event in the lane. Returns false if empty
+            void drainLanes(void);
+            void writeLaneTlm(void);
+            void reportLaneDrops(void); //!< send ALOG_LANE_OVERFLOW for lanes that dropped events since the last call
+            void storeEvent(FwEventIdType id, Fw::Time &timeTag, Fw::LogSeverity severity, Fw::LogBuffer &args);
+
+            // Batch mode
+            void sendEvent(bool flushNow); //!< send the serialized event in m_comBuffer
+            void flushBatch(void); //!< send the batch packet if it has events
+            BatchModeEnabled m_batchMode; //!< events are packed into batch packets
+            Fw::ComBuffer m_batchBuffer; //!< batch packet being filled
+            NATIVE_UINT_TYPE m_batchEvents; //!< number of events in m_batchBuffer
+
+            // Event history. Serialized events are kept in one byte arena, split
+            // into a part for each severity. Each part is a circular buffer of
+            // variable length records, oldest record first, found by its index.
+            enum {
+                ALOG_HISTORY_FATAL,
+                ALOG_HISTORY_WARNING_HI,
+                ALOG_HISTORY_WARNING_LO,
+                ALOG_HISTORY_COMMAND,
+                ALOG_HISTORY_ACTIVITY_HI,
+                ALOG_HISTORY_ACTIVITY_LO,
+                ALOG_HISTORY_DIAGNOSTIC,
+                ALOG_NUM_HISTORIES
+            };
+
+            struct HistoryRecord {
+                U16 offset; //!< start of the event in the severity's part of the arena
+                U16 size; //!< serialized event size
+            };
+
+            struct History {
+                U8* arena; //!< this severity's part of m_historyArena
+                U32 arenaSize; //!< bytes in the part
+                HistoryRecord* records; //!< this severity's part of m_historyRecords
+                U32 depth; //!< maximum number of records
+                U32 first; //!< index of the oldest record
+                U32 count; //!< number of records
+                U32 tail; //!< arena offset after the newest record
+            } m_history[ALOG_NUM_HISTORIES];
+
+            U8 m_historyArena[
+                FATAL_EVENT_HISTORY_BYTES +
+                WARNING_HI_EVENT_HISTORY_BYTES +
+                WARNING_LO_EVENT_HISTORY_BYTES +
+                COMMAND_EVENT_HISTORY_BYTES +
+                ACTIVITY_HI_EVENT_HISTORY_BYTES +
+                ACTIVITY_LO_EVENT_HISTORY_BYTES +
+                DIAGNOSTIC_EVENT_HISTORY_BYTES];
+            HistoryRecord m_historyRecords[
+                FATAL_EVENT_CB_DEPTH +
+                WARNING_HI_EVENT_CB_DEPTH +
+                WARNING_LO_EVENT_CB_DEPTH +
+                COMMAND_EVENT_CB_DEPTH +
+                ACTIVITY_HI_EVENT_CB_DEPTH +
+                ACTIVITY_LO_EVENT_CB_DEPTH +
+                DIAGNOSTIC_EVENT_CB_DEPTH];
+
+            void initHistories(void);
+            void storeHistory(NATIVE_UINT_TYPE history, const Fw::ComBuffer& event); //!< add event, removing the oldest as needed
+            void dropOldestHistory(NATIVE_UINT_TYPE history);
+
+            // ID table helpers. The table is only changed on the component thread.
+            NATIVE_UINT_TYPE hashId(FwEventIdType id);
+            NATIVE_INT_TYPE findId(FwEventIdType id); //!< returns the slot, or ALOG_NO_ID
+            NATIVE_INT_TYPE claimId(FwEventIdType id); //!< find or add an ID. returns ALOG_NO_ID if full
+            void releaseId(NATIVE_INT_TYPE slot); //!< called when a slot no longer filters or throttles
+            void compactIds(void);
+            bool throttleEvent(NATIVE_INT_TYPE throttle, const Fw::Time& timeTag, U32& suppressed);
+            void reportSuppressed(const Fw::Time& now); //!< report bursts dropped more than a window ago
 
-            Fw::ComBuffer m_warningHiCb[WARNING_HI_EVENT_CB_DEPTH];
-            NATIVE_UINT_TYPE m_warningHiHead;
+            enum {
+                ALOG_ID_TABLE_SLOTS = 1 << ALOG_ID_TABLE_BITS,
+                ALOG_NO_ID = -1,
+                ALOG_NO_THROTTLE = -1
+            };
 
-            Fw::ComBuffer m_warningLoCb[WARNING_LO_EVENT_CB_DEPTH];
-            NATIVE_UINT_TYPE m_warningLoHead;
+            // ID table. Slots are open addressed with linear probing. An ID of 0
+            // means the slot is empty. A slot that has neither a filter nor a
+            // throttle stays in the table until it is reused or compacted.
+            struct IdEntry {
+                volatile FwEventIdType id; //!< event ID
+                volatile bool filtered; //!< events with the ID are dropped
+                volatile I8 throttle; //!< index into m_throttles, or ALOG_NO_THROTTLE
+            } m_ids[ALOG_ID_TABLE_SLOTS];
+            NATIVE_UINT_TYPE m_numIds; //!< slots with a filter or throttle
+            NATIVE_UINT_TYPE m_usedIdSlots; //!< slots with a non-zero ID
 
-            Fw::ComBuffer m_commandCb[COMMAND_EVENT_CB_DEPTH];
-            NATIVE_UINT_TYPE m_commandHead;
+            // copy of the live IDs used while compacting the table
+            struct {
+                FwEventIdType id;
+                bool filtered;
+                I8 throttle;
+            } m_compactIds[TELEM_ID_FILTER_SIZE];
 
-            Fw::ComBuffer m_activityHiCb[ACTIVITY_HI_EVENT_CB_DEPTH];
-            NATIVE_UINT_TYPE m_activityHiHead;
+            // Token bucket for each throttled ID. Credit is kept in microseconds
+            // of the window; each event costs windowUs/maxEvents.
+            struct Throttle {
+                FwEventIdType id; //!< throttled ID. 0 if unused
+                U32 maxEvents; //!< events allowed in a window
+                U32 windowMs; //!< window length
+                U32 windowUs; //!< window length in microseconds, the bucket size
+                U32 costUs; //!< credit used by each event
+                volatile U32 busy; //!< set while a caller updates the bucket
+                bool started; //!< an event has been seen
+                U32 creditUs; //!< credit left in the bucket
+                U32 lastSeconds; //!< time of the last event
+                U32 lastUSeconds;
+                U32 suppressed; //!< events dropped since the last one passed or was reported
+                U32 suppressedSeconds; //!< time of the first event in suppressed
+                U32 suppressedUSeconds;
+            } m_throttles[ALOG_MAX_THROTTLES];
 
-            Fw::ComBuffer m_activityLoCb[ACTIVITY_LO_EVENT_CB_DEPTH];
-            NATIVE_UINT_TYPE m_activityLoHead;
+            // Persistent event ring. Each record is the sync word, the event size,
+            // the sequence number, the serialized event and a CRC32 of everything
+            // after the sync word, all big endian. Records are collected in the
+            // stage and written together. A record never wraps past the end of the
+            // file, and the oldest records are just after the write position.
+            enum {
+                ALOG_PERSIST_SYNC = 0xA55A,
+                ALOG_PERSIST_HEADER_SIZE = sizeof(U16) + sizeof(U16) + sizeof(U32), //!< sync, size, sequence
+                ALOG_PERSIST_CRC_SIZE = sizeof(U32),
+                ALOG_PERSIST_MAX_RECORD = ALOG_PERSIST_HEADER_SIZE + FW_COM_BUFFER_MAX_SIZE + ALOG_PERSIST_CRC_SIZE
+            };
 
-            Fw::ComBuffer m_diagnosticCb[DIAGNOSTIC_EVENT_CB_DEPTH];
-            NATIVE_UINT_TYPE m_diagnosticHead;
+            void persistEvent(bool flushNow); //!< add the serialized event in m_comBuffer to the ring
+            void flushPersist(void); //!< write the stage to the file
+            //! find the next good record in [pos,end) of the file. pos is moved past it
+            bool nextPersistRecord(Os::File& file, U32& pos, U32 end, U32& seq,
+                    const U8*& packet, U32& size, Os::File::Status& stat);
 
-            // array of filtered event IDs.
-            // value of 0 means no entry
-            FwEventIdType m_filteredIDs[TELEM_ID_FILTER_SIZE];
+            bool m_persistEnabled; //!< the ring file is open
+            Fw::EightyCharString m_persistFileName;
+            Os::File m_persistFile;
+            U32 m_persistWritePos; //!< file offset to write the stage
+            U32 m_persistSeq; //!< sequence number of the next record
+            U8 m_persistStage[ALOG_PERSIST_STAGE_SIZE];
+            U32 m_persistStageLen;
+            // part of the file read by nextPersistRecord()
+            U8 m_persistWindow[ALOG_PERSIST_READ_CHUNK + ALOG_PERSIST_MAX_RECORD];
+            U32 m_persistWindowStart;
+            U32 m_persistWindowLen;
 
     };
 
@@ -28,17 +28,73 @@ enum {
     SEND_DIAGNOSTIC_DEFAULT = false //!< DIAGNOSTIC events are filtered at output
 };
 
-// set event history circular buffer sizes
+// set event history sizes. Each severity keeps its most recent events as
+// variable length records in its own part of one byte arena. A severity keeps
+// up to *_EVENT_CB_DEPTH events, or fewer if they don't fit in *_EVENT_HISTORY_BYTES.
+// The bytes must be at least FW_COM_BUFFER_MAX_SIZE and less than 64K.
 
 enum {
-    FATAL_EVENT_CB_DEPTH = 5, //!< FATAL event circular buffer depth
-    WARNING_HI_EVENT_CB_DEPTH = 10, //!< WARNING HI event circular buffer depth
-    WARNING_LO_EVENT_CB_DEPTH = 20, //!< WARNING LO event circular buffer depth
-    COMMAND_EVENT_CB_DEPTH = 20, //!< COMMAND event circular buffer depth
-    ACTIVITY_HI_EVENT_CB_DEPTH = 20, //!< ACTIVITY HI event circular buffer depth
-    ACTIVITY_LO_EVENT_CB_DEPTH = 20, //!< ACTIVITY LO circular buffer depth
-    DIAGNOSTIC_EVENT_CB_DEPTH = 50, //!< DIAGNOSTIC event circular buffer depth
-    TELEM_ID_FILTER_SIZE = 25, //!< Size of telemetry ID filter
+    FATAL_EVENT_CB_DEPTH = 5, //!< FATAL event history depth
+    WARNING_HI_EVENT_CB_DEPTH = 10, //!< WARNING HI event history depth
+    WARNING_LO_EVENT_CB_DEPTH = 20, //!< WARNING LO event history depth
+    COMMAND_EVENT_CB_DEPTH = 20, //!< COMMAND event history depth
+    ACTIVITY_HI_EVENT_CB_DEPTH = 20, //!< ACTIVITY HI event history depth
+    ACTIVITY_LO_EVENT_CB_DEPTH = 20, //!< ACTIVITY LO event history depth
+    DIAGNOSTIC_EVENT_CB_DEPTH = 50, //!< DIAGNOSTIC event history depth
+};
+
+enum {
+    FATAL_EVENT_HISTORY_BYTES = 640, //!< FATAL event history arena bytes
+    WARNING_HI_EVENT_HISTORY_BYTES = 640, //!< WARNING HI event history arena bytes
+    WARNING_LO_EVENT_HISTORY_BYTES = 960, //!< WARNING LO event history arena bytes
+    COMMAND_EVENT_HISTORY_BYTES = 960, //!< COMMAND event history arena bytes
+    ACTIVITY_HI_EVENT_HISTORY_BYTES = 960, //!< ACTIVITY HI event history arena bytes
+    ACTIVITY_LO_EVENT_HISTORY_BYTES = 960, //!< ACTIVITY LO event history arena bytes
+    DIAGNOSTIC_EVENT_HISTORY_BYTES = 2400, //!< DIAGNOSTIC event history arena bytes
+};
+
+// ID filters and throttles. IDs are kept in a hash table of 2^ALOG_ID_TABLE_BITS
+// slots so an event is checked with one or two probes however many IDs are set.
+
+enum {
+    TELEM_ID_FILTER_SIZE = 256, //!< Maximum number of IDs that are filtered or throttled
+    ALOG_ID_TABLE_BITS = 9, //!< ID table has 2^ALOG_ID_TABLE_BITS slots. Must be at least twice TELEM_ID_FILTER_SIZE
+    ALOG_MAX_THROTTLES = 32, //!< Maximum number of throttled IDs
+    ALOG_MAX_THROTTLE_WINDOW_MS = 1800000 //!< Longest throttle window. Must be less than 2^31 microseconds
+};
+
+// Severity lanes. Events wait for the component thread in one of four lanes,
+// and the thread empties the lanes highest severity first. Each lane drops new
+// events when it is full, so a flood of low severity events can't delay or
+// crowd out higher ones. FATAL events have their own lane and are never dropped;
+// the component asserts if that lane fills. Depths must be powers of two.
+
+enum {
+    ALOG_LANE_FATAL_DEPTH = 4, //!< FATAL lane depth
+    ALOG_LANE_HIGH_DEPTH = 8, //!< WARNING_HI lane depth
+    ALOG_LANE_MID_DEPTH = 16, //!< WARNING_LO, COMMAND and ACTIVITY_HI lane depth
+    ALOG_LANE_LOW_DEPTH = 16 //!< ACTIVITY_LO and DIAGNOSTIC lane depth
+};
+
+// Persistent event ring, used when setupPersistLog() is called. Stored events
+// are also written to a ring in a file of ALOG_PERSIST_FILE_SIZE bytes. They are
+// collected in a stage and written on Run, when the stage is full, or right
+// away for a FATAL. Startup and the dump command read the file
+// ALOG_PERSIST_READ_CHUNK bytes at a time, so the time to scan the ring is
+// bounded by the file size.
+
+enum {
+    ALOG_PERSIST_FILE_SIZE = 65536, //!< persistent ring file size
+    ALOG_PERSIST_STAGE_SIZE = 1024, //!< events held for the next write. Must hold the largest event
+    ALOG_PERSIST_READ_CHUNK = 512 //!< bytes read at a time when scanning the ring
+};
+
+// Batch mode. Events are packed into FW_PACKET_LOG_BATCH packets until the
+// next event doesn't fit, the Run port is called, or a FATAL or WARNING_HI
+// event is sent.
+
+enum {
+    ALOG_BATCH_DEFAULT = false //!< batch mode is enabled at startup
 };
 
 #endif /* ACTIVELOGGER_ACTIVELOGGERIMPLCFG_HPP_ */
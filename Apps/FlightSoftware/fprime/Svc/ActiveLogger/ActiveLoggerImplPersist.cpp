@@ -0,0 +1,322 @@
+/*
+ * ActiveLoggerImplPersist.cpp
+ *
+ *  Persistent event ring for ActiveLoggerImpl
+ */
+
+#include <Svc/ActiveLogger/ActiveLoggerImpl.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <string.h>
+extern "C" {
+#include "Utils/Hash/libcrc/lib_crc.h"
+}
+
+namespace {
+
+    void putU16(U8* buff, U16 val) {
+        buff[0] = static_cast<U8>(val >> 8);
+        buff[1] = static_cast<U8>(val);
+    }
+
+    void putU32(U8* buff, U32 val) {
+        buff[0] = static_cast<U8>(val >> 24);
+        buff[1] = static_cast<U8>(val >> 16);
+        buff[2] = static_cast<U8>(val >> 8);
+        buff[3] = static_cast<U8>(val);
+    }
+
+    U16 getU16(const U8* buff) {
+        return static_cast<U16>((buff[0] << 8) | buff[1]);
+    }
+
+    U32 getU32(const U8* buff) {
+        return (static_cast<U32>(buff[0]) << 24) |
+               (static_cast<U32>(buff[1]) << 16) |
+               (static_cast<U32>(buff[2]) << 8) |
+               static_cast<U32>(buff[3]);
+    }
+
+    U32 persistCrc(const U8* buff, U32 size) {
+        unsigned long crc = 0xFFFFFFFF;
+        for (U32 byte = 0; byte < size; byte++) {
+            crc = update_crc_32(crc, static_cast<char>(buff[byte]));
+        }
+        return static_cast<U32>(~crc);
+    }
+
+}
+
+namespace Svc {
+
+    void ActiveLoggerImpl::setupPersistLog(const char* fileName) {
+
+        FW_ASSERT(fileName);
+        // the stage has to hold any event, and the ring a full stage
+        FW_ASSERT(static_cast<U32>(ALOG_PERSIST_STAGE_SIZE) >= static_cast<U32>(ALOG_PERSIST_MAX_RECORD),ALOG_PERSIST_STAGE_SIZE);
+        FW_ASSERT(ALOG_PERSIST_FILE_SIZE >= ALOG_PERSIST_STAGE_SIZE,ALOG_PERSIST_FILE_SIZE);
+        FW_ASSERT(not this->m_persistEnabled);
+
+        this->m_persistFileName = fileName;
+        this->m_persistWritePos = 0;
+        this->m_persistSeq = 1;
+        this->m_persistStageLen = 0;
+
+        // Find the newest record. Writing continues after it, which leaves the
+        // events from before the reset in the ring.
+        U32 records = 0;
+        Os::File file;
+        Os::File::Status stat = file.open(fileName,Os::File::OPEN_READ);
+        if (Os::File::OP_OK == stat) {
+            U32 pos = 0;
+            U32 seq;
+            const U8* packet;
+            U32 size;
+            this->m_persistWindowLen = 0;
+            while (this->nextPersistRecord(file,pos,ALOG_PERSIST_FILE_SIZE,seq,packet,size,stat)) {
+                if ((0 == records) or (seq >= this->m_persistSeq)) {
+                    this->m_persistSeq = seq + 1;
+                    this->m_persistWritePos = pos;
+                }
+                records++;
+            }
+            file.close();
+            if (stat != Os::File::OP_OK) {
+                this->log_WARNING_HI_ALOG_PERSIST_ERR(PERSIST_READ,stat);
+                return;
+            }
+        }
+
+        // open without truncating and make sure the whole ring is allocated
+        stat = this->m_persistFile.open(fileName,Os::File::OPEN_WRITE);
+        if (stat != Os::File::OP_OK) {
+            this->log_WARNING_HI_ALOG_PERSIST_ERR(PERSIST_OPEN,stat);
+            return;
+        }
+        stat = this->m_persistFile.prealloc(0,ALOG_PERSIST_FILE_SIZE);
+        if (stat != Os::File::OP_OK) {
+            this->log_WARNING_HI_ALOG_PERSIST_ERR(PERSIST_ALLOCATE,stat);
+            this->m_persistFile.close();
+            return;
+        }
+
+        this->m_persistEnabled = true;
+        this->log_ACTIVITY_HI_ALOG_PERSIST_RECOVERED(records,this->m_persistSeq);
+    }
+
+    void ActiveLoggerImpl::persistEvent(bool flushNow) {
+
+        if (not this->m_persistEnabled) {
+            return;
+        }
+
+        U32 size = this->m_comBuffer.getBuffLength();
+        U32 recordSize = ALOG_PERSIST_HEADER_SIZE + size + ALOG_PERSIST_CRC_SIZE;
+        FW_ASSERT(recordSize <= sizeof(this->m_persistStage),recordSize);
+
+        if (this->m_persistStageLen + recordSize > sizeof(this->m_persistStage)) {
+            this->flushPersist();
+        }
+        // records don't wrap, so start over at the beginning of the file
+        if (this->m_persistWritePos + this->m_persistStageLen + recordSize > ALOG_PERSIST_FILE_SIZE) {
+            this->flushPersist();
+            this->m_persistWritePos = 0;
+        }
+        // a failed write turns the ring off
+        if (not this->m_persistEnabled) {
+            return;
+        }
+
+        U8* record = &this->m_persistStage[this->m_persistStageLen];
+        putU16(&record[0],ALOG_PERSIST_SYNC);
+        putU16(&record[2],static_cast<U16>(size));
+        putU32(&record[4],this->m_persistSeq++);
+        (void)memcpy(&record[ALOG_PERSIST_HEADER_SIZE],this->m_comBuffer.getBuffAddr(),size);
+        putU32(&record[ALOG_PERSIST_HEADER_SIZE + size],
+                persistCrc(&record[sizeof(U16)],ALOG_PERSIST_HEADER_SIZE - sizeof(U16) + size));
+        this->m_persistStageLen += recordSize;
+
+        if (flushNow) {
+            this->flushPersist();
+            if (this->m_persistEnabled) {
+                (void)this->m_persistFile.flush();
+            }
+        }
+    }
+
+    void ActiveLoggerImpl::flushPersist(void) {
+
+        if ((not this->m_persistEnabled) or (0 == this->m_persistStageLen)) {
+            return;
+        }
+
+        Os::File::Status stat = this->m_persistFile.seek(this->m_persistWritePos);
+        if (Os::File::OP_OK == stat) {
+            NATIVE_INT_TYPE writeSize = this->m_persistStageLen;
+            stat = this->m_persistFile.write(this->m_persistStage,writeSize);
+            if ((Os::File::OP_OK == stat) and (writeSize != static_cast<NATIVE_INT_TYPE>(this->m_persistStageLen))) {
+                stat = Os::File::BAD_SIZE;
+            }
+        }
+
+        if (stat != Os::File::OP_OK) {
+            // stop, rather than report the error for every event
+            this->m_persistEnabled = false;
+            this->m_persistFile.close();
+            this->m_persistStageLen = 0;
+            this->log_WARNING_HI_ALOG_PERSIST_ERR(PERSIST_WRITE,stat);
+            return;
+        }
+
+        this->m_persistWritePos += this->m_persistStageLen;
+        this->m_persistStageLen = 0;
+    }
+
+    bool ActiveLoggerImpl::nextPersistRecord(Os::File& file, U32& pos, U32 end, U32& seq,
+            const U8*& packet, U32& size, Os::File::Status& stat) {
+
+        stat = Os::File::OP_OK;
+
+        while (pos + ALOG_PERSIST_HEADER_SIZE + ALOG_PERSIST_CRC_SIZE <= end) {
+
+            // read more when the largest record starting here isn't in the window
+            U32 need = FW_MIN(end - pos,static_cast<U32>(ALOG_PERSIST_MAX_RECORD));
+            if (  (pos < this->m_persistWindowStart) or
+                  (pos + need > this->m_persistWindowStart + this->m_persistWindowLen)) {
+                stat = file.seek(pos);
+                if (stat != Os::File::OP_OK) {
+                    return false;
+                }
+                NATIVE_INT_TYPE readSize = FW_MIN(end - pos,static_cast<U32>(sizeof(this->m_persistWindow)));
+                stat = file.read(this->m_persistWindow,readSize,false);
+                if (stat != Os::File::OP_OK) {
+                    return false;
+                }
+                this->m_persistWindowStart = pos;
+                this->m_persistWindowLen = readSize;
+                // the file is shorter than the ring
+                if (static_cast<U32>(readSize) < need) {
+                    end = pos + readSize;
+                    continue;
+                }
+            }
+
+            const U8* record = &this->m_persistWindow[pos - this->m_persistWindowStart];
+            if (ALOG_PERSIST_SYNC == getU16(&record[0])) {
+                U32 recordSize = getU16(&record[2]);
+                U32 total = ALOG_PERSIST_HEADER_SIZE + recordSize + ALOG_PERSIST_CRC_SIZE;
+                if (  (recordSize > 0) and
+                      (recordSize <= FW_COM_BUFFER_MAX_SIZE) and
+                      (pos + total <= end) and
+                      (getU32(&record[ALOG_PERSIST_HEADER_SIZE + recordSize]) ==
+                            persistCrc(&record[sizeof(U16)],ALOG_PERSIST_HEADER_SIZE - sizeof(U16) + recordSize))) {
+                    seq = getU32(&record[4]);
+                    packet = &record[ALOG_PERSIST_HEADER_SIZE];
+                    size = recordSize;
+                    pos += total;
+                    return true;
+                }
+            }
+
+            // not a good record, so look for one at the next byte
+            pos++;
+        }
+
+        return false;
+    }
+
+    void ActiveLoggerImpl::ALOG_DUMP_PERSIST_LOG_cmdHandler(
+            FwOpcodeType opCode,
+            U32 cmdSeq,
+            const Fw::CmdStringArg& filename) {
+
+        static const BYTE delimiter = 0xA5;
+
+        if (not this->m_persistEnabled) {
+            this->log_WARNING_HI_ALOG_PERSIST_ERR(PERSIST_NOT_ENABLED,0);
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+            return;
+        }
+
+        // so the dump has every event
+        this->flushPersist();
+
+        Os::File ring;
+        Os::File::Status stat = ring.open(this->m_persistFileName.toChar(),Os::File::OPEN_READ);
+        if (stat != Os::File::OP_OK) {
+            this->log_WARNING_HI_ALOG_PERSIST_ERR(PERSIST_READ,stat);
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+            return;
+        }
+
+        Os::File file;
+        // truncate, since the dump can be shorter than the last one
+        stat = file.open(filename.toChar(),Os::File::OPEN_CREATE);
+        if (stat != Os::File::OP_OK) {
+            this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_OPEN,stat);
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+            ring.close();
+            return;
+        }
+
+        // The oldest records follow the write position. Leftovers from earlier
+        // passes through the ring are older than the records before them, so skip them.
+        const U32 ranges[2][2] = {
+            {this->m_persistWritePos,ALOG_PERSIST_FILE_SIZE},
+            {0,this->m_persistWritePos}
+        };
+        NATIVE_UINT_TYPE numRecords = 0;
+        bool first = true;
+        U32 lastSeq = 0;
+        this->m_persistWindowLen = 0;
+        for (NATIVE_UINT_TYPE range = 0; range < FW_NUM_ARRAY_ELEMENTS(ranges); range++) {
+            U32 pos = ranges[range][0];
+            U32 seq;
+            const U8* packet;
+            U32 size;
+            while (this->nextPersistRecord(ring,pos,ranges[range][1],seq,packet,size,stat)) {
+                if ((not first) and (seq <= lastSeq)) {
+                    continue;
+                }
+                first = false;
+                lastSeq = seq;
+
+                // same format as ALOG_DUMP_EVENT_LOG
+                NATIVE_INT_TYPE fileWriteSize = sizeof(delimiter);
+                Os::File::Status writeStat = file.write(&delimiter,fileWriteSize);
+                if (writeStat != Os::File::OP_OK) {
+                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_PERSIST_DELIMETER,writeStat);
+                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+                    file.close();
+                    ring.close();
+                    return;
+                }
+                fileWriteSize = size;
+                writeStat = file.write(packet,fileWriteSize);
+                if (writeStat != Os::File::OP_OK) {
+                    this->log_WARNING_HI_ALOG_FILE_WRITE_ERR(LOG_WRITE_PERSIST_RECORD,writeStat);
+                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+                    file.close();
+                    ring.close();
+                    return;
+                }
+                numRecords++;
+            }
+            if (stat != Os::File::OP_OK) {
+                break;
+            }
+        }
+
+        file.close();
+        ring.close();
+
+        if (stat != Os::File::OP_OK) {
+            this->log_WARNING_HI_ALOG_PERSIST_ERR(PERSIST_READ,stat);
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+            return;
+        }
+
+        this->log_ACTIVITY_HI_ALOG_FILE_WRITE_COMPLETE(numRecords);
+        this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
+    }
+
+}
@@ -7,7 +7,8 @@
 
 
 SRC =	ActiveLoggerComponentAi.xml \
-		ActiveLoggerImpl.cpp
+		ActiveLoggerImpl.cpp \
+		ActiveLoggerImplPersist.cpp
 
 HDR = 	ActiveLoggerImpl.hpp
 
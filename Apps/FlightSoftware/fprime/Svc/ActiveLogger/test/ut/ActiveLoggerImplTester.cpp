@@ -26,6 +26,7 @@ namespace Svc {
             Svc::ActiveLoggerGTestBase("testerbase",100),
             m_impl(inst),
             m_receivedPacket(false),
+            m_numSentIds(0),
             m_receivedFatalEvent(false) {
     }
 
@@ -39,6 +40,17 @@ namespace Svc {
         ) {
         this->m_sentPacket = data;
         this->m_receivedPacket = true;
+
+        // record the ID of single events
+        Fw::ComBuffer packet(data);
+        FwPacketDescriptorType desc;
+        FwEventIdType id;
+        if (  (Fw::FW_SERIALIZE_OK == packet.deserialize(desc)) and
+              (Fw::ComPacket::FW_PACKET_LOG == desc) and
+              (Fw::FW_SERIALIZE_OK == packet.deserialize(id)) and
+              (this->m_numSentIds < MAX_SENT_IDS)) {
+            this->m_sentIds[this->m_numSentIds++] = id;
+        }
     }
 
     void ActiveLoggerImplTester::from_FatalAnnounce_handler(
@@ -503,6 +515,479 @@ namespace Svc {
 
     }
 
+    void ActiveLoggerImplTester::runFilterThrottle(void) {
+
+        U32 cmdSeq = 21;
+
+        REQUIREMENT("AL-008");
+
+        // limit ID 50 to 2 events a second
+        this->clearHistory();
+        this->sendCmd_ALOG_SET_ID_THROTTLE(0,cmdSeq,50,2,1000);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_SET_ID_THROTTLE,
+                cmdSeq,
+                Fw::COMMAND_OK
+                );
+        ASSERT_EVENTS_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_THROTTLE_SET_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_THROTTLE_SET(0,50,2,1000);
+
+        // a burst of two passes, the third is dropped
+        this->clearHistory();
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,100,0,true);
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,100,0,true);
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,100,0,false);
+        // other IDs aren't affected
+        this->sendTimedEvent(51,Fw::LOG_WARNING_HI,100,0,true);
+        // FATAL always passes
+        this->sendTimedEvent(50,Fw::LOG_FATAL,100,0,true);
+        ASSERT_EVENTS_SIZE(0);
+
+        // 0.4 seconds isn't enough for another event
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,100,400000,false);
+        // 0.6 seconds is, and the dropped events are reported
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,100,600000,true);
+        ASSERT_EVENTS_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_EVENTS_SUPPRESSED_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_EVENTS_SUPPRESSED(0,50,2);
+
+        // after a full window the whole burst is allowed again, and nothing was dropped
+        this->clearHistory();
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,105,0,true);
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,105,0,true);
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,105,0,false);
+        ASSERT_EVENTS_SIZE(0);
+
+        // Run reports the dropped event once the window has passed, without another event
+        Fw::Time runTime(TB_NONE,105,500000);
+        this->setTestTime(runTime);
+        this->invoke_to_Run(0,0);
+        this->m_impl.doDispatch();
+        ASSERT_EVENTS_SIZE(0);
+        runTime.set(TB_NONE,106,0);
+        this->setTestTime(runTime);
+        this->invoke_to_Run(0,0);
+        this->m_impl.doDispatch();
+        ASSERT_EVENTS_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_EVENTS_SUPPRESSED_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_EVENTS_SUPPRESSED(0,50,1);
+        // and only once
+        this->clearHistory();
+        this->invoke_to_Run(0,0);
+        this->m_impl.doDispatch();
+        ASSERT_EVENTS_SIZE(0);
+
+        // drop one more for the throttle removal below
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,106,0,true);
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,106,0,true);
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,106,0,false);
+
+        // an ID filter still mutes a throttled ID
+        this->sendCmd_ALOG_SET_ID_FILTER(0,cmdSeq,50,ActiveLoggerComponentBase::ID_ENABLED);
+        this->m_impl.doDispatch();
+        this->sendTimedEvent(50,Fw::LOG_WARNING_HI,110,0,false);
+        this->sendCmd_ALOG_SET_ID_FILTER(0,cmdSeq,50,ActiveLoggerComponentBase::ID_DISABLED);
+        this->m_impl.doDispatch();
+
+        // removing the throttle reports the event dropped before it
+        this->clearHistory();
+        this->sendCmd_ALOG_SET_ID_THROTTLE(0,cmdSeq,50,0,0);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_SET_ID_THROTTLE,
+                cmdSeq,
+                Fw::COMMAND_OK
+                );
+        ASSERT_EVENTS_SIZE(2);
+        ASSERT_EVENTS_ALOG_ID_EVENTS_SUPPRESSED_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_EVENTS_SUPPRESSED(0,50,1);
+        ASSERT_EVENTS_ALOG_ID_THROTTLE_REMOVED_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_THROTTLE_REMOVED(0,50);
+        for (NATIVE_INT_TYPE event = 0; event < 5; event++) {
+            this->sendTimedEvent(50,Fw::LOG_WARNING_HI,110,0,true);
+        }
+
+        // remove it again
+        this->clearHistory();
+        this->sendCmd_ALOG_SET_ID_THROTTLE(0,cmdSeq,50,0,0);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_SET_ID_THROTTLE,
+                cmdSeq,
+                Fw::COMMAND_EXECUTION_ERROR
+                );
+        ASSERT_EVENTS_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_FILTER_NOT_FOUND_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_FILTER_NOT_FOUND(0,50);
+
+        // invalid arguments: ID 0, no window, window too long, more events than microseconds in the window
+        const U32 badArgs[][3] = {
+                {0,2,1000},
+                {50,2,0},
+                {50,2,ALOG_MAX_THROTTLE_WINDOW_MS+1},
+                {50,1001,1}
+        };
+        for (NATIVE_UINT_TYPE arg = 0; arg < FW_NUM_ARRAY_ELEMENTS(badArgs); arg++) {
+            this->clearHistory();
+            this->sendCmd_ALOG_SET_ID_THROTTLE(0,cmdSeq,badArgs[arg][0],badArgs[arg][1],badArgs[arg][2]);
+            this->m_impl.doDispatch();
+            ASSERT_CMD_RESPONSE_SIZE(1);
+            ASSERT_CMD_RESPONSE(
+                    0,
+                    ActiveLoggerImpl::OPCODE_ALOG_SET_ID_THROTTLE,
+                    cmdSeq,
+                    Fw::COMMAND_VALIDATION_ERROR
+                    );
+            ASSERT_EVENTS_SIZE(0);
+        }
+
+        // fill the throttle list
+        for (NATIVE_INT_TYPE throttleID = 1; throttleID <= ALOG_MAX_THROTTLES; throttleID++) {
+            this->clearHistory();
+            this->sendCmd_ALOG_SET_ID_THROTTLE(0,cmdSeq,1000+throttleID,10,1000);
+            this->m_impl.doDispatch();
+            ASSERT_CMD_RESPONSE_SIZE(1);
+            ASSERT_CMD_RESPONSE(
+                    0,
+                    ActiveLoggerImpl::OPCODE_ALOG_SET_ID_THROTTLE,
+                    cmdSeq,
+                    Fw::COMMAND_OK
+                    );
+        }
+        // changing a throttled ID is allowed
+        this->clearHistory();
+        this->sendCmd_ALOG_SET_ID_THROTTLE(0,cmdSeq,1001,20,1000);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_SET_ID_THROTTLE,
+                cmdSeq,
+                Fw::COMMAND_OK
+                );
+        // another one is rejected
+        this->clearHistory();
+        this->sendCmd_ALOG_SET_ID_THROTTLE(0,cmdSeq,2000,10,1000);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_SET_ID_THROTTLE,
+                cmdSeq,
+                Fw::COMMAND_EXECUTION_ERROR
+                );
+        ASSERT_EVENTS_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_THROTTLE_LIST_FULL_SIZE(1);
+        ASSERT_EVENTS_ALOG_ID_THROTTLE_LIST_FULL(0,2000);
+
+        // a failed throttle doesn't use up an ID filter, so the full set of filters still fits.
+        // Filtering and removing more IDs than the table has slots checks unused slots are reclaimed.
+        for (NATIVE_INT_TYPE pass = 0; pass < 4; pass++) {
+            for (NATIVE_INT_TYPE filterID = 1; filterID <= TELEM_ID_FILTER_SIZE - ALOG_MAX_THROTTLES; filterID++) {
+                this->clearHistory();
+                this->sendCmd_ALOG_SET_ID_FILTER(0,cmdSeq,pass*10000+filterID,ActiveLoggerComponentBase::ID_ENABLED);
+                this->m_impl.doDispatch();
+                ASSERT_CMD_RESPONSE(
+                        0,
+                        ActiveLoggerImpl::OPCODE_ALOG_SET_ID_FILTER,
+                        cmdSeq,
+                        Fw::COMMAND_OK
+                        );
+            }
+            // throttles survive the table being compacted
+            this->sendTimedEvent(1001,Fw::LOG_WARNING_HI,200+pass*10,0,true);
+            this->sendTimedEvent(pass*10000+1,Fw::LOG_WARNING_HI,200+pass*10,0,false);
+            for (NATIVE_INT_TYPE filterID = 1; filterID <= TELEM_ID_FILTER_SIZE - ALOG_MAX_THROTTLES; filterID++) {
+                this->clearHistory();
+                this->sendCmd_ALOG_SET_ID_FILTER(0,cmdSeq,pass*10000+filterID,ActiveLoggerComponentBase::ID_DISABLED);
+                this->m_impl.doDispatch();
+                ASSERT_CMD_RESPONSE(
+                        0,
+                        ActiveLoggerImpl::OPCODE_ALOG_SET_ID_FILTER,
+                        cmdSeq,
+                        Fw::COMMAND_OK
+                        );
+            }
+        }
+
+    }
+
+    void ActiveLoggerImplTester::runBatchMode(void) {
+
+        U32 cmdSeq = 21;
+
+        REQUIREMENT("AL-009");
+
+        this->clearHistory();
+        this->sendCmd_ALOG_SET_BATCH_MODE(0,cmdSeq,ActiveLoggerComponentBase::BATCH_ENABLED);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_SET_BATCH_MODE,
+                cmdSeq,
+                Fw::COMMAND_OK
+                );
+
+        // events are held until Run is called
+        Fw::Time timeTag(TB_NONE,1,2);
+        for (U32 event = 0; event < 3; event++) {
+            Fw::LogBuffer buff;
+            ASSERT_EQ(Fw::FW_SERIALIZE_OK,buff.serialize(event));
+            this->m_receivedPacket = false;
+            this->invoke_to_LogRecv(0,100+event,timeTag,Fw::LOG_ACTIVITY_HI,buff);
+            this->m_impl.doDispatch();
+            ASSERT_FALSE(this->m_receivedPacket);
+        }
+
+        this->invoke_to_Run(0,0);
+        this->m_impl.doDispatch();
+        ASSERT_TRUE(this->m_receivedPacket);
+        FwPacketDescriptorType desc;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_sentPacket.deserialize(desc));
+        ASSERT_EQ(desc,(FwPacketDescriptorType)Fw::ComPacket::FW_PACKET_LOG_BATCH);
+        for (U32 event = 0; event < 3; event++) {
+            this->checkBatchEvent(100+event,event);
+        }
+        ASSERT_EQ(this->m_sentPacket.getBuffLeft(),(NATIVE_UINT_TYPE)0);
+
+        // nothing is sent when the batch is empty
+        this->m_receivedPacket = false;
+        this->invoke_to_Run(0,0);
+        this->m_impl.doDispatch();
+        ASSERT_FALSE(this->m_receivedPacket);
+
+        // a WARNING_HI is sent right away with the events before it
+        Fw::LogBuffer buff;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,buff.serialize(static_cast<U32>(5)));
+        this->invoke_to_LogRecv(0,105,timeTag,Fw::LOG_ACTIVITY_HI,buff);
+        this->m_impl.doDispatch();
+        ASSERT_FALSE(this->m_receivedPacket);
+        buff.resetSer();
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,buff.serialize(static_cast<U32>(6)));
+        this->invoke_to_LogRecv(0,106,timeTag,Fw::LOG_WARNING_HI,buff);
+        this->m_impl.doDispatch();
+        ASSERT_TRUE(this->m_receivedPacket);
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_sentPacket.deserialize(desc));
+        ASSERT_EQ(desc,(FwPacketDescriptorType)Fw::ComPacket::FW_PACKET_LOG_BATCH);
+        this->checkBatchEvent(105,5);
+        this->checkBatchEvent(106,6);
+        ASSERT_EQ(this->m_sentPacket.getBuffLeft(),(NATIVE_UINT_TYPE)0);
+
+        // a full batch is sent when the next event doesn't fit
+        U32 eventSize = sizeof(FwPacketDescriptorType) + sizeof(FwEventIdType) +
+                Fw::Time::SERIALIZED_SIZE + sizeof(U32);
+        U32 batchEvents = (FW_COM_BUFFER_MAX_SIZE - sizeof(FwPacketDescriptorType))/(sizeof(U32) + eventSize);
+        this->m_receivedPacket = false;
+        for (U32 event = 0; event < batchEvents; event++) {
+            buff.resetSer();
+            ASSERT_EQ(Fw::FW_SERIALIZE_OK,buff.serialize(event));
+            this->invoke_to_LogRecv(0,200,timeTag,Fw::LOG_ACTIVITY_HI,buff);
+            this->m_impl.doDispatch();
+            ASSERT_FALSE(this->m_receivedPacket);
+        }
+        buff.resetSer();
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,buff.serialize(batchEvents));
+        this->invoke_to_LogRecv(0,200,timeTag,Fw::LOG_ACTIVITY_HI,buff);
+        this->m_impl.doDispatch();
+        ASSERT_TRUE(this->m_receivedPacket);
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_sentPacket.deserialize(desc));
+        for (U32 event = 0; event < batchEvents; event++) {
+            this->checkBatchEvent(200,event);
+        }
+        ASSERT_EQ(this->m_sentPacket.getBuffLeft(),(NATIVE_UINT_TYPE)0);
+
+        // turning batch mode off sends the last event
+        this->m_receivedPacket = false;
+        this->clearHistory();
+        this->sendCmd_ALOG_SET_BATCH_MODE(0,cmdSeq,ActiveLoggerComponentBase::BATCH_DISABLED);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_SET_BATCH_MODE,
+                cmdSeq,
+                Fw::COMMAND_OK
+                );
+        ASSERT_TRUE(this->m_receivedPacket);
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_sentPacket.deserialize(desc));
+        this->checkBatchEvent(200,batchEvents);
+        ASSERT_EQ(this->m_sentPacket.getBuffLeft(),(NATIVE_UINT_TYPE)0);
+
+        // events are sent one at a time again
+        this->writeEvent(29,Fw::LOG_ACTIVITY_HI,10);
+
+        // invalid mode
+        this->clearHistory();
+        this->sendCmd_ALOG_SET_BATCH_MODE(0,cmdSeq,static_cast<ActiveLoggerComponentBase::BatchModeEnabled>(10));
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_SET_BATCH_MODE,
+                cmdSeq,
+                Fw::COMMAND_VALIDATION_ERROR
+                );
+    }
+
+    void ActiveLoggerImplTester::runSeverityLanes(void) {
+
+        REQUIREMENT("AL-010");
+
+        // events received before the thread runs are stored highest severity first
+        this->clearHistory();
+        this->m_numSentIds = 0;
+        this->queueEvent(10,Fw::LOG_ACTIVITY_LO);
+        this->queueEvent(11,Fw::LOG_ACTIVITY_LO);
+        this->queueEvent(20,Fw::LOG_COMMAND);
+        this->queueEvent(30,Fw::LOG_WARNING_HI);
+        this->queueEvent(21,Fw::LOG_WARNING_LO);
+        // one message covers all of them
+        this->m_impl.doDispatch();
+        ASSERT_EQ(this->m_numSentIds,(NATIVE_UINT_TYPE)5);
+        ASSERT_EQ(this->m_sentIds[0],(FwEventIdType)30);
+        ASSERT_EQ(this->m_sentIds[1],(FwEventIdType)20);
+        ASSERT_EQ(this->m_sentIds[2],(FwEventIdType)21);
+        ASSERT_EQ(this->m_sentIds[3],(FwEventIdType)10);
+        ASSERT_EQ(this->m_sentIds[4],(FwEventIdType)11);
+
+        ASSERT_TLM_ALOG_HIGH_LANE_HWM_SIZE(1);
+        ASSERT_TLM_ALOG_HIGH_LANE_HWM(0,1);
+        ASSERT_TLM_ALOG_MID_LANE_HWM(0,2);
+        ASSERT_TLM_ALOG_LOW_LANE_HWM(0,2);
+        ASSERT_TLM_ALOG_LOW_LANE_DROPS(0,0);
+
+        // a full low lane drops its own events, but not higher ones
+        this->clearHistory();
+        this->m_numSentIds = 0;
+        for (NATIVE_UINT_TYPE event = 0; event < ALOG_LANE_LOW_DEPTH + 2; event++) {
+            this->queueEvent(40,Fw::LOG_ACTIVITY_LO);
+        }
+        this->queueEvent(31,Fw::LOG_FATAL);
+        this->m_impl.doDispatch();
+        ASSERT_EQ(this->m_numSentIds,(NATIVE_UINT_TYPE)ALOG_LANE_LOW_DEPTH + 1);
+        ASSERT_EQ(this->m_sentIds[0],(FwEventIdType)31);
+        for (NATIVE_UINT_TYPE event = 1; event < this->m_numSentIds; event++) {
+            ASSERT_EQ(this->m_sentIds[event],(FwEventIdType)40);
+        }
+        // only changed channels are sent
+        ASSERT_TLM_ALOG_HIGH_LANE_HWM_SIZE(0);
+        ASSERT_TLM_ALOG_LOW_LANE_HWM_SIZE(1);
+        ASSERT_TLM_ALOG_LOW_LANE_HWM(0,ALOG_LANE_LOW_DEPTH);
+        ASSERT_TLM_ALOG_LOW_LANE_DROPS_SIZE(1);
+        ASSERT_TLM_ALOG_LOW_LANE_DROPS(0,2);
+        ASSERT_TLM_ALOG_HIGH_LANE_DROPS_SIZE(0);
+
+        // a FATAL is stored ahead of a full WARNING_HI lane
+        this->clearHistory();
+        this->m_numSentIds = 0;
+        for (NATIVE_UINT_TYPE event = 0; event < ALOG_LANE_HIGH_DEPTH + 2; event++) {
+            this->queueEvent(41,Fw::LOG_WARNING_HI);
+        }
+        this->queueEvent(32,Fw::LOG_FATAL);
+        this->m_impl.doDispatch();
+        ASSERT_EQ(this->m_numSentIds,(NATIVE_UINT_TYPE)ALOG_LANE_HIGH_DEPTH + 1);
+        ASSERT_EQ(this->m_sentIds[0],(FwEventIdType)32);
+        ASSERT_TLM_ALOG_HIGH_LANE_DROPS(0,2);
+
+        // Run reports each lane that dropped events once
+        this->clearHistory();
+        this->invoke_to_Run(0,0);
+        this->m_impl.doDispatch();
+        ASSERT_EVENTS_ALOG_LANE_OVERFLOW_SIZE(2);
+        ASSERT_EVENTS_ALOG_LANE_OVERFLOW(0,ActiveLoggerImpl::ALOG_LANE_HIGH,2);
+        ASSERT_EVENTS_ALOG_LANE_OVERFLOW(1,ActiveLoggerImpl::ALOG_LANE_LOW,2);
+        this->clearHistory();
+        this->invoke_to_Run(0,0);
+        this->m_impl.doDispatch();
+        ASSERT_EVENTS_ALOG_LANE_OVERFLOW_SIZE(0);
+
+        // lanes are reused after wrapping around
+        for (NATIVE_UINT_TYPE pass = 0; pass < 3; pass++) {
+            this->m_numSentIds = 0;
+            for (NATIVE_UINT_TYPE event = 0; event < ALOG_LANE_LOW_DEPTH; event++) {
+                this->queueEvent(50+event,Fw::LOG_ACTIVITY_LO);
+            }
+            this->m_impl.doDispatch();
+            ASSERT_EQ(this->m_numSentIds,(NATIVE_UINT_TYPE)ALOG_LANE_LOW_DEPTH);
+            for (NATIVE_UINT_TYPE event = 0; event < ALOG_LANE_LOW_DEPTH; event++) {
+                ASSERT_EQ(this->m_sentIds[event],(FwEventIdType)(50+event));
+            }
+        }
+
+        // fill the queue (depth 10 in the test) so the laneReady message is dropped.
+        // Each event tries again while the queue is full, and the first Run call
+        // stores them.
+        for (NATIVE_UINT_TYPE call = 0; call < 10; call++) {
+            this->invoke_to_Run(0,0);
+        }
+        this->m_numSentIds = 0;
+        this->queueEvent(60,Fw::LOG_WARNING_LO);
+        ASSERT_EQ(this->m_impl.m_lanesPending,(U32)0);
+        this->queueEvent(62,Fw::LOG_WARNING_LO);
+        ASSERT_EQ(this->m_impl.m_lanesPending,(U32)0);
+        this->m_impl.doDispatch();
+        ASSERT_EQ(this->m_numSentIds,(NATIVE_UINT_TYPE)2);
+        ASSERT_EQ(this->m_sentIds[0],(FwEventIdType)60);
+        ASSERT_EQ(this->m_sentIds[1],(FwEventIdType)62);
+        for (NATIVE_UINT_TYPE call = 1; call < 10; call++) {
+            this->m_impl.doDispatch();
+        }
+        // with room in the queue, the next event sends a laneReady message again
+        this->queueEvent(61,Fw::LOG_WARNING_LO);
+        ASSERT_EQ(this->m_impl.m_lanesPending,(U32)1);
+        this->m_impl.doDispatch();
+        ASSERT_EQ(this->m_numSentIds,(NATIVE_UINT_TYPE)3);
+        ASSERT_EQ(this->m_sentIds[2],(FwEventIdType)61);
+    }
+
+    void ActiveLoggerImplTester::queueEvent(FwEventIdType id, Fw::LogSeverity severity) {
+        Fw::LogBuffer buff;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,buff.serialize(id));
+        Fw::Time timeTag(TB_NONE,1,2);
+        this->invoke_to_LogRecv(0,id,timeTag,severity,buff);
+    }
+
+    void ActiveLoggerImplTester::checkBatchEvent(FwEventIdType id, U32 value) {
+        // each event is its length followed by a log packet
+        U32 size;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_sentPacket.deserialize(size));
+        ASSERT_EQ(size,sizeof(FwPacketDescriptorType) + sizeof(FwEventIdType) + Fw::Time::SERIALIZED_SIZE + sizeof(U32));
+        FwPacketDescriptorType desc;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_sentPacket.deserialize(desc));
+        ASSERT_EQ(desc,(FwPacketDescriptorType)Fw::ComPacket::FW_PACKET_LOG);
+        FwEventIdType sentId;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_sentPacket.deserialize(sentId));
+        ASSERT_EQ(sentId,id);
+        Fw::Time recTimeTag;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_sentPacket.deserialize(recTimeTag));
+        U32 readVal;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_sentPacket.deserialize(readVal));
+        ASSERT_EQ(readVal,value);
+    }
+
+    void ActiveLoggerImplTester::sendTimedEvent(FwEventIdType id, Fw::LogSeverity severity, U32 seconds, U32 useconds, bool passes) {
+        Fw::LogBuffer buff;
+        U32 value = 10;
+
+        Fw::SerializeStatus stat = buff.serialize(value);
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,stat);
+        Fw::Time timeTag(TB_NONE,seconds,useconds);
+
+        this->m_receivedPacket = false;
+        this->invoke_to_LogRecv(0,id,timeTag,severity,buff);
+        // dropped events aren't queued, so only dispatch when one is expected
+        if (passes) {
+            this->m_impl.doDispatch();
+        }
+        ASSERT_EQ(passes,this->m_receivedPacket);
+    }
+
     void ActiveLoggerImplTester::runFilterDump(void) {
         U32 cmdSeq = 21;
         // set random set of filters
@@ -778,84 +1263,56 @@ namespace Svc {
         COMMENT("Write FATAL");
         for (NATIVE_UINT_TYPE event = 0; event < FATAL_EVENT_CB_DEPTH; event++) {
             this->writeEvent(event+1,Fw::LOG_FATAL,FATAL_EVENT_CB_DEPTH-event);
-            // check for wraparound
-            if (event < FATAL_EVENT_CB_DEPTH - 1) {
-                ASSERT_EQ(this->m_impl.m_fatalHead,event + 1);
-            } else {
-                ASSERT_EQ(this->m_impl.m_fatalHead,(NATIVE_UINT_TYPE)0);
-            }
+            // check history fills
+            ASSERT_EQ(this->m_impl.m_history[ActiveLoggerImpl::ALOG_HISTORY_FATAL].count,event + 1);
         }
 
         // WARNING HI
         COMMENT("Write WARNING HI");
         for (NATIVE_UINT_TYPE event = 0; event < WARNING_HI_EVENT_CB_DEPTH; event++) {
             this->writeEvent(event+1,Fw::LOG_WARNING_HI,WARNING_HI_EVENT_CB_DEPTH-event);
-            // check for wraparound
-            if (event < WARNING_HI_EVENT_CB_DEPTH - 1) {
-                ASSERT_EQ(this->m_impl.m_warningHiHead,event + 1);
-            } else {
-                ASSERT_EQ(this->m_impl.m_warningHiHead,(NATIVE_UINT_TYPE)0);
-            }
+            // check history fills
+            ASSERT_EQ(this->m_impl.m_history[ActiveLoggerImpl::ALOG_HISTORY_WARNING_HI].count,event + 1);
         }
 
         // WARNING LO
         COMMENT("Write WARNING LO");
         for (NATIVE_UINT_TYPE event = 0; event < WARNING_LO_EVENT_CB_DEPTH; event++) {
             this->writeEvent(event+1,Fw::LOG_WARNING_LO,WARNING_LO_EVENT_CB_DEPTH-event);
-            // check for wraparound
-            if (event < WARNING_LO_EVENT_CB_DEPTH - 1) {
-                ASSERT_EQ(this->m_impl.m_warningLoHead,event + 1);
-            } else {
-                ASSERT_EQ(this->m_impl.m_warningLoHead,(NATIVE_UINT_TYPE)0);
-            }
+            // check history fills
+            ASSERT_EQ(this->m_impl.m_history[ActiveLoggerImpl::ALOG_HISTORY_WARNING_LO].count,event + 1);
         }
 
         // COMMAND
         COMMENT("Write COMMAND");
         for (NATIVE_UINT_TYPE event = 0; event < COMMAND_EVENT_CB_DEPTH; event++) {
             this->writeEvent(event+1,Fw::LOG_COMMAND,COMMAND_EVENT_CB_DEPTH-event);
-            // check for wraparound
-            if (event < COMMAND_EVENT_CB_DEPTH - 1) {
-                ASSERT_EQ(this->m_impl.m_commandHead,event + 1);
-            } else {
-                ASSERT_EQ(this->m_impl.m_commandHead,(NATIVE_UINT_TYPE)0);
-            }
+            // check history fills
+            ASSERT_EQ(this->m_impl.m_history[ActiveLoggerImpl::ALOG_HISTORY_COMMAND].count,event + 1);
         }
 
         // ACTIVITY_HI
         COMMENT("Write ACTIVITY HI");
         for (NATIVE_UINT_TYPE event = 0; event < ACTIVITY_HI_EVENT_CB_DEPTH; event++) {
             this->writeEvent(event+1,Fw::LOG_ACTIVITY_HI,ACTIVITY_HI_EVENT_CB_DEPTH-event);
-            // check for wraparound
-            if (event < ACTIVITY_HI_EVENT_CB_DEPTH - 1) {
-                ASSERT_EQ(this->m_impl.m_activityHiHead,event + 1);
-            } else {
-                ASSERT_EQ(this->m_impl.m_activityHiHead,(NATIVE_UINT_TYPE)0);
-            }
+            // check history fills
+            ASSERT_EQ(this->m_impl.m_history[ActiveLoggerImpl::ALOG_HISTORY_ACTIVITY_HI].count,event + 1);
         }
 
         // ACTIVITY_LO
         COMMENT("Write ACTIVITY LO");
         for (NATIVE_UINT_TYPE event = 0; event < ACTIVITY_LO_EVENT_CB_DEPTH; event++) {
             this->writeEvent(event+1,Fw::LOG_ACTIVITY_LO,ACTIVITY_LO_EVENT_CB_DEPTH-event);
-            // check for wraparound
-            if (event < ACTIVITY_LO_EVENT_CB_DEPTH - 1) {
-                ASSERT_EQ(this->m_impl.m_activityLoHead,event + 1);
-            } else {
-                ASSERT_EQ(this->m_impl.m_activityLoHead,(NATIVE_UINT_TYPE)0);
-            }
+            // check history fills
+            ASSERT_EQ(this->m_impl.m_history[ActiveLoggerImpl::ALOG_HISTORY_ACTIVITY_LO].count,event + 1);
         }
 
         // DIAGNOSTIC
         COMMENT("Write DIAGNOSTIC");
         for (NATIVE_UINT_TYPE event = 0; event < DIAGNOSTIC_EVENT_CB_DEPTH; event++) {
             this->writeEvent(event+1,Fw::LOG_DIAGNOSTIC,DIAGNOSTIC_EVENT_CB_DEPTH-event);
-            // check for wraparound
-            if (event < DIAGNOSTIC_EVENT_CB_DEPTH - 1) {
-                ASSERT_EQ(this->m_impl.m_diagnosticHead,event + 1);
-            } else {
-                ASSERT_EQ(this->m_impl.m_diagnosticHead,(NATIVE_UINT_TYPE)0);
-            }
+            // check history fills
+            ASSERT_EQ(this->m_impl.m_history[ActiveLoggerImpl::ALOG_HISTORY_DIAGNOSTIC].count,event + 1);
         }
 
         // dump file
@@ -936,6 +1393,192 @@ namespace Svc {
         readFile.close();
     }
 
+    void ActiveLoggerImplTester::runHistoryWrap(void) {
+
+        REQUIREMENT("AL-002");
+
+        // history keeps the most recent events when it wraps
+        COMMENT("Wrap WARNING LO history");
+        const U32 numEvents = 2*WARNING_LO_EVENT_CB_DEPTH + 3;
+        for (U32 event = 0; event < numEvents; event++) {
+            this->writeEvent(event+1,Fw::LOG_WARNING_LO,event);
+        }
+        ASSERT_EQ(this->m_impl.m_history[ActiveLoggerImpl::ALOG_HISTORY_WARNING_LO].count,
+                (U32)WARNING_LO_EVENT_CB_DEPTH);
+
+        this->clearHistory();
+        Fw::CmdStringArg file("dump.dat");
+        this->sendCmd_ALOG_DUMP_EVENT_LOG(0,12,file);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_DUMP_EVENT_LOG,
+                12,
+                Fw::COMMAND_OK
+                );
+        ASSERT_EVENTS_ALOG_FILE_WRITE_COMPLETE(0,WARNING_LO_EVENT_CB_DEPTH);
+
+        Os::File readFile;
+        ASSERT_EQ(Os::File::OP_OK,readFile.open("dump.dat",Os::File::OPEN_READ));
+        for (U32 event = numEvents - WARNING_LO_EVENT_CB_DEPTH; event < numEvents; event++) {
+            this->readEvent(event+1,Fw::LOG_WARNING_LO,event,readFile);
+        }
+        readFile.close();
+
+        // large events are limited by the history bytes instead of the depth
+        COMMENT("Fill WARNING LO history with large events");
+        const NATIVE_UINT_TYPE argSize = 80;
+        const NATIVE_UINT_TYPE eventSize = sizeof(FwPacketDescriptorType) + sizeof(FwEventIdType) +
+                Fw::Time::SERIALIZED_SIZE + argSize;
+        Fw::Time timeTag(TB_NONE,1,2);
+        for (U32 event = 0; event < numEvents; event++) {
+            Fw::LogBuffer buff;
+            for (NATIVE_UINT_TYPE byte = 0; byte < argSize; byte++) {
+                ASSERT_EQ(Fw::FW_SERIALIZE_OK,buff.serialize(static_cast<U8>(event)));
+            }
+            this->invoke_to_LogRecv(0,100+event,timeTag,Fw::LOG_WARNING_LO,buff);
+            this->m_impl.doDispatch();
+        }
+        U32 count = this->m_impl.m_history[ActiveLoggerImpl::ALOG_HISTORY_WARNING_LO].count;
+        ASSERT_LT(count,(U32)WARNING_LO_EVENT_CB_DEPTH);
+        // at most one event is lost to the space left at the end of the arena
+        ASSERT_GE(count,(U32)(WARNING_LO_EVENT_HISTORY_BYTES/eventSize - 1));
+
+        this->clearHistory();
+        this->sendCmd_ALOG_DUMP_EVENT_LOG(0,13,file);
+        this->m_impl.doDispatch();
+        ASSERT_EVENTS_ALOG_FILE_WRITE_COMPLETE(0,count);
+
+        ASSERT_EQ(Os::File::OP_OK,readFile.open("dump.dat",Os::File::OPEN_READ));
+        for (U32 event = numEvents - count; event < numEvents; event++) {
+            BYTE delimiter;
+            NATIVE_INT_TYPE readSize = sizeof(delimiter);
+            ASSERT_EQ(Os::File::OP_OK,readFile.read(&delimiter,readSize,true));
+            ASSERT_EQ(0xA5,delimiter);
+            Fw::ComBuffer comBuff;
+            readSize = eventSize;
+            ASSERT_EQ(Os::File::OP_OK,readFile.read(comBuff.getBuffAddr(),readSize,true));
+            comBuff.setBuffLen(readSize);
+            Fw::LogPacket packet;
+            ASSERT_EQ(Fw::FW_SERIALIZE_OK,comBuff.deserialize(packet));
+            ASSERT_EQ(100+event,packet.getId());
+            Fw::LogBuffer logBuff = packet.getLogBuffer();
+            ASSERT_EQ(argSize,logBuff.getBuffLength());
+            ASSERT_EQ(static_cast<U8>(event),logBuff.getBuffAddr()[argSize-1]);
+        }
+        readFile.close();
+    }
+
+    void ActiveLoggerImplTester::runPersistLog(void) {
+
+        REQUIREMENT("AL-011");
+
+        // start with an empty ring file
+        Os::File file;
+        ASSERT_EQ(Os::File::OP_OK,file.open("persist.dat",Os::File::OPEN_CREATE));
+        file.close();
+
+        COMMENT("Dump before the ring is set up");
+        this->clearHistory();
+        Fw::CmdStringArg dumpFile("persist_dump.dat");
+        this->sendCmd_ALOG_DUMP_PERSIST_LOG(0,10,dumpFile);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_DUMP_PERSIST_LOG,
+                10,
+                Fw::COMMAND_EXECUTION_ERROR
+                );
+        ASSERT_EVENTS_ALOG_PERSIST_ERR_SIZE(1);
+        ASSERT_EVENTS_ALOG_PERSIST_ERR(0,ActiveLoggerImpl::PERSIST_NOT_ENABLED,0);
+
+        this->clearHistory();
+        this->m_impl.setupPersistLog("persist.dat");
+        ASSERT_EVENTS_ALOG_PERSIST_RECOVERED_SIZE(1);
+        ASSERT_EVENTS_ALOG_PERSIST_RECOVERED(0,0,1);
+
+        COMMENT("Events are staged until Run");
+        for (U32 event = 0; event < 5; event++) {
+            this->writeEvent(event+1,Fw::LOG_ACTIVITY_HI,event);
+        }
+        ASSERT_EQ(0u,this->m_impl.m_persistWritePos);
+        ASSERT_NE(0u,this->m_impl.m_persistStageLen);
+        this->invoke_to_Run(0,0);
+        this->m_impl.doDispatch();
+        ASSERT_EQ(0u,this->m_impl.m_persistStageLen);
+        const U32 recordSize = this->m_impl.m_persistWritePos/5;
+
+        COMMENT("FATAL events are written right away");
+        this->writeEvent(6,Fw::LOG_FATAL,5);
+        ASSERT_EQ(0u,this->m_impl.m_persistStageLen);
+        ASSERT_EQ(6*recordSize,this->m_impl.m_persistWritePos);
+
+        COMMENT("Recover the ring after a reset");
+        // the staged event is lost with the reset
+        this->writeEvent(7,Fw::LOG_ACTIVITY_HI,6);
+        this->m_impl.m_persistFile.close();
+        this->m_impl.m_persistEnabled = false;
+        this->m_impl.m_persistStageLen = 0;
+        this->clearHistory();
+        this->m_impl.setupPersistLog("persist.dat");
+        ASSERT_EVENTS_ALOG_PERSIST_RECOVERED_SIZE(1);
+        ASSERT_EVENTS_ALOG_PERSIST_RECOVERED(0,6,7);
+        ASSERT_EQ(6*recordSize,this->m_impl.m_persistWritePos);
+
+        this->clearHistory();
+        this->sendCmd_ALOG_DUMP_PERSIST_LOG(0,11,dumpFile);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_DUMP_PERSIST_LOG,
+                11,
+                Fw::COMMAND_OK
+                );
+        ASSERT_EVENTS_ALOG_FILE_WRITE_COMPLETE(0,6);
+
+        ASSERT_EQ(Os::File::OP_OK,file.open("persist_dump.dat",Os::File::OPEN_READ));
+        for (U32 event = 0; event < 5; event++) {
+            this->readEvent(event+1,Fw::LOG_ACTIVITY_HI,event,file);
+        }
+        this->readEvent(6,Fw::LOG_FATAL,5,file);
+        file.close();
+
+        COMMENT("Wrap the ring");
+        const U32 ringRecords = ALOG_PERSIST_FILE_SIZE/recordSize;
+        const U32 numEvents = 2*ringRecords + 10;
+        for (U32 event = 0; event < numEvents; event++) {
+            this->writeEvent(100+event,Fw::LOG_ACTIVITY_HI,event);
+        }
+
+        this->clearHistory();
+        this->sendCmd_ALOG_DUMP_PERSIST_LOG(0,12,dumpFile);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE(
+                0,
+                ActiveLoggerImpl::OPCODE_ALOG_DUMP_PERSIST_LOG,
+                12,
+                Fw::COMMAND_OK
+                );
+        ASSERT_EVENTS_ALOG_FILE_WRITE_COMPLETE_SIZE(1);
+        U32 count = this->eventHistory_ALOG_FILE_WRITE_COMPLETE->at(0).records;
+        // the space left at the end of the file holds less than a stage
+        ASSERT_LE(count,ringRecords);
+        ASSERT_GE(count,ringRecords - ALOG_PERSIST_STAGE_SIZE/recordSize - 1);
+
+        // the dump has the newest events, oldest first
+        ASSERT_EQ(Os::File::OP_OK,file.open("persist_dump.dat",Os::File::OPEN_READ));
+        for (U32 event = numEvents - count; event < numEvents; event++) {
+            this->readEvent(100+event,Fw::LOG_ACTIVITY_HI,event,file);
+        }
+        file.close();
+
+        this->m_impl.m_persistFile.close();
+        this->m_impl.m_persistEnabled = false;
+    }
+
     void ActiveLoggerImplTester::runFileDumpErrors(void) {
 
         // Turn on all the filters to verify we get the events
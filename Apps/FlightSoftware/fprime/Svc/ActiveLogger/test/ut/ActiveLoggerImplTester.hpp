@@ -24,10 +24,15 @@ namespace Svc {
             void runEventNominal(void);
             void runFilterEventNominal(void);
             void runFilterIdNominal(void);
+            void runFilterThrottle(void);
+            void runBatchMode(void);
+            void runSeverityLanes(void);
             void runFilterDump(void);
             void runFilterInvalidCommands(void);
             void runEventFatal(void);
             void runFileDump(void);
+            void runHistoryWrap(void);
+            void runPersistLog(void);
             void runFileDumpErrors(void);
 
         private:
@@ -47,12 +52,22 @@ namespace Svc {
             bool m_receivedPacket;
             Fw::ComBuffer m_sentPacket;
 
+            // IDs of events sent in their own packet, in order
+            enum {
+                MAX_SENT_IDS = 32
+            };
+            FwEventIdType m_sentIds[MAX_SENT_IDS];
+            NATIVE_UINT_TYPE m_numSentIds;
+
             bool m_receivedFatalEvent;
             FwEventIdType m_fatalID;
 
             void runWithFilters(Fw::LogSeverity filter);
 
             void writeEvent(FwEventIdType id, Fw::LogSeverity severity, U32 value);
+            void checkBatchEvent(FwEventIdType id, U32 value);
+            void sendTimedEvent(FwEventIdType id, Fw::LogSeverity severity, U32 seconds, U32 useconds, bool passes);
+            void queueEvent(FwEventIdType id, Fw::LogSeverity severity);
             void readEvent(FwEventIdType id, Fw::LogSeverity severity, U32 value, Os::File& file);
 
             // open call modifiers
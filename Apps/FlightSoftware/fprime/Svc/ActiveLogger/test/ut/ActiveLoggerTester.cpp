@@ -23,11 +23,14 @@ void connectPorts(Svc::ActiveLoggerImpl& impl, Svc::ActiveLoggerImplTester& test
     impl.set_FatalAnnounce_OutputPort(0,tester.get_from_FatalAnnounce(0));
 
     tester.connect_to_LogRecv(0,impl.get_LogRecv_InputPort(0));
+    tester.connect_to_Run(0,impl.get_Run_InputPort(0));
 
     impl.set_Log_OutputPort(0,tester.get_from_Log(0));
     impl.set_LogText_OutputPort(0,tester.get_from_LogText(0));
 
     impl.set_PktSend_OutputPort(0,tester.get_from_PktSend(0));
+    impl.set_Tlm_OutputPort(0,tester.get_from_Tlm(0));
+    impl.set_Time_OutputPort(0,tester.get_from_Time(0));
 
 #if FW_PORT_TRACING
     // Fw::PortBase::setTrace(true);
@@ -93,6 +96,63 @@ TEST(ActiveLoggerTest,FilterIdTest) {
 
 }
 
+TEST(ActiveLoggerTest,FilterThrottleTest) {
+
+    TEST_CASE(100.1.4,"Throttle events by ID");
+
+    Svc::ActiveLoggerImpl impl("ActiveLoggerImpl");
+
+    impl.init(10,0);
+
+    Svc::ActiveLoggerImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    tester.runFilterThrottle();
+
+}
+
+TEST(ActiveLoggerTest,BatchModeTest) {
+
+    TEST_CASE(100.1.5,"Pack events into batch packets");
+
+    Svc::ActiveLoggerImpl impl("ActiveLoggerImpl");
+
+    impl.init(10,0);
+
+    Svc::ActiveLoggerImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    tester.runBatchMode();
+
+}
+
+TEST(ActiveLoggerTest,SeverityLaneTest) {
+
+    TEST_CASE(100.1.6,"Store events by severity lane");
+
+    Svc::ActiveLoggerImpl impl("ActiveLoggerImpl");
+
+    impl.init(10,0);
+
+    Svc::ActiveLoggerImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    tester.runSeverityLanes();
+
+}
+
 TEST(ActiveLoggerTest,FilterDumpTest) {
 
     TEST_CASE(100.1.3,"Dump filter values");
@@ -169,6 +229,44 @@ TEST(ActiveLoggerTest,CircularBufferDump) {
 
 }
 
+TEST(ActiveLoggerTest,HistoryWrap) {
+
+    TEST_CASE(100.1.7,"Event history keeps the most recent events");
+
+    Svc::ActiveLoggerImpl impl("ActiveLoggerImpl");
+
+    impl.init(10,0);
+
+    Svc::ActiveLoggerImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    tester.runHistoryWrap();
+
+}
+
+TEST(ActiveLoggerTest,PersistLog) {
+
+    TEST_CASE(100.1.8,"Persistent event ring survives a reset");
+
+    Svc::ActiveLoggerImpl impl("ActiveLoggerImpl");
+
+    impl.init(10,0);
+
+    Svc::ActiveLoggerImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    tester.runPersistLog();
+
+}
+
 TEST(ActiveLoggerTest,CircularBufferDumpWithErrors) {
 
     TEST_CASE(100.2.3,"File dump of event circular buffers with errors");
@@ -13,6 +13,7 @@
 #include "Fw/Types/Assert.hpp"
 #include "Fw/Types/BasicTypes.hpp"
 #include "Svc/BufferManager/BufferManager.hpp"
+#include "Os/Mutex.hpp"
 
 namespace Svc {
 
@@ -22,8 +23,8 @@ namespace Svc {
 
   BufferManager::Warnings::State ::
     State(void) :
-      storeSizeExceeded(false),
-      tooManyBuffers(false)
+      storeSizeExceeded(0),
+      tooManyBuffers(0)
   {
 
   }
@@ -42,24 +43,28 @@ namespace Svc {
   void BufferManager::Warnings ::
     update(const Status::t status)
   {
+    // the flags are swapped atomically, so callers on several threads
+    // emit each event once
     switch (status) {
       case Status::SUCCESS:
         if (this->state.storeSizeExceeded || this->state.tooManyBuffers) {
-          this->bufferManager.log_ACTIVITY_HI_ClearedErrorState();
+          const U32 storeSizeExceeded =
+            __sync_lock_test_and_set(&this->state.storeSizeExceeded, 0);
+          const U32 tooManyBuffers =
+            __sync_lock_test_and_set(&this->state.tooManyBuffers, 0);
+          if (storeSizeExceeded || tooManyBuffers) {
+            this->bufferManager.log_ACTIVITY_HI_ClearedErrorState();
+          }
         }
-        this->state.storeSizeExceeded = false;
-        this->state.tooManyBuffers = false;
         break;
       case Status::STORE_SIZE_EXCEEDED:
-        if (!this->state.storeSizeExceeded) {
+        if (__sync_bool_compare_and_swap(&this->state.storeSizeExceeded, 0, 1)) {
           this->bufferManager.log_WARNING_HI_StoreSizeExceeded();
-          this->state.storeSizeExceeded = true;
         }
         break;
       case Status::TOO_MANY_BUFFERS:
-        if (!this->state.tooManyBuffers) {
+        if (__sync_bool_compare_and_swap(&this->state.tooManyBuffers, 0, 1)) {
           this->bufferManager.log_WARNING_HI_TooManyBuffers();
-          this->state.tooManyBuffers = true;
         }
         break;
       default:
@@ -192,6 +197,12 @@ namespace Svc {
     return this->allocationSize;
   }
   
+  U32 BufferManager::AllocationQueue ::
+    getTotalSize(void) const
+  {
+    return this->totalSize;
+  }
+
   BufferManager::AllocationQueue::Allocate::Status 
     BufferManager::AllocationQueue ::
     allocate(
@@ -240,6 +251,388 @@ namespace Svc {
     return Free::SUCCESS;
   }
 
+  // ----------------------------------------------------------------------
+  // The pool 
+  // ----------------------------------------------------------------------
+
+  BufferManager::Pool ::
+    Pool(
+        const Bin *const bins,
+        const U32 numBins
+    ) :
+      numBins(numBins),
+      memoryBase(0),
+      linkBase(0)
+  {
+    FW_ASSERT(numBins <= BUFFERMGR_MAX_NUM_BINS, numBins);
+    U32 memorySize = 0;
+    U32 numLinks = 0;
+    for (U32 bin = 0; bin < numBins; ++bin) {
+      FW_ASSERT(bins != 0);
+      FW_ASSERT(bins[bin].bufferSize > 0, bin);
+      FW_ASSERT(bins[bin].numBuffers > 0, bin);
+      // the buffer index has to fit in the bufferID below the bin
+      FW_ASSERT(bins[bin].numBuffers <= (1U << BUFFERMGR_BIN_ID_SHIFT), bin, bins[bin].numBuffers);
+      // smallest first, so the first bin that fits wastes the least
+      if (bin > 0) {
+        FW_ASSERT(bins[bin].bufferSize > bins[bin-1].bufferSize, bin);
+      }
+      memorySize += bins[bin].bufferSize * bins[bin].numBuffers;
+      numLinks += bins[bin].numBuffers;
+    }
+    if (numBins > 0) {
+      this->memoryBase = new U8[memorySize];
+      this->linkBase = new U32[numLinks];
+    }
+    U8* memory = this->memoryBase;
+    volatile U32* links = this->linkBase;
+    for (U32 bin = 0; bin < numBins; ++bin) {
+      BinState& b = this->bins[bin];
+      b.bufferSize = bins[bin].bufferSize;
+      b.numBuffers = bins[bin].numBuffers;
+      b.memory = memory;
+      b.links = links;
+      // every buffer starts on the free list
+      for (U32 buffer = 0; buffer < b.numBuffers; ++buffer) {
+        b.links[buffer] = buffer + 1;
+      }
+      b.links[b.numBuffers - 1] = NO_BUFFER;
+      b.freeHead = makeHead(0, 0);
+      b.numAllocated = 0;
+      b.highWater = 0;
+      memory += b.bufferSize * b.numBuffers;
+      links += b.numBuffers;
+    }
+  }
+
+  BufferManager::Pool ::
+    ~Pool(void)
+  {
+    delete[] this->memoryBase;
+    delete[] this->linkBase;
+  }
+
+  bool BufferManager::Pool ::
+    isEnabled(void) const
+  {
+    return this->numBins > 0;
+  }
+
+  U32 BufferManager::Pool ::
+    getNumBins(void) const
+  {
+    return this->numBins;
+  }
+
+  U32 BufferManager::Pool ::
+    getHighWater(const U32 bin) const
+  {
+    FW_ASSERT(bin < this->numBins, bin);
+    return this->bins[bin].highWater;
+  }
+
+  U32 BufferManager::Pool ::
+    getNumBuffers(void) const
+  {
+    U32 numBuffers = 0;
+    for (U32 bin = 0; bin < this->numBins; ++bin) {
+      numBuffers += this->bins[bin].numBuffers;
+    }
+    return numBuffers;
+  }
+
+  U32 BufferManager::Pool ::
+    getIndex(const U32 id) const
+  {
+    const U32 bin = id >> BUFFERMGR_BIN_ID_SHIFT;
+    const U32 buffer = id & ((1U << BUFFERMGR_BIN_ID_SHIFT) - 1);
+    FW_ASSERT(bin < this->numBins, bin, id);
+    FW_ASSERT(buffer < this->bins[bin].numBuffers, buffer, id);
+    U32 index = buffer;
+    for (U32 i = 0; i < bin; ++i) {
+      index += this->bins[i].numBuffers;
+    }
+    return index;
+  }
+
+  U64 BufferManager::Pool ::
+    makeHead(
+        const U32 tag,
+        const U32 buffer
+    )
+  {
+    return (static_cast<U64>(tag) << 32) | buffer;
+  }
+
+  U32 BufferManager::Pool ::
+    pop(BinState& b)
+  {
+    // the head is read atomically, since a U64 read is two loads on some
+    // targets. A failed swap returns the new head
+    U64 head = __sync_val_compare_and_swap(&b.freeHead, 0, 0);
+    while (true) {
+      const U32 buffer = static_cast<U32>(head);
+      if (buffer == NO_BUFFER) {
+        return NO_BUFFER;
+      }
+      FW_ASSERT(buffer < b.numBuffers, buffer);
+      // may be stale if another thread takes the buffer first. The tag
+      // changes on every push and pop, so the swap then fails
+      const U32 next = b.links[buffer];
+      const U32 tag = static_cast<U32>(head >> 32) + 1;
+      const U64 seen = __sync_val_compare_and_swap(&b.freeHead, head, makeHead(tag, next));
+      if (seen == head) {
+        b.links[buffer] = IN_USE;
+        return buffer;
+      }
+      head = seen;
+    }
+  }
+
+  void BufferManager::Pool ::
+    push(
+        BinState& b,
+        const U32 buffer
+    )
+  {
+    U64 head = __sync_val_compare_and_swap(&b.freeHead, 0, 0);
+    while (true) {
+      b.links[buffer] = static_cast<U32>(head);
+      const U32 tag = static_cast<U32>(head >> 32) + 1;
+      const U64 seen = __sync_val_compare_and_swap(&b.freeHead, head, makeHead(tag, buffer));
+      if (seen == head) {
+        return;
+      }
+      head = seen;
+    }
+  }
+
+  BufferManager::Pool::Status BufferManager::Pool ::
+    allocate(
+        const U32 n,
+        U32& id,
+        U32& bin,
+        U8* &result,
+        bool& newHighWater
+    )
+  {
+    Status status = TOO_LARGE;
+    id = 0;
+    bin = 0;
+    result = 0;
+    newHighWater = false;
+    for (U32 i = 0; i < this->numBins; ++i) {
+      BinState& b = this->bins[i];
+      if (b.bufferSize < n) {
+        continue;
+      }
+      const U32 buffer = this->pop(b);
+      if (buffer == NO_BUFFER) {
+        // try the next size up
+        status = EMPTY;
+        continue;
+      }
+      const U32 allocated = __sync_add_and_fetch(&b.numAllocated, 1);
+      U32 highWater = b.highWater;
+      while (allocated > highWater) {
+        if (__sync_bool_compare_and_swap(&b.highWater, highWater, allocated)) {
+          newHighWater = true;
+          break;
+        }
+        highWater = b.highWater;
+      }
+      id = (i << BUFFERMGR_BIN_ID_SHIFT) | buffer;
+      bin = i;
+      result = &b.memory[buffer * b.bufferSize];
+      status = SUCCESS;
+      break;
+    }
+    return status;
+  }
+
+  void BufferManager::Pool ::
+    free(
+        const U32 id,
+        U8 *const address
+    )
+  {
+    const U32 bin = id >> BUFFERMGR_BIN_ID_SHIFT;
+    const U32 buffer = id & ((1U << BUFFERMGR_BIN_ID_SHIFT) - 1);
+    FW_ASSERT(bin < this->numBins, bin, id);
+    BinState& b = this->bins[bin];
+    FW_ASSERT(buffer < b.numBuffers, buffer, id);
+    FW_ASSERT(address == &b.memory[buffer * b.bufferSize], id);
+    // returned twice, or never allocated
+    const bool inUse =
+      __sync_bool_compare_and_swap(&b.links[buffer], IN_USE, NO_BUFFER);
+    FW_ASSERT(inUse, id);
+    const U32 allocated = __sync_sub_and_fetch(&b.numAllocated, 1);
+    FW_ASSERT(allocated < b.numBuffers, bin, allocated);
+    this->push(b, buffer);
+  }
+
+  // ----------------------------------------------------------------------
+  // The tracker 
+  // ----------------------------------------------------------------------
+
+  BufferManager::Tracker ::
+    Tracker(BufferManager& bufferManager) :
+      bufferManager(bufferManager),
+      records(0),
+      numRecords(0),
+      holdLimitMs(0)
+  {
+
+  }
+
+  BufferManager::Tracker ::
+    ~Tracker(void)
+  {
+    delete[] this->records;
+  }
+
+  void BufferManager::Tracker ::
+    setup(
+        const U32 numBuffers,
+        const U32 holdLimitMs
+    )
+  {
+    FW_ASSERT(this->records == 0);
+    FW_ASSERT(numBuffers > 0);
+    this->records = new Record[numBuffers];
+    this->numRecords = numBuffers;
+    this->holdLimitMs = holdLimitMs;
+    for (U32 index = 0; index < numBuffers; ++index) {
+      Record& r = this->records[index];
+      r.sequence = 0;
+      r.active = 0;
+      r.id = 0;
+      r.seconds = 0;
+      r.useconds = 0;
+      r.port = 0;
+      r.holder = NO_HOLDER;
+      // no warning yet for sequence 0
+      r.warned = 1;
+    }
+    // publish the records before another thread sees them
+    __sync_synchronize();
+  }
+
+  bool BufferManager::Tracker ::
+    isEnabled(void) const
+  {
+    return this->records != 0;
+  }
+
+  void BufferManager::Tracker ::
+    allocated(
+        const U32 index,
+        const U32 id,
+        const Fw::Time& time,
+        const U32 port
+    )
+  {
+    FW_ASSERT(index < this->numRecords, index, this->numRecords);
+    Record& r = this->records[index];
+    ++r.sequence;
+    __sync_synchronize();
+    r.id = id;
+    r.seconds = time.getSeconds();
+    r.useconds = time.getUSeconds();
+    r.port = port;
+    r.holder = NO_HOLDER;
+    r.active = 1;
+    __sync_synchronize();
+    ++r.sequence;
+  }
+
+  void BufferManager::Tracker ::
+    held(
+        const U32 index,
+        const U32 id,
+        const U32 port
+    )
+  {
+    FW_ASSERT(index < this->numRecords, index, this->numRecords);
+    Record& r = this->records[index];
+    // a buffer that was already returned keeps its record free
+    if (r.active && (r.id == id)) {
+      r.holder = port;
+    }
+  }
+
+  void BufferManager::Tracker ::
+    freed(const U32 index)
+  {
+    FW_ASSERT(index < this->numRecords, index, this->numRecords);
+    Record& r = this->records[index];
+    ++r.sequence;
+    __sync_synchronize();
+    r.active = 0;
+    __sync_synchronize();
+    ++r.sequence;
+  }
+
+  void BufferManager::Tracker ::
+    scan(
+        const Fw::Time& now,
+        Ages& ages
+    )
+  {
+    static const U32 bucketMs[BUFFERMGR_NUM_AGE_BUCKETS] = {
+      0,
+      BUFFERMGR_AGE_BUCKET_1_MS,
+      BUFFERMGR_AGE_BUCKET_2_MS,
+      BUFFERMGR_AGE_BUCKET_3_MS
+    };
+    ages.outstanding = 0;
+    ages.heldTooLong = 0;
+    for (U32 bucket = 0; bucket < BUFFERMGR_NUM_AGE_BUCKETS; ++bucket) {
+      ages.buckets[bucket] = 0;
+    }
+    const U64 nowUs =
+      static_cast<U64>(now.getSeconds()) * 1000000 + now.getUSeconds();
+    for (U32 index = 0; index < this->numRecords; ++index) {
+      Record& r = this->records[index];
+      const U32 sequence = r.sequence;
+      if (sequence & 1) {
+        // being changed by its owner
+        continue;
+      }
+      __sync_synchronize();
+      const U32 active = r.active;
+      const U32 id = r.id;
+      const U32 seconds = r.seconds;
+      const U32 useconds = r.useconds;
+      const U32 port = r.port;
+      const I32 holder = r.holder;
+      __sync_synchronize();
+      if ((r.sequence != sequence) || !active) {
+        continue;
+      }
+      const U64 thenUs = static_cast<U64>(seconds) * 1000000 + useconds;
+      const U64 ageUs = (nowUs > thenUs) ? nowUs - thenUs : 0;
+      const U32 ageMs = (ageUs / 1000 > 0xFFFFFFFF) ?
+        0xFFFFFFFF : static_cast<U32>(ageUs / 1000);
+      ++ages.outstanding;
+      U32 bucket = BUFFERMGR_NUM_AGE_BUCKETS - 1;
+      while (ageMs < bucketMs[bucket]) {
+        --bucket;
+      }
+      ++ages.buckets[bucket];
+      if (ageMs > this->holdLimitMs) {
+        ++ages.heldTooLong;
+        const U32 warned = r.warned;
+        if ((warned != sequence) &&
+            __sync_bool_compare_and_swap(&r.warned, warned, sequence)) {
+          this->bufferManager.log_WARNING_LO_BufferHeldTooLong(
+              id, port, holder, ageMs
+          );
+        }
+      }
+    }
+  }
+
   // ----------------------------------------------------------------------
   // Construction, initialization, and destruction 
   // ----------------------------------------------------------------------
@@ -253,11 +646,29 @@ namespace Svc {
       BufferManagerComponentBase(compName),
       warnings(*this),
       store(storeSize),
-      allocationQueue(maxNumBuffers)
+      allocationQueue(maxNumBuffers),
+      pool(0, 0),
+      tracker(*this)
   {
 
   }
 
+  BufferManager ::
+    BufferManager(
+        const char *const compName,
+        const Bin *const bins,
+        const U32 numBins
+    ) :
+      BufferManagerComponentBase(compName),
+      warnings(*this),
+      store(0),
+      allocationQueue(0),
+      pool(bins, numBins),
+      tracker(*this)
+  {
+    FW_ASSERT(numBins > 0);
+  }
+
   void BufferManager ::
     init(const NATIVE_INT_TYPE instance) 
   {
@@ -270,6 +681,14 @@ namespace Svc {
 
   }
 
+  void BufferManager ::
+    setupTracking(const U32 holdLimitMs)
+  {
+    const U32 numBuffers = this->pool.isEnabled() ?
+      this->pool.getNumBuffers() : this->allocationQueue.getTotalSize();
+    this->tracker.setup(numBuffers, holdLimitMs);
+  }
+
   // ----------------------------------------------------------------------
   // Handler implementations for user-defined typed input ports
   // ----------------------------------------------------------------------
@@ -287,6 +706,41 @@ namespace Svc {
 
     Warnings::Status::t warningStatus = Warnings::Status::SUCCESS;
 
+    if (this->pool.isEnabled()) {
+      U32 bin;
+      bool newHighWater;
+      const Pool::Status status =
+        this->pool.allocate(size, id, bin, address, newHighWater);
+      switch (status) {
+        case Pool::SUCCESS:
+          buffer.setbufferID(id);
+          buffer.setdata(reinterpret_cast<U64>(address));
+          if (this->tracker.isEnabled()) {
+            this->tracker.allocated(
+                this->pool.getIndex(id), id, this->getTime(), portNum
+            );
+          }
+          if (newHighWater) {
+            this->writeBinTlm(bin);
+          }
+          break;
+        case Pool::TOO_LARGE:
+          warningStatus = Warnings::Status::STORE_SIZE_EXCEEDED;
+          break;
+        case Pool::EMPTY:
+          warningStatus = Warnings::Status::TOO_MANY_BUFFERS;
+          break;
+        default:
+          FW_ASSERT(0, status);
+          break;
+      }
+      this->warnings.update(warningStatus);
+      return buffer;
+    }
+
+    // the store and allocation queue are shared by every caller
+    this->ringLock.lock();
+
     {
       const Store::Status status = 
         this->store.allocate(size, address);
@@ -307,9 +761,15 @@ namespace Svc {
     if (warningStatus == Warnings::Status::SUCCESS) {
       buffer.setbufferID(id);
       buffer.setdata(reinterpret_cast<U64>(address));
+      if (this->tracker.isEnabled()) {
+        this->tracker.allocated(
+            this->getTrackIndex(id), id, this->getTime(), portNum
+        );
+      }
     }
 
     this->warnings.update(warningStatus);
+    this->ringLock.unLock();
     return buffer;
   }
 
@@ -325,9 +785,21 @@ namespace Svc {
 
     const U32 expectedId = buffer.getbufferID();
     U8 *const address = reinterpret_cast<U8*>(buffer.getdata());
+
+    if (this->pool.isEnabled()) {
+      // before the buffer can be handed out again
+      if (this->tracker.isEnabled()) {
+        this->tracker.freed(this->pool.getIndex(expectedId));
+      }
+      this->pool.free(expectedId, address);
+      return;
+    }
+
     U32 sawId = 0;
     U32 size = 0;
 
+    this->ringLock.lock();
+
     {
       const AllocationQueue::Free::Status status =
         this->allocationQueue.free(expectedId, sawId, size);
@@ -341,6 +813,88 @@ namespace Svc {
       this->store.free(size, address);
     }
 
+    if (this->tracker.isEnabled()) {
+      this->tracker.freed(this->getTrackIndex(expectedId));
+    }
+
+    this->ringLock.unLock();
+
+  }
+
+  void BufferManager ::
+    bufferHeldIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer &buffer
+    )
+  {
+    const U32 instance = static_cast<U32>(this->getInstance());
+    FW_ASSERT(buffer.getmanagerID() == instance);
+    if (this->tracker.isEnabled()) {
+      const U32 id = buffer.getbufferID();
+      this->tracker.held(this->getTrackIndex(id), id, portNum);
+    }
+  }
+
+  void BufferManager ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    if (this->tracker.isEnabled()) {
+      Tracker::Ages ages;
+      this->tracker.scan(this->getTime(), ages);
+      this->writeTrackTlm(ages);
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Private helper methods
+  // ----------------------------------------------------------------------
+
+  U32 BufferManager ::
+    getTrackIndex(const U32 id) const
+  {
+    if (this->pool.isEnabled()) {
+      return this->pool.getIndex(id);
+    }
+    // ids are handed out in order and returned in order, so the
+    // outstanding ids never share a record
+    return id % this->allocationQueue.getTotalSize();
+  }
+
+  void BufferManager ::
+    writeTrackTlm(const Tracker::Ages& ages)
+  {
+    this->tlmWrite_BufferManager_OutstandingBuffers(ages.outstanding);
+    this->tlmWrite_BufferManager_HeldTooLong(ages.heldTooLong);
+    this->tlmWrite_BufferManager_AgeBucket0(ages.buckets[0]);
+    this->tlmWrite_BufferManager_AgeBucket1(ages.buckets[1]);
+    this->tlmWrite_BufferManager_AgeBucket2(ages.buckets[2]);
+    this->tlmWrite_BufferManager_AgeBucket3(ages.buckets[3]);
+  }
+
+  void BufferManager ::
+    writeBinTlm(const U32 bin)
+  {
+    const U32 highWater = this->pool.getHighWater(bin);
+    switch (bin) {
+      case 0:
+        this->tlmWrite_BufferManager_Bin0HighWater(highWater);
+        break;
+      case 1:
+        this->tlmWrite_BufferManager_Bin1HighWater(highWater);
+        break;
+      case 2:
+        this->tlmWrite_BufferManager_Bin2HighWater(highWater);
+        break;
+      case 3:
+        this->tlmWrite_BufferManager_Bin3HighWater(highWater);
+        break;
+      default:
+        FW_ASSERT(0, bin);
+        break;
+    }
   }
 
 }
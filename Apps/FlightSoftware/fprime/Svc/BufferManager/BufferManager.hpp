@@ -14,6 +14,8 @@
 #define BufferManager_HPP
 
 #include "Svc/BufferManager/BufferManagerComponentAc.hpp"
+#include "Svc/BufferManager/BufferManagerCfg.hpp"
+#include "Os/Mutex.hpp"
 
 namespace Svc {
 
@@ -53,11 +55,11 @@ namespace Svc {
             //! Construct a State object
             State(void);
 
-            //! StoreSizeExceeded
-            bool storeSizeExceeded;
+            //! StoreSizeExceeded. Nonzero if emitted
+            volatile U32 storeSizeExceeded;
 
-            //! TooManyBuffers
-            bool tooManyBuffers;
+            //! TooManyBuffers. Nonzero if emitted
+            volatile U32 tooManyBuffers;
 
           };
 
@@ -224,6 +226,9 @@ namespace Svc {
 
           // Get the number of buffers currently allocated
           U32 getAllocationSize(void) const;
+
+          // Get the most buffers that can be allocated at once
+          U32 getTotalSize(void) const;
         
           // Record an allocation of size 'size' and generate a new id
           Allocate::Status allocate(
@@ -282,6 +287,276 @@ namespace Svc {
 
       };
 
+    public:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! A bin of buffers of the same size, used to configure the pool
+      struct Bin {
+        U32 bufferSize; //!< The size of each buffer in the bin
+        U32 numBuffers; //!< The number of buffers in the bin
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // The pool
+      // ----------------------------------------------------------------------
+
+      class Pool {
+
+        public:
+
+          // ----------------------------------------------------------------------
+          // Construction and destruction 
+          // ----------------------------------------------------------------------
+
+          // Construct a Pool. A pool with no bins is not used
+          Pool(
+              const Bin *const bins, //!< The bins, in increasing order of buffer size
+              const U32 numBins //!< The number of bins
+          );
+
+          // Destroy a Pool
+          ~Pool(void);
+
+        public:
+
+          // ----------------------------------------------------------------------
+          // Types 
+          // ----------------------------------------------------------------------
+
+          typedef enum {
+            SUCCESS, // Allocation OK
+            TOO_LARGE, // No bin has buffers that large
+            EMPTY // Every bin with buffers that large is in use
+          } Status;
+
+        public:
+
+          // ----------------------------------------------------------------------
+          // Methods 
+          // ----------------------------------------------------------------------
+
+          // Whether the pool has bins
+          bool isEnabled(void) const;
+
+          // Get the number of bins
+          U32 getNumBins(void) const;
+
+          // Get the most buffers of a bin allocated at once
+          U32 getHighWater(const U32 bin) const;
+
+          // Get the number of buffers in every bin
+          U32 getNumBuffers(void) const;
+
+          // Get the index of a buffer among the buffers of every bin
+          U32 getIndex(const U32 id) const;
+
+          // Allocate a buffer of at least n bytes. Safe to call from any thread
+          Status allocate(
+              const U32 n,
+              U32& id, //!< The buffer id
+              U32& bin, //!< The bin the buffer came from
+              U8* &result,
+              bool& newHighWater //!< Whether the bin reached a new high-water mark
+          );
+
+          // Free a buffer. Safe to call from any thread
+          void free(
+              const U32 id, //!< The buffer id
+              U8 *const address //!< The buffer address
+          );
+
+        PRIVATE:
+
+          // ----------------------------------------------------------------------
+          // Constants
+          // ----------------------------------------------------------------------
+
+          enum {
+            // End of a free list
+            NO_BUFFER = 0xFFFFFFFF,
+            // Link of a buffer that is allocated
+            IN_USE = 0xFFFFFFFE
+          };
+
+          // The number of bins
+          const U32 numBins;
+
+          // ----------------------------------------------------------------------
+          // Variables
+          // ----------------------------------------------------------------------
+
+          // A bin's buffers and free list. Each buffer has a link: the next
+          // free buffer while it is free, IN_USE while it is allocated.
+          // The free list is a lock-free stack. Its head holds the first
+          // free buffer in the low 32 bits and a tag in the high 32 bits
+          // that changes on every push and pop, so a stale head is never
+          // swapped in
+          struct BinState {
+            U32 bufferSize;
+            U32 numBuffers;
+            U8* memory;
+            volatile U32* links;
+            volatile U64 freeHead;
+            volatile U32 numAllocated;
+            volatile U32 highWater;
+          } bins[BUFFERMGR_MAX_NUM_BINS];
+
+          //! Memory of every bin
+          U8* memoryBase;
+
+          //! Links of every bin
+          volatile U32* linkBase;
+
+        PRIVATE:
+
+          // ----------------------------------------------------------------------
+          // Private methods
+          // ----------------------------------------------------------------------
+
+          // Make a free list head
+          static U64 makeHead(
+              const U32 tag,
+              const U32 buffer
+          );
+
+          // Take the first free buffer of a bin, or NO_BUFFER
+          U32 pop(
+              BinState& b
+          );
+
+          // Put a buffer on the free list of a bin
+          void push(
+              BinState& b,
+              const U32 buffer
+          );
+
+      };
+
+      // ----------------------------------------------------------------------
+      // The tracker
+      // ----------------------------------------------------------------------
+
+      class Tracker {
+
+        public:
+
+          // ----------------------------------------------------------------------
+          // Construction and destruction 
+          // ----------------------------------------------------------------------
+
+          // Construct a Tracker. It is not used until it is set up
+          Tracker(
+              BufferManager& bufferManager //!< The enclosing BufferManager
+          );
+
+          // Destroy a Tracker
+          ~Tracker(void);
+
+        public:
+
+          // ----------------------------------------------------------------------
+          // Types 
+          // ----------------------------------------------------------------------
+
+          // Outstanding buffers counted by a scan
+          struct Ages {
+            U32 outstanding; // Buffers handed out and not returned
+            U32 heldTooLong; // Outstanding buffers older than the hold limit
+            U32 buckets[BUFFERMGR_NUM_AGE_BUCKETS]; // Outstanding buffers by age
+          };
+
+        public:
+
+          // ----------------------------------------------------------------------
+          // Methods 
+          // ----------------------------------------------------------------------
+
+          // Make a record for each buffer. Call once, before buffers are handed out
+          void setup(
+              const U32 numBuffers, //!< The most buffers outstanding at once
+              const U32 holdLimitMs //!< Buffers held longer are reported
+          );
+
+          // Whether the tracker is set up
+          bool isEnabled(void) const;
+
+          // Record that a buffer was handed out. Only the thread holding
+          // the buffer changes its record
+          void allocated(
+              const U32 index, //!< The record of the buffer
+              const U32 id, //!< The buffer id
+              const Fw::Time& time, //!< When it was handed out
+              const U32 port //!< The port that asked for it
+          );
+
+          // Record the port the holder of a buffer reported it on
+          void held(
+              const U32 index, //!< The record of the buffer
+              const U32 id, //!< The buffer id
+              const U32 port //!< The holder port
+          );
+
+          // Record that a buffer was returned
+          void freed(
+              const U32 index //!< The record of the buffer
+          );
+
+          // Count the outstanding buffers by age, and warn once about
+          // each buffer held longer than the limit
+          void scan(
+              const Fw::Time& now, //!< The current time
+              Ages& ages //!< The counts
+          );
+
+        PRIVATE:
+
+          // ----------------------------------------------------------------------
+          // Constants
+          // ----------------------------------------------------------------------
+
+          enum {
+            // Holder of a buffer no holder has reported
+            NO_HOLDER = -1
+          };
+
+          // ----------------------------------------------------------------------
+          // Variables
+          // ----------------------------------------------------------------------
+
+          // A buffer's record. The owning thread makes the sequence odd
+          // while it changes the record, so a scan on another thread skips
+          // a record whose sequence was odd or changed while it was read.
+          // warned holds the sequence a warning was issued for
+          struct Record {
+            volatile U32 sequence;
+            volatile U32 active;
+            volatile U32 id;
+            volatile U32 seconds;
+            volatile U32 useconds;
+            volatile U32 port;
+            volatile I32 holder;
+            volatile U32 warned;
+          };
+
+          //! The enclosing BufferManager
+          BufferManager& bufferManager;
+
+          //! A record for each buffer
+          Record* records;
+
+          //! The number of records
+          U32 numRecords;
+
+          //! Buffers held longer are reported
+          U32 holdLimitMs;
+
+      };
+
     public:
 
       // ----------------------------------------------------------------------
@@ -296,6 +571,15 @@ namespace Svc {
           const U32 maxNumBuffers
       );
 
+      //! Construct object BufferManager with a pool of bins. Buffers
+      //! can be returned in any order
+      //!
+      BufferManager(
+          const char *const compName, //!< The component name
+          const Bin *const bins, //!< The bins, in increasing order of buffer size
+          const U32 numBins //!< The number of bins. At most BUFFERMGR_MAX_NUM_BINS
+      );
+
       //! Initialize object BufferManager
       //!
       void init(
@@ -306,6 +590,16 @@ namespace Svc {
       //!
       ~BufferManager(void);
 
+      //! Track each outstanding buffer: when it was handed out, the port
+      //! that asked for it and the holder port it was last reported on.
+      //! Each schedIn call then reports buffers held longer than the limit
+      //! and writes the outstanding buffer telemetry. Call before buffers
+      //! are handed out
+      //!
+      void setupTracking(
+          const U32 holdLimitMs //!< Buffers held longer are reported
+      );
+
     PRIVATE:
 
       // ----------------------------------------------------------------------
@@ -326,6 +620,20 @@ namespace Svc {
           Fw::Buffer &buffer
       );
 
+      //! Handler implementation for bufferHeldIn
+      //!
+      void bufferHeldIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number. Identifies the holder
+          Fw::Buffer &buffer
+      );
+
+      //! Handler implementation for schedIn
+      //!
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      );
+
     PRIVATE:
 
       // ----------------------------------------------------------------------
@@ -341,6 +649,30 @@ namespace Svc {
       //! The allocation queue
       AllocationQueue allocationQueue;
 
+      //! The pool. Used instead of the store and allocation queue if it has bins
+      Pool pool;
+
+      //! Guards the store and allocation queue. The pool takes no lock
+      Os::Mutex ringLock;
+
+      //! Records of the outstanding buffers, if set up
+      Tracker tracker;
+
+      //! Get the tracker record of a buffer
+      U32 getTrackIndex(
+          const U32 id //!< The buffer id
+      ) const;
+
+      //! Write the outstanding buffer telemetry
+      void writeTrackTlm(
+          const Tracker::Ages& ages //!< The counts from the last scan
+      );
+
+      //! Write the high-water telemetry of a bin
+      void writeBinTlm(
+          const U32 bin //!< The bin
+      );
+
     };
 
 }
@@ -0,0 +1,34 @@
+// ======================================================================
+// \title  BufferManagerCfg.hpp
+// \brief  Configuration for the BufferManager component
+//
+// ======================================================================
+
+#ifndef BufferManagerCfg_HPP
+#define BufferManagerCfg_HPP
+
+// A BufferManager constructed with a list of bins hands out buffers from a
+// pool instead of the store. Each bin holds buffers of one size, and a
+// request is served from the smallest bin with a free buffer that is large
+// enough. Buffers can be returned in any order. Each bin has a high-water
+// telemetry channel, so the number of bins is limited.
+
+enum {
+  BUFFERMGR_MAX_NUM_BINS = 4, //!< The most bins a pool can have. Must match the bin telemetry channels
+  BUFFERMGR_BIN_ID_SHIFT = 24 //!< bufferID bits holding the buffer index. The bin is above them
+};
+
+// With tracking set up, each outstanding buffer records when it was handed
+// out, the port that asked for it and the last holder port it was reported
+// on. On each schedIn call the outstanding buffers are counted by age into
+// the buckets below. Bucket 0 is younger than BUFFERMGR_AGE_BUCKET_1_MS and
+// bucket 3 is BUFFERMGR_AGE_BUCKET_3_MS or older.
+
+enum {
+  BUFFERMGR_NUM_AGE_BUCKETS = 4, //!< Must match the age telemetry channels
+  BUFFERMGR_AGE_BUCKET_1_MS = 100, //!< Lower age of bucket 1
+  BUFFERMGR_AGE_BUCKET_2_MS = 1000, //!< Lower age of bucket 2
+  BUFFERMGR_AGE_BUCKET_3_MS = 10000 //!< Lower age of bucket 3
+};
+
+#endif
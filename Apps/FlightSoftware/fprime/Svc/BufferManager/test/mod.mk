@@ -2,4 +2,4 @@
 # mod.mk 
 # ----------------------------------------------------------------------
 
-SUBDIRS = ut
+SUBDIRS = ut perf
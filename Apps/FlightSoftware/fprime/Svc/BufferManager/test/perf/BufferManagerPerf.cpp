@@ -0,0 +1,48 @@
+// ======================================================================
+// \title  BufferManager/test/perf/BufferManagerPerf.cpp
+// \brief  Main program for the BufferManager pool benchmark
+// ======================================================================
+
+#include "Svc/BufferManager/test/perf/BufferManagerPerfTester.hpp"
+#include "Fw/Obj/SimpleObjRegistry.hpp"
+#include "Fw/Types/Assert.hpp"
+
+#include <stdlib.h>
+
+#if FW_OBJECT_REGISTRATION == 1
+static Fw::SimpleObjRegistry simpleReg;
+#endif
+
+namespace {
+  // the bins of the pool
+  const Svc::BufferManager::Bin PERF_BINS[] = { { 64, 32 }, { 256, 32 }, { 1024, 32 } };
+  const U32 PERF_DEFAULT_CYCLES = 20000;
+}
+
+int main(int argc, char* argv[]) {
+
+  // optional argument is the number of get and return cycles of each task
+  U32 cycles = PERF_DEFAULT_CYCLES;
+  if (argc > 1) {
+    cycles = atoi(argv[1]);
+  }
+  if (cycles == 0) {
+    cycles = PERF_DEFAULT_CYCLES;
+  }
+
+  Svc::BufferManager component("BufferManager", PERF_BINS, FW_NUM_ARRAY_ELEMENTS(PERF_BINS));
+  component.init(0);
+
+  Svc::BufferManagerPerfTester tester(component, PERF_BINS, FW_NUM_ARRAY_ELEMENTS(PERF_BINS));
+  tester.init();
+  tester.connect();
+
+  Svc::BufferManagerPerfTester::printHeader();
+  for (U32 numTasks = 1; numTasks <= Svc::BufferManagerPerfTester::PERF_MAX_TASKS; numTasks *= 2) {
+    const U32 guardedUs = tester.runTasks(Svc::BufferManagerPerfTester::TARGET_GUARDED, numTasks, cycles);
+    const U32 lockFreeUs = tester.runTasks(Svc::BufferManagerPerfTester::TARGET_LOCK_FREE, numTasks, cycles);
+    tester.report(numTasks, cycles, guardedUs, lockFreeUs);
+  }
+
+  return 0;
+}
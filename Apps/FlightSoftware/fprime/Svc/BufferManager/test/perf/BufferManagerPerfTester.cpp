@@ -0,0 +1,271 @@
+// ======================================================================
+// \title  BufferManager/test/perf/BufferManagerPerfTester.cpp
+// \brief  cpp file for the BufferManager pool benchmark
+// ======================================================================
+
+#include "Svc/BufferManager/test/perf/BufferManagerPerfTester.hpp"
+#include "Os/Task.hpp"
+#include "Os/IntervalTimer.hpp"
+#include "Fw/Types/Assert.hpp"
+#include "Fw/Types/EightyCharString.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace Svc {
+
+  // ----------------------------------------------------------------------
+  // The guarded pool
+  // ----------------------------------------------------------------------
+
+  BufferManagerPerfTester::GuardedPool ::
+    GuardedPool(
+        const BufferManager::Bin *const bins,
+        const U32 numBins
+    ) :
+      numBins(numBins)
+  {
+    FW_ASSERT(numBins <= BUFFERMGR_MAX_NUM_BINS, numBins);
+    for (U32 bin = 0; bin < numBins; ++bin) {
+      BinState& b = this->bins[bin];
+      FW_ASSERT(bins[bin].numBuffers <= PERF_MAX_BUFFERS, bin, bins[bin].numBuffers);
+      b.bufferSize = bins[bin].bufferSize;
+      b.numBuffers = bins[bin].numBuffers;
+      b.memory = new U8[b.bufferSize * b.numBuffers];
+      // every buffer starts on the free list
+      for (U32 buffer = 0; buffer < b.numBuffers; ++buffer) {
+        b.links[buffer] = buffer + 1;
+      }
+      b.links[b.numBuffers - 1] = NO_BUFFER;
+      b.freeHead = 0;
+      b.numAllocated = 0;
+      b.highWater = 0;
+    }
+  }
+
+  BufferManagerPerfTester::GuardedPool ::
+    ~GuardedPool(void)
+  {
+    for (U32 bin = 0; bin < this->numBins; ++bin) {
+      delete[] this->bins[bin].memory;
+    }
+  }
+
+  Fw::Buffer BufferManagerPerfTester::GuardedPool ::
+    get(const U32 size)
+  {
+    Fw::Buffer buffer;
+    buffer.setdata(0);
+    buffer.setsize(size);
+    for (U32 bin = 0; bin < this->numBins; ++bin) {
+      BinState& b = this->bins[bin];
+      if ((b.bufferSize < size) or (NO_BUFFER == b.freeHead)) {
+        continue;
+      }
+      // pop the head of the free list
+      const U32 index = b.freeHead;
+      b.freeHead = b.links[index];
+      ++b.numAllocated;
+      if (b.numAllocated > b.highWater) {
+        b.highWater = b.numAllocated;
+      }
+      buffer.setbufferID((bin << BUFFERMGR_BIN_ID_SHIFT) | index);
+      buffer.setdata(reinterpret_cast<U64>(&b.memory[index * b.bufferSize]));
+      break;
+    }
+    return buffer;
+  }
+
+  void BufferManagerPerfTester::GuardedPool ::
+    put(Fw::Buffer& buffer)
+  {
+    const U32 id = buffer.getbufferID();
+    const U32 bin = id >> BUFFERMGR_BIN_ID_SHIFT;
+    const U32 index = id & ((1U << BUFFERMGR_BIN_ID_SHIFT) - 1);
+    FW_ASSERT(bin < this->numBins, bin, id);
+    BinState& b = this->bins[bin];
+    FW_ASSERT(index < b.numBuffers, index, id);
+    // push it on the free list
+    b.links[index] = b.freeHead;
+    b.freeHead = index;
+    FW_ASSERT(b.numAllocated > 0, bin);
+    --b.numAllocated;
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  BufferManagerPerfTester ::
+    BufferManagerPerfTester(
+        BufferManager& component,
+        const BufferManager::Bin *const bins,
+        const U32 numBins
+    ) :
+#if FW_OBJECT_NAMES == 1
+      Fw::PassiveComponentBase("perftester"),
+#endif
+      component(component),
+      bins(bins),
+      numBins(numBins),
+      guardedPool(bins, numBins),
+      target(TARGET_LOCK_FREE),
+      cycles(0)
+  {
+    FW_ASSERT(numBins > 0 and numBins <= BUFFERMGR_MAX_NUM_BINS, numBins);
+  }
+
+  BufferManagerPerfTester ::
+    ~BufferManagerPerfTester(void)
+  {
+
+  }
+
+  void BufferManagerPerfTester ::
+    init(const NATIVE_INT_TYPE instance)
+  {
+    Fw::PassiveComponentBase::init(instance);
+    for (U32 target = 0; target < TARGET_MAX; ++target) {
+      this->getOut[target].init();
+      this->returnOut[target].init();
+    }
+    this->guardedGetPort.init();
+    this->guardedGetPort.addCallComp(this, guardedGetIn);
+    this->guardedReturnPort.init();
+    this->guardedReturnPort.addCallComp(this, guardedReturnIn);
+  }
+
+  void BufferManagerPerfTester ::
+    connect(void)
+  {
+    this->getOut[TARGET_GUARDED].addCallPort(&this->guardedGetPort);
+    this->returnOut[TARGET_GUARDED].addCallPort(&this->guardedReturnPort);
+    this->getOut[TARGET_LOCK_FREE].addCallPort(this->component.get_bufferGetCallee_InputPort(0));
+    this->returnOut[TARGET_LOCK_FREE].addCallPort(this->component.get_bufferSendIn_InputPort(0));
+  }
+
+  // ----------------------------------------------------------------------
+  // Ports of the guarded pool
+  // ----------------------------------------------------------------------
+
+  Fw::Buffer BufferManagerPerfTester ::
+    guardedGetIn(
+        Fw::PassiveComponentBase* callComp,
+        NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    FW_ASSERT(callComp);
+    BufferManagerPerfTester* tester = static_cast<BufferManagerPerfTester*>(callComp);
+    // a guarded port holds the component mutex for the whole handler
+    tester->guardedPool.guard.lock();
+    Fw::Buffer buffer = tester->guardedPool.get(size);
+    tester->guardedPool.guard.unLock();
+    return buffer;
+  }
+
+  void BufferManagerPerfTester ::
+    guardedReturnIn(
+        Fw::PassiveComponentBase* callComp,
+        NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    FW_ASSERT(callComp);
+    BufferManagerPerfTester* tester = static_cast<BufferManagerPerfTester*>(callComp);
+    tester->guardedPool.guard.lock();
+    tester->guardedPool.put(fwBuffer);
+    tester->guardedPool.guard.unLock();
+  }
+
+  // ----------------------------------------------------------------------
+  // Measurements
+  // ----------------------------------------------------------------------
+
+  U32 BufferManagerPerfTester ::
+    runTasks(
+        const Target target,
+        const U32 numTasks,
+        const U32 cycles
+    )
+  {
+    FW_ASSERT(target < TARGET_MAX, target);
+    FW_ASSERT(numTasks > 0 and numTasks <= PERF_MAX_TASKS, numTasks);
+    this->target = target;
+    this->cycles = cycles;
+    TaskArgs args[PERF_MAX_TASKS];
+    Os::Task tasks[PERF_MAX_TASKS];
+    Os::IntervalTimer timer;
+    timer.start();
+    for (U32 task = 0; task < numTasks; ++task) {
+      args[task].tester = this;
+      args[task].index = task;
+      Fw::EightyCharString name;
+      name.format("BUFP%d", task);
+      const Os::Task::TaskStatus status =
+        tasks[task].start(name, task, 0, 64*1024, allocTask, &args[task]);
+      FW_ASSERT(status == Os::Task::TASK_OK, status);
+    }
+    for (U32 task = 0; task < numTasks; ++task) {
+      const Os::Task::TaskStatus status = tasks[task].join(0);
+      FW_ASSERT(status == Os::Task::TASK_OK, status);
+    }
+    timer.stop();
+    return timer.getDiffUsec();
+  }
+
+  void BufferManagerPerfTester ::
+    allocTask(void* ptr)
+  {
+    TaskArgs* args = static_cast<TaskArgs*>(ptr);
+    BufferManagerPerfTester* tester = args->tester;
+    Fw::OutputBufferGetPort& getOut = tester->getOut[tester->target];
+    Fw::OutputBufferSendPort& returnOut = tester->returnOut[tester->target];
+    Fw::Buffer buffers[BUFFERMGR_MAX_NUM_BINS];
+    const U8 fill = static_cast<U8>(args->index + 1);
+    for (U32 cycle = 0; cycle < tester->cycles; ++cycle) {
+      // hold one buffer of each bin at a time
+      for (U32 bin = 0; bin < tester->numBins; ++bin) {
+        const U32 size = tester->bins[bin].bufferSize;
+        buffers[bin] = getOut.invoke(size);
+        FW_ASSERT(buffers[bin].getdata() != 0, bin);
+        memset(reinterpret_cast<U8*>(buffers[bin].getdata()), fill, size);
+      }
+      for (U32 bin = 0; bin < tester->numBins; ++bin) {
+        // a buffer handed to two tasks at once is written by the other one
+        const U8 *const data = reinterpret_cast<U8*>(buffers[bin].getdata());
+        for (U32 byte = 0; byte < tester->bins[bin].bufferSize; ++byte) {
+          FW_ASSERT(data[byte] == fill, bin, byte, data[byte], fill);
+        }
+        returnOut.invoke(buffers[bin]);
+      }
+    }
+  }
+
+  void BufferManagerPerfTester ::
+    printHeader(void)
+  {
+    (void) printf("tasks,cycles,guarded_pairs_per_sec,lock_free_pairs_per_sec,speedup\n");
+  }
+
+  void BufferManagerPerfTester ::
+    report(
+        const U32 numTasks,
+        const U32 cycles,
+        const U32 guardedUs,
+        const U32 lockFreeUs
+    )
+  {
+    // a pair is one get and one return
+    const F64 pairs = static_cast<F64>(numTasks) * cycles * this->numBins;
+    const F64 guardedRate = pairs * 1000000.0 / (guardedUs ? guardedUs : 1);
+    const F64 lockFreeRate = pairs * 1000000.0 / (lockFreeUs ? lockFreeUs : 1);
+    (void) printf("%u,%u,%.0f,%.0f,%.2f\n",
+        numTasks,
+        cycles,
+        guardedRate,
+        lockFreeRate,
+        lockFreeRate / guardedRate);
+  }
+
+} // end namespace Svc
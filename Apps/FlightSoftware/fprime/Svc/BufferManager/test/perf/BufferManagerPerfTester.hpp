@@ -0,0 +1,223 @@
+// ======================================================================
+// \title  BufferManager/test/perf/BufferManagerPerfTester.hpp
+// \brief  hpp file for the BufferManager pool benchmark
+// ======================================================================
+
+#ifndef BufferManagerPerfTester_HPP
+#define BufferManagerPerfTester_HPP
+
+#include "Fw/Comp/PassiveComponentBase.hpp"
+#include "Fw/Buffer/BufferGetPortAc.hpp"
+#include "Fw/Buffer/BufferSendPortAc.hpp"
+#include "Os/Mutex.hpp"
+#include "Svc/BufferManager/BufferManager.hpp"
+
+namespace Svc {
+
+  //! Benchmark for the BufferManager pool. Several tasks get and return
+  //! buffers through the component ports, and the same is done with a
+  //! copy of the pool as it was with guarded ports, for comparison.
+  //! The benchmark is a standalone program, so it drives the component
+  //! through its own ports instead of the unit test tester base.
+  class BufferManagerPerfTester :
+    public Fw::PassiveComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Types
+      // ----------------------------------------------------------------------
+
+      //! The allocator the tasks use
+      typedef enum {
+        TARGET_GUARDED, //!< The guarded pool baseline
+        TARGET_LOCK_FREE, //!< The BufferManager pool
+        TARGET_MAX
+      } Target;
+
+      enum {
+        PERF_MAX_TASKS = 8, //!< The most allocation tasks
+        PERF_MAX_BUFFERS = 64 //!< The most buffers in a bin of the baseline
+      };
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object BufferManagerPerfTester
+      //!
+      BufferManagerPerfTester(
+          BufferManager& component, //!< The component, built with the same bins
+          const BufferManager::Bin *const bins, //!< The bins
+          const U32 numBins //!< The number of bins
+      );
+
+      //! Destroy object BufferManagerPerfTester
+      //!
+      ~BufferManagerPerfTester(void);
+
+      //! Initialize object BufferManagerPerfTester
+      //!
+      void init(
+          const NATIVE_INT_TYPE instance = 0 //!< The instance number
+      );
+
+      //! Connect the measured ports of the component. Time, events and
+      //! telemetry aren't connected, so they aren't included in the times.
+      //!
+      void connect(void);
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Measurements
+      // ----------------------------------------------------------------------
+
+      //! Get and return buffers from numTasks tasks. Returns usec
+      //!
+      U32 runTasks(
+          const Target target, //!< The allocator
+          const U32 numTasks, //!< The number of tasks
+          const U32 cycles //!< Get and return cycles of each task
+      );
+
+      //! Print the column names of the results
+      //!
+      static void printHeader(void);
+
+      //! Print the results for one task count
+      //!
+      void report(
+          const U32 numTasks, //!< The number of tasks
+          const U32 cycles, //!< Get and return cycles of each task
+          const U32 guardedUs, //!< Time with the guarded pool
+          const U32 lockFreeUs //!< Time with the BufferManager pool
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // The guarded pool
+      // ----------------------------------------------------------------------
+
+      //! The pool with a free list that isn't thread safe, called with a
+      //! mutex held the way a guarded port holds the component mutex.
+      //! This is how the pool worked before the ports were made sync.
+      class GuardedPool {
+
+        public:
+
+          //! Construct a GuardedPool
+          GuardedPool(
+              const BufferManager::Bin *const bins, //!< The bins
+              const U32 numBins //!< The number of bins
+          );
+
+          //! Destroy a GuardedPool
+          ~GuardedPool(void);
+
+          //! Get a buffer of at least size bytes
+          Fw::Buffer get(
+              const U32 size //!< The size
+          );
+
+          //! Return a buffer
+          void put(
+              Fw::Buffer& buffer //!< The buffer
+          );
+
+          //! The guard of the ports
+          Os::Mutex guard;
+
+        PRIVATE:
+
+          enum {
+            NO_BUFFER = 0xFFFFFFFF //!< End of a free list
+          };
+
+          //! A bin's buffers and free list
+          struct BinState {
+            U32 bufferSize;
+            U32 numBuffers;
+            U8* memory;
+            U32 links[PERF_MAX_BUFFERS];
+            U32 freeHead;
+            U32 numAllocated;
+            U32 highWater;
+          } bins[BUFFERMGR_MAX_NUM_BINS];
+
+          //! The number of bins
+          const U32 numBins;
+
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Ports of the guarded pool
+      // ----------------------------------------------------------------------
+
+      //! Handler for the guarded get port
+      static Fw::Buffer guardedGetIn(
+          Fw::PassiveComponentBase* callComp,
+          NATIVE_INT_TYPE portNum,
+          U32 size
+      );
+
+      //! Handler for the guarded return port
+      static void guardedReturnIn(
+          Fw::PassiveComponentBase* callComp,
+          NATIVE_INT_TYPE portNum,
+          Fw::Buffer& fwBuffer
+      );
+
+      //! Arguments of an allocation task
+      struct TaskArgs {
+        BufferManagerPerfTester* tester;
+        U32 index;
+      };
+
+      //! Get and return buffers, checking no other task wrote them
+      //!
+      static void allocTask(void* ptr);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      BufferManager& component;
+
+      //! The bins of the component
+      const BufferManager::Bin *const bins;
+
+      //! The number of bins
+      const U32 numBins;
+
+      //! The baseline
+      GuardedPool guardedPool;
+
+      //! Ports to each allocator, indexed by Target
+      Fw::OutputBufferGetPort getOut[TARGET_MAX];
+      Fw::OutputBufferSendPort returnOut[TARGET_MAX];
+
+      //! Ports of the baseline
+      Fw::InputBufferGetPort guardedGetPort;
+      Fw::InputBufferSendPort guardedReturnPort;
+
+      //! The allocator of the current run
+      Target target;
+
+      //! Get and return cycles of each task in the current run
+      U32 cycles;
+
+  };
+
+} // end namespace Svc
+
+#endif
@@ -0,0 +1,11 @@
+# ----------------------------------------------------------------------
+# mod.mk 
+# ----------------------------------------------------------------------
+
+TEST_SRC = BufferManagerPerf.cpp \
+           BufferManagerPerfTester.cpp
+
+TEST_MODS = Svc/BufferManager \
+            Svc/Sched \
+            Fw/Buffer Fw/Cmd Fw/Comp Fw/Port Fw/Prm Fw/Time \
+            Fw/Tlm Fw/Types Fw/Log Fw/Obj Os Fw/Com
@@ -9,6 +9,35 @@ TEST(Test, ThreeBufferProblem) {
   tester.three_buffer_problem();
 }
 
+TEST(Test, PoolOutOfOrder) {
+  const Svc::BufferManager::Bin bins[] = { { 16, 2 }, { 64, 2 } };
+  Svc::Tester tester(bins, FW_NUM_ARRAY_ELEMENTS(bins));
+  tester.pool_out_of_order();
+}
+
+TEST(Test, PoolExhaustion) {
+  const Svc::BufferManager::Bin bins[] = { { 16, 1 }, { 64, 1 } };
+  Svc::Tester tester(bins, FW_NUM_ARRAY_ELEMENTS(bins));
+  tester.pool_exhaustion();
+}
+
+TEST(Test, PoolConcurrent) {
+  const Svc::BufferManager::Bin bins[] = { { 64, 32 }, { 256, 32 }, { 1024, 32 } };
+  Svc::Tester tester(bins, FW_NUM_ARRAY_ELEMENTS(bins));
+  tester.pool_concurrent();
+}
+
+TEST(Test, PoolTracking) {
+  const Svc::BufferManager::Bin bins[] = { { 16, 2 }, { 64, 2 } };
+  Svc::Tester tester(bins, FW_NUM_ARRAY_ELEMENTS(bins));
+  tester.pool_tracking();
+}
+
+TEST(Test, RingTracking) {
+  Svc::Tester tester;
+  tester.ring_tracking();
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
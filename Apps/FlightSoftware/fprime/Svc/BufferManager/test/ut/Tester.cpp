@@ -11,9 +11,16 @@
 // ====================================================================== 
 
 #include "Tester.hpp"
+#include "Os/Task.hpp"
+#include "Fw/Types/Assert.hpp"
+#include "Fw/Types/EightyCharString.hpp"
+
+#include <string.h>
 
 #define INSTANCE 0
 #define MAX_HISTORY_SIZE 10
+#define NUM_TASKS 4
+#define TASK_CYCLES 1000
 
 namespace Svc {
 
@@ -25,11 +32,30 @@ namespace Svc {
     Tester(void) : 
 #if FW_OBJECT_NAMES == 1
       BufferManagerGTestBase("Tester", MAX_HISTORY_SIZE),
-      component("BufferManager", 12, 3)
+      component("BufferManager", 12, 3),
 #else
       BufferManagerGTestBase(MAX_HISTORY_SIZE),
-      component()
+      component(),
 #endif
+      corrupted(0)
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  Tester ::
+    Tester(
+        const BufferManager::Bin *const bins,
+        const U32 numBins
+    ) :
+#if FW_OBJECT_NAMES == 1
+      BufferManagerGTestBase("Tester", MAX_HISTORY_SIZE),
+      component("BufferManager", bins, numBins),
+#else
+      BufferManagerGTestBase(MAX_HISTORY_SIZE),
+      component(bins, numBins),
+#endif
+      corrupted(0)
   {
     this->initComponents();
     this->connectPorts();
@@ -63,10 +89,257 @@ namespace Svc {
       ASSERT_EQ(0xDEADBEEF,*((U32*)buffer2.getdata()));
   }
 
+  void Tester ::
+    pool_out_of_order(void) 
+  {
+      // fill the small bin, then the next one is from the large bin
+      Fw::Buffer buffer1 = this->invoke_to_bufferGetCallee(0, 10);
+      Fw::Buffer buffer2 = this->invoke_to_bufferGetCallee(0, 16);
+      Fw::Buffer buffer3 = this->invoke_to_bufferGetCallee(0, 10);
+      ASSERT_NE(buffer1.getdata(), (U64)0);
+      ASSERT_NE(buffer2.getdata(), (U64)0);
+      ASSERT_NE(buffer3.getdata(), (U64)0);
+      ASSERT_EQ(buffer1.getmanagerID(), (U32)INSTANCE);
+      ASSERT_EQ(buffer3.getsize(), (U32)10);
+      ASSERT_NE(buffer1.getbufferID(), buffer2.getbufferID());
+      ASSERT_NE(buffer2.getbufferID(), buffer3.getbufferID());
+      *((U32*)buffer1.getdata()) = 0x11111111;
+      *((U32*)buffer2.getdata()) = 0x22222222;
+      *((U32*)buffer3.getdata()) = 0x33333333;
+      // return the last small buffer first
+      this->invoke_to_bufferSendIn(0, buffer2);
+      Fw::Buffer buffer4 = this->invoke_to_bufferGetCallee(0, 4);
+      ASSERT_EQ(buffer4.getdata(), buffer2.getdata());
+      *((U32*)buffer4.getdata()) = 0x44444444;
+      // the buffers still held are intact
+      ASSERT_EQ(0x11111111, *((U32*)buffer1.getdata()));
+      ASSERT_EQ(0x33333333, *((U32*)buffer3.getdata()));
+      this->invoke_to_bufferSendIn(0, buffer3);
+      this->invoke_to_bufferSendIn(0, buffer1);
+      this->invoke_to_bufferSendIn(0, buffer4);
+      ASSERT_EVENTS_SIZE(0);
+      // high-water marks of each bin
+      ASSERT_TLM_BufferManager_Bin0HighWater_SIZE(2);
+      ASSERT_TLM_BufferManager_Bin0HighWater(0, 1);
+      ASSERT_TLM_BufferManager_Bin0HighWater(1, 2);
+      ASSERT_TLM_BufferManager_Bin1HighWater_SIZE(1);
+      ASSERT_TLM_BufferManager_Bin1HighWater(0, 1);
+  }
+
+  void Tester ::
+    pool_exhaustion(void) 
+  {
+      // larger than the largest bin
+      Fw::Buffer buffer = this->invoke_to_bufferGetCallee(0, 100);
+      ASSERT_EQ(buffer.getdata(), (U64)0);
+      ASSERT_EVENTS_SIZE(1);
+      ASSERT_EVENTS_StoreSizeExceeded_SIZE(1);
+      // use up both bins
+      Fw::Buffer buffer1 = this->invoke_to_bufferGetCallee(0, 16);
+      Fw::Buffer buffer2 = this->invoke_to_bufferGetCallee(0, 16);
+      ASSERT_NE(buffer1.getdata(), (U64)0);
+      ASSERT_NE(buffer2.getdata(), (U64)0);
+      ASSERT_EVENTS_ClearedErrorState_SIZE(1);
+      buffer = this->invoke_to_bufferGetCallee(0, 16);
+      ASSERT_EQ(buffer.getdata(), (U64)0);
+      ASSERT_EVENTS_TooManyBuffers_SIZE(1);
+      // warned once
+      buffer = this->invoke_to_bufferGetCallee(0, 1);
+      ASSERT_EVENTS_TooManyBuffers_SIZE(1);
+      // a returned buffer is handed out again
+      this->invoke_to_bufferSendIn(0, buffer1);
+      buffer = this->invoke_to_bufferGetCallee(0, 16);
+      ASSERT_EQ(buffer.getdata(), buffer1.getdata());
+      ASSERT_EVENTS_ClearedErrorState_SIZE(2);
+      this->invoke_to_bufferSendIn(0, buffer);
+      this->invoke_to_bufferSendIn(0, buffer2);
+  }
+
+  void Tester ::
+    pool_concurrent(void) 
+  {
+      // take every buffer once, so the tasks don't reach a new high-water
+      // mark and write telemetry into the history from several threads
+      const U32 numBins = this->component.pool.getNumBins();
+      for (U32 bin = 0; bin < numBins; ++bin) {
+        const U32 bufferSize = this->component.pool.bins[bin].bufferSize;
+        const U32 numBuffers = this->component.pool.bins[bin].numBuffers;
+        Fw::Buffer* buffers = new Fw::Buffer[numBuffers];
+        for (U32 buffer = 0; buffer < numBuffers; ++buffer) {
+          buffers[buffer] = this->invoke_to_bufferGetCallee(0, bufferSize);
+          ASSERT_NE(buffers[buffer].getdata(), (U64)0);
+        }
+        for (U32 buffer = 0; buffer < numBuffers; ++buffer) {
+          this->invoke_to_bufferSendIn(0, buffers[buffer]);
+        }
+        delete[] buffers;
+      }
+      this->clearHistory();
+
+      this->runTasks(NUM_TASKS);
+
+      ASSERT_EQ((U32)0, this->corrupted);
+      ASSERT_EVENTS_SIZE(0);
+      ASSERT_TLM_SIZE(0);
+      for (U32 bin = 0; bin < numBins; ++bin) {
+        ASSERT_EQ((U32)0, this->component.pool.bins[bin].numAllocated);
+      }
+  }
+
+  void Tester ::
+    pool_tracking(void) 
+  {
+      this->component.setupTracking(1000);
+      this->setTime(10, 0);
+      Fw::Buffer buffer1 = this->invoke_to_bufferGetCallee(0, 16);
+      Fw::Buffer buffer2 = this->invoke_to_bufferGetCallee(1, 64);
+      ASSERT_NE(buffer1.getdata(), (U64)0);
+      ASSERT_NE(buffer2.getdata(), (U64)0);
+      // the next component reports that it has buffer 2
+      this->invoke_to_bufferHeldIn(2, buffer2);
+      this->clearHistory();
+
+      // both within the limit
+      this->setTime(10, 500000);
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_EVENTS_SIZE(0);
+      ASSERT_TLM_BufferManager_OutstandingBuffers(0, 2);
+      ASSERT_TLM_BufferManager_HeldTooLong(0, 0);
+      ASSERT_TLM_BufferManager_AgeBucket0(0, 0);
+      ASSERT_TLM_BufferManager_AgeBucket1(0, 2);
+      ASSERT_TLM_BufferManager_AgeBucket2(0, 0);
+      ASSERT_TLM_BufferManager_AgeBucket3(0, 0);
+
+      // both over the limit, with a new buffer
+      this->setTime(11, 200000);
+      Fw::Buffer buffer3 = this->invoke_to_bufferGetCallee(0, 16);
+      ASSERT_NE(buffer3.getdata(), (U64)0);
+      this->clearHistory();
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_EVENTS_SIZE(2);
+      ASSERT_EVENTS_BufferHeldTooLong_SIZE(2);
+      ASSERT_EVENTS_BufferHeldTooLong(0, buffer1.getbufferID(), 0, -1, 1200);
+      ASSERT_EVENTS_BufferHeldTooLong(1, buffer2.getbufferID(), 1, 2, 1200);
+      ASSERT_TLM_BufferManager_OutstandingBuffers(0, 3);
+      ASSERT_TLM_BufferManager_HeldTooLong(0, 2);
+      ASSERT_TLM_BufferManager_AgeBucket0(0, 1);
+      ASSERT_TLM_BufferManager_AgeBucket2(0, 2);
+
+      // warned once. A returned buffer handed out again starts over
+      this->setTime(12, 0);
+      this->invoke_to_bufferSendIn(0, buffer1);
+      Fw::Buffer buffer4 = this->invoke_to_bufferGetCallee(0, 16);
+      ASSERT_EQ(buffer4.getbufferID(), buffer1.getbufferID());
+      this->clearHistory();
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_EVENTS_SIZE(0);
+      ASSERT_TLM_BufferManager_OutstandingBuffers(0, 3);
+      ASSERT_TLM_BufferManager_HeldTooLong(0, 1);
+
+      // a buffer that was returned keeps no holder
+      this->invoke_to_bufferSendIn(0, buffer2);
+      this->invoke_to_bufferHeldIn(3, buffer2);
+      this->invoke_to_bufferSendIn(0, buffer3);
+      this->invoke_to_bufferSendIn(0, buffer4);
+      this->setTime(20, 0);
+      this->clearHistory();
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_EVENTS_SIZE(0);
+      ASSERT_TLM_BufferManager_OutstandingBuffers(0, 0);
+      ASSERT_TLM_BufferManager_HeldTooLong(0, 0);
+  }
+
+  void Tester ::
+    ring_tracking(void) 
+  {
+      this->component.setupTracking(100);
+      this->setTime(0, 0);
+      Fw::Buffer buffer1 = this->invoke_to_bufferGetCallee(0, 4);
+      Fw::Buffer buffer2 = this->invoke_to_bufferGetCallee(1, 4);
+      Fw::Buffer buffer3 = this->invoke_to_bufferGetCallee(0, 4);
+      // the ids wrap around the records
+      this->invoke_to_bufferSendIn(0, buffer1);
+      this->setTime(0, 150000);
+      Fw::Buffer buffer4 = this->invoke_to_bufferGetCallee(1, 4);
+      ASSERT_NE(buffer4.getdata(), (U64)0);
+      this->clearHistory();
+      this->setTime(0, 200000);
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_EVENTS_BufferHeldTooLong_SIZE(2);
+      ASSERT_EVENTS_BufferHeldTooLong(0, buffer2.getbufferID(), 1, -1, 200);
+      ASSERT_EVENTS_BufferHeldTooLong(1, buffer3.getbufferID(), 0, -1, 200);
+      ASSERT_TLM_BufferManager_OutstandingBuffers(0, 3);
+      ASSERT_TLM_BufferManager_AgeBucket0(0, 1);
+      ASSERT_TLM_BufferManager_AgeBucket1(0, 2);
+      this->invoke_to_bufferSendIn(0, buffer2);
+      this->invoke_to_bufferSendIn(0, buffer3);
+      this->invoke_to_bufferSendIn(0, buffer4);
+  }
+
   // ----------------------------------------------------------------------
   // Helper methods 
   // ----------------------------------------------------------------------
 
+  void Tester ::
+    setTime(
+        const U32 seconds,
+        const U32 useconds
+    )
+  {
+    Fw::Time time(TB_NONE, seconds, useconds);
+    this->setTestTime(time);
+  }
+
+  void Tester ::
+    runTasks(const U32 numTasks)
+  {
+    FW_ASSERT(numTasks <= NUM_TASKS, numTasks);
+    TaskArgs args[NUM_TASKS];
+    Os::Task tasks[NUM_TASKS];
+    for (U32 task = 0; task < numTasks; ++task) {
+      args[task].tester = this;
+      args[task].index = task;
+      Fw::EightyCharString name;
+      name.format("BUFM%d", task);
+      const Os::Task::TaskStatus status =
+        tasks[task].start(name, task, 0, 64*1024, allocTask, &args[task]);
+      FW_ASSERT(status == Os::Task::TASK_OK, status);
+    }
+    for (U32 task = 0; task < numTasks; ++task) {
+      const Os::Task::TaskStatus status = tasks[task].join(0);
+      FW_ASSERT(status == Os::Task::TASK_OK, status);
+    }
+  }
+
+  void Tester ::
+    allocTask(void* ptr)
+  {
+    TaskArgs* args = static_cast<TaskArgs*>(ptr);
+    Tester* tester = args->tester;
+    const U32 numBins = tester->component.pool.getNumBins();
+    Fw::Buffer buffers[BUFFERMGR_MAX_NUM_BINS];
+    const U8 fill = static_cast<U8>(args->index + 1);
+    for (U32 cycle = 0; cycle < TASK_CYCLES; ++cycle) {
+      // hold one buffer of each bin at a time
+      for (U32 bin = 0; bin < numBins; ++bin) {
+        const U32 size = tester->component.pool.bins[bin].bufferSize;
+        buffers[bin] = tester->invoke_to_bufferGetCallee(0, size);
+        FW_ASSERT(buffers[bin].getdata() != 0, bin);
+        memset(reinterpret_cast<U8*>(buffers[bin].getdata()), fill, size);
+      }
+      for (U32 bin = 0; bin < numBins; ++bin) {
+        const U8 *const data = reinterpret_cast<U8*>(buffers[bin].getdata());
+        for (U32 byte = 0; byte < buffers[bin].getsize(); ++byte) {
+          if (data[byte] != fill) {
+            __sync_fetch_and_add(&tester->corrupted, 1);
+            break;
+          }
+        }
+        tester->invoke_to_bufferSendIn(0, buffers[bin]);
+      }
+    }
+  }
+
   void Tester ::
     connectPorts(void) 
   {
@@ -78,9 +351,25 @@ namespace Svc {
     );
 
     // bufferGetCallee
-    this->connect_to_bufferGetCallee(
+    for (NATIVE_INT_TYPE i = 0; i < 2; ++i) {
+      this->connect_to_bufferGetCallee(
+          i,
+          this->component.get_bufferGetCallee_InputPort(i)
+      );
+    }
+
+    // bufferHeldIn
+    for (NATIVE_INT_TYPE i = 0; i < 4; ++i) {
+      this->connect_to_bufferHeldIn(
+          i,
+          this->component.get_bufferHeldIn_InputPort(i)
+      );
+    }
+
+    // schedIn
+    this->connect_to_schedIn(
         0,
-        this->component.get_bufferGetCallee_InputPort(0)
+        this->component.get_schedIn_InputPort(0)
     );
 
     // timeCaller
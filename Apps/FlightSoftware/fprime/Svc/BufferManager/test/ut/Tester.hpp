@@ -32,6 +32,13 @@ namespace Svc {
       //!
       Tester(void);
 
+      //! Construct object Tester with a pool BufferManager
+      //!
+      Tester(
+          const BufferManager::Bin *const bins, //!< The bins
+          const U32 numBins //!< The number of bins
+      );
+
       //! Destroy object Tester
       //!
       ~Tester(void);
@@ -43,6 +50,23 @@ namespace Svc {
       // ---------------------------------------------------------------------- 
 
       void three_buffer_problem(void);
+
+      //! Return pool buffers out of order and check none is overwritten
+      void pool_out_of_order(void);
+
+      //! Ask for too large a buffer and use up the pool
+      void pool_exhaustion(void);
+
+      //! Get and return pool buffers from several tasks and check
+      //! no buffer is handed to two tasks at once
+      void pool_concurrent(void);
+
+      //! Track pool buffers and report the ones held too long
+      void pool_tracking(void);
+
+      //! Track store buffers
+      void ring_tracking(void);
+
     private:
 
       // ----------------------------------------------------------------------
@@ -57,6 +81,29 @@ namespace Svc {
       //!
       void initComponents(void);
 
+      //! Set the test time
+      //!
+      void setTime(
+          const U32 seconds, //!< The seconds
+          const U32 useconds //!< The microseconds
+      );
+
+      //! Run numTasks allocation tasks and wait for them to finish
+      //!
+      void runTasks(
+          const U32 numTasks //!< The number of tasks
+      );
+
+      //! Arguments of an allocation task
+      struct TaskArgs {
+        Tester* tester;
+        U32 index;
+      };
+
+      //! Get and return buffers, checking no other task wrote them
+      //!
+      static void allocTask(void* ptr);
+
     private:
 
       // ----------------------------------------------------------------------
@@ -67,6 +114,10 @@ namespace Svc {
       //!
       BufferManager component;
 
+      //! Buffers the allocation tasks found written by another task
+      //!
+      volatile U32 corrupted;
+
   };
 
 } // end namespace Svc
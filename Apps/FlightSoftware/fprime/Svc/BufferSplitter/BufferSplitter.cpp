@@ -0,0 +1,161 @@
+// ====================================================================== 
+// \title  BufferSplitter.cpp
+// \brief  cpp file for BufferSplitter component implementation class
+// ====================================================================== 
+
+#include "Fw/Types/Assert.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+#include "Svc/BufferSplitter/BufferSplitter.hpp"
+
+namespace Svc {
+
+  // ----------------------------------------------------------------------
+  // Construction, initialization, and destruction 
+  // ----------------------------------------------------------------------
+
+  BufferSplitter ::
+    BufferSplitter(const char *const compName) :
+      BufferSplitterComponentBase(compName),
+      numShared(0),
+      numDropped(0)
+  {
+    for (U32 entry = 0; entry < BUFFERSPLITTER_MAX_SHARED_BUFFERS; ++entry) {
+      this->shared[entry].state = FREE;
+      this->shared[entry].references = 0;
+    }
+  }
+
+  void BufferSplitter ::
+    init(const NATIVE_INT_TYPE instance) 
+  {
+    BufferSplitterComponentBase::init(instance);
+  }
+
+  BufferSplitter ::
+    ~BufferSplitter(void)
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void BufferSplitter ::
+    bufferSendIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer &buffer
+    )
+  {
+    U32 numConsumers = 0;
+    for (NATIVE_INT_TYPE port = 0; port < this->getNum_bufferSendOut_OutputPorts(); ++port) {
+      if (this->isConnected_bufferSendOut_OutputPort(port)) {
+        ++numConsumers;
+      }
+    }
+    if (numConsumers == 0) {
+      this->bufferReturnOut_out(0, buffer);
+      return;
+    }
+
+    U32 entry;
+    if (not this->claim(buffer, entry)) {
+      const U32 numDropped = __sync_add_and_fetch(&this->numDropped, 1);
+      this->log_WARNING_HI_TooManySharedBuffers(buffer.getbufferID());
+      this->tlmWrite_BufferSplitter_DroppedBuffers(numDropped);
+      this->bufferReturnOut_out(0, buffer);
+      return;
+    }
+
+    Shared& s = this->shared[entry];
+    s.buffer = buffer;
+    // every consumer is counted before the first is sent the buffer, so a
+    // consumer that returns it at once does not free the entry early
+    s.references = numConsumers;
+    __sync_synchronize();
+    s.state = SHARED;
+    const U32 numShared = __sync_add_and_fetch(&this->numShared, 1);
+    this->tlmWrite_BufferSplitter_SharedBuffers(numShared);
+
+    // the entry can be freed by the last return, so only the local copy
+    // is used from here
+    for (NATIVE_INT_TYPE port = 0; port < this->getNum_bufferSendOut_OutputPorts(); ++port) {
+      if (this->isConnected_bufferSendOut_OutputPort(port)) {
+        // each consumer gets its own copy of the buffer, not of the data
+        Fw::Buffer copy = buffer;
+        this->bufferSendOut_out(port, copy);
+      }
+    }
+  }
+
+  void BufferSplitter ::
+    bufferReturnIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer &buffer
+    )
+  {
+    const U32 entry = this->find(buffer);
+    Shared& s = this->shared[entry];
+    const U32 references = __sync_sub_and_fetch(&s.references, 1);
+    // returned more times than it was sent
+    FW_ASSERT(references < static_cast<U32>(this->getNum_bufferSendOut_OutputPorts()), references);
+    if (references > 0) {
+      return;
+    }
+
+    // the last consumer is done
+    Fw::Buffer original = s.buffer;
+    __sync_synchronize();
+    s.state = FREE;
+    const U32 numShared = __sync_sub_and_fetch(&this->numShared, 1);
+    this->tlmWrite_BufferSplitter_SharedBuffers(numShared);
+    this->bufferReturnOut_out(0, original);
+  }
+
+  // ----------------------------------------------------------------------
+  // Private helper methods
+  // ----------------------------------------------------------------------
+
+  U32 BufferSplitter ::
+    getFirstEntry(const Fw::Buffer& buffer)
+  {
+    return buffer.getbufferID() % BUFFERSPLITTER_MAX_SHARED_BUFFERS;
+  }
+
+  bool BufferSplitter ::
+    claim(
+        const Fw::Buffer& buffer,
+        U32& entry
+    )
+  {
+    const U32 first = getFirstEntry(buffer);
+    for (U32 i = 0; i < BUFFERSPLITTER_MAX_SHARED_BUFFERS; ++i) {
+      entry = (first + i) % BUFFERSPLITTER_MAX_SHARED_BUFFERS;
+      if (__sync_bool_compare_and_swap(&this->shared[entry].state, FREE, CLAIMED)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  U32 BufferSplitter ::
+    find(const Fw::Buffer& buffer)
+  {
+    // entries are freed in any order, so every entry may have to be checked
+    const U32 first = getFirstEntry(buffer);
+    for (U32 i = 0; i < BUFFERSPLITTER_MAX_SHARED_BUFFERS; ++i) {
+      const U32 entry = (first + i) % BUFFERSPLITTER_MAX_SHARED_BUFFERS;
+      const Shared& s = this->shared[entry];
+      if ((s.state == SHARED) &&
+          (s.buffer.getmanagerID() == buffer.getmanagerID()) &&
+          (s.buffer.getbufferID() == buffer.getbufferID()) &&
+          (s.buffer.getdata() == buffer.getdata())) {
+        return entry;
+      }
+    }
+    // never sent, or returned by every consumer already
+    FW_ASSERT(0, buffer.getmanagerID(), buffer.getbufferID());
+    return 0;
+  }
+
+}
@@ -0,0 +1,124 @@
+// ====================================================================== 
+// \title  BufferSplitter.hpp
+// \brief  hpp file for BufferSplitter component implementation class
+// ====================================================================== 
+
+#ifndef BufferSplitter_HPP
+#define BufferSplitter_HPP
+
+#include "Svc/BufferSplitter/BufferSplitterComponentAc.hpp"
+#include "Svc/BufferSplitter/BufferSplitterCfg.hpp"
+
+namespace Svc {
+
+  //! Sends each buffer to every connected consumer without copying it.
+  //! The consumers return the buffer to the splitter, which returns it to
+  //! its manager when the last consumer is done. Consumers may only read
+  //! the buffer
+  class BufferSplitter :
+    public BufferSplitterComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction, initialization, and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object BufferSplitter
+      //!
+      BufferSplitter(
+          const char *const compName //!< The component name
+      );
+
+      //! Initialize object BufferSplitter
+      //!
+      void init(
+          const NATIVE_INT_TYPE instance //!< The instance number
+      );
+
+      //! Destroy object BufferSplitter
+      //!
+      ~BufferSplitter(void);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for user-defined typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for bufferSendIn
+      //!
+      void bufferSendIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer &buffer
+      );
+
+      //! Handler implementation for bufferReturnIn
+      //!
+      void bufferReturnIn_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer &buffer
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      enum {
+        // The entry is not used
+        FREE,
+        // A buffer is being put in the entry
+        CLAIMED,
+        // The entry holds a buffer some consumer has
+        SHARED
+      };
+
+      // ----------------------------------------------------------------------
+      // Variables 
+      // ----------------------------------------------------------------------
+
+      //! A shared buffer. The buffer goes back to its manager when the
+      //! reference count reaches zero. Consumers can return buffers on
+      //! several threads, so the state and count change atomically
+      struct Shared {
+        volatile U32 state; //!< FREE, CLAIMED or SHARED
+        volatile U32 references; //!< Consumers that have not returned the buffer
+        Fw::Buffer buffer; //!< The buffer as it arrived
+      } shared[BUFFERSPLITTER_MAX_SHARED_BUFFERS];
+
+      //! The number of SHARED entries
+      volatile U32 numShared;
+
+      //! The number of buffers returned unsent
+      volatile U32 numDropped;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Private helper methods
+      // ----------------------------------------------------------------------
+
+      //! Get the entry to look in first for a buffer
+      static U32 getFirstEntry(
+          const Fw::Buffer& buffer //!< The buffer
+      );
+
+      //! Claim a free entry for a buffer. Returns false if none is free
+      bool claim(
+          const Fw::Buffer& buffer, //!< The buffer
+          U32& entry //!< The entry
+      );
+
+      //! Find the entry holding a buffer. Asserts if there is none
+      U32 find(
+          const Fw::Buffer& buffer //!< The buffer
+      );
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,18 @@
+// ======================================================================
+// \title  BufferSplitterCfg.hpp
+// \brief  Configuration for the BufferSplitter component
+//
+// ======================================================================
+
+#ifndef BufferSplitterCfg_HPP
+#define BufferSplitterCfg_HPP
+
+// Each buffer a BufferSplitter has sent and not had back from every
+// consumer takes an entry. A buffer that arrives when every entry is in
+// use goes straight back to its manager.
+
+enum {
+  BUFFERSPLITTER_MAX_SHARED_BUFFERS = 16 //!< The most buffers shared at once
+};
+
+#endif
@@ -0,0 +1,7 @@
+# ---------------------------------------------------------------------- 
+# mod.mk
+# ---------------------------------------------------------------------- 
+
+SRC = BufferSplitterComponentAi.xml BufferSplitter.cpp
+
+HDR = BufferSplitter.hpp BufferSplitterCfg.hpp
@@ -0,0 +1,30 @@
+// ----------------------------------------------------------------------
+// Main.cpp 
+// ----------------------------------------------------------------------
+
+#include "Tester.hpp"
+
+TEST(Test, ShareBuffer) {
+  Svc::Tester tester;
+  tester.share_buffer();
+}
+
+TEST(Test, OutOfOrder) {
+  Svc::Tester tester;
+  tester.out_of_order();
+}
+
+TEST(Test, ReturnAtOnce) {
+  Svc::Tester tester;
+  tester.return_at_once();
+}
+
+TEST(Test, TooManyBuffers) {
+  Svc::Tester tester;
+  tester.too_many_buffers();
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
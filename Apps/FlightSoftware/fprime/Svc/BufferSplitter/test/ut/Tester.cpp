@@ -0,0 +1,268 @@
+// ====================================================================== 
+// \title  BufferSplitter/test/ut/Tester.cpp
+// \brief  cpp file for BufferSplitter test harness implementation class
+// ====================================================================== 
+
+#include "Tester.hpp"
+
+#define INSTANCE 0
+#define MAX_HISTORY_SIZE 100
+#define MANAGER_ID 3
+
+namespace Svc {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction 
+  // ----------------------------------------------------------------------
+
+  Tester ::
+    Tester(void) : 
+#if FW_OBJECT_NAMES == 1
+      BufferSplitterGTestBase("Tester", MAX_HISTORY_SIZE),
+      component("BufferSplitter"),
+#else
+      BufferSplitterGTestBase(MAX_HISTORY_SIZE),
+      component(),
+#endif
+      returnAtOnce(false)
+  {
+    for (U32 port = 0; port < FW_NUM_ARRAY_ELEMENTS(this->numSent); ++port) {
+      this->numSent[port] = 0;
+    }
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  Tester ::
+    ~Tester(void) 
+  {
+    
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests 
+  // ----------------------------------------------------------------------
+
+  void Tester ::
+    share_buffer(void) 
+  {
+      Fw::Buffer buffer = this->makeBuffer(7);
+      this->invoke_to_bufferSendIn(0, buffer);
+      // the same data goes to every consumer
+      ASSERT_from_bufferSendOut_SIZE(3);
+      for (U32 port = 0; port < 3; ++port) {
+        ASSERT_EQ((U32)1, this->numSent[port]);
+        const Fw::Buffer& sent = this->fromPortHistory_bufferSendOut->at(port).fwBuffer;
+        ASSERT_EQ(buffer.getdata(), sent.getdata());
+        ASSERT_EQ(buffer.getbufferID(), sent.getbufferID());
+        ASSERT_EQ(buffer.getmanagerID(), sent.getmanagerID());
+      }
+      ASSERT_TLM_BufferSplitter_SharedBuffers_SIZE(1);
+      ASSERT_TLM_BufferSplitter_SharedBuffers(0, 1);
+
+      // a consumer's copy is its own
+      Fw::Buffer copy = this->fromPortHistory_bufferSendOut->at(0).fwBuffer;
+      copy.setsize(4);
+      this->invoke_to_bufferReturnIn(0, copy);
+      copy = this->fromPortHistory_bufferSendOut->at(2).fwBuffer;
+      this->invoke_to_bufferReturnIn(2, copy);
+      ASSERT_from_bufferReturnOut_SIZE(0);
+
+      // the last return sends the buffer back to the manager as it arrived
+      copy = this->fromPortHistory_bufferSendOut->at(1).fwBuffer;
+      this->invoke_to_bufferReturnIn(1, copy);
+      ASSERT_from_bufferReturnOut_SIZE(1);
+      const Fw::Buffer& returned = this->fromPortHistory_bufferReturnOut->at(0).fwBuffer;
+      ASSERT_EQ(buffer.getdata(), returned.getdata());
+      ASSERT_EQ(buffer.getbufferID(), returned.getbufferID());
+      ASSERT_EQ(buffer.getsize(), returned.getsize());
+      ASSERT_TLM_BufferSplitter_SharedBuffers_SIZE(2);
+      ASSERT_TLM_BufferSplitter_SharedBuffers(1, 0);
+      ASSERT_EVENTS_SIZE(0);
+  }
+
+  void Tester ::
+    out_of_order(void) 
+  {
+      // ids that look in the same entry first
+      Fw::Buffer buffer1 = this->makeBuffer(1);
+      Fw::Buffer buffer2 = this->makeBuffer(1 + BUFFERSPLITTER_MAX_SHARED_BUFFERS);
+      this->invoke_to_bufferSendIn(0, buffer1);
+      this->invoke_to_bufferSendIn(0, buffer2);
+      ASSERT_from_bufferSendOut_SIZE(6);
+      for (U32 port = 0; port < 3; ++port) {
+        this->invoke_to_bufferReturnIn(port, buffer2);
+        if (port < 2) {
+          this->invoke_to_bufferReturnIn(port, buffer1);
+        }
+      }
+      // buffer 2 went back first
+      ASSERT_from_bufferReturnOut_SIZE(1);
+      ASSERT_EQ(buffer2.getbufferID(),
+          this->fromPortHistory_bufferReturnOut->at(0).fwBuffer.getbufferID());
+      this->invoke_to_bufferReturnIn(2, buffer1);
+      ASSERT_from_bufferReturnOut_SIZE(2);
+      ASSERT_EQ(buffer1.getbufferID(),
+          this->fromPortHistory_bufferReturnOut->at(1).fwBuffer.getbufferID());
+      ASSERT_EQ((U32)0, this->component.numShared);
+  }
+
+  void Tester ::
+    return_at_once(void) 
+  {
+      this->returnAtOnce = true;
+      Fw::Buffer buffer = this->makeBuffer(5);
+      this->invoke_to_bufferSendIn(0, buffer);
+      ASSERT_from_bufferSendOut_SIZE(3);
+      ASSERT_from_bufferReturnOut_SIZE(1);
+      // the entry is free again
+      this->invoke_to_bufferSendIn(0, buffer);
+      ASSERT_from_bufferSendOut_SIZE(6);
+      ASSERT_from_bufferReturnOut_SIZE(2);
+      ASSERT_EQ((U32)0, this->component.numShared);
+  }
+
+  void Tester ::
+    too_many_buffers(void) 
+  {
+      for (U32 id = 0; id < BUFFERSPLITTER_MAX_SHARED_BUFFERS; ++id) {
+        Fw::Buffer buffer = this->makeBuffer(id);
+        this->invoke_to_bufferSendIn(0, buffer);
+      }
+      ASSERT_EVENTS_SIZE(0);
+      ASSERT_from_bufferReturnOut_SIZE(0);
+
+      // no entry left, so it goes back unsent
+      this->clearHistory();
+      Fw::Buffer extra = this->makeBuffer(BUFFERSPLITTER_MAX_SHARED_BUFFERS);
+      this->invoke_to_bufferSendIn(0, extra);
+      ASSERT_from_bufferSendOut_SIZE(0);
+      ASSERT_from_bufferReturnOut_SIZE(1);
+      ASSERT_EVENTS_TooManySharedBuffers_SIZE(1);
+      ASSERT_EVENTS_TooManySharedBuffers(0, BUFFERSPLITTER_MAX_SHARED_BUFFERS);
+      ASSERT_TLM_BufferSplitter_DroppedBuffers_SIZE(1);
+      ASSERT_TLM_BufferSplitter_DroppedBuffers(0, 1);
+
+      // a returned buffer frees its entry
+      Fw::Buffer buffer = this->makeBuffer(3);
+      for (U32 port = 0; port < 3; ++port) {
+        this->invoke_to_bufferReturnIn(port, buffer);
+      }
+      this->clearHistory();
+      this->invoke_to_bufferSendIn(0, extra);
+      ASSERT_from_bufferSendOut_SIZE(3);
+      ASSERT_from_bufferReturnOut_SIZE(0);
+      ASSERT_EVENTS_SIZE(0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  void Tester ::
+    from_bufferSendOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer &fwBuffer
+    )
+  {
+    this->pushFromPortEntry_bufferSendOut(fwBuffer);
+    ++this->numSent[portNum];
+    if (this->returnAtOnce) {
+      this->invoke_to_bufferReturnIn(portNum, fwBuffer);
+    }
+  }
+
+  void Tester ::
+    from_bufferReturnOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer &fwBuffer
+    )
+  {
+    this->pushFromPortEntry_bufferReturnOut(fwBuffer);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper methods 
+  // ----------------------------------------------------------------------
+
+  Fw::Buffer Tester ::
+    makeBuffer(const U32 bufferID)
+  {
+    FW_ASSERT(bufferID < FW_NUM_ARRAY_ELEMENTS(this->data), bufferID);
+    Fw::Buffer buffer(
+        MANAGER_ID,
+        bufferID,
+        reinterpret_cast<U64>(this->data[bufferID]),
+        sizeof(this->data[bufferID])
+    );
+    return buffer;
+  }
+
+  void Tester ::
+    connectPorts(void) 
+  {
+
+    // bufferSendIn
+    this->connect_to_bufferSendIn(
+        0,
+        this->component.get_bufferSendIn_InputPort(0)
+    );
+
+    // bufferReturnIn
+    for (NATIVE_INT_TYPE i = 0; i < 3; ++i) {
+      this->connect_to_bufferReturnIn(
+          i,
+          this->component.get_bufferReturnIn_InputPort(i)
+      );
+    }
+
+    // bufferSendOut
+    for (NATIVE_INT_TYPE i = 0; i < 3; ++i) {
+      this->component.set_bufferSendOut_OutputPort(
+          i, 
+          this->get_from_bufferSendOut(i)
+      );
+    }
+
+    // bufferReturnOut
+    this->component.set_bufferReturnOut_OutputPort(
+        0, 
+        this->get_from_bufferReturnOut(0)
+    );
+
+    // timeCaller
+    this->component.set_timeCaller_OutputPort(
+        0, 
+        this->get_from_timeCaller(0)
+    );
+
+    // eventOut
+    this->component.set_eventOut_OutputPort(
+        0, 
+        this->get_from_eventOut(0)
+    );
+
+    // textEventOut
+    this->component.set_textEventOut_OutputPort(
+        0, 
+        this->get_from_textEventOut(0)
+    );
+
+    // tlmOut
+    this->component.set_tlmOut_OutputPort(
+        0, 
+        this->get_from_tlmOut(0)
+    );
+
+  }
+
+  void Tester ::
+    initComponents(void) 
+  {
+    this->init();
+    this->component.init(
+        INSTANCE
+    );
+  }
+
+} // end namespace Svc
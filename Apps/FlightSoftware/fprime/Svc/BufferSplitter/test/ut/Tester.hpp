@@ -0,0 +1,117 @@
+// ====================================================================== 
+// \title  BufferSplitter/test/ut/Tester.hpp
+// \brief  hpp file for BufferSplitter test harness implementation class
+// ====================================================================== 
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "GTestBase.hpp"
+#include "Svc/BufferSplitter/BufferSplitter.hpp"
+
+namespace Svc {
+
+  class Tester :
+    public BufferSplitterGTestBase
+  {
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+    public:
+
+      //! Construct object Tester
+      //!
+      Tester(void);
+
+      //! Destroy object Tester
+      //!
+      ~Tester(void);
+
+    public:
+
+      // ---------------------------------------------------------------------- 
+      // Tests
+      // ---------------------------------------------------------------------- 
+
+      //! Send a buffer to every consumer and return it after the last
+      void share_buffer(void);
+
+      //! Return two shared buffers in interleaved order
+      void out_of_order(void);
+
+      //! Consumers that return the buffer before the splitter has sent it
+      //! to every consumer
+      void return_at_once(void);
+
+      //! Share more buffers than the splitter has entries for
+      void too_many_buffers(void);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler for from_bufferSendOut
+      //!
+      void from_bufferSendOut_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer &fwBuffer 
+      );
+
+      //! Handler for from_bufferReturnOut
+      //!
+      void from_bufferReturnOut_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          Fw::Buffer &fwBuffer 
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper methods
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      //!
+      void connectPorts(void);
+
+      //! Initialize components
+      //!
+      void initComponents(void);
+
+      //! Make a buffer
+      //!
+      Fw::Buffer makeBuffer(
+          const U32 bufferID //!< The buffer id
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      //!
+      BufferSplitter component;
+
+      //! Data of the buffers
+      //!
+      U8 data[2 * BUFFERSPLITTER_MAX_SHARED_BUFFERS][16];
+
+      //! Buffers sent to each consumer
+      //!
+      U32 numSent[BufferSplitterComponentBase::NUM_BUFFERSENDOUT_OUTPUT_PORTS];
+
+      //! Whether the consumers return buffers as soon as they get them
+      //!
+      bool returnAtOnce;
+
+  };
+
+} // end namespace Svc
+
+#endif
@@ -7,6 +7,7 @@
 
 #include <Svc/CmdDispatcher/CommandDispatcherImpl.hpp>
 #include <Fw/Cmd/CmdPacket.hpp>
+#include <Fw/Com/ComPacket.hpp>
 #include <Fw/Types/Assert.hpp>
 #include <stdio.h>
 
@@ -17,15 +18,43 @@ namespace Svc {
 #else
     CommandDispatcherImpl::CommandDispatcherImpl() :
 #endif
-    m_seq(0), m_numCmdsDispatched(0), m_numCmdErrors(0)
+    m_numEntries(0), m_numPending(0), m_ticks(0), m_numTimeouts(0), m_latencySamples(0),
+    m_lanesPending(0), m_seq(0), m_numCmdsDispatched(0), m_numCmdErrors(0)
     {
+        // keep the table at most half full so probe sequences stay short
+        FW_ASSERT(CMD_DISPATCHER_DISPATCH_TABLE_SLOTS >= 2*CMD_DISPATCHER_DISPATCH_TABLE_SIZE,
+                CMD_DISPATCHER_DISPATCH_TABLE_SLOTS,CMD_DISPATCHER_DISPATCH_TABLE_SIZE);
         memset(this->m_entryTable,0,sizeof(this->m_entryTable));
-        memset(this->m_sequenceTracker,0,sizeof(this->m_sequenceTracker));
+        // sequence numbers index the tracker, so it wraps with them
+        FW_ASSERT(0 == (CMD_DISPATCHER_SEQUENCER_TABLE_SIZE & (CMD_DISPATCHER_SEQUENCER_TABLE_SIZE - 1)),
+                CMD_DISPATCHER_SEQUENCER_TABLE_SIZE);
+        for (NATIVE_UINT_TYPE entry = 0; entry < FW_NUM_ARRAY_ELEMENTS(this->m_sequenceTracker); entry++) {
+            this->m_sequenceTracker[entry].used = false;
+            this->m_sequenceTracker[entry].seq = 0;
+            this->m_sequenceTracker[entry].opCode = 0;
+            this->m_sequenceTracker[entry].context = 0;
+            this->m_sequenceTracker[entry].callerPort = 0;
+            this->m_sequenceTracker[entry].timeout = 0;
+            this->m_sequenceTracker[entry].deadline = 0;
+        }
+        memset(this->m_latencyBuckets,0,sizeof(this->m_latencyBuckets));
+        this->m_lanes[CMD_PRIORITY_HIGH].setup(this->m_highLane,FW_NUM_ARRAY_ELEMENTS(this->m_highLane));
+        this->m_lanes[CMD_PRIORITY_NORMAL].setup(this->m_normalLane,FW_NUM_ARRAY_ELEMENTS(this->m_normalLane));
+        this->m_lanes[CMD_PRIORITY_LOW].setup(this->m_lowLane,FW_NUM_ARRAY_ELEMENTS(this->m_lowLane));
+        for (NATIVE_UINT_TYPE port = 0; port < FW_NUM_ARRAY_ELEMENTS(this->m_portPriority); port++) {
+            this->m_portPriority[port] = CMD_PRIORITY_NORMAL;
+        }
     }
 
     CommandDispatcherImpl::~CommandDispatcherImpl() {
     }
 
+    void CommandDispatcherImpl::setPortPriority(NATIVE_INT_TYPE portNum, CmdPriority priority) {
+        FW_ASSERT(portNum >= 0 and portNum < NUM_SEQCMDBUFF_INPUT_PORTS,portNum);
+        FW_ASSERT(priority >= 0 and priority < CMD_PRIORITY_MAX,priority);
+        this->m_portPriority[portNum] = priority;
+    }
+
     void CommandDispatcherImpl::init(
             NATIVE_INT_TYPE queueDepth, /*!< The queue depth*/
             NATIVE_INT_TYPE instance /*!< The instance number*/
@@ -34,20 +63,38 @@ namespace Svc {
     }
 
     void CommandDispatcherImpl::compCmdReg_handler(NATIVE_INT_TYPE portNum, FwOpcodeType opCode) {
-        // search for an empty slot
-        bool slotFound = false;
-        for (U32 slot = 0; slot < FW_NUM_ARRAY_ELEMENTS(this->m_entryTable); slot++) {
-            if ((not this->m_entryTable[slot].used) and (not slotFound)) {
-                this->m_entryTable[slot].opcode = opCode;
-                this->m_entryTable[slot].port = portNum;
-                this->m_entryTable[slot].used = true;
-                this->log_DIAGNOSTIC_OpCodeRegistered(opCode,portNum,slot);
-                slotFound = true;
-            } else if (this->m_entryTable[slot].used) { // make sure no duplicates
-                FW_ASSERT(this->m_entryTable[slot].opcode != opCode, opCode);
+        // CMD_DISPATCHER_DISPATCH_TABLE_SIZE is too small for the topology
+        FW_ASSERT(this->m_numEntries < CMD_DISPATCHER_DISPATCH_TABLE_SIZE,opCode,this->m_numEntries);
+        // probe from the hashed slot for an empty slot
+        NATIVE_UINT_TYPE slot = this->hashOpcode(opCode);
+        while (this->m_entryTable[slot].used) {
+            // make sure no duplicates
+            FW_ASSERT(this->m_entryTable[slot].opcode != opCode, opCode);
+            slot = (slot + 1) & (CMD_DISPATCHER_DISPATCH_TABLE_SLOTS - 1);
+        }
+        this->m_entryTable[slot].opcode = opCode;
+        this->m_entryTable[slot].port = portNum;
+        this->m_entryTable[slot].timeout = CMD_DISPATCHER_DEFAULT_TIMEOUT;
+        this->m_entryTable[slot].used = true;
+        this->m_numEntries++;
+        this->log_DIAGNOSTIC_OpCodeRegistered(opCode,portNum,slot);
+    }
+
+    NATIVE_UINT_TYPE CommandDispatcherImpl::hashOpcode(FwOpcodeType opCode) {
+        // multiplicative hash with Knuth's constant; top bits of the product select the slot
+        return (static_cast<U32>(opCode) * 2654435761U) >> (32 - CMD_DISPATCHER_DISPATCH_TABLE_BITS);
+    }
+
+    NATIVE_INT_TYPE CommandDispatcherImpl::findOpcode(FwOpcodeType opCode) {
+        // the table is never full, so the probe always reaches an unused slot
+        NATIVE_UINT_TYPE slot = this->hashOpcode(opCode);
+        while (this->m_entryTable[slot].used) {
+            if (this->m_entryTable[slot].opcode == opCode) {
+                return slot;
             }
+            slot = (slot + 1) & (CMD_DISPATCHER_DISPATCH_TABLE_SLOTS - 1);
         }
-        FW_ASSERT(slotFound,opCode);
+        return CMD_DISPATCHER_NO_ENTRY;
     }
 
     void CommandDispatcherImpl::compCmdStat_handler(NATIVE_INT_TYPE portNum, FwOpcodeType opCode, U32 cmdSeq, Fw::CommandResponse response) {
@@ -83,81 +130,225 @@ namespace Svc {
             }
             this->log_WARNING_HI_OpCodeError(opCode,evrResp);
         }
-        // look for command source
-        NATIVE_INT_TYPE portToCall = -1;
-        U32 context;
-        for (U32 pending = 0; pending < FW_NUM_ARRAY_ELEMENTS(this->m_sequenceTracker); pending++) {
-            if (
-                    (this->m_sequenceTracker[pending].seq == cmdSeq) &&
-                    (this->m_sequenceTracker[pending].used)
-                ) {
-                portToCall = this->m_sequenceTracker[pending].callerPort;
-                context = this->m_sequenceTracker[pending].context;
-                FW_ASSERT(opCode == this->m_sequenceTracker[pending].opCode);
-                FW_ASSERT(portToCall < this->getNum_seqCmdStatus_OutputPorts());
-                this->m_sequenceTracker[pending].used = false;
-                break;
-            }
-        }
+        // look for command source. The sequence number indexes the tracker
+        NATIVE_UINT_TYPE pending = cmdSeq & (CMD_DISPATCHER_SEQUENCER_TABLE_SIZE - 1);
+        if (
+                (this->m_sequenceTracker[pending].used) &&
+                (this->m_sequenceTracker[pending].seq == cmdSeq)
+            ) {
+            NATIVE_INT_TYPE portToCall = this->m_sequenceTracker[pending].callerPort;
+            U32 context = this->m_sequenceTracker[pending].context;
+            FW_ASSERT(opCode == this->m_sequenceTracker[pending].opCode);
+            FW_ASSERT(portToCall < this->getNum_seqCmdStatus_OutputPorts());
+            this->addLatency(this->m_sequenceTracker[pending].dispatchTime);
+            this->releaseTracker(pending);
 
-        if (portToCall != -1) {
             // call port to report status
             if (this->isConnected_seqCmdStatus_OutputPort(portToCall)) {
                 this->seqCmdStatus_out(portToCall,opCode,context,response);
             }
         }
+        // otherwise the command wasn't tracked, or timed out and was already reported
     }
 
     void CommandDispatcherImpl::seqCmdBuff_handler(NATIVE_INT_TYPE portNum, Fw::ComBuffer &data, U32 context) {
 
-        Fw::CmdPacket cmdPkt;
-        Fw::SerializeStatus stat = cmdPkt.deserialize(data);
+        FW_ASSERT(portNum >= 0 and portNum < NUM_SEQCMDBUFF_INPUT_PORTS,portNum);
+        NATIVE_UINT_TYPE lane = this->m_portPriority[portNum];
 
-        if (stat != Fw::FW_SERIALIZE_OK) {
-            CmdSerError serErr = ERR_UNEXP_STAT;
-            switch (stat) {
-                case Fw::FW_DESERIALIZE_BUFFER_EMPTY:
-                    serErr = ERR_BUFFER_TOO_SMALL;
-                    break;
-                case Fw::FW_DESERIALIZE_FORMAT_ERROR:
-                    serErr = ERR_BUFFER_FORMAT;
-                    break;
-                case Fw::FW_DESERIALIZE_SIZE_MISMATCH:
-                    serErr = ERR_SIZE_MISMATCH;
-                    break;
-                case Fw::FW_DESERIALIZE_TYPE_MISMATCH:
-                    serErr = ERR_TYPE_MISMATCH;
-                    break;
-                case Fw::FW_SERIALIZE_OK:
-                    FW_ASSERT(0); // should never get here
-                    break;
-                default:
-                    serErr = ERR_UNEXP_STAT;
+        // put packet in its lane and wake up the dispatcher thread. One message covers
+        // every packet put in the lanes until the thread empties them.
+        if (this->putLane(lane,portNum,data,context)) {
+            if (__sync_bool_compare_and_swap(&this->m_lanesPending,0,1)) {
+                NATIVE_INT_TYPE dropped = this->getNumMsgsDropped();
+                this->cmdReady_internalInterfaceInvoke(lane);
+                // the queue was full and the message was dropped, so let the next
+                // packet send another one. schedIn also empties the lanes, which
+                // covers a drop that wasn't seen here.
+                if (this->getNumMsgsDropped() != dropped) {
+                    this->m_lanesPending = 0;
+                }
+            }
+            return;
+        }
+
+        // lane is full. Return the packet to the sender rather than wait for room
+        FW_ASSERT(CMD_DISPATCHER_LANE_FULL_BUSY,portNum,lane);
+        if (this->isConnected_seqCmdStatus_OutputPort(portNum)) {
+            this->seqCmdStatus_out(portNum,peekOpcode(data),context,Fw::COMMAND_BUSY);
+        }
+    }
+
+    void CommandDispatcherImpl::cmdReady_internalInterfaceHandler(U32 lane) {
+        FW_ASSERT(lane < CMD_PRIORITY_MAX,lane);
+        this->drainLanes();
+    }
+
+    bool CommandDispatcherImpl::putLane(NATIVE_UINT_TYPE lane, NATIVE_INT_TYPE portNum, Fw::ComBuffer &data, U32 context) {
+
+        FW_ASSERT(lane < CMD_PRIORITY_MAX,lane);
+
+        // no entry means the lane is full. The ring counts the busy packet.
+        U32 pos;
+        LaneEntry* entry = this->m_lanes[lane].claim(pos);
+        if (0 == entry) {
+            return false;
+        }
+
+        entry->portNum = portNum;
+        entry->context = context;
+        entry->data = data;
+        this->m_lanes[lane].publish(pos);
+        return true;
+    }
+
+    bool CommandDispatcherImpl::takeLane(NATIVE_UINT_TYPE lane) {
+
+        FW_ASSERT(lane < CMD_PRIORITY_MAX,lane);
+
+        // empty, or the caller that claimed it hasn't finished. That caller sends a message when done.
+        LaneEntry* entry = this->m_lanes[lane].front();
+        if (0 == entry) {
+            return false;
+        }
+
+        entry->data.resetDeser();
+        this->dispatchBuffer(entry->portNum,entry->data,entry->context);
+        this->m_lanes[lane].pop();
+        return true;
+    }
+
+    void CommandDispatcherImpl::drainLanes(void) {
+
+        // clear first, so a packet put in a lane after this sends another message
+        this->m_lanesPending = 0;
+        __sync_synchronize();
+
+        // take one packet at a time from the highest lane that has one, so
+        // urgent commands put in while draining go ahead of the rest
+        bool dispatched = true;
+        while (dispatched) {
+            dispatched = false;
+            for (NATIVE_UINT_TYPE lane = 0; lane < CMD_PRIORITY_MAX; lane++) {
+                if (this->takeLane(lane)) {
+                    dispatched = true;
                     break;
+                }
             }
-            this->log_WARNING_HI_MalformedCommand(serErr);
-            if (this->isConnected_seqCmdStatus_OutputPort(portNum)) {
-                this->seqCmdStatus_out(portNum,cmdPkt.getOpCode(),context,Fw::COMMAND_VALIDATION_ERROR);
+        }
+
+        this->writeLaneTlm();
+    }
+
+    void CommandDispatcherImpl::writeLaneTlm(void) {
+        this->tlmWrite_HighLaneHighWater(this->m_lanes[CMD_PRIORITY_HIGH].getHighWater());
+        this->tlmWrite_NormalLaneHighWater(this->m_lanes[CMD_PRIORITY_NORMAL].getHighWater());
+        this->tlmWrite_LowLaneHighWater(this->m_lanes[CMD_PRIORITY_LOW].getHighWater());
+        this->tlmWrite_HighLaneBusy(this->m_lanes[CMD_PRIORITY_HIGH].getOverflows());
+        this->tlmWrite_NormalLaneBusy(this->m_lanes[CMD_PRIORITY_NORMAL].getOverflows());
+        this->tlmWrite_LowLaneBusy(this->m_lanes[CMD_PRIORITY_LOW].getOverflows());
+    }
+
+    FwOpcodeType CommandDispatcherImpl::peekOpcode(Fw::ComBuffer &data) {
+        // the packet isn't decoded yet. A batch or a short packet reports 0
+        FwPacketDescriptorType desc = 0;
+        FwOpcodeType opCode = 0;
+        data.resetDeser();
+        if ((Fw::FW_SERIALIZE_OK == data.deserialize(desc)) and
+                (static_cast<FwPacketDescriptorType>(Fw::ComPacket::FW_PACKET_COMMAND) == desc)) {
+            if (Fw::FW_SERIALIZE_OK != data.deserialize(opCode)) {
+                opCode = 0;
             }
+        }
+        data.resetDeser();
+        return opCode;
+    }
+
+    void CommandDispatcherImpl::dispatchBuffer(NATIVE_INT_TYPE portNum, Fw::ComBuffer &data, U32 context) {
+
+        // a batch carries several command packets, each preceded by its length
+        FwPacketDescriptorType desc;
+        if ((Fw::FW_SERIALIZE_OK == data.deserialize(desc)) and
+                (static_cast<FwPacketDescriptorType>(Fw::ComPacket::FW_PACKET_COMMAND_BATCH) == desc)) {
+            this->dispatchBatch(portNum,data,context);
             return;
         }
+        data.resetDeser();
+        this->dispatchCommand(portNum,data,context);
+    }
 
-        // search for opcode in dispatch table
-        U32 entry;
-        bool entryFound = false;
+    void CommandDispatcherImpl::dispatchBatch(NATIVE_INT_TYPE portNum, Fw::ComBuffer &data, U32 context) {
 
-        for (entry = 0; entry < FW_NUM_ARRAY_ELEMENTS(this->m_entryTable); entry++) {
-            if ((this->m_entryTable[entry].used) and (cmdPkt.getOpCode() == this->m_entryTable[entry].opcode)) {
-                entryFound = true;
-                break;
+        Fw::ComBuffer cmdBuff;
+        while (data.getBuffLeft() > 0) {
+            U32 cmdSize = 0;
+            Fw::SerializeStatus stat = data.deserialize(cmdSize);
+            if ((Fw::FW_SERIALIZE_OK == stat) and (cmdSize > data.getBuffLeft())) {
+                stat = Fw::FW_DESERIALIZE_SIZE_MISMATCH;
+            }
+            if (stat != Fw::FW_SERIALIZE_OK) {
+                // the rest of the batch can't be found, so it is dropped
+                this->reportMalformed(portNum,0,context,stat);
+                return;
             }
+            cmdBuff.resetSer();
+            stat = data.copyRawOffset(cmdBuff,cmdSize);
+            // a command can't be larger than the batch holding it
+            FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,stat);
+            this->dispatchCommand(portNum,cmdBuff,context);
+        }
+    }
+
+    void CommandDispatcherImpl::reportMalformed(NATIVE_INT_TYPE portNum, FwOpcodeType opCode, U32 context, Fw::SerializeStatus stat) {
+        CmdSerError serErr = ERR_UNEXP_STAT;
+        switch (stat) {
+            case Fw::FW_DESERIALIZE_BUFFER_EMPTY:
+                serErr = ERR_BUFFER_TOO_SMALL;
+                break;
+            case Fw::FW_DESERIALIZE_FORMAT_ERROR:
+                serErr = ERR_BUFFER_FORMAT;
+                break;
+            case Fw::FW_DESERIALIZE_SIZE_MISMATCH:
+                serErr = ERR_SIZE_MISMATCH;
+                break;
+            case Fw::FW_DESERIALIZE_TYPE_MISMATCH:
+                serErr = ERR_TYPE_MISMATCH;
+                break;
+            case Fw::FW_SERIALIZE_OK:
+                FW_ASSERT(0); // should never get here
+                break;
+            default:
+                serErr = ERR_UNEXP_STAT;
+                break;
+        }
+        this->log_WARNING_HI_MalformedCommand(serErr);
+        if (this->isConnected_seqCmdStatus_OutputPort(portNum)) {
+            this->seqCmdStatus_out(portNum,opCode,context,Fw::COMMAND_VALIDATION_ERROR);
+        }
+    }
+
+    void CommandDispatcherImpl::dispatchCommand(NATIVE_INT_TYPE portNum, Fw::ComBuffer &data, U32 context) {
+
+        Fw::CmdPacket cmdPkt;
+        Fw::SerializeStatus stat = cmdPkt.deserialize(data);
+
+        if (stat != Fw::FW_SERIALIZE_OK) {
+            this->reportMalformed(portNum,cmdPkt.getOpCode(),context,stat);
+            return;
         }
+
+        // look up opcode in dispatch table
+        NATIVE_INT_TYPE entry = this->findOpcode(cmdPkt.getOpCode());
+        bool entryFound = (entry != CMD_DISPATCHER_NO_ENTRY);
+
         if (entryFound and this->isConnected_compCmdSend_OutputPort(this->m_entryTable[entry].port)) {
             // register command in command tracker only if response port is connect
             if (this->isConnected_seqCmdStatus_OutputPort(portNum)) {
                 bool pendingFound = false;
 
-                for (U32 pending = 0; pending < FW_NUM_ARRAY_ELEMENTS(this->m_sequenceTracker); pending++) {
+                // skip sequence numbers whose tracker entry is still in use
+                for (U32 probe = 0; probe < CMD_DISPATCHER_SEQUENCER_TABLE_SIZE; probe++) {
+                    NATIVE_UINT_TYPE pending = this->m_seq & (CMD_DISPATCHER_SEQUENCER_TABLE_SIZE - 1);
                     if (not this->m_sequenceTracker[pending].used) {
                         pendingFound = true;
                         this->m_sequenceTracker[pending].used = true;
@@ -165,8 +356,14 @@ namespace Svc {
                         this->m_sequenceTracker[pending].seq = this->m_seq;
                         this->m_sequenceTracker[pending].context = context;
                         this->m_sequenceTracker[pending].callerPort = portNum;
+                        this->m_sequenceTracker[pending].timeout = this->m_entryTable[entry].timeout;
+                        this->m_sequenceTracker[pending].deadline = this->m_ticks + this->m_entryTable[entry].timeout;
+                        this->m_sequenceTracker[pending].dispatchTime = this->getTime();
+                        this->m_numPending++;
+                        this->tlmWrite_CommandsInFlight(this->m_numPending);
                         break;
                     }
+                    this->m_seq++;
                 }
 
                 // if we couldn't find a slot to track the command, quit
@@ -225,9 +422,134 @@ namespace Svc {
         for (NATIVE_INT_TYPE entry = 0; entry < CMD_DISPATCHER_SEQUENCER_TABLE_SIZE; entry++) {
             this->m_sequenceTracker[entry].used = false;
         }
+        this->m_numPending = 0;
+        this->tlmWrite_CommandsInFlight(this->m_numPending);
         this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
     }
 
+    void CommandDispatcherImpl::CMD_SET_TIMEOUT_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U32 opcode, U32 timeout) {
+        NATIVE_INT_TYPE entry = this->findOpcode(opcode);
+        if (CMD_DISPATCHER_NO_ENTRY == entry) {
+            this->log_WARNING_HI_InvalidCommand(opcode);
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_VALIDATION_ERROR);
+            return;
+        }
+        this->m_entryTable[entry].timeout = timeout;
+        this->log_ACTIVITY_HI_TimeoutSet(opcode,timeout);
+        this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
+    }
+
+    void CommandDispatcherImpl::schedIn_handler(NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+
+        this->m_ticks++;
+
+        // picks up packets whose cmdReady message was dropped, and updates the lane telemetry
+        this->drainLanes();
+
+        if (this->m_numPending > 0) {
+            for (NATIVE_UINT_TYPE pending = 0; pending < CMD_DISPATCHER_SEQUENCER_TABLE_SIZE; pending++) {
+                SequenceTracker& tracker = this->m_sequenceTracker[pending];
+                // deadlines are compared as a signed difference so the count can wrap
+                if ((not tracker.used) or (0 == tracker.timeout) or
+                        (static_cast<I32>(this->m_ticks - tracker.deadline) < 0)) {
+                    continue;
+                }
+                this->log_WARNING_HI_OpCodeTimedOut(tracker.opCode,tracker.seq,tracker.timeout);
+                this->m_numTimeouts++;
+                this->tlmWrite_CommandTimeouts(this->m_numTimeouts);
+                this->m_numCmdErrors++;
+                this->tlmWrite_CommandErrors(this->m_numCmdErrors);
+                FwOpcodeType opCode = tracker.opCode;
+                NATIVE_INT_TYPE portToCall = tracker.callerPort;
+                U32 cmdContext = tracker.context;
+                this->releaseTracker(pending);
+                // a late status finds the entry free and isn't reported again
+                if (this->isConnected_seqCmdStatus_OutputPort(portToCall)) {
+                    this->seqCmdStatus_out(portToCall,opCode,cmdContext,Fw::COMMAND_EXECUTION_ERROR);
+                }
+            }
+        }
+
+        if (0 == (this->m_ticks % CMD_DISPATCHER_LATENCY_WINDOW)) {
+            this->writeLatencyTlm();
+        }
+    }
+
+    void CommandDispatcherImpl::releaseTracker(NATIVE_UINT_TYPE slot) {
+        FW_ASSERT(slot < CMD_DISPATCHER_SEQUENCER_TABLE_SIZE,slot);
+        FW_ASSERT(this->m_sequenceTracker[slot].used,slot);
+        FW_ASSERT(this->m_numPending > 0);
+        this->m_sequenceTracker[slot].used = false;
+        this->m_numPending--;
+        this->tlmWrite_CommandsInFlight(this->m_numPending);
+    }
+
+    NATIVE_UINT_TYPE CommandDispatcherImpl::latencyBucket(U32 latencyUs) {
+        if (latencyUs < CMD_DISPATCHER_LATENCY_SUB_BUCKETS) {
+            return latencyUs;
+        }
+        // the top bit picks the power of two, the next bits the bucket within it
+        NATIVE_UINT_TYPE msb = 31 - __builtin_clz(latencyUs);
+        NATIVE_UINT_TYPE shift = msb - CMD_DISPATCHER_LATENCY_SUB_BITS;
+        return (msb - CMD_DISPATCHER_LATENCY_SUB_BITS + 1) * CMD_DISPATCHER_LATENCY_SUB_BUCKETS +
+                ((latencyUs >> shift) & (CMD_DISPATCHER_LATENCY_SUB_BUCKETS - 1));
+    }
+
+    U32 CommandDispatcherImpl::latencyBucketTop(NATIVE_UINT_TYPE bucket) {
+        FW_ASSERT(bucket < CMD_DISPATCHER_LATENCY_BUCKETS,bucket);
+        if (bucket < CMD_DISPATCHER_LATENCY_SUB_BUCKETS) {
+            return bucket;
+        }
+        NATIVE_UINT_TYPE shift = bucket / CMD_DISPATCHER_LATENCY_SUB_BUCKETS - 1;
+        U32 bottom = static_cast<U32>(CMD_DISPATCHER_LATENCY_SUB_BUCKETS + bucket % CMD_DISPATCHER_LATENCY_SUB_BUCKETS) << shift;
+        return bottom + ((static_cast<U32>(1) << shift) - 1);
+    }
+
+    void CommandDispatcherImpl::addLatency(const Fw::Time& dispatchTime) {
+        Fw::Time now = this->getTime();
+        U32 seconds = now.getSeconds();
+        U32 useconds = now.getUSeconds();
+        // skip samples from a time source that went backwards
+        if ((seconds < dispatchTime.getSeconds()) or
+                ((seconds == dispatchTime.getSeconds()) and (useconds < dispatchTime.getUSeconds()))) {
+            return;
+        }
+        U32 elapsedSeconds = seconds - dispatchTime.getSeconds();
+        U32 latencyUs = 0xFFFFFFFF;
+        if (elapsedSeconds < 0xFFFFFFFF/1000000) {
+            latencyUs = elapsedSeconds*1000000 + useconds - dispatchTime.getUSeconds();
+        }
+        this->m_latencyBuckets[latencyBucket(latencyUs)]++;
+        this->m_latencySamples++;
+    }
+
+    U32 CommandDispatcherImpl::latencyPercentile(U32 percent) {
+        FW_ASSERT(this->m_latencySamples > 0);
+        // rank of the sample at the percentile, rounded up. Split so it can't overflow
+        U32 rank = (this->m_latencySamples / 100) * percent +
+                ((this->m_latencySamples % 100) * percent + 99) / 100;
+        U32 count = 0;
+        for (NATIVE_UINT_TYPE bucket = 0; bucket < CMD_DISPATCHER_LATENCY_BUCKETS; bucket++) {
+            count += this->m_latencyBuckets[bucket];
+            if (count >= rank) {
+                return latencyBucketTop(bucket);
+            }
+        }
+        return latencyBucketTop(CMD_DISPATCHER_LATENCY_BUCKETS - 1);
+    }
+
+    void CommandDispatcherImpl::writeLatencyTlm(void) {
+        // keep the last values through windows without completions
+        if (0 == this->m_latencySamples) {
+            return;
+        }
+        this->tlmWrite_LatencyP50(this->latencyPercentile(50));
+        this->tlmWrite_LatencyP90(this->latencyPercentile(90));
+        this->tlmWrite_LatencyP99(this->latencyPercentile(99));
+        memset(this->m_latencyBuckets,0,sizeof(this->m_latencyBuckets));
+        this->m_latencySamples = 0;
+    }
+
     void CommandDispatcherImpl::pingIn_handler(NATIVE_INT_TYPE portNum, U32 key) {
         // respond to ping
         this->pingOut_out(0,key);
@@ -15,6 +15,7 @@
 #define COMMANDDISPATCHERIMPL_HPP_
 
 #include <Svc/CmdDispatcher/CommandDispatcherComponentAc.hpp>
+#include <Fw/Types/MpscRing.hpp>
 #include <Os/Mutex.hpp>
 #include <Svc/CmdDispatcher/CommandDispatcherImplCfg.hpp>
 
@@ -31,6 +32,7 @@ namespace Svc {
 
     class CommandDispatcherImpl : public CommandDispatcherComponentBase {
         public:
+            friend class CommandDispatcherPerfTester;
             //!  \brief Command Dispatcher constructor
             //!
             //!  The constructor initializes the state of the component.
@@ -53,6 +55,21 @@ namespace Svc {
                     NATIVE_INT_TYPE queueDepth, /*!< The queue depth*/
                     NATIVE_INT_TYPE instance /*!< The instance number*/
                     ); //!< initialization function
+            //! \brief priority classes of the command buffer ports
+            enum CmdPriority {
+                CMD_PRIORITY_HIGH, //!< urgent commands, such as safing from the ground
+                CMD_PRIORITY_NORMAL, //!< sequences. Every port starts here
+                CMD_PRIORITY_LOW, //!< bulk and internally generated commands
+                CMD_PRIORITY_MAX
+            };
+            //!  \brief Set the priority class of a command buffer port
+            //!
+            //!  Commands from the port wait in the lane of this priority.
+            //!  Call after init() and before the component is started.
+            //!
+            //!  \param portNum the seqCmdBuff port number
+            //!  \param priority the priority class of the port
+            void setPortPriority(NATIVE_INT_TYPE portNum, CmdPriority priority);
             //!  \brief Component destructor
             //!
             //!  The destructor for this component is empty
@@ -72,12 +89,38 @@ namespace Svc {
             //!  \brief component command buffer handler
             //!
             //!  The command buffer handler is called to submit a new
-            //!  command packet to be decoded
+            //!  command packet to be decoded. It runs on the caller's
+            //!  thread and puts the packet in the lane of the port's
+            //!  priority. If the lane is full, the packet is returned
+            //!  with COMMAND_BUSY.
             //!
             //!  \param portNum the number of the incoming port.
             //!  \param data the buffer containing the command.
             //!  \param context a user value returned with the statuss
             void seqCmdBuff_handler(NATIVE_INT_TYPE portNum, Fw::ComBuffer &data, U32 context);
+            //!  \brief command lane handler
+            //!
+            //!  Called on the component thread after a packet is put in
+            //!  an empty lane. Dispatches the waiting packets highest
+            //!  priority first.
+            //!
+            //!  \param lane the lane the packet was put in
+            void cmdReady_internalInterfaceHandler(U32 lane);
+            void dispatchBuffer(NATIVE_INT_TYPE portNum, Fw::ComBuffer &data, U32 context); //!< dispatch a command or batch packet
+            //!  \brief dispatch the commands in a batch
+            //!
+            //!  A FW_PACKET_COMMAND_BATCH packet holds several command packets,
+            //!  each preceded by its 32-bit length. They are dispatched in order
+            //!  as if each had arrived by itself, so each gets its own sequence
+            //!  number and status. A length that runs past the end of the batch
+            //!  drops the rest of it.
+            //!
+            //!  \param portNum the number of the incoming port.
+            //!  \param data the batch, with the descriptor already read
+            //!  \param context a user value returned with the status of each command
+            void dispatchBatch(NATIVE_INT_TYPE portNum, Fw::ComBuffer &data, U32 context);
+            void dispatchCommand(NATIVE_INT_TYPE portNum, Fw::ComBuffer &data, U32 context); //!< decode and dispatch one command packet
+            void reportMalformed(NATIVE_INT_TYPE portNum, FwOpcodeType opCode, U32 context, Fw::SerializeStatus stat); //!< event and status for a packet that can't be decoded
             //!  \brief component command registration handler
             //!
             //!  The command registration handler is called to register
@@ -96,6 +139,16 @@ namespace Svc {
             //!  \param opCode the opcode being registered.
             //!  \param key the key value that is returned with the ping response
             void pingIn_handler(NATIVE_INT_TYPE portNum, U32 key);
+            //!  \brief scheduler handler
+            //!
+            //!  The scheduler handler counts time for the command timeouts.
+            //!  Commands whose timeout has passed are failed back to the port
+            //!  that sent them, and the latency telemetry is written once
+            //!  every CMD_DISPATCHER_LATENCY_WINDOW calls.
+            //!
+            //!  \param portNum the number of the incoming port.
+            //!  \param context the context value from the scheduler
+            void schedIn_handler(NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context);
             //!  \brief NO_OP command handler
             //!
             //!  A test command that does nothing
@@ -132,23 +185,45 @@ namespace Svc {
             //!  \param opCode the CLEAR_TRACKING opcode.
             //!  \param cmdSeq the assigned sequence number for the command
             void CMD_CLEAR_TRACKING_cmdHandler(FwOpcodeType opCode, U32 cmdSeq);
+            //!  \brief A command to set the timeout of an opcode
+            //!
+            //!  Registered opcodes start with CMD_DISPATCHER_DEFAULT_TIMEOUT.
+            //!  The new timeout applies to commands dispatched after this one.
+            //!
+            //!  \param opCode the SET_TIMEOUT opcode.
+            //!  \param cmdSeq the assigned sequence number for the command
+            //!  \param opcode the opcode to set the timeout of
+            //!  \param timeout schedIn calls before the opcode times out. 0 never times out
+            void CMD_SET_TIMEOUT_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, U32 opcode, U32 timeout);
 
             //! \struct DispatchEntry
             //! \brief table used to store opcode to port mappings
             //!
             //! The DispatchEntry table is used to map incoming opcodes to the port
             //! connected to the component that implements the opcode.
-            //! As each command opcode is registered, a new entry is found
-            //! in the table by checking for the "used" flag. The opcode
-            //! member is set to the opcode, and the port member set to the
-            //! port to dispatch to. When a new opcode is received for
-            //! execution, the table is traversed until the opcode is located.
+            //! The table is open addressed: an opcode is hashed to a slot, and
+            //! the following slots are probed until one without the "used" flag
+            //! is found. The opcode member is set to the opcode, and the port
+            //! member set to the port to dispatch to. When a new opcode is received
+            //! for execution, the same probe sequence locates it, so lookup takes
+            //! one or two probes however many opcodes are registered. Entries
+            //! are never removed, so a probe can stop at the first unused slot.
+
+            enum {
+                CMD_DISPATCHER_DISPATCH_TABLE_SLOTS = 1 << CMD_DISPATCHER_DISPATCH_TABLE_BITS,
+                CMD_DISPATCHER_NO_ENTRY = -1
+            };
 
             struct DispatchEntry {
                     bool used; //!< if entry has been used yet
                     U32 opcode; //!< opcode of entry
                     NATIVE_INT_TYPE port; //!< which port the entry invokes
-            } m_entryTable[CMD_DISPATCHER_DISPATCH_TABLE_SIZE]; //!< table of dispatch entries
+                    U32 timeout; //!< schedIn calls before a command times out, or 0
+            } m_entryTable[CMD_DISPATCHER_DISPATCH_TABLE_SLOTS]; //!< table of dispatch entries
+            NATIVE_UINT_TYPE m_numEntries; //!< number of registered opcodes
+
+            NATIVE_UINT_TYPE hashOpcode(FwOpcodeType opCode); //!< first slot probed for an opcode
+            NATIVE_INT_TYPE findOpcode(FwOpcodeType opCode); //!< returns the slot, or CMD_DISPATCHER_NO_ENTRY
 
             //! \struct SequenceTracker
             //! \brief table used to store opcode that are being executed
@@ -157,11 +232,15 @@ namespace Svc {
             //! but are not yet complete. When a new command opcode is received,
             //! the status port that would be used to report the completion status
             //! is checked. If it is connected, then an entry is placed in this table.
+            //! The entry is the one indexed by the low bits of the sequence number,
+            //! so the status is matched with one lookup. If that entry is still in
+            //! use, sequence numbers are skipped until a free entry is reached.
             //! The "used" flag is set, and the "seq" member is set to the the
             //! assigned sequence number for the command. The "opCode" field is
             //! used for the opcode, and the "callerPort" field is used to store
             //! the port number of the caller so the status can be reported back to
-            //! correct port.
+            //! correct port. If the opcode has a timeout, the "deadline" field is
+            //! the schedIn count at which the command fails with an execution error.
 
             struct SequenceTracker {
                     bool used; //!< if this slot is used
@@ -169,7 +248,54 @@ namespace Svc {
                     FwOpcodeType opCode; //!< opcode being tracked
                     U32 context; //!< context passed by user
                     NATIVE_INT_TYPE callerPort; //!< port command source port
+                    U32 timeout; //!< timeout of the opcode when dispatched, or 0
+                    U32 deadline; //!< schedIn count the command times out at
+                    Fw::Time dispatchTime; //!< when the command was dispatched
             } m_sequenceTracker[CMD_DISPATCHER_SEQUENCER_TABLE_SIZE]; //!< sequence tracking port for command completions;
+            NATIVE_UINT_TYPE m_numPending; //!< commands waiting for status
+            U32 m_ticks; //!< schedIn calls so far
+            U32 m_numTimeouts; //!< commands that timed out
+
+            void releaseTracker(NATIVE_UINT_TYPE slot); //!< free an entry and update the in-flight telemetry
+
+            // Latency histogram for the telemetry window. Each power of two is split into
+            // CMD_DISPATCHER_LATENCY_SUB_BUCKETS buckets, so a percentile is reported
+            // within 25% of its true value.
+            enum {
+                CMD_DISPATCHER_LATENCY_SUB_BITS = 2,
+                CMD_DISPATCHER_LATENCY_SUB_BUCKETS = 1 << CMD_DISPATCHER_LATENCY_SUB_BITS,
+                CMD_DISPATCHER_LATENCY_BUCKETS = (32 - CMD_DISPATCHER_LATENCY_SUB_BITS + 1) * CMD_DISPATCHER_LATENCY_SUB_BUCKETS
+            };
+            U32 m_latencyBuckets[CMD_DISPATCHER_LATENCY_BUCKETS]; //!< completions in each latency bucket
+            U32 m_latencySamples; //!< completions this window
+
+            static NATIVE_UINT_TYPE latencyBucket(U32 latencyUs); //!< bucket a latency falls in
+            static U32 latencyBucketTop(NATIVE_UINT_TYPE bucket); //!< largest latency in a bucket
+            void addLatency(const Fw::Time& dispatchTime); //!< record the latency of a completed command
+            U32 latencyPercentile(U32 percent); //!< upper bound of a percentile this window
+            void writeLatencyTlm(void); //!< write the percentiles and start a new window
+
+            // Command lanes. Callers put packets in the lane of their port's
+            // priority, and the component thread takes them out highest lane first.
+            struct LaneEntry {
+                NATIVE_INT_TYPE portNum; //!< port the packet arrived on
+                U32 context; //!< context passed by user
+                Fw::ComBuffer data; //!< the command or batch packet
+            };
+
+            Fw::MpscRing<LaneEntry> m_lanes[CMD_PRIORITY_MAX]; //!< overflows are packets returned busy because the lane was full
+
+            Fw::MpscRing<LaneEntry>::Slot m_highLane[CMD_DISPATCHER_LANE_HIGH_DEPTH];
+            Fw::MpscRing<LaneEntry>::Slot m_normalLane[CMD_DISPATCHER_LANE_NORMAL_DEPTH];
+            Fw::MpscRing<LaneEntry>::Slot m_lowLane[CMD_DISPATCHER_LANE_LOW_DEPTH];
+            CmdPriority m_portPriority[NUM_SEQCMDBUFF_INPUT_PORTS]; //!< priority of each seqCmdBuff port
+            volatile U32 m_lanesPending; //!< a cmdReady message has been sent and not handled
+
+            bool putLane(NATIVE_UINT_TYPE lane, NATIVE_INT_TYPE portNum, Fw::ComBuffer &data, U32 context);
+            bool takeLane(NATIVE_UINT_TYPE lane); //!< dispatch the oldest packet in the lane. Returns false if empty
+            void drainLanes(void);
+            void writeLaneTlm(void);
+            static FwOpcodeType peekOpcode(Fw::ComBuffer &data); //!< opcode of a command packet, or 0
 
             I32 m_seq; //!< current command sequence number
 
@@ -10,9 +10,44 @@
 
 // Define configuration values for dispatcher
 
+// Opcodes are kept in a hash table of 2^CMD_DISPATCHER_DISPATCH_TABLE_BITS slots so
+// a command is found with one or two probes however many opcodes are registered.
+// Set CMD_DISPATCHER_DISPATCH_TABLE_SIZE to at least the number of opcodes the
+// topology registers, i.e. the commands of every component connected to compCmdReg.
+// Both values can be set on the compiler command line instead, as the dispatch
+// benchmark in test/perf does.
+
+#ifndef CMD_DISPATCHER_DISPATCH_TABLE_SIZE
+#define CMD_DISPATCHER_DISPATCH_TABLE_SIZE 100 // !< The most opcodes that can be registered
+#endif
+
+#ifndef CMD_DISPATCHER_DISPATCH_TABLE_BITS
+#define CMD_DISPATCHER_DISPATCH_TABLE_BITS 8 // !< Dispatch table has 2^CMD_DISPATCHER_DISPATCH_TABLE_BITS slots. Must be at least twice CMD_DISPATCHER_DISPATCH_TABLE_SIZE
+#endif
+
+// Commands waiting for status are kept in a table indexed by the low bits of
+// their sequence number, so a status is matched to its command with one lookup.
+// Timeouts and the latency telemetry window are in calls to the schedIn port.
+// The Ref and RPI topologies call schedIn at 1 Hz, so these are in seconds there.
+
+enum {
+    CMD_DISPATCHER_SEQUENCER_TABLE_SIZE = 32, // !< The size of the table holding commands in progress. Must be a power of two
+    CMD_DISPATCHER_DEFAULT_TIMEOUT = 60, // !< schedIn calls before a command without status times out. 0 never times out
+    CMD_DISPATCHER_LATENCY_WINDOW = 10, // !< schedIn calls between updates of the latency telemetry
+};
+
+// Command lanes. Commands from the seqCmdBuff ports wait for the component
+// thread in the lane of their port's priority, set with setPortPriority().
+// The thread empties the lanes highest priority first, so a sequence filling
+// its lane can't delay a command from a higher priority port. A command that
+// finds its lane full is returned to its port with COMMAND_BUSY, or asserts if
+// CMD_DISPATCHER_LANE_FULL_BUSY is 0. Depths must be powers of two.
+
 enum {
-    CMD_DISPATCHER_DISPATCH_TABLE_SIZE = 6, // !< The size of the table holding opcodes to dispatch
-    CMD_DISPATCHER_SEQUENCER_TABLE_SIZE = 5, // !< The size of the table holding commands in progress
+    CMD_DISPATCHER_LANE_HIGH_DEPTH = 4, // !< CMD_PRIORITY_HIGH lane depth
+    CMD_DISPATCHER_LANE_NORMAL_DEPTH = 8, // !< CMD_PRIORITY_NORMAL lane depth
+    CMD_DISPATCHER_LANE_LOW_DEPTH = 8, // !< CMD_PRIORITY_LOW lane depth
+    CMD_DISPATCHER_LANE_FULL_BUSY = 1 // !< 1 returns COMMAND_BUSY when a lane is full, 0 asserts
 };
 
 
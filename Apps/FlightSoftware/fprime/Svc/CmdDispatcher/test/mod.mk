@@ -8,4 +8,4 @@
 
 # There are some standard files that are included for reference
 
-SUBDIRS = ut
+SUBDIRS = ut perf
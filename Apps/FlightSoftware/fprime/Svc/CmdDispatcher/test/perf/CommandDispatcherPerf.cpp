@@ -0,0 +1,67 @@
+/*
+ * CommandDispatcherPerf.cpp
+ *
+ * Main program for the CommandDispatcherImpl benchmark
+ */
+
+#include <Svc/CmdDispatcher/test/perf/CommandDispatcherPerfTester.hpp>
+#include <Svc/CmdDispatcher/CommandDispatcherImpl.hpp>
+#include <Fw/Obj/SimpleObjRegistry.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <cstdlib>
+
+#if FW_OBJECT_REGISTRATION == 1
+static Fw::SimpleObjRegistry simpleReg;
+#endif
+
+namespace {
+    // swept values. Counts above the table size the benchmark is built with are skipped
+    const NATIVE_UINT_TYPE PERF_OPCODES[] = {1, 8, 25, 100, 1000, CMD_DISPATCHER_DISPATCH_TABLE_SIZE};
+    const NATIVE_UINT_TYPE PERF_DEFAULT_SAMPLES = 1000;
+}
+
+void runPerfTest(NATIVE_UINT_TYPE numOpcodes, NATIVE_UINT_TYPE samples) {
+
+    Svc::CommandDispatcherImpl* impl = new Svc::CommandDispatcherImpl("CmdDispImpl");
+    FW_ASSERT(impl);
+
+    impl->init(10,0);
+
+    Svc::CommandDispatcherPerfTester* tester = new Svc::CommandDispatcherPerfTester(*impl);
+    FW_ASSERT(tester);
+
+    tester->init();
+
+    // connect ports
+    tester->connect();
+
+    // run measurements
+    tester->setup(numOpcodes);
+    tester->runDispatch(samples);
+    tester->runMiss(samples);
+
+    delete tester;
+    delete impl;
+}
+
+int main(int argc, char* argv[]) {
+
+    // optional argument is the number of samples for each measurement
+    NATIVE_UINT_TYPE samples = PERF_DEFAULT_SAMPLES;
+    if (argc > 1) {
+        samples = atoi(argv[1]);
+    }
+    if ((samples == 0) or (samples > Svc::CommandDispatcherPerfTester::PERF_MAX_SAMPLES)) {
+        samples = PERF_DEFAULT_SAMPLES;
+    }
+
+    Svc::CommandDispatcherPerfTester::printHeader();
+    for (NATIVE_UINT_TYPE opcodes = 0; opcodes < FW_NUM_ARRAY_ELEMENTS(PERF_OPCODES); opcodes++) {
+        if (PERF_OPCODES[opcodes] <= CMD_DISPATCHER_DISPATCH_TABLE_SIZE) {
+            runPerfTest(PERF_OPCODES[opcodes],samples);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,10 @@
+/*
+ * CommandDispatcherPerfImpl.cpp
+ *
+ * Builds CommandDispatcherImpl into the benchmark with the benchmark's
+ * dispatch table size. The size is set on the compiler command line in
+ * mod.mk and CMakeLists.txt, and changes the size of the component, so the
+ * benchmark can't use the component built with the flight configuration.
+ */
+
+#include <Svc/CmdDispatcher/CommandDispatcherImpl.cpp>
@@ -0,0 +1,173 @@
+/*
+ * CommandDispatcherPerfTester.cpp
+ *
+ * Benchmark driver for CommandDispatcherImpl
+ */
+
+#include <Svc/CmdDispatcher/test/perf/CommandDispatcherPerfTester.hpp>
+#include <Fw/Com/ComPacket.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Os/IntervalTimer.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace Svc {
+
+    CommandDispatcherPerfTester::CommandDispatcherPerfTester(Svc::CommandDispatcherImpl& inst) :
+#if FW_OBJECT_NAMES == 1
+        Fw::PassiveComponentBase("perftester"),
+#endif
+            m_impl(inst),
+            m_numOpcodes(0),
+            m_cmdSent(false),
+            m_cmdSentOpCode(0) {
+    }
+
+    CommandDispatcherPerfTester::~CommandDispatcherPerfTester() {
+    }
+
+    void CommandDispatcherPerfTester::init(NATIVE_INT_TYPE instance) {
+        Fw::PassiveComponentBase::init(instance);
+        this->m_seqCmdBuffOut.init();
+        this->m_cmdRegOut.init();
+        this->m_cmdSendIn.init();
+        this->m_cmdSendIn.addCallComp(this,cmdSendIn);
+    }
+
+    void CommandDispatcherPerfTester::connect(void) {
+        this->m_seqCmdBuffOut.addCallPort(this->m_impl.get_seqCmdBuff_InputPort(0));
+        this->m_cmdRegOut.addCallPort(this->m_impl.get_compCmdReg_InputPort(0));
+        this->m_impl.set_compCmdSend_OutputPort(0,&this->m_cmdSendIn);
+    }
+
+    void CommandDispatcherPerfTester::cmdSendIn(Fw::PassiveComponentBase* callComp, NATIVE_INT_TYPE portNum,
+            FwOpcodeType opCode, U32 cmdSeq, Fw::CmdArgBuffer &args) {
+        FW_ASSERT(callComp);
+        CommandDispatcherPerfTester* tester = static_cast<CommandDispatcherPerfTester*>(callComp);
+        tester->m_cmdSent = true;
+        tester->m_cmdSentOpCode = opCode;
+    }
+
+    FwOpcodeType CommandDispatcherPerfTester::opCode(NATIVE_UINT_TYPE command) {
+        // opcodes laid out the way a topology would: components with
+        // base IDs PERF_COMPONENT_STRIDE apart, each with a few commands
+        return PERF_BASE_OPCODE + (command/PERF_COMPONENT_COMMANDS)*PERF_COMPONENT_STRIDE
+                + (command%PERF_COMPONENT_COMMANDS);
+    }
+
+    void CommandDispatcherPerfTester::setup(NATIVE_UINT_TYPE numOpcodes) {
+
+        FW_ASSERT(numOpcodes > 0 and numOpcodes <= CMD_DISPATCHER_DISPATCH_TABLE_SIZE,numOpcodes);
+        this->m_numOpcodes = numOpcodes;
+
+        for (NATIVE_UINT_TYPE command = 0; command < numOpcodes; command++) {
+            this->m_cmdRegOut.invoke(this->opCode(command));
+            Fw::ComBuffer& buff = this->m_cmdBuffs[command];
+            buff.resetSer();
+            FW_ASSERT(Fw::FW_SERIALIZE_OK == buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)));
+            FW_ASSERT(Fw::FW_SERIALIZE_OK == buff.serialize(this->opCode(command)));
+        }
+        FW_ASSERT(this->m_impl.m_numEntries == numOpcodes,this->m_impl.m_numEntries,numOpcodes);
+    }
+
+    void CommandDispatcherPerfTester::runDispatch(NATIVE_UINT_TYPE samples) {
+
+        FW_ASSERT(samples > 0 and samples <= PERF_MAX_SAMPLES,samples);
+
+        Os::IntervalTimer::RawTime start;
+        Os::IntervalTimer::RawTime stop;
+        NATIVE_UINT_TYPE command = 0;
+        U32 errors = 0;
+
+        for (NATIVE_UINT_TYPE sample = 0; sample < samples; sample++) {
+            Os::IntervalTimer::getRawTime(start);
+            for (NATIVE_UINT_TYPE call = 0; call < PERF_BATCH; call++) {
+                // seqCmdBuff puts the command in a lane, so dispatch the message on this thread
+                this->m_cmdSent = false;
+                this->m_seqCmdBuffOut.invoke(this->m_cmdBuffs[command],command);
+                (void) this->m_impl.doDispatch();
+                if ((not this->m_cmdSent) or (this->m_cmdSentOpCode != this->opCode(command))) {
+                    errors++;
+                }
+                if (++command == this->m_numOpcodes) {
+                    command = 0;
+                }
+            }
+            Os::IntervalTimer::getRawTime(stop);
+            this->m_samples[sample] = Os::IntervalTimer::getDiffNsec(stop,start);
+        }
+
+        // every command should reach the port of its opcode
+        FW_ASSERT(0 == errors,errors);
+
+        this->report("dispatch",samples,PERF_BATCH);
+    }
+
+    void CommandDispatcherPerfTester::runMiss(NATIVE_UINT_TYPE samples) {
+
+        FW_ASSERT(samples > 0 and samples <= PERF_MAX_SAMPLES,samples);
+
+        Os::IntervalTimer::RawTime start;
+        Os::IntervalTimer::RawTime stop;
+        NATIVE_UINT_TYPE command = 0;
+        U32 found = 0;
+
+        for (NATIVE_UINT_TYPE sample = 0; sample < samples; sample++) {
+            Os::IntervalTimer::getRawTime(start);
+            for (NATIVE_UINT_TYPE call = 0; call < PERF_BATCH; call++) {
+                // past the last command of each component, so never registered
+                FwOpcodeType missing = this->opCode(command) + PERF_COMPONENT_COMMANDS;
+                if (this->m_impl.findOpcode(missing) != CommandDispatcherImpl::CMD_DISPATCHER_NO_ENTRY) {
+                    found++;
+                }
+                if (++command == this->m_numOpcodes) {
+                    command = 0;
+                }
+            }
+            Os::IntervalTimer::getRawTime(stop);
+            this->m_samples[sample] = Os::IntervalTimer::getDiffNsec(stop,start);
+        }
+
+        FW_ASSERT(0 == found,found);
+
+        this->report("miss",samples,PERF_BATCH);
+    }
+
+    void CommandDispatcherPerfTester::printHeader(void) {
+        (void)printf("bench,opcodes,samples,batch,p50_ns,p90_ns,p99_ns,max_ns,mean_ns,ops_per_sec\n");
+    }
+
+    void CommandDispatcherPerfTester::report(const char* bench, NATIVE_UINT_TYPE samples, NATIVE_UINT_TYPE batch) {
+
+        // convert samples to time per operation and sort for percentiles
+        U64 sumNsec = 0;
+        for (NATIVE_UINT_TYPE sample = 0; sample < samples; sample++) {
+            sumNsec += this->m_samples[sample];
+            this->m_samples[sample] /= batch;
+        }
+        qsort(this->m_samples,samples,sizeof(this->m_samples[0]),compareSamples);
+
+        F64 meanNsec = static_cast<F64>(sumNsec)/(static_cast<F64>(samples)*batch);
+        F64 opsPerSec = (sumNsec > 0) ? 1.0e9/meanNsec : 0.0;
+
+        (void)printf("%s,%u,%u,%u,%u,%u,%u,%u,%.1f,%.0f\n",
+                bench,
+                static_cast<U32>(this->m_numOpcodes),
+                static_cast<U32>(samples),
+                static_cast<U32>(batch),
+                this->m_samples[(samples-1)*50/100],
+                this->m_samples[(samples-1)*90/100],
+                this->m_samples[(samples-1)*99/100],
+                this->m_samples[samples-1],
+                meanNsec,
+                opsPerSec);
+    }
+
+    int CommandDispatcherPerfTester::compareSamples(const void* a, const void* b) {
+        U32 first = *static_cast<const U32*>(a);
+        U32 second = *static_cast<const U32*>(b);
+        return (first > second) - (first < second);
+    }
+
+} /* namespace Svc */
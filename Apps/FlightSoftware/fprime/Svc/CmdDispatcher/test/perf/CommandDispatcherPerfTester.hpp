@@ -0,0 +1,85 @@
+/*
+ * CommandDispatcherPerfTester.hpp
+ *
+ * Benchmark driver for CommandDispatcherImpl
+ */
+
+#ifndef CMDDISPATCHER_TEST_PERF_COMMANDDISPATCHERPERFTESTER_HPP_
+#define CMDDISPATCHER_TEST_PERF_COMMANDDISPATCHERPERFTESTER_HPP_
+
+#include <Fw/Comp/PassiveComponentBase.hpp>
+#include <Fw/Cmd/CmdPortAc.hpp>
+#include <Fw/Cmd/CmdRegPortAc.hpp>
+#include <Fw/Com/ComPortAc.hpp>
+#include <Svc/CmdDispatcher/CommandDispatcherImpl.hpp>
+
+namespace Svc {
+
+    //! Benchmark for CommandDispatcherImpl. Each measurement is printed as a
+    //! comma separated line so results can be compared between builds.
+    //! The benchmark is a standalone program, so it drives the component
+    //! through its own ports instead of the unit test tester base.
+    class CommandDispatcherPerfTester: public Fw::PassiveComponentBase {
+        public:
+
+            CommandDispatcherPerfTester(Svc::CommandDispatcherImpl& inst);
+            virtual ~CommandDispatcherPerfTester();
+
+            void init(NATIVE_INT_TYPE instance = 0);
+
+            //! Connect the command ports of the component. Status, time, events and
+            //! telemetry aren't connected, so they aren't included in the times.
+            void connect(void);
+
+            //! Register opcodes. Must be called once on a new component.
+            void setup(NATIVE_UINT_TYPE numOpcodes);
+
+            //! Measure the time to dispatch a command, cycling over the registered opcodes
+            void runDispatch(NATIVE_UINT_TYPE samples);
+            //! Measure the time to look up an opcode that isn't registered
+            void runMiss(NATIVE_UINT_TYPE samples);
+
+            //! print the column names for the results
+            static void printHeader(void);
+
+            enum {
+                PERF_BATCH = 128, //!< calls timed together for one sample
+                PERF_MAX_SAMPLES = 2000, //!< maximum samples for one measurement
+                PERF_BASE_OPCODE = 0x1000, //!< opcode of the first command
+                PERF_COMPONENT_STRIDE = 0x100, //!< spacing between component base opcodes
+                PERF_COMPONENT_COMMANDS = 20 //!< commands for each component
+            };
+
+        private:
+            Svc::CommandDispatcherImpl& m_impl;
+
+            //! Callback for commands sent by the component
+            static void cmdSendIn(Fw::PassiveComponentBase* callComp, NATIVE_INT_TYPE portNum,
+                    FwOpcodeType opCode, U32 cmdSeq, Fw::CmdArgBuffer &args);
+
+            // ports to and from the component
+            Fw::OutputComPort m_seqCmdBuffOut;
+            Fw::OutputCmdRegPort m_cmdRegOut;
+            Fw::InputCmdPort m_cmdSendIn;
+
+            // helpers
+            FwOpcodeType opCode(NATIVE_UINT_TYPE command);
+            void report(const char* bench, NATIVE_UINT_TYPE samples, NATIVE_UINT_TYPE batch);
+            static int compareSamples(const void* a, const void* b);
+
+            NATIVE_UINT_TYPE m_numOpcodes;
+
+            // last command sent by the component
+            bool m_cmdSent;
+            FwOpcodeType m_cmdSentOpCode;
+
+            // commands for each registered opcode
+            Fw::ComBuffer m_cmdBuffs[CMD_DISPATCHER_DISPATCH_TABLE_SIZE];
+
+            // time of each sample in nanoseconds per operation
+            U32 m_samples[PERF_MAX_SAMPLES];
+    };
+
+} /* namespace Svc */
+
+#endif /* CMDDISPATCHER_TEST_PERF_COMMANDDISPATCHERPERFTESTER_HPP_ */
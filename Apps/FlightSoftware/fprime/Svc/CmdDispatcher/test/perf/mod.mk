@@ -0,0 +1,25 @@
+# ----------------------------------------------------------------------
+# mod.mk 
+# ----------------------------------------------------------------------
+
+TEST_SRC = 	CommandDispatcherPerf.cpp \
+			CommandDispatcherPerfTester.cpp \
+			CommandDispatcherPerfImpl.cpp
+
+TEST_MODS = Svc/CmdDispatcher \
+			Svc/Sched \
+			Svc/Ping \
+			Fw/Tlm \
+			Fw/Cmd \
+			Fw/Com \
+			Fw/Comp \
+			Fw/Log \
+			Fw/Obj \
+			Fw/Port \
+			Fw/Prm \
+			Fw/Time \
+			Fw/Types \
+			Os
+
+# measure a dispatch table bigger than any topology registers
+COMPARGS = -DCMD_DISPATCHER_DISPATCH_TABLE_SIZE=4096 -DCMD_DISPATCHER_DISPATCH_TABLE_BITS=13
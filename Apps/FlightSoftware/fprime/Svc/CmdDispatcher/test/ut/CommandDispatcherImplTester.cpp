@@ -61,30 +61,22 @@ namespace Svc {
         // register built-in commands
         this->m_impl.regCommands();
         // verify registrations
-        ASSERT_TRUE(this->m_impl.m_entryTable[0].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[1].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[2].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].opcode,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[3].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].opcode,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1);
 
         // verify event
         printTextLogHistory(stdout);
         ASSERT_EVENTS_SIZE(4);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(4);
-        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,0);
-        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,1);
-        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,2);
-        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,3);
+        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP));
+        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING));
+        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1));
+        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING));
 
 
         REQUIREMENT("CD-003");
@@ -93,14 +85,12 @@ namespace Svc {
 
         this->clearEvents();
         this->invoke_to_compCmdReg(0,0x50);
-        ASSERT_TRUE(this->m_impl.m_entryTable[4].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[4].opcode,testOpCode);
-        ASSERT_EQ(this->m_impl.m_entryTable[4].port,0);
+        this->checkRegistered(testOpCode,0);
 
         // verify registration event
         ASSERT_EVENTS_SIZE(1);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(1);
-        ASSERT_EVENTS_OpCodeRegistered(0,testOpCode,0,4);
+        ASSERT_EVENTS_OpCodeRegistered(0,testOpCode,0,this->m_impl.findOpcode(testOpCode));
 
         // dispatch a test command
         REQUIREMENT("CD-001");
@@ -183,30 +173,22 @@ namespace Svc {
         // register built-in commands
         this->m_impl.regCommands();
         // verify registrations
-        ASSERT_TRUE(this->m_impl.m_entryTable[0].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[1].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[2].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].opcode,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[3].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].opcode,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1);
 
         // verify event
 
         ASSERT_EVENTS_SIZE(4);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(4);
-        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,0);
-        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,1);
-        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,2);
-        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,3);
+        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP));
+        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING));
+        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1));
+        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING));
 
         // send NO_OP command
         this->m_seqStatusRcvd = false;
@@ -311,43 +293,33 @@ namespace Svc {
         // register built-in commands
         this->m_impl.regCommands();
         // verify registrations
-        ASSERT_TRUE(this->m_impl.m_entryTable[0].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[1].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[2].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].opcode,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[3].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].opcode,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1);
 
         // verify event
         ASSERT_EVENTS_SIZE(4);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(4);
-        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,0);
-        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,1);
-        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,2);
-        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,3);
+        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP));
+        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING));
+        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1));
+        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING));
 
         // register our own command
         FwOpcodeType testOpCode = 0x50;
 
         this->clearEvents();
         this->invoke_to_compCmdReg(0,0x50);
-        ASSERT_TRUE(this->m_impl.m_entryTable[4].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[4].opcode,testOpCode);
-        ASSERT_EQ(this->m_impl.m_entryTable[4].port,0);
+        this->checkRegistered(testOpCode,0);
 
         // verify registration event
         ASSERT_EVENTS_SIZE(1);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(1);
-        ASSERT_EVENTS_OpCodeRegistered(0,(U32)testOpCode,0,4);
+        ASSERT_EVENTS_OpCodeRegistered(0,(U32)testOpCode,0,this->m_impl.findOpcode(testOpCode));
 
         // dispatch a test command with a bad opcode
         U32 testCmdArg = 100;
@@ -393,42 +365,32 @@ namespace Svc {
         // register built-in commands
         this->m_impl.regCommands();
         // verify registrations
-        ASSERT_TRUE(this->m_impl.m_entryTable[0].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[1].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[2].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].opcode,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[3].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].opcode,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1);
 
         // verify event
         ASSERT_EVENTS_SIZE(4);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(4);
-        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,0);
-        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,1);
-        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,2);
-        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,3);
+        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP));
+        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING));
+        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1));
+        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING));
         // register our own command
         FwOpcodeType testOpCode = 0x50;
 
         this->clearEvents();
         this->invoke_to_compCmdReg(0,0x50);
-        ASSERT_TRUE(this->m_impl.m_entryTable[4].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[4].opcode,testOpCode);
-        ASSERT_EQ(this->m_impl.m_entryTable[4].port,0);
+        this->checkRegistered(testOpCode,0);
 
         // verify registration event
         ASSERT_EVENTS_SIZE(1);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(1);
-        ASSERT_EVENTS_OpCodeRegistered(0,(U32)testOpCode,0,4);
+        ASSERT_EVENTS_OpCodeRegistered(0,(U32)testOpCode,0,this->m_impl.findOpcode(testOpCode));
 
         U32 currSeq = 0;
 
@@ -647,43 +609,33 @@ namespace Svc {
         // register built-in commands
         this->m_impl.regCommands();
         // verify registrations
-        ASSERT_TRUE(this->m_impl.m_entryTable[0].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[1].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[2].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].opcode,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[3].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].opcode,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1);
 
         // verify event
         ASSERT_EVENTS_SIZE(4);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(4);
-        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,0);
-        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,1);
-        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,2);
-        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,3);
+        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP));
+        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING));
+        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1));
+        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING));
 
         // register our own command
         FwOpcodeType testOpCode = 0x50;
 
         this->clearEvents();
         this->invoke_to_compCmdReg(0,0x50);
-        ASSERT_TRUE(this->m_impl.m_entryTable[4].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[4].opcode,testOpCode);
-        ASSERT_EQ(this->m_impl.m_entryTable[4].port,0);
+        this->checkRegistered(testOpCode,0);
 
         // verify registration event
         ASSERT_EVENTS_SIZE(1);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(1);
-        ASSERT_EVENTS_OpCodeRegistered(0,(U32)testOpCode,0,4);
+        ASSERT_EVENTS_OpCodeRegistered(0,(U32)testOpCode,0,this->m_impl.findOpcode(testOpCode));
 
         for (NATIVE_UINT_TYPE disp = 0; disp < CMD_DISPATCHER_SEQUENCER_TABLE_SIZE + 1; disp++) {
             // dispatch a test command
@@ -744,29 +696,21 @@ namespace Svc {
         // register built-in commands
         this->m_impl.regCommands();
         // verify registrations
-        ASSERT_TRUE(this->m_impl.m_entryTable[0].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP);
-        ASSERT_EQ(this->m_impl.m_entryTable[0].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[1].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].opcode,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING);
-        ASSERT_EQ(this->m_impl.m_entryTable[1].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[2].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].opcode,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1);
-        ASSERT_EQ(this->m_impl.m_entryTable[2].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1);
 
-        ASSERT_TRUE(this->m_impl.m_entryTable[3].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].opcode,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING);
-        ASSERT_EQ(this->m_impl.m_entryTable[3].port,1);
+        this->checkRegistered(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1);
 
         // verify event
         ASSERT_EVENTS_SIZE(4);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(4);
-        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,0);
-        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,1);
-        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,2);
-        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,3);
+        ASSERT_EVENTS_OpCodeRegistered(0,CommandDispatcherImpl::OPCODE_CMD_NO_OP,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP));
+        ASSERT_EVENTS_OpCodeRegistered(1,CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_NO_OP_STRING));
+        ASSERT_EVENTS_OpCodeRegistered(2,CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_TEST_CMD_1));
+        ASSERT_EVENTS_OpCodeRegistered(3,CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING,1,this->m_impl.findOpcode(CommandDispatcherImpl::OPCODE_CMD_CLEAR_TRACKING));
 
         // register our own command
         FwOpcodeType testOpCode = 0x50;
@@ -774,14 +718,12 @@ namespace Svc {
 
         this->clearEvents();
         this->invoke_to_compCmdReg(0,testOpCode);
-        ASSERT_TRUE(this->m_impl.m_entryTable[4].used);
-        ASSERT_EQ(this->m_impl.m_entryTable[4].opcode,testOpCode);
-        ASSERT_EQ(this->m_impl.m_entryTable[4].port,0);
+        this->checkRegistered(testOpCode,0);
 
         // verify registration event
         ASSERT_EVENTS_SIZE(1);
         ASSERT_EVENTS_OpCodeRegistered_SIZE(1);
-        ASSERT_EVENTS_OpCodeRegistered(0,(U32)testOpCode,0,4);
+        ASSERT_EVENTS_OpCodeRegistered(0,(U32)testOpCode,0,this->m_impl.findOpcode(testOpCode));
 
         // dispatch a test command
         U32 testCmdArg = 100;
@@ -848,6 +790,366 @@ namespace Svc {
 
     }
 
+    void CommandDispatcherImplTester::checkRegistered(FwOpcodeType opCode, NATIVE_INT_TYPE port) {
+        NATIVE_INT_TYPE slot = this->m_impl.findOpcode(opCode);
+        ASSERT_NE(slot,CommandDispatcherImpl::CMD_DISPATCHER_NO_ENTRY);
+        ASSERT_TRUE(this->m_impl.m_entryTable[slot].used);
+        ASSERT_EQ(this->m_impl.m_entryTable[slot].opcode,opCode);
+        ASSERT_EQ(this->m_impl.m_entryTable[slot].port,port);
+    }
+
+    void CommandDispatcherImplTester::dispatchTestCmd(FwOpcodeType opCode, U32 context) {
+        Fw::ComBuffer buff;
+        ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize(opCode),Fw::FW_SERIALIZE_OK);
+        this->m_cmdSendRcvd = false;
+        this->invoke_to_seqCmdBuff(0,buff,context);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_TRUE(this->m_cmdSendRcvd);
+        ASSERT_EQ(this->m_cmdSendOpCode,opCode);
+    }
+
+    void CommandDispatcherImplTester::runCommandTimeout(void) {
+
+        this->m_impl.regCommands();
+        FwOpcodeType testOpCode = 0x50;
+        U32 testContext = 21;
+        this->invoke_to_compCmdReg(0,testOpCode);
+        ASSERT_EQ(this->m_impl.m_entryTable[this->m_impl.findOpcode(testOpCode)].timeout,(U32)CMD_DISPATCHER_DEFAULT_TIMEOUT);
+
+        // set the timeout of the test opcode to 3 ticks
+        this->clearHistory();
+        this->m_seqStatusRcvd = false;
+        Fw::ComBuffer buff;
+        ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize((FwOpcodeType)CommandDispatcherImpl::OPCODE_CMD_SET_TIMEOUT),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize((U32)testOpCode),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize((U32)3),Fw::FW_SERIALIZE_OK);
+        this->invoke_to_seqCmdBuff(0,buff,testContext);
+        // dispatch, run the command, then report its status
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EVENTS_TimeoutSet_SIZE(1);
+        ASSERT_EVENTS_TimeoutSet(0,testOpCode,3);
+        ASSERT_TRUE(this->m_seqStatusRcvd);
+        ASSERT_EQ(this->m_seqStatusCmdResponse,Fw::COMMAND_OK);
+        ASSERT_EQ(this->m_impl.m_entryTable[this->m_impl.findOpcode(testOpCode)].timeout,(U32)3);
+
+        // setting the timeout of an unregistered opcode fails
+        this->clearHistory();
+        this->m_seqStatusRcvd = false;
+        buff.resetSer();
+        ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize((FwOpcodeType)CommandDispatcherImpl::OPCODE_CMD_SET_TIMEOUT),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize((U32)0x60),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize((U32)3),Fw::FW_SERIALIZE_OK);
+        this->invoke_to_seqCmdBuff(0,buff,testContext);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EVENTS_InvalidCommand_SIZE(1);
+        ASSERT_EVENTS_InvalidCommand(0,0x60);
+        ASSERT_TRUE(this->m_seqStatusRcvd);
+        ASSERT_EQ(this->m_seqStatusCmdResponse,Fw::COMMAND_VALIDATION_ERROR);
+
+        // dispatch a command that never reports status
+        this->clearHistory();
+        this->m_seqStatusRcvd = false;
+        this->dispatchTestCmd(testOpCode,testContext);
+        U32 testSeq = this->m_cmdSendCmdSeq;
+        ASSERT_EQ(this->m_impl.m_numPending,(NATIVE_UINT_TYPE)1);
+        ASSERT_TLM_CommandsInFlight_SIZE(1);
+        ASSERT_TLM_CommandsInFlight(0,1);
+
+        // nothing happens until the third tick
+        for (NATIVE_UINT_TYPE tick = 0; tick < 2; tick++) {
+            this->invoke_to_schedIn(0,0);
+            ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+            ASSERT_FALSE(this->m_seqStatusRcvd);
+        }
+        ASSERT_EVENTS_OpCodeTimedOut_SIZE(0);
+
+        this->invoke_to_schedIn(0,0);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EVENTS_OpCodeTimedOut_SIZE(1);
+        ASSERT_EVENTS_OpCodeTimedOut(0,testOpCode,testSeq,3);
+        ASSERT_TRUE(this->m_seqStatusRcvd);
+        ASSERT_EQ(this->m_seqStatusOpCode,testOpCode);
+        ASSERT_EQ(this->m_seqStatusCmdSeq,testContext);
+        ASSERT_EQ(this->m_seqStatusCmdResponse,Fw::COMMAND_EXECUTION_ERROR);
+        ASSERT_EQ(this->m_impl.m_numPending,(NATIVE_UINT_TYPE)0);
+        ASSERT_TLM_CommandTimeouts_SIZE(1);
+        ASSERT_TLM_CommandTimeouts(0,1);
+        ASSERT_TLM_CommandsInFlight(1,0);
+
+        // a late status isn't reported twice
+        this->m_seqStatusRcvd = false;
+        this->invoke_to_compCmdStat(0,testOpCode,testSeq,Fw::COMMAND_OK);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_FALSE(this->m_seqStatusRcvd);
+
+        // a timeout of 0 never expires
+        this->m_impl.m_entryTable[this->m_impl.findOpcode(testOpCode)].timeout = 0;
+        this->clearHistory();
+        this->dispatchTestCmd(testOpCode,testContext);
+        testSeq = this->m_cmdSendCmdSeq;
+        for (NATIVE_UINT_TYPE tick = 0; tick < 2*CMD_DISPATCHER_DEFAULT_TIMEOUT; tick++) {
+            this->invoke_to_schedIn(0,0);
+            ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        }
+        ASSERT_EVENTS_OpCodeTimedOut_SIZE(0);
+        this->invoke_to_compCmdStat(0,testOpCode,testSeq,Fw::COMMAND_OK);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_TRUE(this->m_seqStatusRcvd);
+        ASSERT_EQ(this->m_seqStatusCmdResponse,Fw::COMMAND_OK);
+    }
+
+    void CommandDispatcherImplTester::runLatencyTelemetry(void) {
+
+        FwOpcodeType testOpCode = 0x50;
+        this->invoke_to_compCmdReg(0,testOpCode);
+
+        // latencies of 100 to 10000 us
+        for (U32 cmd = 1; cmd <= 100; cmd++) {
+            this->setTestTime(Fw::Time(TB_NONE,100,0));
+            this->dispatchTestCmd(testOpCode,cmd);
+            this->setTestTime(Fw::Time(TB_NONE,100,cmd*100));
+            this->invoke_to_compCmdStat(0,testOpCode,this->m_cmdSendCmdSeq,Fw::COMMAND_OK);
+            ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+            this->clearHistory();
+        }
+
+        // written at the end of the window
+        for (NATIVE_UINT_TYPE tick = 0; tick < CMD_DISPATCHER_LATENCY_WINDOW; tick++) {
+            ASSERT_TLM_LatencyP50_SIZE(0);
+            this->invoke_to_schedIn(0,0);
+            ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        }
+
+        // reported as the top of the bucket holding the sample: 5000 is in [4096,5119],
+        // 9000 in [8192,10239] and 9900 in the same bucket
+        ASSERT_TLM_LatencyP50_SIZE(1);
+        ASSERT_TLM_LatencyP50(0,5119);
+        ASSERT_TLM_LatencyP90_SIZE(1);
+        ASSERT_TLM_LatencyP90(0,10239);
+        ASSERT_TLM_LatencyP99_SIZE(1);
+        ASSERT_TLM_LatencyP99(0,10239);
+        ASSERT_EQ(this->m_impl.m_latencySamples,(U32)0);
+
+        // an empty window leaves the telemetry alone
+        this->clearHistory();
+        for (NATIVE_UINT_TYPE tick = 0; tick < CMD_DISPATCHER_LATENCY_WINDOW; tick++) {
+            this->invoke_to_schedIn(0,0);
+            ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        }
+        ASSERT_TLM_LatencyP50_SIZE(0);
+    }
+
+    void CommandDispatcherImplTester::runBatchCommands(void) {
+
+        FwOpcodeType testOpCode = 0x50;
+        FwOpcodeType badOpCode = 0x60;
+        U32 testContext = 31;
+        this->invoke_to_compCmdReg(0,testOpCode);
+
+        // batch of three commands, the second not registered
+        const U32 cmdSize = sizeof(FwPacketDescriptorType) + sizeof(FwOpcodeType) + sizeof(U32);
+        const FwOpcodeType opCodes[] = {testOpCode,badOpCode,testOpCode};
+        Fw::ComBuffer buff;
+        ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND_BATCH)),Fw::FW_SERIALIZE_OK);
+        for (U32 cmd = 0; cmd < FW_NUM_ARRAY_ELEMENTS(opCodes); cmd++) {
+            ASSERT_EQ(buff.serialize(cmdSize),Fw::FW_SERIALIZE_OK);
+            ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)),Fw::FW_SERIALIZE_OK);
+            ASSERT_EQ(buff.serialize(opCodes[cmd]),Fw::FW_SERIALIZE_OK);
+            ASSERT_EQ(buff.serialize(100 + cmd),Fw::FW_SERIALIZE_OK);
+        }
+
+        this->clearHistory();
+        this->m_seqStatusRcvd = false;
+        this->invoke_to_seqCmdBuff(0,buff,testContext);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+
+        // dispatched in order, each with its own sequence number
+        ASSERT_EVENTS_SIZE(3);
+        ASSERT_EVENTS_OpCodeDispatched_SIZE(2);
+        ASSERT_EVENTS_OpCodeDispatched(0,(U32)testOpCode,0);
+        ASSERT_EVENTS_OpCodeDispatched(1,(U32)testOpCode,0);
+        ASSERT_EVENTS_InvalidCommand_SIZE(1);
+        ASSERT_EVENTS_InvalidCommand(0,(U32)badOpCode);
+        ASSERT_TRUE(this->m_impl.m_sequenceTracker[0].used);
+        ASSERT_FALSE(this->m_impl.m_sequenceTracker[1].used);
+        ASSERT_TRUE(this->m_impl.m_sequenceTracker[2].used);
+        ASSERT_EQ(this->m_impl.m_sequenceTracker[2].context,testContext);
+        ASSERT_EQ(this->m_cmdSendCmdSeq,(U32)2);
+        U32 checkVal;
+        ASSERT_EQ(this->m_cmdSendArgs.deserialize(checkVal),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(checkVal,(U32)102);
+
+        // the unregistered opcode fails on its own
+        ASSERT_TRUE(this->m_seqStatusRcvd);
+        ASSERT_EQ(this->m_seqStatusOpCode,badOpCode);
+        ASSERT_EQ(this->m_seqStatusCmdSeq,testContext);
+        ASSERT_EQ(this->m_seqStatusCmdResponse,Fw::COMMAND_INVALID_OPCODE);
+
+        // each command reports its own status
+        this->invoke_to_compCmdStat(0,testOpCode,0,Fw::COMMAND_OK);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EQ(this->m_seqStatusCmdResponse,Fw::COMMAND_OK);
+        this->invoke_to_compCmdStat(0,testOpCode,2,Fw::COMMAND_EXECUTION_ERROR);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EQ(this->m_seqStatusCmdResponse,Fw::COMMAND_EXECUTION_ERROR);
+        ASSERT_EQ(this->m_impl.m_numPending,(NATIVE_UINT_TYPE)0);
+
+        // a length past the end drops the rest of the batch
+        buff.resetSer();
+        ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND_BATCH)),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize(cmdSize),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize(testOpCode),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize((U32)100),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize(cmdSize + 1),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize(testOpCode),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize((U32)101),Fw::FW_SERIALIZE_OK);
+
+        this->clearHistory();
+        this->invoke_to_seqCmdBuff(0,buff,testContext);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EVENTS_SIZE(2);
+        ASSERT_EVENTS_OpCodeDispatched_SIZE(1);
+        ASSERT_EVENTS_MalformedCommand_SIZE(1);
+        ASSERT_EVENTS_MalformedCommand(0,CommandDispatcherComponentBase::ERR_SIZE_MISMATCH);
+        ASSERT_EQ(this->m_seqStatusCmdResponse,Fw::COMMAND_VALIDATION_ERROR);
+    }
+
+    void CommandDispatcherImplTester::runCommandPriority(void) {
+
+        FwOpcodeType seqOpCode = 0x50;
+        FwOpcodeType urgentOpCode = 0x51;
+        U32 urgentContext = 99;
+        this->invoke_to_compCmdReg(0,seqOpCode);
+        this->invoke_to_compCmdReg(0,urgentOpCode);
+        // port 0 is the sequencer, port 1 the ground
+        this->m_impl.setPortPriority(1,CommandDispatcherImpl::CMD_PRIORITY_HIGH);
+
+        Fw::ComBuffer buff;
+        ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize(seqOpCode),Fw::FW_SERIALIZE_OK);
+
+        // the sequence fills its lane before the dispatcher thread runs
+        this->clearHistory();
+        this->m_seqStatusRcvd = false;
+        for (U32 cmd = 0; cmd < CMD_DISPATCHER_LANE_NORMAL_DEPTH; cmd++) {
+            this->invoke_to_seqCmdBuff(0,buff,cmd);
+        }
+        ASSERT_FALSE(this->m_seqStatusRcvd);
+
+        // the next one is returned busy right away
+        this->invoke_to_seqCmdBuff(0,buff,CMD_DISPATCHER_LANE_NORMAL_DEPTH);
+        ASSERT_TRUE(this->m_seqStatusRcvd);
+        ASSERT_EQ(this->m_seqStatusOpCode,seqOpCode);
+        ASSERT_EQ(this->m_seqStatusCmdSeq,(U32)CMD_DISPATCHER_LANE_NORMAL_DEPTH);
+        ASSERT_EQ(this->m_seqStatusCmdResponse,Fw::COMMAND_BUSY);
+
+        // a ground command sent after the sequence goes ahead of it
+        buff.resetSer();
+        ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize(urgentOpCode),Fw::FW_SERIALIZE_OK);
+        this->invoke_to_seqCmdBuff(1,buff,urgentContext);
+
+        // one message dispatches every waiting command
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EVENTS_SIZE(CMD_DISPATCHER_LANE_NORMAL_DEPTH + 1);
+        ASSERT_EVENTS_OpCodeDispatched_SIZE(CMD_DISPATCHER_LANE_NORMAL_DEPTH + 1);
+        ASSERT_EVENTS_OpCodeDispatched(0,(U32)urgentOpCode,0);
+        ASSERT_EVENTS_OpCodeDispatched(1,(U32)seqOpCode,0);
+        ASSERT_EQ(this->m_impl.m_sequenceTracker[0].opCode,urgentOpCode);
+        ASSERT_EQ(this->m_impl.m_sequenceTracker[0].callerPort,1);
+        ASSERT_EQ(this->m_impl.m_sequenceTracker[0].context,urgentContext);
+        ASSERT_EQ(this->m_cmdSendOpCode,seqOpCode);
+
+        // occupancy telemetry
+        ASSERT_TLM_HighLaneHighWater_SIZE(1);
+        ASSERT_TLM_HighLaneHighWater(0,1);
+        ASSERT_TLM_NormalLaneHighWater_SIZE(1);
+        ASSERT_TLM_NormalLaneHighWater(0,CMD_DISPATCHER_LANE_NORMAL_DEPTH);
+        ASSERT_TLM_NormalLaneBusy_SIZE(1);
+        ASSERT_TLM_NormalLaneBusy(0,1);
+
+        // the lane has room again
+        buff.resetSer();
+        ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)),Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(buff.serialize(seqOpCode),Fw::FW_SERIALIZE_OK);
+        this->clearHistory();
+        this->m_seqStatusRcvd = false;
+        this->invoke_to_seqCmdBuff(0,buff,0);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_FALSE(this->m_seqStatusRcvd);
+        ASSERT_EVENTS_OpCodeDispatched_SIZE(1);
+
+        // fill the queue (depth 10 in the test) so the cmdReady message is dropped.
+        // Each command tries again while the queue is full.
+        for (NATIVE_UINT_TYPE call = 0; call < 10; call++) {
+            this->invoke_to_schedIn(0,0);
+        }
+        this->clearHistory();
+        this->invoke_to_seqCmdBuff(0,buff,1);
+        ASSERT_EQ(this->m_impl.m_lanesPending,(U32)0);
+        this->invoke_to_seqCmdBuff(0,buff,2);
+        ASSERT_EQ(this->m_impl.m_lanesPending,(U32)0);
+        // the first schedIn call dispatches both
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EVENTS_OpCodeDispatched_SIZE(2);
+        for (NATIVE_UINT_TYPE call = 1; call < 10; call++) {
+            ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        }
+        // with room in the queue, the next command sends a cmdReady message again
+        this->clearHistory();
+        this->invoke_to_seqCmdBuff(0,buff,3);
+        ASSERT_EQ(this->m_impl.m_lanesPending,(U32)1);
+        ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+        ASSERT_EVENTS_OpCodeDispatched_SIZE(1);
+        ASSERT_FALSE(this->m_seqStatusRcvd);
+    }
+
+    void CommandDispatcherImplTester::runFullDispatchTable(void) {
+
+        // opcodes laid out the way a topology would: components with
+        // base IDs 0x100 apart, each with 20 commands
+        const NATIVE_UINT_TYPE numOpcodes = CMD_DISPATCHER_DISPATCH_TABLE_SIZE;
+        FwOpcodeType opCodes[CMD_DISPATCHER_DISPATCH_TABLE_SIZE];
+        for (NATIVE_UINT_TYPE op = 0; op < numOpcodes; op++) {
+            opCodes[op] = 0x1000 + (op/20)*0x100 + (op%20);
+        }
+
+        // fill the table
+        for (NATIVE_UINT_TYPE op = 0; op < numOpcodes; op++) {
+            this->invoke_to_compCmdReg(0,opCodes[op]);
+        }
+        ASSERT_EQ(this->m_impl.m_numEntries,numOpcodes);
+        for (NATIVE_UINT_TYPE op = 0; op < numOpcodes; op++) {
+            this->checkRegistered(opCodes[op],0);
+        }
+
+        // every opcode is dispatched to its port
+        for (NATIVE_UINT_TYPE op = 0; op < numOpcodes; op++) {
+            Fw::ComBuffer buff;
+            ASSERT_EQ(buff.serialize(FwPacketDescriptorType(Fw::ComPacket::FW_PACKET_COMMAND)),Fw::FW_SERIALIZE_OK);
+            ASSERT_EQ(buff.serialize(opCodes[op]),Fw::FW_SERIALIZE_OK);
+            this->m_cmdSendRcvd = false;
+            this->invoke_to_seqCmdBuff(0,buff,op);
+            ASSERT_EQ(Fw::QueuedComponentBase::MSG_DISPATCH_OK,this->m_impl.doDispatch());
+            ASSERT_TRUE(this->m_cmdSendRcvd);
+            ASSERT_EQ(this->m_cmdSendOpCode,opCodes[op]);
+        }
+
+        // opcodes that aren't registered have to probe until an unused slot
+        for (NATIVE_UINT_TYPE op = 0; op < numOpcodes; op++) {
+            ASSERT_EQ(this->m_impl.findOpcode(opCodes[op] + 20),CommandDispatcherImpl::CMD_DISPATCHER_NO_ENTRY);
+        }
+    }
+
     void CommandDispatcherImplTester::from_pingOut_handler(
               const NATIVE_INT_TYPE portNum, /*!< The port number*/
               U32 key /*!< Value to return to pinger*/
@@ -27,10 +27,18 @@ namespace Svc {
             void runOverflowCommands(void);
             void runNopCommands(void);
             void runClearCommandTracking();
+            void runFullDispatchTable(void);
+            void runCommandTimeout(void);
+            void runLatencyTelemetry(void);
+            void runBatchCommands(void);
+            void runCommandPriority(void);
 
         private:
             Svc::CommandDispatcherImpl& m_impl;
 
+            void checkRegistered(FwOpcodeType opCode, NATIVE_INT_TYPE port); //!< check opcode is in the dispatch table
+            void dispatchTestCmd(FwOpcodeType opCode, U32 context); //!< send a command with no arguments and dispatch it
+
             void from_compCmdSend_handler(NATIVE_INT_TYPE portNum, FwOpcodeType opCode, U32 cmdSeq, Fw::CmdArgBuffer &args);
 
             void from_pingOut_handler(
@@ -19,6 +19,7 @@ void connectPorts(Svc::CommandDispatcherImpl& impl, Svc::CommandDispatcherImplTe
     tester.connect_to_compCmdStat(0,impl.get_compCmdStat_InputPort(0));
     tester.connect_to_seqCmdBuff(0,impl.get_seqCmdBuff_InputPort(0));
     tester.connect_to_compCmdReg(0,impl.get_compCmdReg_InputPort(0));
+    tester.connect_to_schedIn(0,impl.get_schedIn_InputPort(0));
 
     impl.set_compCmdSend_OutputPort(0,tester.get_from_compCmdSend(0));
     impl.set_seqCmdStatus_OutputPort(0,tester.get_from_seqCmdStatus(0));
@@ -183,6 +184,110 @@ TEST(CmdDispTestOffNominal,ClearSequenceTracker) {
 
 }
 
+TEST(CmdDispTestNominal,FullDispatchTable) {
+
+    TEST_CASE(102.1.4,"Full Dispatch Table");
+    COMMENT("Register as many opcodes as the table holds and dispatch each of them.");
+
+    Svc::CommandDispatcherImpl impl("CmdDispImpl");
+
+    impl.init(10,0);
+
+    Svc::CommandDispatcherImplTester tester(impl);
+
+    tester.init();
+
+    // only the command ports
+    tester.connect_to_seqCmdBuff(0,impl.get_seqCmdBuff_InputPort(0));
+    tester.connect_to_compCmdReg(0,impl.get_compCmdReg_InputPort(0));
+    impl.set_compCmdSend_OutputPort(0,tester.get_from_compCmdSend(0));
+
+    tester.runFullDispatchTable();
+
+}
+
+TEST(CmdDispTestOffNominal,CommandTimeout) {
+
+    TEST_CASE(102.2.5,"Command Timeout");
+    COMMENT("Verify commands that don't report status time out and are failed back to the sender.");
+
+    Svc::CommandDispatcherImpl impl("CmdDispImpl");
+
+    impl.init(10,0);
+
+    Svc::CommandDispatcherImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    tester.runCommandTimeout();
+
+}
+
+TEST(CmdDispTestNominal,LatencyTelemetry) {
+
+    TEST_CASE(102.1.5,"Latency Telemetry");
+    COMMENT("Verify the command latency percentiles.");
+
+    Svc::CommandDispatcherImpl impl("CmdDispImpl");
+
+    impl.init(10,0);
+
+    Svc::CommandDispatcherImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    tester.runLatencyTelemetry();
+
+}
+
+TEST(CmdDispTestNominal,BatchCommands) {
+
+    TEST_CASE(102.1.6,"Command Batch");
+    COMMENT("Dispatch a batch of commands and verify each is dispatched in order with its own status.");
+
+    Svc::CommandDispatcherImpl impl("CmdDispImpl");
+
+    impl.init(10,0);
+
+    Svc::CommandDispatcherImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    tester.runBatchCommands();
+
+}
+
+TEST(CmdDispTestNominal,CommandPriority) {
+
+    TEST_CASE(102.1.7,"Command Priority");
+    COMMENT("Verify a high priority port goes ahead of a full sequence lane, a full lane returns busy, and a dropped wakeup is retried.");
+
+    Svc::CommandDispatcherImpl impl("CmdDispImpl");
+
+    impl.init(10,0);
+
+    Svc::CommandDispatcherImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports, with a second command source
+    connectPorts(impl,tester);
+    tester.connect_to_seqCmdBuff(1,impl.get_seqCmdBuff_InputPort(1));
+    impl.set_seqCmdStatus_OutputPort(1,tester.get_from_seqCmdStatus(1));
+
+    tester.runCommandPriority();
+
+}
+
 #ifndef TGT_OS_TYPE_VXWORKS
 int main(int argc, char* argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,41 @@
+/*
+ * DeferredTextLoggerImpl.cpp
+ *
+ * This file implements the DeferredTextLogger component, which
+ * formats text log events queued by other components.
+ */
+
+#include <Svc/DeferredTextLogger/DeferredTextLoggerImpl.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+#include <Fw/Types/Assert.hpp>
+
+namespace Svc {
+
+#if FW_OBJECT_NAMES == 1
+    DeferredTextLoggerImpl::DeferredTextLoggerImpl(const char* compName) :
+        DeferredTextLoggerComponentBase(compName) {
+    }
+#else
+    DeferredTextLoggerImpl::DeferredTextLoggerImpl(void) :
+        DeferredTextLoggerComponentBase() {
+    }
+#endif
+
+    void DeferredTextLoggerImpl::init(NATIVE_INT_TYPE queueDepth, NATIVE_INT_TYPE instance) {
+        DeferredTextLoggerComponentBase::init(queueDepth,instance);
+        Fw::TextLogQueue::setQueue(&this->m_queue);
+    }
+
+    DeferredTextLoggerImpl::~DeferredTextLoggerImpl(void) {
+    }
+
+    void DeferredTextLoggerImpl::Run_handler(NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context) {
+        // Take at most what the queue holds, so a steady stream of events
+        // doesn't keep the thread from returning to its message queue
+        (void)this->m_queue.drain(FW_TEXT_LOG_QUEUE_DEPTH);
+
+        this->tlmWrite_DTL_OVERFLOWS(this->m_queue.getOverflows());
+        this->tlmWrite_DTL_HIGH_WATER(this->m_queue.getHighWater());
+    }
+
+}
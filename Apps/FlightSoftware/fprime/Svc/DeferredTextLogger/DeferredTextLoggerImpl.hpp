@@ -0,0 +1,56 @@
+/*
+ * DeferredTextLoggerImpl.hpp
+ *
+ * This file implements the DeferredTextLogger component, which
+ * formats text log events queued by other components.
+ */
+
+#ifndef SVC_DEFERRED_TEXT_LOGGER_IMPL_HPP
+#define SVC_DEFERRED_TEXT_LOGGER_IMPL_HPP
+
+#include <Svc/DeferredTextLogger/DeferredTextLoggerComponentAc.hpp>
+#include <Fw/Log/TextLogQueue.hpp>
+
+namespace Svc {
+
+    //! \class DeferredTextLoggerImpl
+    //! \brief Formats text log events off the thread of the caller
+    //!
+    //! When FW_TEXT_LOG_DEFERRED is set, the generated log functions put the
+    //! event arguments in this component's Fw::TextLogQueue instead of formatting
+    //! the text. Each call to the Run port formats the waiting events on the
+    //! component thread and sends them on the text log port of the component
+    //! that logged them, so the text logger sees the same text as before.
+    //! Give the component a low priority so the formatting runs when the
+    //! system is otherwise idle.
+
+    class DeferredTextLoggerImpl : public DeferredTextLoggerComponentBase {
+        public:
+
+#if FW_OBJECT_NAMES == 1
+            DeferredTextLoggerImpl(const char* compName);
+#else
+            DeferredTextLoggerImpl(void);
+#endif
+
+            //!  \brief Initializes the component and makes its queue the one
+            //!  the generated log functions use
+            //!
+            //!  \param queueDepth Depth of the active component message queue
+            //!  \param instance Instance of the component
+
+            void init(NATIVE_INT_TYPE queueDepth, NATIVE_INT_TYPE instance);
+
+            ~DeferredTextLoggerImpl(void);
+
+        PRIVATE:
+
+            //! Formats and sends the waiting events, then updates telemetry
+            void Run_handler(NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context);
+
+            Fw::TextLogQueue m_queue; //!< events waiting to be formatted
+    };
+
+}
+
+#endif
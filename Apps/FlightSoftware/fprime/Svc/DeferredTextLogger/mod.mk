@@ -0,0 +1,10 @@
+# ----------------------------------------------------------------------
+# mod.mk 
+# ----------------------------------------------------------------------
+
+SRC = 	\
+		DeferredTextLoggerImpl.cpp \
+		DeferredTextLoggerComponentAi.xml
+
+HDR = 	\
+		DeferredTextLoggerImpl.hpp
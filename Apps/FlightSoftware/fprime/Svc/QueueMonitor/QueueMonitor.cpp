@@ -0,0 +1,123 @@
+// ====================================================================== 
+// \title  QueueMonitor.cpp
+// \brief  cpp file for QueueMonitor component implementation class
+// ====================================================================== 
+
+#include "Fw/Types/Assert.hpp"
+#include "Fw/Types/BasicTypes.hpp"
+#include "Svc/QueueMonitor/QueueMonitor.hpp"
+
+#if !FW_QUEUE_REGISTRATION
+#error "QueueMonitor needs FW_QUEUE_REGISTRATION"
+#endif
+
+namespace Svc {
+
+  // ----------------------------------------------------------------------
+  // Construction, initialization, and destruction 
+  // ----------------------------------------------------------------------
+
+  QueueMonitor ::
+    QueueMonitor(const char *const compName) :
+      QueueMonitorComponentBase(compName),
+      numQueues(0),
+      numUnmonitored(0),
+      next(0)
+  {
+    for (U32 entry = 0; entry < QUEUEMONITOR_MAX_QUEUES; ++entry) {
+      this->queues[entry] = NULL;
+    }
+  }
+
+  void QueueMonitor ::
+    init(const NATIVE_INT_TYPE instance) 
+  {
+    QueueMonitorComponentBase::init(instance);
+    Os::Queue::setQueueRegistry(this);
+  }
+
+  QueueMonitor ::
+    ~QueueMonitor(void)
+  {
+    Os::Queue::setQueueRegistry(NULL);
+  }
+
+  void QueueMonitor ::
+    regQueue(Os::Queue* queue)
+  {
+    FW_ASSERT(queue);
+    this->entryLock.lock();
+    // a queue that is created again keeps its entry
+    for (U32 entry = 0; entry < this->numQueues; ++entry) {
+      if (this->queues[entry] == queue) {
+        this->entryLock.unLock();
+        return;
+      }
+    }
+    if (this->numQueues == QUEUEMONITOR_MAX_QUEUES) {
+      ++this->numUnmonitored;
+    } else {
+      this->queues[this->numQueues] = queue;
+      ++this->numQueues;
+    }
+    this->entryLock.unLock();
+  }
+
+  void QueueMonitor ::
+    unregQueue(Os::Queue* queue)
+  {
+    FW_ASSERT(queue);
+    this->entryLock.lock();
+    for (U32 entry = 0; entry < this->numQueues; ++entry) {
+      if (this->queues[entry] == queue) {
+        // the last entry takes its place
+        --this->numQueues;
+        this->queues[entry] = this->queues[this->numQueues];
+        this->queues[this->numQueues] = NULL;
+        break;
+      }
+    }
+    this->entryLock.unLock();
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void QueueMonitor ::
+    Run_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->entryLock.lock();
+    if (this->numQueues == 0) {
+      this->entryLock.unLock();
+      return;
+    }
+    if (this->next >= this->numQueues) {
+      this->next = 0;
+    }
+    // channels only hold their last value, so one queue is published per
+    // call
+    Os::Queue* queue = this->queues[this->next];
+    ++this->next;
+
+    Fw::TlmString name(queue->getName().toChar());
+    this->tlmWrite_QueueMonitor_Queue(name);
+    this->tlmWrite_QueueMonitor_Depth(queue->getNumMsgs());
+    this->tlmWrite_QueueMonitor_Size(queue->getQueueSize());
+    this->tlmWrite_QueueMonitor_HighWater(queue->getMaxMsgs());
+#if FW_QUEUE_INSTRUMENTATION
+    const Os::QueueStats& stats = queue->getStats();
+    this->tlmWrite_QueueMonitor_Sends(stats.getSends());
+    this->tlmWrite_QueueMonitor_SendsFull(stats.getSendsFull());
+    this->tlmWrite_QueueMonitor_LatencyP50(stats.getLatencyPercentile(50));
+    this->tlmWrite_QueueMonitor_LatencyP99(stats.getLatencyPercentile(99));
+    this->tlmWrite_QueueMonitor_LatencyMax(stats.getMaxLatency());
+#endif
+    this->tlmWrite_QueueMonitor_UnmonitoredQueues(this->numUnmonitored);
+    this->entryLock.unLock();
+  }
+
+}
@@ -0,0 +1,100 @@
+// ====================================================================== 
+// \title  QueueMonitor.hpp
+// \brief  hpp file for QueueMonitor component implementation class
+// ====================================================================== 
+
+#ifndef QueueMonitor_HPP
+#define QueueMonitor_HPP
+
+#include "Os/Mutex.hpp"
+#include "Os/Queue.hpp"
+#include "Svc/QueueMonitor/QueueMonitorComponentAc.hpp"
+#include "Svc/QueueMonitor/QueueMonitorCfg.hpp"
+
+namespace Svc {
+
+  //! The queue registry. Every queue created after it is initialized is
+  //! registered with it until the queue is destroyed, and each Run call
+  //! publishes the depth, high water mark and statistics of the next queue
+  //! as telemetry
+  class QueueMonitor :
+    public QueueMonitorComponentBase,
+    public Os::QueueRegistry
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction, initialization, and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object QueueMonitor
+      //!
+      QueueMonitor(
+          const char *const compName //!< The component name
+      );
+
+      //! Initialize object QueueMonitor, and make it the queue registry.
+      //! Components create their queues in init, so call this before the
+      //! init of any other component. Queues created before this are never
+      //! monitored
+      //!
+      void init(
+          const NATIVE_INT_TYPE instance //!< The instance number
+      );
+
+      //! Destroy object QueueMonitor
+      //!
+      ~QueueMonitor(void);
+
+      //! Register a queue. Called by Os::Queue::create
+      //!
+      void regQueue(
+          Os::Queue* queue //!< The queue
+      );
+
+      //! Remove a queue. Called by the Os::Queue destructor
+      //!
+      void unregQueue(
+          Os::Queue* queue //!< The queue
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for user-defined typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for Run
+      //!
+      void Run_handler(
+          const NATIVE_INT_TYPE portNum, //!< The port number
+          NATIVE_UINT_TYPE context //!< The call order
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Variables 
+      // ----------------------------------------------------------------------
+
+      //! The registered queues. Entries below numQueues are in use
+      Os::Queue* queues[QUEUEMONITOR_MAX_QUEUES];
+
+      //! The number of registered queues
+      U32 numQueues;
+
+      //! The number of queues not registered because every entry was in use
+      U32 numUnmonitored;
+
+      //! The entry Run publishes next
+      U32 next;
+
+      //! Guards the entries, so a queue isn't destroyed while Run reads it
+      Os::Mutex entryLock;
+
+    };
+
+}
+
+#endif
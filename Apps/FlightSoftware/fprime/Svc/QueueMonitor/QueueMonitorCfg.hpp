@@ -0,0 +1,18 @@
+// ======================================================================
+// \title  QueueMonitorCfg.hpp
+// \brief  Configuration for the QueueMonitor component
+//
+// ======================================================================
+
+#ifndef QueueMonitorCfg_HPP
+#define QueueMonitorCfg_HPP
+
+// Each queue created after the QueueMonitor is initialized takes an
+// entry until it is destroyed. Queues created when every entry is in use
+// are counted, but not published.
+
+enum {
+  QUEUEMONITOR_MAX_QUEUES = 32 //!< The most queues published
+};
+
+#endif
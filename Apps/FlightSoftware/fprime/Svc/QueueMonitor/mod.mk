@@ -0,0 +1,7 @@
+# ---------------------------------------------------------------------- 
+# mod.mk
+# ---------------------------------------------------------------------- 
+
+SRC = QueueMonitorComponentAi.xml QueueMonitor.cpp
+
+HDR = QueueMonitor.hpp QueueMonitorCfg.hpp
@@ -0,0 +1,30 @@
+// ----------------------------------------------------------------------
+// Main.cpp 
+// ----------------------------------------------------------------------
+
+#include "Tester.hpp"
+
+TEST(Test, PublishQueues) {
+  Svc::Tester tester;
+  tester.publish_queues();
+}
+
+TEST(Test, CreateAgain) {
+  Svc::Tester tester;
+  tester.create_again();
+}
+
+TEST(Test, TooManyQueues) {
+  Svc::Tester tester;
+  tester.too_many_queues();
+}
+
+TEST(Test, DestroyQueue) {
+  Svc::Tester tester;
+  tester.destroy_queue();
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,220 @@
+// ====================================================================== 
+// \title  QueueMonitor/test/ut/Tester.cpp
+// \brief  cpp file for QueueMonitor test harness implementation class
+// ====================================================================== 
+
+#include "Tester.hpp"
+#include "Fw/Types/EightyCharString.hpp"
+#include <stdio.h>
+
+#define INSTANCE 0
+#define MAX_HISTORY_SIZE 100
+#define MSG_SIZE 4
+
+namespace Svc {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction 
+  // ----------------------------------------------------------------------
+
+  Tester ::
+    Tester(void) : 
+#if FW_OBJECT_NAMES == 1
+      QueueMonitorGTestBase("Tester", MAX_HISTORY_SIZE),
+      component("QueueMonitor")
+#else
+      QueueMonitorGTestBase(MAX_HISTORY_SIZE),
+      component()
+#endif
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  Tester ::
+    ~Tester(void) 
+  {
+    
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests 
+  // ----------------------------------------------------------------------
+
+  void Tester ::
+    publish_queues(void) 
+  {
+      // nothing to publish yet
+      this->invoke_to_Run(0, 0);
+      ASSERT_TLM_SIZE(0);
+
+      Os::Queue queueA;
+      Os::Queue queueB;
+      this->createQueue(queueA, "QueueA", 4);
+      this->createQueue(queueB, "QueueB", 2);
+      this->send(queueA, 3);
+      this->send(queueB, 3);
+      U8 msg[MSG_SIZE];
+      NATIVE_INT_TYPE size;
+      NATIVE_INT_TYPE priority;
+      ASSERT_EQ(Os::Queue::QUEUE_OK,
+          queueA.receive(msg, sizeof(msg), size, priority, Os::Queue::QUEUE_NONBLOCKING));
+
+      // one queue each call, in the order they were created
+      this->invoke_to_Run(0, 0);
+      ASSERT_TLM_QueueMonitor_Queue_SIZE(1);
+      ASSERT_TLM_QueueMonitor_Queue(0, "QueueA");
+      ASSERT_TLM_QueueMonitor_Depth(0, 2);
+      ASSERT_TLM_QueueMonitor_Size(0, 4);
+      ASSERT_TLM_QueueMonitor_HighWater(0, 3);
+      ASSERT_TLM_QueueMonitor_UnmonitoredQueues(0, 0);
+
+      this->invoke_to_Run(0, 0);
+      ASSERT_TLM_QueueMonitor_Queue_SIZE(2);
+      ASSERT_TLM_QueueMonitor_Queue(1, "QueueB");
+      ASSERT_TLM_QueueMonitor_Depth(1, 2);
+      ASSERT_TLM_QueueMonitor_Size(1, 2);
+      ASSERT_TLM_QueueMonitor_HighWater(1, 2);
+#if FW_QUEUE_INSTRUMENTATION
+      ASSERT_TLM_QueueMonitor_Sends(0, 3);
+      ASSERT_TLM_QueueMonitor_SendsFull(0, 0);
+      ASSERT_TLM_QueueMonitor_Sends(1, 2);
+      ASSERT_TLM_QueueMonitor_SendsFull(1, 1);
+      // nothing has been received from queue B
+      ASSERT_TLM_QueueMonitor_LatencyMax(1, 0);
+#else
+      ASSERT_TLM_QueueMonitor_Sends_SIZE(0);
+#endif
+
+      // and around again
+      this->invoke_to_Run(0, 0);
+      ASSERT_TLM_QueueMonitor_Queue_SIZE(3);
+      ASSERT_TLM_QueueMonitor_Queue(2, "QueueA");
+  }
+
+  void Tester ::
+    create_again(void) 
+  {
+      Os::Queue queue;
+      this->createQueue(queue, "Queue", 4);
+      this->createQueue(queue, "Queue", 8);
+      this->invoke_to_Run(0, 0);
+      this->invoke_to_Run(0, 0);
+      ASSERT_TLM_QueueMonitor_Size_SIZE(2);
+      ASSERT_TLM_QueueMonitor_Size(0, 8);
+      ASSERT_TLM_QueueMonitor_Size(1, 8);
+  }
+
+  void Tester ::
+    too_many_queues(void) 
+  {
+      Os::Queue queues[QUEUEMONITOR_MAX_QUEUES + 2];
+      for (U32 entry = 0; entry < FW_NUM_ARRAY_ELEMENTS(queues); ++entry) {
+        char name[16];
+        (void) snprintf(name, sizeof(name), "Queue%u", entry);
+        this->createQueue(queues[entry], name, 1);
+      }
+
+      // the last two are counted, not published
+      for (U32 entry = 0; entry <= QUEUEMONITOR_MAX_QUEUES; ++entry) {
+        this->invoke_to_Run(0, 0);
+      }
+      ASSERT_TLM_QueueMonitor_Queue_SIZE(QUEUEMONITOR_MAX_QUEUES + 1);
+      char last[16];
+      (void) snprintf(last, sizeof(last), "Queue%u", QUEUEMONITOR_MAX_QUEUES - 1);
+      ASSERT_TLM_QueueMonitor_Queue(QUEUEMONITOR_MAX_QUEUES - 1, last);
+      ASSERT_TLM_QueueMonitor_Queue(QUEUEMONITOR_MAX_QUEUES, "Queue0");
+      ASSERT_TLM_QueueMonitor_UnmonitoredQueues(QUEUEMONITOR_MAX_QUEUES, 2);
+  }
+
+  void Tester ::
+    destroy_queue(void) 
+  {
+      Os::Queue queueA;
+      this->createQueue(queueA, "QueueA", 1);
+      {
+        Os::Queue queueB;
+        Os::Queue queueC;
+        this->createQueue(queueB, "QueueB", 1);
+        this->createQueue(queueC, "QueueC", 1);
+        this->invoke_to_Run(0, 0);
+        ASSERT_TLM_QueueMonitor_Queue(0, "QueueA");
+      }
+
+      // only queue A is left
+      this->invoke_to_Run(0, 0);
+      this->invoke_to_Run(0, 0);
+      ASSERT_TLM_QueueMonitor_Queue_SIZE(3);
+      ASSERT_TLM_QueueMonitor_Queue(1, "QueueA");
+      ASSERT_TLM_QueueMonitor_Queue(2, "QueueA");
+
+      // and its entry is free again
+      Os::Queue queueD;
+      this->createQueue(queueD, "QueueD", 1);
+      this->invoke_to_Run(0, 0);
+      ASSERT_TLM_QueueMonitor_Queue(3, "QueueD");
+      ASSERT_TLM_QueueMonitor_UnmonitoredQueues(3, 0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper methods 
+  // ----------------------------------------------------------------------
+
+  void Tester ::
+    createQueue(
+        Os::Queue& queue,
+        const char* name,
+        const NATIVE_INT_TYPE depth
+    )
+  {
+    const Os::Queue::QueueStatus stat =
+      queue.create(Fw::EightyCharString(name), depth, MSG_SIZE);
+    ASSERT_EQ(Os::Queue::QUEUE_OK, stat);
+  }
+
+  void Tester ::
+    send(
+        Os::Queue& queue,
+        const U32 numMsgs
+    )
+  {
+    const U8 msg[MSG_SIZE] = { 0 };
+    for (U32 i = 0; i < numMsgs; ++i) {
+      (void) queue.send(msg, sizeof(msg), 0, Os::Queue::QUEUE_NONBLOCKING);
+    }
+  }
+
+  void Tester ::
+    connectPorts(void) 
+  {
+
+    // Run
+    this->connect_to_Run(
+        0,
+        this->component.get_Run_InputPort(0)
+    );
+
+    // timeCaller
+    this->component.set_timeCaller_OutputPort(
+        0, 
+        this->get_from_timeCaller(0)
+    );
+
+    // tlmOut
+    this->component.set_tlmOut_OutputPort(
+        0, 
+        this->get_from_tlmOut(0)
+    );
+
+  }
+
+  void Tester ::
+    initComponents(void) 
+  {
+    this->init();
+    this->component.init(
+        INSTANCE
+    );
+  }
+
+} // end namespace Svc
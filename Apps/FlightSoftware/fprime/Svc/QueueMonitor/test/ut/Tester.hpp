@@ -0,0 +1,93 @@
+// ====================================================================== 
+// \title  QueueMonitor/test/ut/Tester.hpp
+// \brief  hpp file for QueueMonitor test harness implementation class
+// ====================================================================== 
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "GTestBase.hpp"
+#include "Svc/QueueMonitor/QueueMonitor.hpp"
+
+namespace Svc {
+
+  class Tester :
+    public QueueMonitorGTestBase
+  {
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+    public:
+
+      //! Construct object Tester
+      //!
+      Tester(void);
+
+      //! Destroy object Tester
+      //!
+      ~Tester(void);
+
+    public:
+
+      // ---------------------------------------------------------------------- 
+      // Tests 
+      // ---------------------------------------------------------------------- 
+
+      //! Publish two queues in turn
+      void publish_queues(void);
+
+      //! Create a queue twice
+      void create_again(void);
+
+      //! Create more queues than the monitor has entries for
+      void too_many_queues(void);
+
+      //! Destroy a queue, and stop publishing it
+      void destroy_queue(void);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper methods 
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      //!
+      void connectPorts(void);
+
+      //! Initialize components
+      //!
+      void initComponents(void);
+
+      //! Create a queue
+      //!
+      void createQueue(
+          Os::Queue& queue, //!< The queue
+          const char* name, //!< The queue name
+          const NATIVE_INT_TYPE depth //!< The queue depth
+      );
+
+      //! Send messages on a queue
+      //!
+      void send(
+          Os::Queue& queue, //!< The queue
+          const U32 numMsgs //!< The number of messages
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Variables 
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      //!
+      QueueMonitor component;
+
+  };
+
+} // end namespace Svc
+
+#endif
@@ -17,6 +17,11 @@
 
 #include <stdio.h>
 
+namespace {
+    // Knuth's multiplicative hash constant, 2^32 divided by the golden ratio
+    const U32 TLMCHAN_DEFAULT_HASH_MULTIPLIER = 0x9E3779B1;
+}
+
 namespace Svc {
 
 #if FW_OBJECT_NAMES == 1
@@ -24,29 +29,53 @@ namespace Svc {
 #else
     TlmChanImpl::TlmChanImpl()
 #endif
+    ,m_numChannels(0)
+    ,m_hashMultiplier(TLMCHAN_DEFAULT_HASH_MULTIPLIER)
+    ,m_overflowReported(0)
+    ,m_writeStamp(0)
+    ,m_contendedWrites(0)
+    ,m_packetList(0)
+    ,m_runCycles(0)
+    ,m_sentSamples(0)
+    ,m_suppressedSamples(0)
+    ,m_filterParamsUpdated(0)
+    ,m_lastWindowId(0)
     {
-        // clear data
-        this->m_activeBuffer = 0;
-        // clear slot pointers
-        for (NATIVE_UINT_TYPE entry = 0; entry < TLMCHAN_NUM_TLM_HASH_SLOTS; entry++) {
-            this->m_tlmEntries[0].slots[entry] = 0;
-            this->m_tlmEntries[1].slots[entry] = 0;
+        // index must be big enough to keep probe sequences short
+        FW_ASSERT(TLMCHAN_INDEX_SLOTS >= 2*TLMCHAN_MAX_CHANNELS,TLMCHAN_INDEX_SLOTS,TLMCHAN_MAX_CHANNELS);
+        // index stores entry + 1 in a U16
+        FW_ASSERT(TLMCHAN_MAX_CHANNELS < 0xFFFF,TLMCHAN_MAX_CHANNELS);
+        // clear index
+        for (NATIVE_UINT_TYPE slot = 0; slot < TLMCHAN_INDEX_SLOTS; slot++) {
+            this->m_index[slot] = 0;
         }
-        // clear buckets
-        for (NATIVE_UINT_TYPE entry = 0; entry < TLMCHAN_HASH_BUCKETS; entry++) {
-            this->m_tlmEntries[0].buckets[entry].used = false;
-            this->m_tlmEntries[0].buckets[entry].bucketNo = entry;
-            this->m_tlmEntries[0].buckets[entry].next = 0;
-            this->m_tlmEntries[0].buckets[entry].id = 0;
-            this->m_tlmEntries[1].buckets[entry].used = false;
-            this->m_tlmEntries[1].buckets[entry].bucketNo = entry;
-            this->m_tlmEntries[1].buckets[entry].next = 0;
-            this->m_tlmEntries[1].buckets[entry].id = 0;
+        // clear entries
+        for (NATIVE_UINT_TYPE entry = 0; entry < TLMCHAN_MAX_CHANNELS; entry++) {
+            this->m_channels[entry].id = 0;
+            this->m_channels[entry].packet = TLMCHAN_NO_PACKET;
+            this->m_channels[entry].packetSize = 0;
+            this->m_entries[entry].seq = 0;
+            this->m_entries[entry].seenSeq = 0;
+            this->m_entries[entry].statsSlot = TLMCHAN_NO_STATS;
+            for (NATIVE_UINT_TYPE copy = 0; copy < 2; copy++) {
+                this->m_entries[entry].copies[copy].windows[0].window = 0;
+                this->m_entries[entry].copies[copy].windows[1].window = 0;
+            }
+            this->m_channelFilter[entry] = TLMCHAN_FILTER_UNRESOLVED;
+        }
+        // clear filters
+        for (NATIVE_UINT_TYPE filter = 0; filter < TLMCHAN_MAX_FILTERS; filter++) {
+            this->m_filters[filter].mode = TLMCHAN_FILTER_OFF;
+        }
+        for (NATIVE_UINT_TYPE param = 0; param < TLMCHAN_FILTER_PARAMS; param++) {
+            this->m_paramFilters[param].set = false;
+        }
+        // clear statistics slots
+        for (NATIVE_UINT_TYPE slot = 0; slot < TLMCHAN_STATS_SLOTS; slot++) {
+            this->m_stats[slot].entry = TLMCHAN_NO_CHANNEL;
+            this->m_stats[slot].windowId = 0;
+            this->m_stats[slot].ending = false;
         }
-        // clear free index
-        this->m_tlmEntries[0].free = 0;
-        this->m_tlmEntries[1].free = 0;
-
 
     }
 
@@ -60,8 +89,191 @@ namespace Svc {
         TlmChanComponentBase::init(queueDepth,instance);
     }
 
+    void TlmChanImpl::setChannelIds(const FwChanIdType* ids, NATIVE_UINT_TYPE numIds) {
+
+        FW_ASSERT(ids);
+        FW_ASSERT(numIds <= TLMCHAN_MAX_CHANNELS,numIds,TLMCHAN_MAX_CHANNELS);
+        // must be called before any channels are added
+        FW_ASSERT(0 == this->m_numChannels,this->m_numChannels);
+
+        // Search for a multiplier that puts every ID in its own slot.
+        // Odd multipliers are tried, starting with the default.
+        for (NATIVE_UINT_TYPE tryNum = 0; tryNum < TLMCHAN_HASH_SEARCH_TRIES; tryNum++) {
+            this->m_hashMultiplier = TLMCHAN_DEFAULT_HASH_MULTIPLIER + 2*tryNum;
+            bool collision = false;
+            for (NATIVE_UINT_TYPE id = 0; id < numIds; id++) {
+                NATIVE_UINT_TYPE slot = this->doHash(ids[id]);
+                FW_ASSERT(slot < TLMCHAN_INDEX_SLOTS,slot);
+                // duplicate IDs only take one slot
+                if ((this->m_index[slot] != 0) && (this->m_channels[this->m_index[slot]-1].id != ids[id])) {
+                    collision = true;
+                    break;
+                }
+                this->m_channels[id].id = ids[id];
+                this->m_index[slot] = id + 1;
+            }
+            // clear trial index
+            for (NATIVE_UINT_TYPE slot = 0; slot < TLMCHAN_INDEX_SLOTS; slot++) {
+                this->m_index[slot] = 0;
+            }
+            if (not collision) {
+                break;
+            }
+            // if none found, the last multiplier is used and collisions are probed
+        }
+
+        // add channels to table with the selected hash
+        for (NATIVE_UINT_TYPE id = 0; id < numIds; id++) {
+            NATIVE_INT_TYPE entry = this->addChannel(ids[id]);
+            FW_ASSERT(entry != TLMCHAN_NO_CHANNEL,ids[id]);
+        }
+
+    }
+
+    NATIVE_INT_TYPE TlmChanImpl::findChannel(FwChanIdType id) {
+
+        NATIVE_UINT_TYPE slot = this->doHash(id);
+        // linear probe until the channel or an empty slot is found.
+        // Index is never more than half full, so an empty slot is always found.
+        for (NATIVE_UINT_TYPE probe = 0; probe < TLMCHAN_INDEX_SLOTS; probe++) {
+            U16 entry = this->m_index[slot];
+            if (0 == entry) {
+                return TLMCHAN_NO_CHANNEL;
+            }
+            if (this->m_channels[entry-1].id == id) {
+                return entry - 1;
+            }
+            slot = (slot + 1) & (TLMCHAN_INDEX_SLOTS - 1);
+        }
+
+        return TLMCHAN_NO_CHANNEL;
+    }
+
+    NATIVE_INT_TYPE TlmChanImpl::addChannel(FwChanIdType id) {
+
+        // Channels can be added by several writers at once, so entries are
+        // claimed and index slots are filled with compare-and-swap.
+        NATIVE_INT_TYPE claimed = TLMCHAN_NO_CHANNEL;
+        NATIVE_UINT_TYPE slot = this->doHash(id);
+        for (NATIVE_UINT_TYPE probe = 0; probe < TLMCHAN_INDEX_SLOTS; probe++) {
+            U16 entry = this->m_index[slot];
+            if (0 == entry) {
+                // not found, so claim an entry if there is room
+                if (TLMCHAN_NO_CHANNEL == claimed) {
+                    U32 count;
+                    do {
+                        count = this->m_numChannels;
+                        if (count >= TLMCHAN_MAX_CHANNELS) {
+                            return TLMCHAN_NO_CHANNEL;
+                        }
+                    } while (not __sync_bool_compare_and_swap(&this->m_numChannels,count,count+1));
+                    claimed = count;
+                    TlmChannel& channel = this->m_channels[claimed];
+                    channel.id = id;
+                    if (not this->findPacketSlot(id,channel.packet,channel.packetSize)) {
+                        channel.packet = TLMCHAN_NO_PACKET;
+                    }
+                }
+                // publish the entry. The swap is a full barrier, so the
+                // channel information is visible before the index slot.
+                if (__sync_bool_compare_and_swap(&this->m_index[slot],0,claimed+1)) {
+                    return claimed;
+                }
+                // another writer filled the slot first, so check what it added.
+                // If it added this channel, the claimed entry is never written
+                // and is skipped by Run.
+                entry = this->m_index[slot];
+            }
+            if (this->m_channels[entry-1].id == id) {
+                return entry - 1;
+            }
+            slot = (slot + 1) & (TLMCHAN_INDEX_SLOTS - 1);
+        }
+
+        return TLMCHAN_NO_CHANNEL;
+    }
+
+    bool TlmChanImpl::readEntry(NATIVE_UINT_TYPE entry, Fw::Time& timeTag, Fw::TlmBuffer& val, U32& stamp, U32& version) {
+
+        FW_ASSERT(entry < TLMCHAN_MAX_CHANNELS,entry);
+        TlmEntry& tlmEntry = this->m_entries[entry];
+        // retry until the copy is read without the writer switching to it.
+        // The writer never waits on a reader, so this finishes once it stops
+        // writing this channel.
+        while (true) {
+            U32 count = tlmEntry.seq >> 1;
+            __sync_synchronize();
+            if (count < 2) {
+                // first value hasn't been completely written
+                return false;
+            }
+            const TlmValue& value = tlmEntry.copies[count & 1];
+            timeTag = value.lastUpdate;
+            val = value.buffer;
+            stamp = value.stamp;
+            __sync_synchronize();
+            if ((tlmEntry.seq >> 1) == count) {
+                // both halves of an update have the same version
+                version = count & ~1U;
+                return true;
+            }
+        }
+    }
+
+    void TlmChanImpl::setPacketList(const TlmChanPacketList& packetList) {
+
+        FW_ASSERT(packetList.numEntries <= TLMCHAN_MAX_PACKETS,packetList.numEntries);
+
+        for (NATIVE_UINT_TYPE pkt = 0; pkt < packetList.numEntries; pkt++) {
+            const TlmChanPacket* packet = packetList.list[pkt];
+            FW_ASSERT(packet);
+            FW_ASSERT(packet->list);
+            // compute size of values in packet
+            NATIVE_UINT_TYPE size = 0;
+            for (NATIVE_UINT_TYPE entry = 0; entry < packet->numEntries; entry++) {
+                size += packet->list[entry].size;
+            }
+            // make sure packet fits in a com buffer
+            FW_ASSERT(size + TLMCHAN_PACKET_HEADER_SIZE <= FW_COM_BUFFER_MAX_SIZE,
+                    packet->id,size);
+        }
+
+        this->m_packetList = &packetList;
+
+        // look up packets for any channels already in the table
+        for (NATIVE_UINT_TYPE entry = 0; entry < this->m_numChannels; entry++) {
+            TlmChannel& channel = this->m_channels[entry];
+            if (not this->findPacketSlot(channel.id,channel.packet,channel.packetSize)) {
+                channel.packet = TLMCHAN_NO_PACKET;
+            }
+        }
+
+    }
+
+    bool TlmChanImpl::findPacketSlot(FwChanIdType id, NATIVE_INT_TYPE& packet, NATIVE_UINT_TYPE& size) {
+
+        if (not this->m_packetList) {
+            return false;
+        }
+
+        // Only done when a channel is added to the table, so a linear search is fine
+        for (NATIVE_UINT_TYPE pkt = 0; pkt < this->m_packetList->numEntries; pkt++) {
+            const TlmChanPacket* pktDef = this->m_packetList->list[pkt];
+            for (NATIVE_UINT_TYPE entry = 0; entry < pktDef->numEntries; entry++) {
+                if (pktDef->list[entry].id == id) {
+                    packet = pkt;
+                    size = pktDef->list[entry].size;
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
     NATIVE_UINT_TYPE TlmChanImpl::doHash(FwChanIdType id) {
-        return (id % TLMCHAN_HASH_MOD_VALUE)%TLMCHAN_NUM_TLM_HASH_SLOTS;
+        // multiplicative hash; top bits of the product select the slot
+        return (static_cast<U32>(id) * this->m_hashMultiplier) >> (32 - TLMCHAN_INDEX_BITS);
     }
 
     void TlmChanImpl::pingIn_handler(
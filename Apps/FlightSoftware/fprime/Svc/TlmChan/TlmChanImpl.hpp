@@ -15,14 +15,29 @@
 
 #include <Svc/TlmChan/TlmChanComponentAc.hpp>
 #include <Svc/TlmChan/TlmChanImplCfg.hpp>
-#include <Os/Mutex.hpp>
+#include <Svc/TlmChan/TlmChanPacketTypes.hpp>
 #include <Fw/Tlm/TlmPacket.hpp>
 
 namespace Svc {
 
+    enum {
+        TLMCHAN_NO_CHANNEL = -1, //!< channel is not in the table
+        TLMCHAN_INDEX_SLOTS = 1 << TLMCHAN_INDEX_BITS, //!< number of slots in channel index
+        TLMCHAN_NO_PACKET = -1, //!< channel is not part of a packet
+        TLMCHAN_NO_FILTER = -1, //!< channel has no filter
+        TLMCHAN_FILTER_UNRESOLVED = -2, //!< filter for channel hasn't been looked up
+        TLMCHAN_FILTER_PARAMS = 4, //!< number of filter parameters in the component XML
+        TLMCHAN_STATS_SLOTS = 4, //!< number of statistics slots in the component XML
+        TLMCHAN_NO_STATS = -1, //!< channel has no statistics slot
+        TLMCHAN_SEQ_OWNED = 1, //!< bit of the entry sequence that is set while a writer owns the entry
+        //! size of packetized telemetry header
+        TLMCHAN_PACKET_HEADER_SIZE = sizeof(FwPacketDescriptorType) + sizeof(FwTlmPacketizeIdType) + Fw::Time::SERIALIZED_SIZE
+    };
+
     class TlmChanImpl: public TlmChanComponentBase {
         public:
             friend class TlmChanImplTester;
+            friend class TlmChanPerfTester;
     #if FW_OBJECT_NAMES == 1
             TlmChanImpl(const char* compName);
     #else
@@ -33,17 +48,149 @@ namespace Svc {
                     NATIVE_INT_TYPE queueDepth, /*!< The queue depth*/
                     NATIVE_INT_TYPE instance /*!< The instance number*/
                     );
+            //! Set the list of channel IDs in the deployment. The channels
+            //! are added to the table and a collision-free index is searched for.
+            //! Call before telemetry is written.
+            void setChannelIds(
+                    const FwChanIdType* ids, /*!< The list of channel IDs*/
+                    NATIVE_UINT_TYPE numIds /*!< The number of IDs in the list*/
+                    );
+            //! Set the list of telemetry packets. Channels in the list are
+            //! sent as packetized telemetry, others are sent one per packet.
+            //! Call before telemetry is written. The list must persist.
+            void setPacketList(
+                    const TlmChanPacketList& packetList /*!< The list of packets*/
+                    );
         PROTECTED:
 
-            // can be overridden for alternate algorithms
+            // can be overridden for alternate algorithms. Must return a value less than TLMCHAN_INDEX_SLOTS
             virtual NATIVE_UINT_TYPE doHash(FwChanIdType id);
 
         PRIVATE:
 
+            // Aggregates of a statistics window
+            struct TlmWindow {
+                U32 window; //!< id of the window. 0 if none
+                U32 count; //!< number of values in the window
+                F64 min; //!< minimum value in the window
+                F64 max; //!< maximum value in the window
+                F64 sum; //!< sum of values in the window
+            };
+
             // Port functions
             void TlmRecv_handler(NATIVE_INT_TYPE portNum, FwChanIdType id, Fw::Time &timeTag, Fw::TlmBuffer &val);
             void TlmGet_handler(NATIVE_INT_TYPE portNum, FwChanIdType id, Fw::Time &timeTag, Fw::TlmBuffer &val);
             void Run_handler(NATIVE_INT_TYPE portNum, NATIVE_UINT_TYPE context);
+            // Command functions
+            void TLMCHAN_SET_FILTER_cmdHandler(
+                    FwOpcodeType opCode, /*!< The opcode*/
+                    U32 cmdSeq, /*!< The command sequence number*/
+                    U32 channelId, /*!< Channel ID to filter*/
+                    FilterMode mode, /*!< Filter mode*/
+                    FilterValueType valueType, /*!< Type of channel value*/
+                    F64 deadband, /*!< Deadband*/
+                    U32 maxSilence /*!< Maximum Run cycles without sending*/
+                    );
+            void TLMCHAN_SET_STATS_cmdHandler(
+                    FwOpcodeType opCode, /*!< The opcode*/
+                    U32 cmdSeq, /*!< The command sequence number*/
+                    U32 slot, /*!< Statistics slot*/
+                    U32 channelId, /*!< Channel ID to collect statistics for*/
+                    StatsValueType valueType, /*!< Type of channel value*/
+                    U32 window /*!< Run cycles in each statistics window*/
+                    );
+            // Parameter notifications
+            void parameterUpdated(FwPrmIdType id);
+            void parametersLoaded(void);
+            //! Find the table entry for a channel
+            //! \return the entry, or TLMCHAN_NO_CHANNEL if the channel is not in the table
+            NATIVE_INT_TYPE findChannel(
+                    FwChanIdType id /*!< The channel id*/
+                    );
+            //! Find the table entry for a channel, adding it if it isn't in the table
+            //! \return the entry, or TLMCHAN_NO_CHANNEL if the table is full
+            NATIVE_INT_TYPE addChannel(
+                    FwChanIdType id /*!< The channel id*/
+                    );
+            //! Find the packet for a channel
+            //! \return true if the channel is in a packet
+            bool findPacketSlot(
+                    FwChanIdType id, /*!< The channel id*/
+                    NATIVE_INT_TYPE& packet, /*!< The packet index*/
+                    NATIVE_UINT_TYPE& size /*!< The value size*/
+                    );
+            //! Read a consistent copy of a channel value without locking
+            //! \return true if the channel has been written
+            bool readEntry(
+                    NATIVE_UINT_TYPE entry, /*!< The table entry*/
+                    Fw::Time& timeTag, /*!< The time tag of the value*/
+                    Fw::TlmBuffer& val, /*!< The value*/
+                    U32& stamp, /*!< The write stamp of the value*/
+                    U32& version /*!< The version of the value that was read*/
+                    );
+            //! Collect the channel values of a packet and serialize it into
+            //! the com buffer if any of them have changed since the last send
+            //! \return true if the packet should be sent
+            bool buildPacket(
+                    NATIVE_UINT_TYPE pkt /*!< The packet index*/
+                    );
+            //! Set or clear the filter for a channel
+            //! \return false if the filter table is full
+            bool setFilter(
+                    FwChanIdType id, /*!< The channel id*/
+                    TlmChanFilterMode mode, /*!< The filter mode. TLMCHAN_FILTER_OFF clears the filter*/
+                    TlmChanValueType valueType, /*!< The type of the value*/
+                    F64 deadband, /*!< The deadband*/
+                    U32 maxSilence /*!< Maximum Run cycles without sending. 0 for no limit*/
+                    );
+            //! Set filters from the filter parameters
+            void applyFilterParams(void);
+            //! Check a new channel value against the channel filter
+            //! \return true if the value should be sent
+            bool filterValue(
+                    NATIVE_UINT_TYPE entry, /*!< The table entry*/
+                    Fw::TlmBuffer& val /*!< The value*/
+                    );
+            //! Deserialize a channel value as a number
+            //! \return true if the value is a single value of the type
+            static bool valueToNumber(
+                    Fw::TlmBuffer& val, /*!< The value*/
+                    TlmChanValueType valueType, /*!< The type of the value*/
+                    F64& number /*!< The number*/
+                    );
+            //! Add a value to the statistics windows of a channel. Called by a writer that owns the entry
+            void accumulateStats(
+                    NATIVE_INT_TYPE slot, /*!< The statistics slot*/
+                    Fw::TlmBuffer& val, /*!< The value*/
+                    TlmWindow* windows /*!< The current and previous windows of the channel*/
+                    );
+            //! Read the aggregates of an ended statistics window through the channel sequence
+            //! \return false if a writer that may add to the window is updating the channel
+            bool readWindow(
+                    NATIVE_UINT_TYPE entry, /*!< The table entry*/
+                    U32 window, /*!< The window id*/
+                    TlmWindow& aggregates /*!< The aggregates of the window*/
+                    );
+            //! Assign a channel to a statistics slot
+            void applyStatsConfig(
+                    NATIVE_UINT_TYPE slot, /*!< The statistics slot*/
+                    FwChanIdType id, /*!< The channel id*/
+                    TlmChanValueType valueType, /*!< The type of value*/
+                    U32 window /*!< Run cycles in each window. 0 to clear the slot*/
+                    );
+            //! Get the id for a new statistics window. Ids are not reused until the counter wraps
+            U32 nextWindowId(void);
+            //! Update the statistics windows and send the ones that have ended
+            void runStats(void);
+            //! Send the aggregates of a statistics window
+            void writeStats(
+                    NATIVE_UINT_TYPE slot, /*!< The statistics slot*/
+                    FwChanIdType id, /*!< The channel id*/
+                    U32 count, /*!< The number of values*/
+                    F64 min, /*!< The minimum value*/
+                    F64 max, /*!< The maximum value*/
+                    F64 mean /*!< The mean value*/
+                    );
             //! Handler implementation for pingIn
             //!
             void pingIn_handler(
@@ -51,25 +198,88 @@ namespace Svc {
                 U32 key /*!< Value to return to pinger*/
             );
 
-            typedef struct tlmEntry {
-                FwChanIdType id; //!< telemetry id stored in slot
-                bool updated; //!< set whenever a value has been written. Used to skip if writing out values for downlinking
+            // Information about a channel. Written once when the channel is added.
+            struct TlmChannel {
+                FwChanIdType id; //!< telemetry id stored in entry
+                NATIVE_INT_TYPE packet; //!< packet channel is stored in. TLMCHAN_NO_PACKET if not packetized
+                NATIVE_UINT_TYPE packetSize; //!< size of value in packet
+            } m_channels[TLMCHAN_MAX_CHANNELS];
+
+            struct TlmValue {
+                U32 stamp; //!< order of the write among all channels. Used to find the latest packet time
                 Fw::Time lastUpdate; //!< last updated time
                 Fw::TlmBuffer buffer; //!< buffer to store serialized telemetry
-                tlmEntry* next; //!< pointer to next bucket in table
-                bool used; //!< if entry has been used
-                NATIVE_UINT_TYPE bucketNo; //!< for testing
+                TlmWindow windows[2]; //!< current and previous statistics windows, if the channel has a slot
+            };
+
+            // Channel values are shared between writers and readers without a lock.
+            // Bit 0 of seq is set while a writer owns the entry, and the rest counts
+            // copy updates. A writer takes the entry with a compare-and-swap that also
+            // moves the count to odd, updates copies[0], moves the count to even,
+            // updates copies[1], then clears bit 0. Readers read copies[(seq >> 1) & 1],
+            // which is never the copy being written, and retry if the count changed
+            // while reading. Readers never wait for a writer.
+            typedef struct tlmEntry {
+                volatile U32 seq; //!< update count and owner bit. 0 if never written
+                U32 seenSeq; //!< version of the value last seen by Run. Only used by Run
+                volatile NATIVE_INT_TYPE statsSlot; //!< statistics slot for the channel. Only changed by the component thread
+                TlmValue copies[2]; //!< value copies
             } TlmEntry;
 
-            struct TlmSet {
-                TlmEntry* slots[TLMCHAN_NUM_TLM_HASH_SLOTS]; //!< set of hash slots in hash table
-                TlmEntry buckets[TLMCHAN_HASH_BUCKETS]; //!< set of buckets used in hash table
-                NATIVE_INT_TYPE free; //!< next free bucket
-            } m_tlmEntries[2];
+            TlmEntry m_entries[TLMCHAN_MAX_CHANNELS]; //!< channel values, indexed the same as m_channels
+
+            volatile U16 m_index[TLMCHAN_INDEX_SLOTS]; //!< maps hash of channel ID to entry + 1. 0 if slot is empty
+            volatile U32 m_numChannels; //!< number of table entries claimed
+            U32 m_hashMultiplier; //!< multiplier used by hash function
+            volatile U32 m_overflowReported; //!< if a full table has been reported
+            volatile U32 m_writeStamp; //!< counter for TlmValue::stamp
+            volatile U32 m_contendedWrites; //!< writes that retried because another task was updating the same channel
+
+            // packetized telemetry
+            const TlmChanPacketList* m_packetList; //!< packet list. 0 if not packetized
+            U8 m_packetValues[FW_COM_BUFFER_MAX_SIZE]; //!< staging area for packet values
+
+            // downlink filters. Only used by the component thread
+            struct TlmFilter {
+                FwChanIdType id; //!< channel id
+                TlmChanFilterMode mode; //!< filter mode. TLMCHAN_FILTER_OFF if slot is free
+                TlmChanValueType valueType; //!< type of value for deadband
+                F64 deadband; //!< change from last sent value needed to send
+                U32 maxSilence; //!< Run cycles after which a suppressed value is sent. 0 for no limit
+                bool sent; //!< if a value has been sent since the filter was set
+                U32 lastSentCycle; //!< Run cycle the last value was sent
+                F64 lastSentNumber; //!< last value sent in deadband mode
+                Fw::TlmBuffer lastSent; //!< last value sent in on change mode
+            } m_filters[TLMCHAN_MAX_FILTERS];
+
+            NATIVE_INT_TYPE m_channelFilter[TLMCHAN_MAX_CHANNELS]; //!< filter for each entry. TLMCHAN_NO_FILTER if none
+            U32 m_runCycles; //!< number of Run calls
+            U32 m_sentSamples; //!< channel updates sent
+            U32 m_suppressedSamples; //!< channel updates suppressed by a filter
+            volatile U32 m_filterParamsUpdated; //!< set when filter parameters change
+
+            struct {
+                FwChanIdType id; //!< channel id
+                bool set; //!< if the parameter set a filter
+            } m_paramFilters[TLMCHAN_FILTER_PARAMS]; //!< filter set by each parameter
 
-            U32 m_activeBuffer; // !< which buffer is active for storing telemetry
+            // Statistics slots. Only changed by the component thread. Writers add
+            // their values to the window aggregates in the channel entry, tagged
+            // with the id of the current window of the slot.
+            struct TlmStats {
+                NATIVE_INT_TYPE entry; //!< table entry of the channel. TLMCHAN_NO_CHANNEL if the slot is unused
+                FwChanIdType id; //!< channel id
+                volatile TlmChanValueType valueType; //!< type of value
+                volatile U32 windowId; //!< id of the current window. Read by writers
+                U32 window; //!< Run cycles in each window
+                U32 cycles; //!< Run cycles in the current window
+                bool ending; //!< set while the aggregates of an ended window haven't been read
+                U32 endingId; //!< id of the ended window
+            } m_stats[TLMCHAN_STATS_SLOTS];
+            U32 m_lastWindowId; //!< last statistics window id given to a slot
 
             // work variables
+            TlmValue m_readValue; //!< value read by Run
             Fw::ComBuffer m_comBuffer;
             Fw::TlmPacket m_tlmPacket;
 
@@ -16,39 +16,66 @@
 // Anonymous namespace for configuration parameters
 
 
-// The parameters below provide for tuning of the hash function used to
-// write and read entries in the database. The has function is very simple;
-// It first takes the telemetry ID and does a modulo computation with
-// TLMCHAN_HASH_MOD_VALUE. It then does a second modulo with the number
-// of slots to make sure the value lands in the provided slots.
-// The values can be experimented with to try and balance the number
-// of slots versus the number of buckets.
-// To test the set of telemetry ID in the system to see if the hash is
-// balanced, do the following:
+// The parameters below size the channel table. Each channel gets a dense
+// entry in the table, and an index of 2^TLMCHAN_INDEX_BITS slots maps a
+// channel ID to its entry with a multiplicative hash.
+// TLMCHAN_MAX_CHANNELS should be set to the number of telemetry channels
+// in the deployment. The default covers the Ref deployment, which has the
+// most channels of the deployments here (111). A project with more
+// channels, or one that wants to save the RAM, defines TLMCHAN_MAX_CHANNELS
+// and TLMCHAN_INDEX_BITS on the compiler command line (COMPARGS in mod.mk,
+// or add_definitions() in CMake) instead of editing this file.
+// To get the list of channel IDs:
 //  1) From the deployment directory (e.g Ref), do a full build then type:
 //      "make comp_report_gen"
 //     This will generate a list in "<deployment dir>/ComponentReport.txt"
 //     with all the telemetry IDs in the deployment.
-//  2) Cut and paste the ID list to the array declared in the TlmChan unit test
-//     file TelemChanImplTester.cpp in the runMultiChannel() method.
-//  3) Run the unit test ("make ut run_ut")
-//  4) After writing all the telemetry IDs to the component, the
-//     unit test will dump the hash table. The output looks like the following:
-//        Slot: <n> - slot number
-//        Entry - a bucket assigned to the slot
-//        ... (Other buckets in the slot)
-//     The number of buckets assigned to each slot can be checked for balance.
+//  2) Pass the ID list to TlmChanImpl::setChannelIds() during initialization.
+//     The component searches for a hash multiplier that maps every ID to
+//     its own index slot, so each lookup is a single probe. If no list
+//     is given, channels are added to the table the first time they are
+//     written and lookups use linear probing.
+// Channels written after the table is full are dropped and reported
+// with the TLMCHAN_TOO_MANY_CHANNELS event.
+//
+// RAM: each channel costs two copies of its value, so a channel takes
+// about 2 * FW_TLM_BUFFER_MAX_SIZE bytes plus two statistics windows per
+// copy. With the default 128 byte FW_COM_BUFFER_MAX_SIZE that is about
+// 500 bytes a channel on a 64-bit build, or 62 KB for 128 channels,
+// plus 2 bytes for each index slot.
+
+#ifndef TLMCHAN_MAX_CHANNELS
+#define TLMCHAN_MAX_CHANNELS 128    // !< Number of telemetry channels in the table.
+                                    // Must be >= number of telemetry channels in system
+#endif
+
+#ifndef TLMCHAN_INDEX_BITS
+#define TLMCHAN_INDEX_BITS 8        // !< Number of bits in the index. The index has 2^TLMCHAN_INDEX_BITS slots,
+                                    // which must be at least twice TLMCHAN_MAX_CHANNELS
+#endif
 
 namespace {
 
     enum {
-        TLMCHAN_NUM_TLM_HASH_SLOTS = 15, // !< Number of slots in the hash table.
-                                        // Works best when set to about twice the number of components producing telemetry
-        TLMCHAN_HASH_MOD_VALUE = 99,    // !< The modulo value of the hashing function.
-                                        // Should be set to a little below the ID gaps to spread the entries around
+        TLMCHAN_HASH_SEARCH_TRIES = 1000 // !< Number of hash multipliers to try when looking for
+                                        // a collision-free index in setChannelIds()
+    };
 
-        TLMCHAN_HASH_BUCKETS = 50       // !< Buckets assignable to a hash slot.
-                                        // Buckets must be >= number of telemetry channels in system
+    // Packetized telemetry. If a packet list is set with TlmChanImpl::setPacketList(),
+    // channels in the list are grouped into FW_PACKET_PACKETIZED_TLM packets.
+    // Each packet must fit in a Fw::ComBuffer along with its header.
+
+    enum {
+        TLMCHAN_MAX_PACKETS = 8         // !< Maximum number of packets in a packet list
+    };
+
+    // Downlink filters. Channels with a filter set by command or parameter
+    // are only sent when the value changes, or moves more than a deadband.
+
+    enum {
+        TLMCHAN_MAX_FILTERS = 16,       // !< Maximum number of channels with a filter
+        TLMCHAN_COUNTER_CYCLES = 10     // !< Number of Run calls between writes of the
+                                        // sent, suppressed and contended write counters
     };
 
 
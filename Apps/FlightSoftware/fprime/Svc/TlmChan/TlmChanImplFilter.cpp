@@ -0,0 +1,261 @@
+/**
+ * \file
+ * \brief Implementation for telemetry channel downlink filters
+ */
+
+#include <Svc/TlmChan/TlmChanImpl.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <cmath>
+#include <cstring>
+
+namespace Svc {
+
+    void TlmChanImpl::TLMCHAN_SET_FILTER_cmdHandler(
+            FwOpcodeType opCode,
+            U32 cmdSeq,
+            U32 channelId,
+            FilterMode mode,
+            FilterValueType valueType,
+            F64 deadband,
+            U32 maxSilence) {
+
+        if (  (mode < FILTER_OFF) or
+              (mode > FILTER_DEADBAND) or
+              (valueType < VALUE_U8) or
+              (valueType > VALUE_F64) or
+              (not (deadband >= 0.0))) {
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_VALIDATION_ERROR);
+            return;
+        }
+
+        // command enumerations are in the same order as the TlmChanFilter ones
+        if (not this->setFilter(channelId,
+                static_cast<TlmChanFilterMode>(mode),
+                static_cast<TlmChanValueType>(valueType),
+                deadband,maxSilence)) {
+            this->log_WARNING_LO_TLMCHAN_FILTER_TABLE_FULL(channelId);
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+            return;
+        }
+
+        this->log_ACTIVITY_HI_TLMCHAN_FILTER_SET(channelId,mode,deadband,maxSilence);
+        this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
+    }
+
+    void TlmChanImpl::parameterUpdated(FwPrmIdType id) {
+        // called from the command dispatcher, so apply on the next Run
+        this->m_filterParamsUpdated = 1;
+    }
+
+    void TlmChanImpl::parametersLoaded(void) {
+        this->m_filterParamsUpdated = 1;
+    }
+
+    void TlmChanImpl::applyFilterParams(void) {
+
+        TlmChanFilter params[TLMCHAN_FILTER_PARAMS];
+        Fw::ParamValid valid[TLMCHAN_FILTER_PARAMS];
+        params[0] = this->paramGet_TLMCHAN_FILTER_0(valid[0]);
+        params[1] = this->paramGet_TLMCHAN_FILTER_1(valid[1]);
+        params[2] = this->paramGet_TLMCHAN_FILTER_2(valid[2]);
+        params[3] = this->paramGet_TLMCHAN_FILTER_3(valid[3]);
+
+        for (NATIVE_UINT_TYPE slot = 0; slot < TLMCHAN_FILTER_PARAMS; slot++) {
+            // clear the filter previously set by the parameter in case the channel changed
+            if (this->m_paramFilters[slot].set) {
+                (void) this->setFilter(this->m_paramFilters[slot].id,TLMCHAN_FILTER_OFF,TLMCHAN_VALUE_U8,0.0,0);
+                this->m_paramFilters[slot].set = false;
+            }
+            if (valid[slot] != Fw::PARAM_VALID) {
+                continue;
+            }
+            TlmChanFilter& param = params[slot];
+            if (TLMCHAN_FILTER_OFF == param.getmode()) {
+                continue;
+            }
+            if (  (param.getmode() > TLMCHAN_FILTER_DEADBAND) or
+                  (param.getvalueType() > TLMCHAN_VALUE_F64) or
+                  (not (param.getdeadband() >= 0.0))) {
+                this->log_WARNING_LO_TLMCHAN_FILTER_PARAM_INVALID(slot);
+                continue;
+            }
+            if (not this->setFilter(param.getchannelId(),param.getmode(),param.getvalueType(),
+                    param.getdeadband(),param.getmaxSilence())) {
+                this->log_WARNING_LO_TLMCHAN_FILTER_TABLE_FULL(param.getchannelId());
+                continue;
+            }
+            this->m_paramFilters[slot].id = param.getchannelId();
+            this->m_paramFilters[slot].set = true;
+        }
+
+    }
+
+    bool TlmChanImpl::setFilter(FwChanIdType id, TlmChanFilterMode mode, TlmChanValueType valueType, F64 deadband, U32 maxSilence) {
+
+        // find the filter for the channel, or a free slot
+        NATIVE_INT_TYPE slot = TLMCHAN_NO_FILTER;
+        for (NATIVE_UINT_TYPE filter = 0; filter < TLMCHAN_MAX_FILTERS; filter++) {
+            if (TLMCHAN_FILTER_OFF == this->m_filters[filter].mode) {
+                if (TLMCHAN_NO_FILTER == slot) {
+                    slot = filter;
+                }
+            } else if (this->m_filters[filter].id == id) {
+                slot = filter;
+                break;
+            }
+        }
+
+        if (TLMCHAN_NO_FILTER == slot) {
+            // clearing a filter that isn't there is fine
+            return (TLMCHAN_FILTER_OFF == mode);
+        }
+
+        TlmFilter& filter = this->m_filters[slot];
+        filter.id = id;
+        filter.mode = mode;
+        filter.valueType = valueType;
+        filter.deadband = deadband;
+        filter.maxSilence = maxSilence;
+        filter.sent = false;
+        filter.lastSentCycle = 0;
+        filter.lastSentNumber = 0.0;
+        filter.lastSent.resetSer();
+
+        // channels look up their filter again on their next update
+        for (NATIVE_UINT_TYPE entry = 0; entry < TLMCHAN_MAX_CHANNELS; entry++) {
+            this->m_channelFilter[entry] = TLMCHAN_FILTER_UNRESOLVED;
+        }
+
+        return true;
+    }
+
+    bool TlmChanImpl::filterValue(NATIVE_UINT_TYPE entry, Fw::TlmBuffer& val) {
+
+        FW_ASSERT(entry < TLMCHAN_MAX_CHANNELS,entry);
+
+        NATIVE_INT_TYPE filterIndex = this->m_channelFilter[entry];
+        if (TLMCHAN_FILTER_UNRESOLVED == filterIndex) {
+            filterIndex = TLMCHAN_NO_FILTER;
+            for (NATIVE_UINT_TYPE filter = 0; filter < TLMCHAN_MAX_FILTERS; filter++) {
+                if (  (this->m_filters[filter].mode != TLMCHAN_FILTER_OFF) and
+                      (this->m_filters[filter].id == this->m_channels[entry].id)) {
+                    filterIndex = filter;
+                    break;
+                }
+            }
+            this->m_channelFilter[entry] = filterIndex;
+        }
+
+        if (TLMCHAN_NO_FILTER == filterIndex) {
+            return true;
+        }
+
+        TlmFilter& filter = this->m_filters[filterIndex];
+        F64 number = 0.0;
+        bool isNumber = (TLMCHAN_FILTER_DEADBAND == filter.mode) and
+                this->valueToNumber(val,filter.valueType,number);
+
+        bool send;
+        if (not filter.sent) {
+            // first value after the filter is set is always sent
+            send = true;
+        } else if ((filter.maxSilence != 0) and (this->m_runCycles - filter.lastSentCycle >= filter.maxSilence)) {
+            send = true;
+        } else if (isNumber) {
+            send = (::fabs(number - filter.lastSentNumber) > filter.deadband);
+        } else {
+            // on change, or a value that doesn't match the deadband type
+            send = (val.getBuffLength() != filter.lastSent.getBuffLength()) or
+                    (::memcmp(val.getBuffAddr(),filter.lastSent.getBuffAddr(),val.getBuffLength()) != 0);
+        }
+
+        if (send) {
+            filter.sent = true;
+            filter.lastSentCycle = this->m_runCycles;
+            filter.lastSentNumber = number;
+            filter.lastSent = val;
+        }
+
+        return send;
+    }
+
+    bool TlmChanImpl::valueToNumber(Fw::TlmBuffer& val, TlmChanValueType valueType, F64& number) {
+
+        Fw::SerializeStatus stat;
+        val.resetDeser();
+
+        switch (valueType) {
+            case TLMCHAN_VALUE_U8: {
+                U8 value;
+                stat = val.deserialize(value);
+                number = value;
+                break;
+            }
+            case TLMCHAN_VALUE_I8: {
+                I8 value;
+                stat = val.deserialize(value);
+                number = value;
+                break;
+            }
+            case TLMCHAN_VALUE_U16: {
+                U16 value;
+                stat = val.deserialize(value);
+                number = value;
+                break;
+            }
+            case TLMCHAN_VALUE_I16: {
+                I16 value;
+                stat = val.deserialize(value);
+                number = value;
+                break;
+            }
+            case TLMCHAN_VALUE_U32: {
+                U32 value;
+                stat = val.deserialize(value);
+                number = value;
+                break;
+            }
+            case TLMCHAN_VALUE_I32: {
+                I32 value;
+                stat = val.deserialize(value);
+                number = value;
+                break;
+            }
+#if FW_HAS_64_BIT == 1
+            case TLMCHAN_VALUE_U64: {
+                U64 value;
+                stat = val.deserialize(value);
+                number = value;
+                break;
+            }
+            case TLMCHAN_VALUE_I64: {
+                I64 value;
+                stat = val.deserialize(value);
+                number = value;
+                break;
+            }
+#endif
+            case TLMCHAN_VALUE_F32: {
+                F32 value;
+                stat = val.deserialize(value);
+                number = value;
+                break;
+            }
+            case TLMCHAN_VALUE_F64: {
+                F64 value;
+                stat = val.deserialize(value);
+                number = value;
+                break;
+            }
+            default:
+                return false;
+        }
+
+        // value must be a single value of the type
+        bool isNumber = (Fw::FW_SERIALIZE_OK == stat) and (0 == val.getBuffLeft());
+        val.resetDeser();
+        return isNumber;
+    }
+
+}
@@ -16,50 +16,76 @@ namespace Svc {
 
     void TlmChanImpl::TlmRecv_handler(NATIVE_INT_TYPE portNum, FwChanIdType id, Fw::Time &timeTag, Fw::TlmBuffer &val) {
 
-        // Compute index for entry
+        // Find entry for channel, adding it if it is new
+        NATIVE_INT_TYPE entry = this->addChannel(id);
+        if (TLMCHAN_NO_CHANNEL == entry) {
+            // table is full; report the first time only
+            if (__sync_bool_compare_and_swap(&this->m_overflowReported,0,1)) {
+                this->log_WARNING_HI_TLMCHAN_TOO_MANY_CHANNELS(id);
+            }
+            return;
+        }
 
-        NATIVE_UINT_TYPE index = this->doHash(id);
-        TlmEntry* entryToUse = 0;
-        TlmEntry* prevEntry = 0;
+        TlmChannel& channel = this->m_channels[entry];
+        if (channel.packet != TLMCHAN_NO_PACKET) {
+            // value can't be larger than the size in the packet definition
+            FW_ASSERT(val.getBuffLength() <= channel.packetSize,val.getBuffLength(),channel.packetSize,id);
+        }
 
-        // Search to see if channel has already been stored or a bucket needs to be added
-        if (this->m_tlmEntries[this->m_activeBuffer].slots[index]) {
-            entryToUse = this->m_tlmEntries[this->m_activeBuffer].slots[index];
-            for (NATIVE_UINT_TYPE bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-                if (entryToUse) {
-                    if (entryToUse->id == id) { // found the matching entry
-                        break;
-                    } else { // try next entry
-                        prevEntry = entryToUse;
-                        entryToUse = entryToUse->next;
-                    }
-                } else {
-                    // Make sure that we haven't run out of buckets
-                    FW_ASSERT(this->m_tlmEntries[this->m_activeBuffer].free < TLMCHAN_HASH_BUCKETS);
-                    // add new bucket from free list
-                    entryToUse = &this->m_tlmEntries[this->m_activeBuffer].buckets[this->m_tlmEntries[this->m_activeBuffer].free++];
-                    prevEntry->next = entryToUse;
-                    // clear next pointer
-                    entryToUse->next = 0;
-                    break;
-                }
-            }
-        } else {
-            // Make sure that we haven't run out of buckets
-            FW_ASSERT(this->m_tlmEntries[this->m_activeBuffer].free < TLMCHAN_HASH_BUCKETS);
-            // create new entry at slot head
-            this->m_tlmEntries[this->m_activeBuffer].slots[index] = &this->m_tlmEntries[this->m_activeBuffer].buckets[this->m_tlmEntries[this->m_activeBuffer].free++];
-            entryToUse = this->m_tlmEntries[this->m_activeBuffer].slots[index];
-            entryToUse->next = 0;
+        // Only one writer updates an entry at a time. A writer takes the entry
+        // by swapping in the odd count of its first copy update along with the
+        // owner bit. If another writer owns the entry, the swap is retried
+        // without sleeping; the owner only holds it for the copy updates, and
+        // readers and the component thread never own it, so no value is lost.
+        TlmEntry& tlmEntry = this->m_entries[entry];
+        U32 seq = tlmEntry.seq;
+        bool contended = false;
+        while ((seq & TLMCHAN_SEQ_OWNED) or
+               (not __sync_bool_compare_and_swap(&tlmEntry.seq,seq,seq + 2 + TLMCHAN_SEQ_OWNED))) {
+            contended = true;
+            seq = tlmEntry.seq;
+        }
+        if (contended) {
+            (void) __sync_fetch_and_add(&this->m_contendedWrites,1);
         }
 
-        // copy into entry
-        FW_ASSERT(entryToUse);
-        entryToUse->used = true;
-        entryToUse->id = id;
-        entryToUse->updated = true;
-        entryToUse->lastUpdate = timeTag;
-        entryToUse->buffer = val;
+        U32 stamp = __sync_add_and_fetch(&this->m_writeStamp,1);
+        // next even count. Counts 0 and 1 mean never written, so skip them on wrap
+        U32 nextSeq = seq + 4;
+        if (0 == nextSeq) {
+            nextSeq = 4;
+        }
+
+        // Every value is counted in the channel statistics, not just the ones Run sees.
+        // Both copies hold the same value while the entry is owned, so copies[0] has
+        // the aggregates of the last update.
+        TlmWindow windows[2];
+        windows[0] = tlmEntry.copies[0].windows[0];
+        windows[1] = tlmEntry.copies[0].windows[1];
+        NATIVE_INT_TYPE statsSlot = tlmEntry.statsSlot;
+        if (statsSlot != TLMCHAN_NO_STATS) {
+            this->accumulateStats(statsSlot,val,windows);
+        }
+
+        // odd count moves readers to copies[1] while copies[0] is written
+        tlmEntry.copies[0].stamp = stamp;
+        tlmEntry.copies[0].lastUpdate = timeTag;
+        tlmEntry.copies[0].buffer = val;
+        tlmEntry.copies[0].windows[0] = windows[0];
+        tlmEntry.copies[0].windows[1] = windows[1];
+        __sync_synchronize();
+        // even count moves readers to copies[0] while copies[1] is written
+        tlmEntry.seq = nextSeq + TLMCHAN_SEQ_OWNED;
+        __sync_synchronize();
+        tlmEntry.copies[1].stamp = stamp;
+        tlmEntry.copies[1].lastUpdate = timeTag;
+        tlmEntry.copies[1].buffer = val;
+        tlmEntry.copies[1].windows[0] = windows[0];
+        tlmEntry.copies[1].windows[1] = windows[1];
+
+        // updates must be visible before the entry is released
+        __sync_synchronize();
+        tlmEntry.seq = nextSeq;
 
     }
 }
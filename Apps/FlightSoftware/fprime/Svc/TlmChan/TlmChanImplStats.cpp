@@ -0,0 +1,254 @@
+/**
+ * \file
+ * \brief Implementation for telemetry channel statistics windows
+ */
+
+#include <Svc/TlmChan/TlmChanImpl.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+#include <Fw/Types/Assert.hpp>
+
+namespace Svc {
+
+    void TlmChanImpl::TLMCHAN_SET_STATS_cmdHandler(
+            FwOpcodeType opCode,
+            U32 cmdSeq,
+            U32 slot,
+            U32 channelId,
+            StatsValueType valueType,
+            U32 window) {
+
+        if (  (slot >= TLMCHAN_STATS_SLOTS) or
+              (valueType < STATS_U8) or
+              (valueType > STATS_F64)) {
+            this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_VALIDATION_ERROR);
+            return;
+        }
+
+        if (window != 0) {
+            // a channel can only be in one slot, counting requests that haven't been applied yet
+            for (NATIVE_UINT_TYPE other = 0; other < TLMCHAN_STATS_SLOTS; other++) {
+                if (other == slot) {
+                    continue;
+                }
+                const TlmStats& stats = this->m_stats[other];
+                if ((stats.entry != TLMCHAN_NO_CHANNEL) and (stats.id == channelId)) {
+                    this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_VALIDATION_ERROR);
+                    return;
+                }
+            }
+            // the channel may not have been written yet, so make sure it has an entry
+            if (TLMCHAN_NO_CHANNEL == this->addChannel(channelId)) {
+                this->log_WARNING_LO_TLMCHAN_STATS_NO_CHANNEL(channelId);
+                this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_EXECUTION_ERROR);
+                return;
+            }
+        }
+
+        // command enumeration is in the same order as TlmChanValueType
+        this->applyStatsConfig(slot,channelId,static_cast<TlmChanValueType>(valueType),window);
+
+        this->log_ACTIVITY_HI_TLMCHAN_STATS_SET(slot,channelId,window);
+        this->cmdResponse_out(opCode,cmdSeq,Fw::COMMAND_OK);
+    }
+
+    void TlmChanImpl::applyStatsConfig(NATIVE_UINT_TYPE slot, FwChanIdType id, TlmChanValueType valueType, U32 window) {
+
+        FW_ASSERT(slot < TLMCHAN_STATS_SLOTS,slot);
+        TlmStats& stats = this->m_stats[slot];
+
+        // Writers read the slot of an entry without waiting for the component
+        // thread. A writer that read the old slot tags its aggregates with a
+        // window id that is never used again, so they are never read.
+
+        // stop collecting for the current channel. The partial window is discarded.
+        if (stats.entry != TLMCHAN_NO_CHANNEL) {
+            this->m_entries[stats.entry].statsSlot = TLMCHAN_NO_STATS;
+            stats.entry = TLMCHAN_NO_CHANNEL;
+            stats.ending = false;
+        }
+
+        if (0 == window) {
+            return;
+        }
+
+        // channel was added by the command handler
+        NATIVE_INT_TYPE entry = this->findChannel(id);
+        FW_ASSERT(entry != TLMCHAN_NO_CHANNEL,id);
+        stats.id = id;
+        stats.valueType = valueType;
+        stats.window = window;
+        stats.cycles = 0;
+        // the type must be visible before writers see the new window
+        __sync_synchronize();
+        stats.windowId = this->nextWindowId();
+        __sync_synchronize();
+        stats.entry = entry;
+        this->m_entries[entry].statsSlot = slot;
+    }
+
+    U32 TlmChanImpl::nextWindowId(void) {
+        // 0 means no window
+        if (0 == ++this->m_lastWindowId) {
+            this->m_lastWindowId = 1;
+        }
+        return this->m_lastWindowId;
+    }
+
+    void TlmChanImpl::accumulateStats(NATIVE_INT_TYPE slot, Fw::TlmBuffer& val, TlmWindow* windows) {
+
+        FW_ASSERT((slot >= 0) and (slot < TLMCHAN_STATS_SLOTS),slot);
+        FW_ASSERT(windows);
+        TlmStats& stats = this->m_stats[slot];
+
+        // The component thread may end the window or change the slot while it
+        // is read, so read it again until the window id is the same. Either
+        // window is fine, since Run doesn't read a window while the entry is owned.
+        U32 windowId;
+        TlmChanValueType valueType;
+        do {
+            windowId = stats.windowId;
+            __sync_synchronize();
+            valueType = stats.valueType;
+            __sync_synchronize();
+        } while (stats.windowId != windowId);
+
+        F64 number;
+        // values that don't match the type aren't counted
+        if (not this->valueToNumber(val,valueType,number)) {
+            return;
+        }
+
+        // first value of a new window. The ended window is kept until Run reads it.
+        TlmWindow& current = windows[0];
+        if (current.window != windowId) {
+            windows[1] = current;
+            current.window = windowId;
+            current.count = 0;
+            current.min = 0.0;
+            current.max = 0.0;
+            current.sum = 0.0;
+        }
+
+        if ((0 == current.count) or (number < current.min)) {
+            current.min = number;
+        }
+        if ((0 == current.count) or (number > current.max)) {
+            current.max = number;
+        }
+        current.sum += number;
+        current.count++;
+    }
+
+    bool TlmChanImpl::readWindow(NATIVE_UINT_TYPE entry, U32 window, TlmWindow& aggregates) {
+
+        FW_ASSERT(entry < TLMCHAN_MAX_CHANNELS,entry);
+        TlmEntry& tlmEntry = this->m_entries[entry];
+
+        // Writers that took the entry before the window ended may still add
+        // to it, so the window can't be read while the entry is owned. Writers
+        // that take the entry later add to the next window.
+        U32 seq = tlmEntry.seq;
+        __sync_synchronize();
+        if (seq & TLMCHAN_SEQ_OWNED) {
+            return false;
+        }
+
+        aggregates.window = window;
+        aggregates.count = 0;
+        aggregates.min = 0.0;
+        aggregates.max = 0.0;
+        aggregates.sum = 0.0;
+        // a window with no values isn't in the entry
+        if ((seq >> 1) >= 2) {
+            const TlmValue& value = tlmEntry.copies[0];
+            for (NATIVE_UINT_TYPE win = 0; win < 2; win++) {
+                if (value.windows[win].window == window) {
+                    aggregates = value.windows[win];
+                }
+            }
+        }
+        __sync_synchronize();
+
+        // a writer took the entry while it was read
+        return (tlmEntry.seq == seq);
+    }
+
+    void TlmChanImpl::runStats(void) {
+
+        for (NATIVE_UINT_TYPE slot = 0; slot < TLMCHAN_STATS_SLOTS; slot++) {
+            TlmStats& stats = this->m_stats[slot];
+
+            if (TLMCHAN_NO_CHANNEL == stats.entry) {
+                continue;
+            }
+
+            // end the window. Values written from now on go to the next window.
+            // If the last window hasn't been read yet, the next one is ended
+            // once it has.
+            if ((++stats.cycles >= stats.window) and (not stats.ending)) {
+                stats.endingId = stats.windowId;
+                stats.windowId = this->nextWindowId();
+                // the new id must be visible before the entry is checked for writers
+                __sync_synchronize();
+                stats.ending = true;
+                stats.cycles = 0;
+            }
+
+            if (not stats.ending) {
+                continue;
+            }
+
+            // Read the ended window through the channel sequence. If a writer
+            // owns the entry, the window is read on a later Run call instead of
+            // waiting for it, so every value is counted in the window it was written in.
+            TlmWindow ended;
+            if (not this->readWindow(stats.entry,stats.endingId,ended)) {
+                continue;
+            }
+            stats.ending = false;
+
+            this->writeStats(slot,stats.id,ended.count,ended.min,ended.max,
+                    (ended.count != 0) ? ended.sum/ended.count : 0.0);
+        }
+
+    }
+
+    void TlmChanImpl::writeStats(NATIVE_UINT_TYPE slot, FwChanIdType id, U32 count, F64 min, F64 max, F64 mean) {
+
+        switch (slot) {
+            case 0:
+                this->tlmWrite_TLMCHAN_STATS_0_ID(id);
+                this->tlmWrite_TLMCHAN_STATS_0_COUNT(count);
+                this->tlmWrite_TLMCHAN_STATS_0_MIN(min);
+                this->tlmWrite_TLMCHAN_STATS_0_MAX(max);
+                this->tlmWrite_TLMCHAN_STATS_0_MEAN(mean);
+                break;
+            case 1:
+                this->tlmWrite_TLMCHAN_STATS_1_ID(id);
+                this->tlmWrite_TLMCHAN_STATS_1_COUNT(count);
+                this->tlmWrite_TLMCHAN_STATS_1_MIN(min);
+                this->tlmWrite_TLMCHAN_STATS_1_MAX(max);
+                this->tlmWrite_TLMCHAN_STATS_1_MEAN(mean);
+                break;
+            case 2:
+                this->tlmWrite_TLMCHAN_STATS_2_ID(id);
+                this->tlmWrite_TLMCHAN_STATS_2_COUNT(count);
+                this->tlmWrite_TLMCHAN_STATS_2_MIN(min);
+                this->tlmWrite_TLMCHAN_STATS_2_MAX(max);
+                this->tlmWrite_TLMCHAN_STATS_2_MEAN(mean);
+                break;
+            case 3:
+                this->tlmWrite_TLMCHAN_STATS_3_ID(id);
+                this->tlmWrite_TLMCHAN_STATS_3_COUNT(count);
+                this->tlmWrite_TLMCHAN_STATS_3_MIN(min);
+                this->tlmWrite_TLMCHAN_STATS_3_MAX(max);
+                this->tlmWrite_TLMCHAN_STATS_3_MEAN(mean);
+                break;
+            default:
+                FW_ASSERT(0,slot);
+                break;
+        }
+
+    }
+
+}
@@ -27,31 +27,139 @@ namespace Svc {
             return;
         }
 
-        // lock mutex long enough to modify active telemetry buffer
-        // so the data can be read without worrying about updates
-        this->lock();
-        this->m_activeBuffer = 1 - this->m_activeBuffer;
-        // set activeBuffer to not updated
-        for (U32 entry = 0; entry < TLMCHAN_HASH_BUCKETS; entry++) {
-            this->m_tlmEntries[this->m_activeBuffer].buckets[entry].updated = false;
+        this->m_runCycles++;
+
+        // filter parameters are set from the command dispatcher, so they are
+        // applied here where the filter table is used
+        if (__sync_bool_compare_and_swap(&this->m_filterParamsUpdated,1,0)) {
+            this->applyFilterParams();
+        }
+
+        // send statistics for windows that have ended
+        this->runStats();
+
+        // Values are read without a lock, so writers are never blocked
+        // while telemetry is sent. A value is sent if its version has changed
+        // since Run last saw it and it passes the channel filter.
+        // Channels that are in a packet are sent below.
+        NATIVE_UINT_TYPE numChannels = this->m_numChannels;
+        for (U32 entry = 0; entry < numChannels; entry++) {
+            // channels are added before they are written, so the packet
+            // assignment can be read once the entry has a value
+            if (0 == this->m_entries[entry].seq) {
+                continue;
+            }
+            __sync_synchronize();
+            if (this->m_channels[entry].packet != TLMCHAN_NO_PACKET) {
+                continue;
+            }
+            U32 stamp;
+            U32 version;
+            if (not this->readEntry(entry,this->m_readValue.lastUpdate,this->m_readValue.buffer,stamp,version)) {
+                continue;
+            }
+            if (version == this->m_entries[entry].seenSeq) {
+                continue;
+            }
+            this->m_entries[entry].seenSeq = version;
+            // channels with statistics only send the aggregates
+            if ((this->m_entries[entry].statsSlot != TLMCHAN_NO_STATS) or
+                (not this->filterValue(entry,this->m_readValue.buffer))) {
+                this->m_suppressedSamples++;
+                continue;
+            }
+            this->m_sentSamples++;
+            this->m_tlmPacket.setId(this->m_channels[entry].id);
+            this->m_tlmPacket.setTimeTag(this->m_readValue.lastUpdate);
+            this->m_tlmPacket.setTlmBuffer(this->m_readValue.buffer);
+            this->m_comBuffer.resetSer();
+            Fw::SerializeStatus stat = this->m_tlmPacket.serialize(this->m_comBuffer);
+            FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,static_cast<NATIVE_INT_TYPE>(stat));
+            this->PktSend_out(0,this->m_comBuffer,0);
+        }
+
+        // send any packets with updated channels
+        if (this->m_packetList) {
+            for (NATIVE_UINT_TYPE pkt = 0; pkt < this->m_packetList->numEntries; pkt++) {
+                if (this->buildPacket(pkt)) {
+                    this->PktSend_out(0,this->m_comBuffer,0);
+                }
+            }
         }
-        this->unLock();
-
-        // go through each entry and send a packet if it has been updated
-
-        for (U32 entry = 0; entry < TLMCHAN_HASH_BUCKETS; entry++) {
-            TlmEntry* p_entry = &this->m_tlmEntries[1-this->m_activeBuffer].buckets[entry];
-            if ((p_entry->updated) && (p_entry->used)) {
-                this->m_tlmPacket.setId(p_entry->id);
-                this->m_tlmPacket.setTimeTag(p_entry->lastUpdate);
-                this->m_tlmPacket.setTlmBuffer(p_entry->buffer);
-                this->m_comBuffer.resetSer();
-                Fw::SerializeStatus stat = this->m_tlmPacket.serialize(this->m_comBuffer);
-                FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,static_cast<NATIVE_INT_TYPE>(stat));
-                p_entry->updated = false;
-                this->PktSend_out(0,this->m_comBuffer,0);
+
+        // Counters are written every TLMCHAN_COUNTER_CYCLES Run calls. The
+        // channels are on_change, so a counter that hasn't moved isn't sent.
+        if (0 == (this->m_runCycles % TLMCHAN_COUNTER_CYCLES)) {
+            this->tlmWrite_TLMCHAN_SENT_SAMPLES(this->m_sentSamples);
+            this->tlmWrite_TLMCHAN_SUPPRESSED_SAMPLES(this->m_suppressedSamples);
+            this->tlmWrite_TLMCHAN_CONTENDED_WRITES(this->m_contendedWrites);
+        }
+    }
+
+    bool TlmChanImpl::buildPacket(NATIVE_UINT_TYPE pkt) {
+
+        const TlmChanPacket* pktDef = this->m_packetList->list[pkt];
+        bool updated = false;
+        bool written = false;
+        U32 latestStamp = 0;
+        Fw::Time latestTime;
+
+        // copy the latest value of each channel to its place in the packet
+        NATIVE_UINT_TYPE offset = 0;
+        for (NATIVE_UINT_TYPE entry = 0; entry < pktDef->numEntries; entry++) {
+            const TlmChanPacketEntry& chanDef = pktDef->list[entry];
+            U8* dest = &this->m_packetValues[offset];
+            offset += chanDef.size;
+            NATIVE_INT_TYPE channel = this->findChannel(chanDef.id);
+            U32 stamp;
+            U32 version;
+            if ((TLMCHAN_NO_CHANNEL == channel) or
+                (not this->readEntry(channel,this->m_readValue.lastUpdate,this->m_readValue.buffer,stamp,version))) {
+                // unwritten channels are sent as zero
+                ::memset(dest,0,chanDef.size);
+                continue;
             }
+            NATIVE_UINT_TYPE size = this->m_readValue.buffer.getBuffLength();
+            FW_ASSERT(size <= chanDef.size,size,chanDef.size,chanDef.id);
+            ::memcpy(dest,this->m_readValue.buffer.getBuffAddr(),size);
+            // pad shorter values such as strings
+            ::memset(&dest[size],0,chanDef.size - size);
+            // packet time is the time of the most recent write. Stamps wrap, so compare the difference
+            if ((not written) or (static_cast<I32>(stamp - latestStamp) > 0)) {
+                latestStamp = stamp;
+                latestTime = this->m_readValue.lastUpdate;
+                written = true;
+            }
+            // new values only cause the packet to be sent if they pass the filter
+            if (version != this->m_entries[channel].seenSeq) {
+                this->m_entries[channel].seenSeq = version;
+                if (this->filterValue(channel,this->m_readValue.buffer)) {
+                    this->m_sentSamples++;
+                    updated = true;
+                } else {
+                    this->m_suppressedSamples++;
+                }
+            }
+        }
+
+        if (not updated) {
+            return false;
         }
+
+        // Packet format:
+        // |descriptor|packet id|time tag of latest update|channel values in packet definition order|
+        this->m_comBuffer.resetSer();
+        Fw::SerializeStatus stat = this->m_comBuffer.serialize(
+                static_cast<FwPacketDescriptorType>(Fw::ComPacket::FW_PACKET_PACKETIZED_TLM));
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,static_cast<NATIVE_INT_TYPE>(stat));
+        stat = this->m_comBuffer.serialize(pktDef->id);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,static_cast<NATIVE_INT_TYPE>(stat));
+        stat = this->m_comBuffer.serialize(latestTime);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,static_cast<NATIVE_INT_TYPE>(stat));
+        stat = this->m_comBuffer.serialize(this->m_packetValues,offset,true);
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == stat,static_cast<NATIVE_INT_TYPE>(stat));
+
+        return true;
     }
 
 }
@@ -0,0 +1,37 @@
+/**
+ * \file
+ * \brief Types used to define packetized telemetry for TlmChan
+ *
+ * A deployment describes its telemetry packets as a list of packets,
+ * each of which is a list of channels. When a packet list is given
+ * to TlmChanImpl::setPacketList(), channels in the list are downlinked
+ * as FW_PACKET_PACKETIZED_TLM packets instead of one packet per channel.
+ */
+
+#ifndef TLMCHAN_TLMCHANPACKETTYPES_HPP_
+#define TLMCHAN_TLMCHANPACKETTYPES_HPP_
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <Svc/TlmChan/TlmChanImplCfg.hpp>
+
+namespace Svc {
+
+    struct TlmChanPacketEntry {
+        FwChanIdType id; //!< id of channel
+        NATIVE_UINT_TYPE size; //!< serialized size of channel in bytes
+    };
+
+    struct TlmChanPacket {
+        const TlmChanPacketEntry* list; //!< list of channels in packet
+        FwTlmPacketizeIdType id; //!< packet ID
+        NATIVE_UINT_TYPE numEntries; //!< number of channels in packet
+    };
+
+    struct TlmChanPacketList {
+        const TlmChanPacket* list[TLMCHAN_MAX_PACKETS]; //!< list of packets
+        NATIVE_UINT_TYPE numEntries; //!< number of packets in list
+    };
+
+}
+
+#endif /* TLMCHAN_TLMCHANPACKETTYPES_HPP_ */
@@ -14,12 +14,16 @@
 # There are some standard files that are included for reference
 
 SRC =      	TlmChanComponentAi.xml \
+			TlmChanFilterSerializableAi.xml \
 			TlmChanImpl.cpp \
            	TlmChanImplRecv.cpp \
            	TlmChanImplGet.cpp \
-           	TlmChanImplTask.cpp 
+           	TlmChanImplTask.cpp \
+           	TlmChanImplFilter.cpp \
+           	TlmChanImplStats.cpp
 
 HDR = 		TlmChanImpl.hpp \
-			TlmChanImplCfg.hpp
+			TlmChanImplCfg.hpp \
+			TlmChanPacketTypes.hpp
 
 SUBDIRS = test
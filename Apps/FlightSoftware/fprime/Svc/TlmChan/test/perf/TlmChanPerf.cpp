@@ -0,0 +1,72 @@
+/*
+ * TlmChanPerf.cpp
+ *
+ * Main program for the TlmChanImpl benchmark
+ */
+
+#include <Svc/TlmChan/test/perf/TlmChanPerfTester.hpp>
+#include <Svc/TlmChan/TlmChanImpl.hpp>
+#include <Fw/Obj/SimpleObjRegistry.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#include <cstdlib>
+
+#if FW_OBJECT_REGISTRATION == 1
+static Fw::SimpleObjRegistry simpleReg;
+#endif
+
+namespace {
+    // swept values. Channel counts are limited by the table size in TlmChanImplCfg.hpp
+    const NATIVE_UINT_TYPE PERF_CHANNELS[] = {1, 8, 25, TLMCHAN_MAX_CHANNELS};
+    const NATIVE_UINT_TYPE PERF_UPDATE_PERCENTS[] = {10, 50, 100};
+    const NATIVE_UINT_TYPE PERF_DEFAULT_SAMPLES = 1000;
+}
+
+void runPerfTest(Svc::TlmChanPerfTester::Config config, NATIVE_UINT_TYPE numChannels, NATIVE_UINT_TYPE samples) {
+
+    // component is large, so allocate instead of putting it on the stack
+    Svc::TlmChanImpl* impl = new Svc::TlmChanImpl("TlmChanImpl");
+    FW_ASSERT(impl);
+
+    impl->init(10,0);
+
+    Svc::TlmChanPerfTester* tester = new Svc::TlmChanPerfTester(*impl);
+    FW_ASSERT(tester);
+
+    tester->init();
+
+    // connect ports
+    tester->connect();
+
+    // run measurements
+    tester->setup(config,numChannels);
+    tester->runRecv(samples);
+    tester->runGet(samples);
+    for (NATIVE_UINT_TYPE pct = 0; pct < FW_NUM_ARRAY_ELEMENTS(PERF_UPDATE_PERCENTS); pct++) {
+        tester->runCycles(samples,PERF_UPDATE_PERCENTS[pct]);
+    }
+
+    delete tester;
+    delete impl;
+}
+
+int main(int argc, char* argv[]) {
+
+    // optional argument is the number of samples for each measurement
+    NATIVE_UINT_TYPE samples = PERF_DEFAULT_SAMPLES;
+    if (argc > 1) {
+        samples = atoi(argv[1]);
+    }
+    if ((samples == 0) or (samples > Svc::TlmChanPerfTester::PERF_MAX_SAMPLES)) {
+        samples = PERF_DEFAULT_SAMPLES;
+    }
+
+    Svc::TlmChanPerfTester::printHeader();
+    for (NATIVE_UINT_TYPE config = 0; config < Svc::TlmChanPerfTester::CONFIG_MAX; config++) {
+        for (NATIVE_UINT_TYPE chans = 0; chans < FW_NUM_ARRAY_ELEMENTS(PERF_CHANNELS); chans++) {
+            runPerfTest(static_cast<Svc::TlmChanPerfTester::Config>(config),PERF_CHANNELS[chans],samples);
+        }
+    }
+
+    return 0;
+}
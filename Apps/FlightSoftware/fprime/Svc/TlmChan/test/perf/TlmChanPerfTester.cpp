@@ -0,0 +1,258 @@
+/*
+ * TlmChanPerfTester.cpp
+ *
+ * Benchmark driver for TlmChanImpl
+ */
+
+#include <Svc/TlmChan/test/perf/TlmChanPerfTester.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Os/IntervalTimer.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    const char* const CONFIG_NAMES[] = {"dynamic","ids","packetized"};
+}
+
+namespace Svc {
+
+    TlmChanPerfTester::TlmChanPerfTester(Svc::TlmChanImpl& inst) :
+#if FW_OBJECT_NAMES == 1
+        Fw::PassiveComponentBase("perftester"),
+#endif
+            m_impl(inst),
+            m_config(CONFIG_DYNAMIC),
+            m_numChannels(0),
+            m_writeValue(0),
+            m_packetsSent(0),
+            m_bytesSent(0) {
+        this->m_packetList.numEntries = 0;
+    }
+
+    TlmChanPerfTester::~TlmChanPerfTester() {
+    }
+
+    void TlmChanPerfTester::init(NATIVE_INT_TYPE instance) {
+        Fw::PassiveComponentBase::init(instance);
+        this->m_tlmRecvOut.init();
+        this->m_tlmGetOut.init();
+        this->m_runOut.init();
+        this->m_pktSendIn.init();
+        this->m_pktSendIn.addCallComp(this,pktSendIn);
+    }
+
+    void TlmChanPerfTester::connect(void) {
+        this->m_tlmRecvOut.addCallPort(this->m_impl.get_TlmRecv_InputPort(0));
+        this->m_tlmGetOut.addCallPort(this->m_impl.get_TlmGet_InputPort(0));
+        this->m_runOut.addCallPort(this->m_impl.get_Run_InputPort(0));
+        this->m_impl.set_PktSend_OutputPort(0,&this->m_pktSendIn);
+    }
+
+    void TlmChanPerfTester::pktSendIn(Fw::PassiveComponentBase* callComp, NATIVE_INT_TYPE portNum,
+            Fw::ComBuffer &data, U32 context) {
+        FW_ASSERT(callComp);
+        TlmChanPerfTester* tester = static_cast<TlmChanPerfTester*>(callComp);
+        // only count what is sent, so the handler adds little to the Run time
+        tester->m_packetsSent++;
+        tester->m_bytesSent += data.getBuffLength();
+    }
+
+    void TlmChanPerfTester::runCycle(void) {
+        // Run is an async port, so dispatch the message on this thread
+        this->m_runOut.invoke(0);
+        (void) this->m_impl.doDispatch();
+    }
+
+    FwChanIdType TlmChanPerfTester::channelId(NATIVE_UINT_TYPE channel) {
+        return PERF_BASE_ID + channel*PERF_ID_STRIDE;
+    }
+
+    void TlmChanPerfTester::writeChannel(NATIVE_UINT_TYPE channel) {
+        Fw::TlmBuffer buff;
+        Fw::Time timeTag;
+        FW_ASSERT(Fw::FW_SERIALIZE_OK == buff.serialize(this->m_writeValue++));
+        this->m_tlmRecvOut.invoke(this->channelId(channel),timeTag,buff);
+    }
+
+    void TlmChanPerfTester::setup(Config config, NATIVE_UINT_TYPE numChannels) {
+
+        FW_ASSERT(config < CONFIG_MAX,config);
+        FW_ASSERT(numChannels > 0 and numChannels <= TLMCHAN_MAX_CHANNELS,numChannels);
+        this->m_config = config;
+        this->m_numChannels = numChannels;
+
+        if (config != CONFIG_DYNAMIC) {
+            FwChanIdType ids[TLMCHAN_MAX_CHANNELS];
+            for (NATIVE_UINT_TYPE channel = 0; channel < numChannels; channel++) {
+                ids[channel] = this->channelId(channel);
+            }
+            this->m_impl.setChannelIds(ids,numChannels);
+        }
+
+        if (CONFIG_PACKETIZED == config) {
+            // fill packets in channel order
+            NATIVE_UINT_TYPE numPackets = (numChannels + PERF_PACKET_CHANNELS - 1)/PERF_PACKET_CHANNELS;
+            FW_ASSERT(numPackets <= TLMCHAN_MAX_PACKETS,numPackets);
+            for (NATIVE_UINT_TYPE channel = 0; channel < numChannels; channel++) {
+                this->m_packetEntries[channel].id = this->channelId(channel);
+                this->m_packetEntries[channel].size = sizeof(U32);
+            }
+            for (NATIVE_UINT_TYPE pkt = 0; pkt < numPackets; pkt++) {
+                NATIVE_UINT_TYPE first = pkt*PERF_PACKET_CHANNELS;
+                this->m_packets[pkt].list = &this->m_packetEntries[first];
+                this->m_packets[pkt].id = pkt + 1;
+                this->m_packets[pkt].numEntries = FW_MIN(numChannels - first,static_cast<NATIVE_UINT_TYPE>(PERF_PACKET_CHANNELS));
+                this->m_packetList.list[pkt] = &this->m_packets[pkt];
+            }
+            this->m_packetList.numEntries = numPackets;
+            this->m_impl.setPacketList(this->m_packetList);
+        }
+
+        // write every channel once so reads find a value and dynamic channels are in the table
+        for (NATIVE_UINT_TYPE channel = 0; channel < numChannels; channel++) {
+            this->writeChannel(channel);
+        }
+        // send the first values so Run only sends what is updated
+        this->runCycle();
+
+    }
+
+    void TlmChanPerfTester::runRecv(NATIVE_UINT_TYPE samples) {
+
+        FW_ASSERT(samples > 0 and samples <= PERF_MAX_SAMPLES,samples);
+
+        Fw::TlmBuffer buff;
+        Fw::Time timeTag;
+        Os::IntervalTimer::RawTime start;
+        Os::IntervalTimer::RawTime stop;
+        NATIVE_UINT_TYPE channel = 0;
+
+        for (NATIVE_UINT_TYPE sample = 0; sample < samples; sample++) {
+            buff.resetSer();
+            FW_ASSERT(Fw::FW_SERIALIZE_OK == buff.serialize(this->m_writeValue++));
+            Os::IntervalTimer::getRawTime(start);
+            for (NATIVE_UINT_TYPE call = 0; call < PERF_BATCH; call++) {
+                this->m_tlmRecvOut.invoke(this->channelId(channel),timeTag,buff);
+                if (++channel == this->m_numChannels) {
+                    channel = 0;
+                }
+            }
+            Os::IntervalTimer::getRawTime(stop);
+            this->m_samples[sample] = Os::IntervalTimer::getDiffNsec(stop,start);
+        }
+
+        this->report("recv",0,samples,PERF_BATCH);
+    }
+
+    void TlmChanPerfTester::runGet(NATIVE_UINT_TYPE samples) {
+
+        FW_ASSERT(samples > 0 and samples <= PERF_MAX_SAMPLES,samples);
+
+        Fw::TlmBuffer buff;
+        Fw::Time timeTag;
+        Os::IntervalTimer::RawTime start;
+        Os::IntervalTimer::RawTime stop;
+        NATIVE_UINT_TYPE channel = 0;
+
+        for (NATIVE_UINT_TYPE sample = 0; sample < samples; sample++) {
+            Os::IntervalTimer::getRawTime(start);
+            for (NATIVE_UINT_TYPE call = 0; call < PERF_BATCH; call++) {
+                this->m_tlmGetOut.invoke(this->channelId(channel),timeTag,buff);
+                if (++channel == this->m_numChannels) {
+                    channel = 0;
+                }
+            }
+            Os::IntervalTimer::getRawTime(stop);
+            // every channel has been written, so every read should return a value
+            FW_ASSERT(buff.getBuffLength() == sizeof(U32),buff.getBuffLength());
+            this->m_samples[sample] = Os::IntervalTimer::getDiffNsec(stop,start);
+        }
+
+        this->report("get",0,samples,PERF_BATCH);
+    }
+
+    void TlmChanPerfTester::runCycles(NATIVE_UINT_TYPE samples, NATIVE_UINT_TYPE updatePercent) {
+
+        FW_ASSERT(samples > 0 and samples <= PERF_MAX_SAMPLES,samples);
+        FW_ASSERT(updatePercent > 0 and updatePercent <= 100,updatePercent);
+
+        // round up so at least one channel is updated
+        NATIVE_UINT_TYPE updates = (this->m_numChannels*updatePercent + 99)/100;
+        Os::IntervalTimer::RawTime start;
+        Os::IntervalTimer::RawTime stop;
+        NATIVE_UINT_TYPE channel = 0;
+
+        this->m_packetsSent = 0;
+        this->m_bytesSent = 0;
+
+        for (NATIVE_UINT_TYPE sample = 0; sample < samples; sample++) {
+            // update a different set of channels each cycle
+            for (NATIVE_UINT_TYPE update = 0; update < updates; update++) {
+                this->writeChannel(channel);
+                if (++channel == this->m_numChannels) {
+                    channel = 0;
+                }
+            }
+            Os::IntervalTimer::getRawTime(start);
+            this->runCycle();
+            Os::IntervalTimer::getRawTime(stop);
+            this->m_samples[sample] = Os::IntervalTimer::getDiffNsec(stop,start);
+        }
+
+        // each cycle should send something
+        FW_ASSERT(this->m_packetsSent >= samples,this->m_packetsSent,samples);
+
+        this->report("run",updatePercent,samples,1);
+    }
+
+    void TlmChanPerfTester::printHeader(void) {
+        (void)printf("bench,config,channels,update_pct,samples,batch,"
+                "p50_ns,p90_ns,p99_ns,max_ns,mean_ns,ops_per_sec,packets,bytes_per_sec\n");
+    }
+
+    void TlmChanPerfTester::report(const char* bench, NATIVE_UINT_TYPE updatePercent, NATIVE_UINT_TYPE samples,
+            NATIVE_UINT_TYPE batch) {
+
+        // convert samples to time per operation and sort for percentiles
+        U64 sumNsec = 0;
+        for (NATIVE_UINT_TYPE sample = 0; sample < samples; sample++) {
+            sumNsec += this->m_samples[sample];
+            this->m_samples[sample] /= batch;
+        }
+        qsort(this->m_samples,samples,sizeof(this->m_samples[0]),compareSamples);
+
+        F64 meanNsec = static_cast<F64>(sumNsec)/(static_cast<F64>(samples)*batch);
+        F64 opsPerSec = (sumNsec > 0) ? 1.0e9/meanNsec : 0.0;
+        // packets are only sent by Run
+        U32 packets = 0;
+        F64 bytesPerSec = 0.0;
+        if (updatePercent > 0) {
+            packets = this->m_packetsSent;
+            bytesPerSec = (sumNsec > 0) ? static_cast<F64>(this->m_bytesSent)*1.0e9/sumNsec : 0.0;
+        }
+
+        (void)printf("%s,%s,%u,%u,%u,%u,%u,%u,%u,%u,%.1f,%.0f,%u,%.0f\n",
+                bench,
+                CONFIG_NAMES[this->m_config],
+                static_cast<U32>(this->m_numChannels),
+                static_cast<U32>(updatePercent),
+                static_cast<U32>(samples),
+                static_cast<U32>(batch),
+                this->m_samples[(samples-1)*50/100],
+                this->m_samples[(samples-1)*90/100],
+                this->m_samples[(samples-1)*99/100],
+                this->m_samples[samples-1],
+                meanNsec,
+                opsPerSec,
+                packets,
+                bytesPerSec);
+    }
+
+    int TlmChanPerfTester::compareSamples(const void* a, const void* b) {
+        U32 first = *static_cast<const U32*>(a);
+        U32 second = *static_cast<const U32*>(b);
+        return (first > second) - (first < second);
+    }
+
+} /* namespace Svc */
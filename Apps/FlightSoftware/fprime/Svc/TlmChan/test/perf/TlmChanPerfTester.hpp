@@ -0,0 +1,103 @@
+/*
+ * TlmChanPerfTester.hpp
+ *
+ * Benchmark driver for TlmChanImpl
+ */
+
+#ifndef TLMCHAN_TEST_PERF_TLMCHANPERFTESTER_HPP_
+#define TLMCHAN_TEST_PERF_TLMCHANPERFTESTER_HPP_
+
+#include <Fw/Comp/PassiveComponentBase.hpp>
+#include <Fw/Tlm/TlmPortAc.hpp>
+#include <Fw/Com/ComPortAc.hpp>
+#include <Svc/Sched/SchedPortAc.hpp>
+#include <Svc/TlmChan/TlmChanImpl.hpp>
+
+namespace Svc {
+
+    //! Benchmark for TlmChanImpl. Each measurement is printed as a
+    //! comma separated line so results can be compared between builds.
+    //! The benchmark is a standalone program, so it drives the component
+    //! through its own ports instead of the unit test tester base.
+    class TlmChanPerfTester: public Fw::PassiveComponentBase {
+        public:
+
+            //! How channels are put in the table
+            typedef enum {
+                CONFIG_DYNAMIC, //!< channels added the first time they are written
+                CONFIG_IDS, //!< channel IDs loaded with setChannelIds()
+                CONFIG_PACKETIZED, //!< channel IDs loaded and all channels in packets
+                CONFIG_MAX
+            } Config;
+
+            TlmChanPerfTester(Svc::TlmChanImpl& inst);
+            virtual ~TlmChanPerfTester();
+
+            void init(NATIVE_INT_TYPE instance = 0);
+
+            //! Connect the measured ports of the component. Time, events and
+            //! telemetry aren't connected, so they aren't included in the times.
+            void connect(void);
+
+            //! Load the channels for a configuration. Must be called once on a new component.
+            void setup(Config config, NATIVE_UINT_TYPE numChannels);
+
+            //! Measure TlmRecv latency
+            void runRecv(NATIVE_UINT_TYPE samples);
+            //! Measure TlmGet latency
+            void runGet(NATIVE_UINT_TYPE samples);
+            //! Measure Run latency and throughput with a percentage of channels updated each cycle
+            void runCycles(NATIVE_UINT_TYPE samples, NATIVE_UINT_TYPE updatePercent);
+
+            //! print the column names for the results
+            static void printHeader(void);
+
+            enum {
+                PERF_BATCH = 128, //!< TlmRecv/TlmGet calls timed together for one sample
+                PERF_MAX_SAMPLES = 2000, //!< maximum samples for one measurement
+                PERF_PACKET_CHANNELS = 16, //!< channels in each packet in the packetized configuration
+                PERF_BASE_ID = 0x1000, //!< first channel ID
+                PERF_ID_STRIDE = 37 //!< spacing between channel IDs, so IDs aren't contiguous
+            };
+
+        private:
+            Svc::TlmChanImpl& m_impl;
+
+            //! Callback for packets sent by the component
+            static void pktSendIn(Fw::PassiveComponentBase* callComp, NATIVE_INT_TYPE portNum,
+                    Fw::ComBuffer &data, U32 context);
+
+            // ports to and from the component
+            Fw::OutputTlmPort m_tlmRecvOut;
+            Fw::OutputTlmPort m_tlmGetOut;
+            Svc::OutputSchedPort m_runOut;
+            Fw::InputComPort m_pktSendIn;
+
+            // helpers
+            void runCycle(void);
+            FwChanIdType channelId(NATIVE_UINT_TYPE channel);
+            void writeChannel(NATIVE_UINT_TYPE channel);
+            void report(const char* bench, NATIVE_UINT_TYPE updatePercent, NATIVE_UINT_TYPE samples,
+                    NATIVE_UINT_TYPE batch);
+            static int compareSamples(const void* a, const void* b);
+
+            Config m_config;
+            NATIVE_UINT_TYPE m_numChannels;
+            U32 m_writeValue;
+
+            // counts of what Run sent
+            U32 m_packetsSent;
+            U32 m_bytesSent;
+
+            // time of each sample in nanoseconds per operation
+            U32 m_samples[PERF_MAX_SAMPLES];
+
+            // packet definitions for the packetized configuration
+            TlmChanPacketEntry m_packetEntries[TLMCHAN_MAX_CHANNELS];
+            TlmChanPacket m_packets[TLMCHAN_MAX_PACKETS];
+            TlmChanPacketList m_packetList;
+    };
+
+} /* namespace Svc */
+
+#endif /* TLMCHAN_TEST_PERF_TLMCHANPERFTESTER_HPP_ */
@@ -13,6 +13,20 @@
 
 # There are some standard files that are included for reference
 
-TEST_SRC = TelemStoreComponentTestAc.cpp TelemChanTester.cpp TelemChanImplTester.cpp
+TEST_SRC = 	TlmChanPerf.cpp \
+			TlmChanPerfTester.cpp
 
-TEST_MODS = Svc/Tlm Svc/TlmChan Fw/Tlm Fw/Cmd Fw/Com Fw/Comp Fw/Log Fw/Obj Fw/Port Fw/Prm Fw/Time Fw/Types Svc/Sched Os
+TEST_MODS = Svc/TlmChan \
+			Svc/Sched \
+			Svc/Ping \
+			Fw/Tlm \
+			Fw/Cmd \
+			Fw/Com \
+			Fw/Comp \
+			Fw/Log \
+			Fw/Obj \
+			Fw/Port \
+			Fw/Prm \
+			Fw/Time \
+			Fw/Types \
+			Os
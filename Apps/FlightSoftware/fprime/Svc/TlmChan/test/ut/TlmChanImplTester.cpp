@@ -10,6 +10,8 @@
 #include <Fw/Com/ComPacket.hpp>
 #include <Os/IntervalTimer.hpp>
 #include <Fw/Test/UnitTest.hpp>
+#include <Fw/Types/EightyCharString.hpp>
+#include <Os/Task.hpp>
 
 #include <cstdio>
 
@@ -70,6 +72,10 @@ namespace Svc {
             FwPacketDescriptorType desc;
             stat = this->m_rcvdBuffer[packet].deserialize(desc);
             ASSERT_EQ(Fw::FW_SERIALIZE_OK,stat);
+            // skip packetized telemetry
+            if (desc == (FwPacketDescriptorType)Fw::ComPacket::FW_PACKET_PACKETIZED_TLM) {
+                continue;
+            }
             ASSERT_EQ(desc,(FwPacketDescriptorType)Fw::ComPacket::FW_PACKET_TELEM);
             // next piece should be event ID
             FwEventIdType sentId;
@@ -99,6 +105,45 @@ namespace Svc {
         ASSERT_TRUE(packetFound);
     }
 
+    void TlmChanImplTester::checkPacket(FwTlmPacketizeIdType id, const U32* vals, NATIVE_UINT_TYPE numVals) {
+        Fw::SerializeStatus stat;
+        bool packetFound = false;
+
+        for (NATIVE_UINT_TYPE packet = 0; packet < this->m_numBuffs; packet++) {
+            this->m_rcvdBuffer[packet].resetDeser();
+            // first piece should be packetized tlm descriptor
+            FwPacketDescriptorType desc;
+            stat = this->m_rcvdBuffer[packet].deserialize(desc);
+            ASSERT_EQ(Fw::FW_SERIALIZE_OK,stat);
+            if (desc != (FwPacketDescriptorType)Fw::ComPacket::FW_PACKET_PACKETIZED_TLM) {
+                continue;
+            }
+            // next piece should be packet ID
+            FwTlmPacketizeIdType sentId;
+            stat = this->m_rcvdBuffer[packet].deserialize(sentId);
+            ASSERT_EQ(Fw::FW_SERIALIZE_OK,stat);
+            if (sentId != id) {
+                continue;
+            }
+            packetFound = true;
+            // next piece is time tag
+            Fw::Time recTimeTag(TB_NONE,0,0);
+            stat = this->m_rcvdBuffer[packet].deserialize(recTimeTag);
+            ASSERT_EQ(Fw::FW_SERIALIZE_OK,stat);
+            // next pieces are channel values
+            for (NATIVE_UINT_TYPE val = 0; val < numVals; val++) {
+                U32 readVal;
+                stat = this->m_rcvdBuffer[packet].deserialize(readVal);
+                ASSERT_EQ(Fw::FW_SERIALIZE_OK,stat);
+                ASSERT_EQ(vals[val],readVal);
+            }
+            // packet should be empty
+            ASSERT_EQ(this->m_rcvdBuffer[packet].getBuffLeft(),(NATIVE_UINT_TYPE)0);
+        }
+
+        ASSERT_TRUE(packetFound);
+    }
+
     void TlmChanImplTester::sendBuff(FwChanIdType id, U32 val, NATIVE_INT_TYPE instance) {
 
         Fw::TlmBuffer buff;
@@ -199,18 +244,491 @@ namespace Svc {
 
     void TlmChanImplTester::runTooManyChannels(void) {
 
-        // This will assert, so disable after testing
+        this->clearBuffs();
+        this->clearHistory();
+        // fill the table
+        for (NATIVE_UINT_TYPE n=0; n < TLMCHAN_MAX_CHANNELS; n++) {
+            this->sendBuff(n,n,0);
+        }
+        ASSERT_EVENTS_SIZE(0);
+
+        // one more channel should be dropped and reported
+        Fw::TlmBuffer buff;
+        Fw::TlmBuffer readBack;
+        Fw::Time timeTag;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,buff.serialize(static_cast<U32>(10)));
+        this->invoke_to_TlmRecv(0,TLMCHAN_MAX_CHANNELS,timeTag,buff);
+        ASSERT_EVENTS_SIZE(1);
+        ASSERT_EVENTS_TLMCHAN_TOO_MANY_CHANNELS_SIZE(1);
+        ASSERT_EVENTS_TLMCHAN_TOO_MANY_CHANNELS(0,TLMCHAN_MAX_CHANNELS);
+        this->invoke_to_TlmGet(0,TLMCHAN_MAX_CHANNELS,timeTag,readBack);
+        ASSERT_EQ((NATIVE_UINT_TYPE)0,readBack.getBuffLength());
+
+        // only the first dropped channel is reported
+        this->invoke_to_TlmRecv(0,TLMCHAN_MAX_CHANNELS+1,timeTag,buff);
+        ASSERT_EVENTS_SIZE(1);
+
+        // existing channels still work and are all sent
+        this->sendBuff(0,100,0);
+        this->doRun(true);
+        ASSERT_EQ(this->m_numBuffs,(NATIVE_UINT_TYPE)TLMCHAN_MAX_CHANNELS);
+        this->checkBuff(0,100,0);
+
+    }
+
+    void TlmChanImplTester::runChannelIds(void) {
+
+        FwChanIdType IDs[] = {
+                // From Ref ComponentReport.txt
+                0x1000,0x1001,0x1002,0x1003,0x1004,0x1005,0x1100,0x1101,0x1102,0x1103,0x300,0x301,0x400,0x401,0x402,0x100,0x101,0x102,0x103,0x104,0x105
+        };
+
+        this->m_impl.setChannelIds(IDs,FW_NUM_ARRAY_ELEMENTS(IDs));
+        ASSERT_EQ(this->m_impl.m_numChannels,FW_NUM_ARRAY_ELEMENTS(IDs));
+
+        // every channel should be in its own hash slot
+        for (NATIVE_UINT_TYPE n=0; n < FW_NUM_ARRAY_ELEMENTS(IDs); n++) {
+            NATIVE_UINT_TYPE slot = this->m_impl.doHash(IDs[n]);
+            ASSERT_NE(0,this->m_impl.m_index[slot]);
+            ASSERT_EQ(IDs[n],this->m_impl.m_channels[this->m_impl.m_index[slot]-1].id);
+        }
+
+        this->dumpHash();
+
+        // channels that haven't been written read back empty
+        Fw::TlmBuffer buff;
+        Fw::Time timeTag;
+        this->invoke_to_TlmGet(0,IDs[0],timeTag,buff);
+        ASSERT_EQ((NATIVE_UINT_TYPE)0,buff.getBuffLength());
 
         this->clearBuffs();
         // send all updates
-//        for (NATIVE_UINT_TYPE n=0; n <= TLMCHAN_HASH_BUCKETS; n++) {
-        for (NATIVE_UINT_TYPE n=0; n < TLMCHAN_HASH_BUCKETS; n++) {
-            this->sendBuff(n,n,0);
+        for (NATIVE_UINT_TYPE n=0; n < FW_NUM_ARRAY_ELEMENTS(IDs); n++) {
+            this->sendBuff(IDs[n],n,0);
         }
 
+        // do a run, and all the packets should be sent
+        this->doRun(true);
+        ASSERT_EQ(this->m_numBuffs,FW_NUM_ARRAY_ELEMENTS(IDs));
+
+        for (NATIVE_UINT_TYPE n=0; n < FW_NUM_ARRAY_ELEMENTS(IDs); n++) {
+            this->checkBuff(IDs[n],n,0);
+        }
+
+        // an ID not in the list is still added
+        this->sendBuff(0x2000,10,0);
+        ASSERT_EQ(this->m_impl.m_numChannels,FW_NUM_ARRAY_ELEMENTS(IDs)+1);
+
+    }
+
+    void TlmChanImplTester::runPacketized(void) {
+
+        static const TlmChanPacketEntry packet1List[] = {
+                {0x100,sizeof(U32)},
+                {0x101,sizeof(U32)},
+                {0x102,sizeof(U32)}
+        };
+        static const TlmChanPacketEntry packet2List[] = {
+                {0x200,sizeof(U32)}
+        };
+        static const TlmChanPacket packet1 = {packet1List,1,FW_NUM_ARRAY_ELEMENTS(packet1List)};
+        static const TlmChanPacket packet2 = {packet2List,2,FW_NUM_ARRAY_ELEMENTS(packet2List)};
+        static const TlmChanPacketList packetList = {{&packet1,&packet2},2};
+
+        this->m_impl.setPacketList(packetList);
+
+        // write channels in packet 1 and one channel not in any packet
+        this->clearBuffs();
+        this->sendBuff(0x100,10,0);
+        this->sendBuff(0x102,12,0);
+        this->sendBuff(0x300,30,0);
+        this->doRun(true);
+
+        // should get one packet and one channel
+        ASSERT_EQ((NATIVE_UINT_TYPE)2,this->m_numBuffs);
+        U32 packet1Vals[] = {10,0,12};
+        this->checkPacket(1,packet1Vals,FW_NUM_ARRAY_ELEMENTS(packet1Vals));
+        this->checkBuff(0x300,30,0);
+
+        // update one channel in each packet; both should be sent with latest values
+        this->clearBuffs();
+        this->sendBuff(0x101,11,0);
+        this->sendBuff(0x200,20,0);
+        this->doRun(true);
+
+        ASSERT_EQ((NATIVE_UINT_TYPE)2,this->m_numBuffs);
+        U32 packet1NewVals[] = {10,11,12};
+        this->checkPacket(1,packet1NewVals,FW_NUM_ARRAY_ELEMENTS(packet1NewVals));
+        U32 packet2Vals[] = {20};
+        this->checkPacket(2,packet2Vals,FW_NUM_ARRAY_ELEMENTS(packet2Vals));
+
+        // nothing updated, so nothing should be sent
+        this->clearBuffs();
+        ASSERT_FALSE(this->doRun(false));
 
     }
 
+    void TlmChanImplTester::runFilter(void) {
+
+        const FwChanIdType deadbandId = 0x10;
+        const FwChanIdType onChangeId = 0x11;
+        const FwChanIdType paramId = 0x12;
+        const FwChanIdType plainId = 0x13;
+
+        // reject a negative deadband
+        this->sendCmd_TLMCHAN_SET_FILTER(0,10,deadbandId,
+                TlmChanComponentBase::FILTER_DEADBAND,TlmChanComponentBase::VALUE_F32,-1.0,0);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(0,TlmChanComponentBase::OPCODE_TLMCHAN_SET_FILTER,10,Fw::COMMAND_VALIDATION_ERROR);
+
+        // deadband of 1.0 with a max silence of 5 Run cycles
+        this->clearHistory();
+        this->sendCmd_TLMCHAN_SET_FILTER(0,11,deadbandId,
+                TlmChanComponentBase::FILTER_DEADBAND,TlmChanComponentBase::VALUE_F32,1.0,5);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(0,TlmChanComponentBase::OPCODE_TLMCHAN_SET_FILTER,11,Fw::COMMAND_OK);
+        ASSERT_EVENTS_TLMCHAN_FILTER_SET_SIZE(1);
+        ASSERT_EVENTS_TLMCHAN_FILTER_SET(0,deadbandId,TlmChanComponentBase::FILTER_DEADBAND,1.0,5);
+
+        this->sendCmd_TLMCHAN_SET_FILTER(0,12,onChangeId,
+                TlmChanComponentBase::FILTER_ON_CHANGE,TlmChanComponentBase::VALUE_U8,0.0,0);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE(1,TlmChanComponentBase::OPCODE_TLMCHAN_SET_FILTER,12,Fw::COMMAND_OK);
+
+        // first values are always sent
+        this->clearBuffs();
+        this->clearHistory();
+        this->sendF32(deadbandId,10.0);
+        this->sendBuff(onChangeId,1,0);
+        this->sendBuff(plainId,1,0);
+        this->doRun(true);
+        ASSERT_EQ((NATIVE_UINT_TYPE)3,this->m_numBuffs);
+        ASSERT_EQ((U32)3,this->m_impl.m_sentSamples);
+
+        // values within the deadband or unchanged are suppressed
+        this->clearBuffs();
+        this->clearHistory();
+        this->sendF32(deadbandId,10.5);
+        this->sendBuff(onChangeId,1,0);
+        this->sendBuff(plainId,1,0);
+        this->doRun(true);
+        ASSERT_EQ((NATIVE_UINT_TYPE)1,this->m_numBuffs);
+        this->checkBuff(plainId,1,0);
+        ASSERT_EQ((U32)2,this->m_impl.m_suppressedSamples);
+
+        // counters are written every TLMCHAN_COUNTER_CYCLES Run calls
+        this->clearHistory();
+        for (NATIVE_UINT_TYPE cycle = 0; cycle < TLMCHAN_COUNTER_CYCLES; cycle++) {
+            this->doRun(false);
+        }
+        ASSERT_TLM_TLMCHAN_SENT_SAMPLES_SIZE(1);
+        ASSERT_TLM_TLMCHAN_SENT_SAMPLES(0,4);
+        ASSERT_TLM_TLMCHAN_SUPPRESSED_SAMPLES_SIZE(1);
+        ASSERT_TLM_TLMCHAN_SUPPRESSED_SAMPLES(0,2);
+
+        // values outside the deadband or changed are sent
+        this->clearBuffs();
+        this->sendF32(deadbandId,11.5);
+        this->sendBuff(onChangeId,2,0);
+        this->doRun(true);
+        ASSERT_EQ((NATIVE_UINT_TYPE)2,this->m_numBuffs);
+        this->checkBuff(onChangeId,2,0);
+
+        // a suppressed value is sent once the channel has been silent for 5 Run cycles
+        for (NATIVE_UINT_TYPE cycle = 1; cycle < 5; cycle++) {
+            this->clearBuffs();
+            this->sendF32(deadbandId,11.6);
+            ASSERT_FALSE(this->doRun(false));
+        }
+        this->clearBuffs();
+        this->sendF32(deadbandId,11.6);
+        this->doRun(true);
+        ASSERT_EQ((NATIVE_UINT_TYPE)1,this->m_numBuffs);
+
+        // set a filter by parameter
+        this->clearHistory();
+        TlmChanFilter filter(paramId,TLMCHAN_FILTER_ON_CHANGE,TLMCHAN_VALUE_U32,0.0,0);
+        this->paramSet_TLMCHAN_FILTER_0(filter,Fw::PARAM_VALID);
+        this->paramSend_TLMCHAN_FILTER_0(0,13);
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(0,TlmChanComponentBase::OPCODE_TLMCHAN_FILTER_0_SET,13,Fw::COMMAND_OK);
+
+        this->clearBuffs();
+        this->sendBuff(paramId,5,0);
+        this->doRun(true);
+        this->clearBuffs();
+        this->sendBuff(paramId,5,0);
+        ASSERT_FALSE(this->doRun(false));
+
+        // moving the parameter to another channel clears the old filter
+        TlmChanFilter otherFilter(plainId,TLMCHAN_FILTER_ON_CHANGE,TLMCHAN_VALUE_U32,0.0,0);
+        this->paramSet_TLMCHAN_FILTER_0(otherFilter,Fw::PARAM_VALID);
+        this->paramSend_TLMCHAN_FILTER_0(0,14);
+        this->clearBuffs();
+        this->sendBuff(paramId,5,0);
+        this->doRun(true);
+        this->checkBuff(paramId,5,0);
+
+        // invalid parameters are reported on load
+        this->clearHistory();
+        TlmChanFilter badFilter(paramId,TLMCHAN_FILTER_DEADBAND,TLMCHAN_VALUE_U32,-1.0,0);
+        this->paramSet_TLMCHAN_FILTER_1(badFilter,Fw::PARAM_VALID);
+        this->m_impl.loadParameters();
+        this->doRun(false);
+        ASSERT_EVENTS_TLMCHAN_FILTER_PARAM_INVALID_SIZE(1);
+        ASSERT_EVENTS_TLMCHAN_FILTER_PARAM_INVALID(0,1);
+
+        // fill the filter table. Three filters are already set
+        this->clearHistory();
+        for (NATIVE_UINT_TYPE filterNum = 0; filterNum < TLMCHAN_MAX_FILTERS; filterNum++) {
+            this->sendCmd_TLMCHAN_SET_FILTER(0,15,0x100 + filterNum,
+                    TlmChanComponentBase::FILTER_ON_CHANGE,TlmChanComponentBase::VALUE_U8,0.0,0);
+            this->m_impl.doDispatch();
+        }
+        ASSERT_EVENTS_TLMCHAN_FILTER_TABLE_FULL_SIZE(3);
+        ASSERT_CMD_RESPONSE(TLMCHAN_MAX_FILTERS-1,TlmChanComponentBase::OPCODE_TLMCHAN_SET_FILTER,15,Fw::COMMAND_EXECUTION_ERROR);
+
+        // clearing a filter makes room
+        this->sendCmd_TLMCHAN_SET_FILTER(0,16,deadbandId,
+                TlmChanComponentBase::FILTER_OFF,TlmChanComponentBase::VALUE_U8,0.0,0);
+        this->m_impl.doDispatch();
+        this->sendCmd_TLMCHAN_SET_FILTER(0,17,0x200,
+                TlmChanComponentBase::FILTER_ON_CHANGE,TlmChanComponentBase::VALUE_U8,0.0,0);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE(TLMCHAN_MAX_FILTERS+1,TlmChanComponentBase::OPCODE_TLMCHAN_SET_FILTER,17,Fw::COMMAND_OK);
+
+    }
+
+    void TlmChanImplTester::runStats(void) {
+
+        const FwChanIdType statsId = 0x10;
+        const FwChanIdType plainId = 0x11;
+
+        // reject a slot that doesn't exist
+        this->sendCmd_TLMCHAN_SET_STATS(0,10,TLMCHAN_STATS_SLOTS,statsId,TlmChanComponentBase::STATS_F32,3);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(0,TlmChanComponentBase::OPCODE_TLMCHAN_SET_STATS,10,Fw::COMMAND_VALIDATION_ERROR);
+
+        // three Run cycle window
+        this->clearHistory();
+        this->sendCmd_TLMCHAN_SET_STATS(0,11,0,statsId,TlmChanComponentBase::STATS_F32,3);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE_SIZE(1);
+        ASSERT_CMD_RESPONSE(0,TlmChanComponentBase::OPCODE_TLMCHAN_SET_STATS,11,Fw::COMMAND_OK);
+        ASSERT_EVENTS_TLMCHAN_STATS_SET_SIZE(1);
+        ASSERT_EVENTS_TLMCHAN_STATS_SET(0,0,statsId,3);
+
+        // a channel can only be in one slot
+        this->sendCmd_TLMCHAN_SET_STATS(0,12,1,statsId,TlmChanComponentBase::STATS_F32,3);
+        this->m_impl.doDispatch();
+        ASSERT_CMD_RESPONSE(1,TlmChanComponentBase::OPCODE_TLMCHAN_SET_STATS,12,Fw::COMMAND_VALIDATION_ERROR);
+
+        // every value written is in the statistics, but only the other channel is sent
+        this->clearBuffs();
+        this->clearHistory();
+        for (NATIVE_UINT_TYPE val = 1; val <= 10; val++) {
+            this->sendF32(statsId,val);
+        }
+        this->sendBuff(plainId,1,0);
+        this->doRun(true);
+        ASSERT_EQ((NATIVE_UINT_TYPE)1,this->m_numBuffs);
+        this->checkBuff(plainId,1,0);
+        ASSERT_TLM_TLMCHAN_STATS_0_COUNT_SIZE(0);
+
+        // aggregates are sent at the end of the window
+        this->doRun(false);
+        ASSERT_TLM_TLMCHAN_STATS_0_COUNT_SIZE(0);
+        this->doRun(false);
+        ASSERT_TLM_TLMCHAN_STATS_0_ID(0,statsId);
+        ASSERT_TLM_TLMCHAN_STATS_0_COUNT(0,10);
+        ASSERT_TLM_TLMCHAN_STATS_0_MIN(0,1.0);
+        ASSERT_TLM_TLMCHAN_STATS_0_MAX(0,10.0);
+        ASSERT_TLM_TLMCHAN_STATS_0_MEAN(0,5.5);
+
+        // next window starts empty
+        this->clearHistory();
+        this->sendF32(statsId,-2.0);
+        for (NATIVE_UINT_TYPE cycle = 0; cycle < 3; cycle++) {
+            this->doRun(false);
+        }
+        ASSERT_TLM_TLMCHAN_STATS_0_COUNT(0,1);
+        ASSERT_TLM_TLMCHAN_STATS_0_MIN(0,-2.0);
+        ASSERT_TLM_TLMCHAN_STATS_0_MEAN(0,-2.0);
+
+        // the window is read on a later Run call if a writer owns the entry
+        this->clearHistory();
+        this->sendF32(statsId,6.0);
+        NATIVE_INT_TYPE entry = this->m_impl.findChannel(statsId);
+        ASSERT_NE(TLMCHAN_NO_CHANNEL,entry);
+        this->m_impl.m_entries[entry].seq |= TLMCHAN_SEQ_OWNED;
+        for (NATIVE_UINT_TYPE cycle = 0; cycle < 4; cycle++) {
+            this->doRun(false);
+        }
+        ASSERT_TLM_TLMCHAN_STATS_0_COUNT_SIZE(0);
+        this->m_impl.m_entries[entry].seq &= ~static_cast<U32>(TLMCHAN_SEQ_OWNED);
+        this->doRun(false);
+        ASSERT_TLM_TLMCHAN_STATS_0_COUNT(0,1);
+        ASSERT_TLM_TLMCHAN_STATS_0_MAX(0,6.0);
+
+        // clearing the slot sends the channel values again
+        this->sendCmd_TLMCHAN_SET_STATS(0,13,0,statsId,TlmChanComponentBase::STATS_F32,0);
+        this->m_impl.doDispatch();
+        this->clearBuffs();
+        this->clearHistory();
+        this->sendF32(statsId,4.0);
+        for (NATIVE_UINT_TYPE cycle = 0; cycle < 3; cycle++) {
+            this->doRun(false);
+        }
+        ASSERT_EQ((NATIVE_UINT_TYPE)1,this->m_numBuffs);
+        ASSERT_TLM_TLMCHAN_STATS_0_COUNT_SIZE(0);
+
+    }
+
+    void TlmChanImplTester::sendF32(FwChanIdType id, F32 val) {
+        Fw::TlmBuffer buff;
+        Fw::Time timeTag;
+        ASSERT_EQ(Fw::FW_SERIALIZE_OK,buff.serialize(val));
+        this->invoke_to_TlmRecv(0,id,timeTag,buff);
+    }
+
+    void TlmChanImplTester::runConcurrent(void) {
+
+        COMMENT("Write and read channels from several tasks while running, and verify no value is torn.");
+
+        this->m_stressDone = false;
+        this->m_writersDone = 0;
+        this->m_tornValues = 0;
+        this->m_goodReads = 0;
+        this->m_sentValues = 0;
+
+        StressArgs writerArgs[STRESS_WRITERS];
+        StressArgs readerArgs[STRESS_READERS];
+        Os::Task writers[STRESS_WRITERS];
+        Os::Task readers[STRESS_READERS];
+
+        for (NATIVE_UINT_TYPE task = 0; task < STRESS_WRITERS; task++) {
+            writerArgs[task].tester = this;
+            writerArgs[task].index = task;
+            Fw::EightyCharString name;
+            name.format("TLMW%d",task);
+            ASSERT_EQ(Os::Task::TASK_OK,
+                    writers[task].start(name,task,0,64*1024,writerTask,&writerArgs[task]));
+        }
+        for (NATIVE_UINT_TYPE task = 0; task < STRESS_READERS; task++) {
+            readerArgs[task].tester = this;
+            readerArgs[task].index = task;
+            Fw::EightyCharString name;
+            name.format("TLMR%d",task);
+            ASSERT_EQ(Os::Task::TASK_OK,
+                    readers[task].start(name,STRESS_WRITERS+task,0,64*1024,readerTask,&readerArgs[task]));
+        }
+
+        // run from this task while the channels are being written, checking each sent value
+        while (this->m_writersDone < STRESS_WRITERS) {
+            this->clearBuffs();
+            this->clearHistory();
+            this->doRun(false);
+            for (NATIVE_UINT_TYPE packet = 0; packet < this->m_numBuffs; packet++) {
+                this->m_rcvdBuffer[packet].resetDeser();
+                FwPacketDescriptorType desc;
+                ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_rcvdBuffer[packet].deserialize(desc));
+                ASSERT_EQ(desc,(FwPacketDescriptorType)Fw::ComPacket::FW_PACKET_TELEM);
+                FwChanIdType id;
+                ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_rcvdBuffer[packet].deserialize(id));
+                Fw::Time timeTag;
+                ASSERT_EQ(Fw::FW_SERIALIZE_OK,this->m_rcvdBuffer[packet].deserialize(timeTag));
+                if (not checkStressValue(this->m_rcvdBuffer[packet],timeTag)) {
+                    this->m_tornValues++;
+                }
+                this->m_sentValues++;
+            }
+        }
+
+        this->m_stressDone = true;
+        for (NATIVE_UINT_TYPE task = 0; task < STRESS_WRITERS; task++) {
+            ASSERT_EQ(Os::Task::TASK_OK,writers[task].join(0));
+        }
+        for (NATIVE_UINT_TYPE task = 0; task < STRESS_READERS; task++) {
+            ASSERT_EQ(Os::Task::TASK_OK,readers[task].join(0));
+        }
+
+        printf("Sent %d, read %d, contended writes %d\n",
+                this->m_sentValues,this->m_goodReads,this->m_impl.m_contendedWrites);
+
+        ASSERT_EQ((U32)0,this->m_tornValues);
+        ASSERT_GT(this->m_goodReads,(U32)0);
+        ASSERT_GT(this->m_sentValues,(U32)0);
+
+        // final values are consistent and get sent once
+        this->clearBuffs();
+        this->doRun(false);
+        this->clearBuffs();
+        ASSERT_FALSE(this->doRun(false));
+        for (NATIVE_UINT_TYPE chan = 0; chan < STRESS_CHANNELS; chan++) {
+            Fw::TlmBuffer buff;
+            Fw::Time timeTag;
+            this->invoke_to_TlmGet(0,STRESS_BASE_ID+chan,timeTag,buff);
+            ASSERT_TRUE(checkStressValue(buff,timeTag));
+            // writes aren't dropped, so the value is from the last iteration of a writer
+            ASSERT_GT(timeTag.getSeconds(),(U32)((STRESS_ITERATIONS-1)*STRESS_WRITERS));
+        }
+
+    }
+
+    void TlmChanImplTester::writerTask(void* ptr) {
+        StressArgs* args = static_cast<StressArgs*>(ptr);
+        for (U32 iter = 0; iter < STRESS_ITERATIONS; iter++) {
+            // every word and the time tag hold the same value, which is different for each writer
+            U32 val = iter*STRESS_WRITERS + args->index + 1;
+            Fw::TlmBuffer buff;
+            for (NATIVE_UINT_TYPE word = 0; word < STRESS_WORDS; word++) {
+                (void) buff.serialize(val);
+            }
+            Fw::Time timeTag(TB_NONE,val,0);
+            for (NATIVE_UINT_TYPE chan = 0; chan < STRESS_CHANNELS; chan++) {
+                args->tester->invoke_to_TlmRecv(0,STRESS_BASE_ID+chan,timeTag,buff);
+            }
+        }
+        (void) __sync_fetch_and_add(&args->tester->m_writersDone,1);
+    }
+
+    void TlmChanImplTester::readerTask(void* ptr) {
+        StressArgs* args = static_cast<StressArgs*>(ptr);
+        while (not args->tester->m_stressDone) {
+            for (NATIVE_UINT_TYPE chan = 0; chan < STRESS_CHANNELS; chan++) {
+                Fw::TlmBuffer buff;
+                Fw::Time timeTag;
+                args->tester->invoke_to_TlmGet(0,STRESS_BASE_ID+chan,timeTag,buff);
+                if (0 == buff.getBuffLength()) {
+                    // not written yet
+                    continue;
+                }
+                if (checkStressValue(buff,timeTag)) {
+                    (void) __sync_fetch_and_add(&args->tester->m_goodReads,1);
+                } else {
+                    (void) __sync_fetch_and_add(&args->tester->m_tornValues,1);
+                }
+            }
+        }
+    }
+
+    bool TlmChanImplTester::checkStressValue(Fw::SerializeBufferBase& buff, const Fw::Time& timeTag) {
+        // value is whole and from the same write as the time tag
+        if (buff.getBuffLeft() != STRESS_WORDS*sizeof(U32)) {
+            return false;
+        }
+        for (NATIVE_UINT_TYPE word = 0; word < STRESS_WORDS; word++) {
+            U32 val;
+            if ((buff.deserialize(val) != Fw::FW_SERIALIZE_OK) or (val != timeTag.getSeconds())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void TlmChanImplTester::runOffNominal(void) {
 
         // Ask for a packet that isn't written yet
@@ -232,67 +750,25 @@ namespace Svc {
 
     void TlmChanImplTester::clearBuffs(void) {
         this->m_numBuffs = 0;
-        for (NATIVE_INT_TYPE n = 0; n < TLMCHAN_HASH_BUCKETS; n++) {
+        for (NATIVE_INT_TYPE n = 0; n < TLMCHAN_MAX_CHANNELS; n++) {
             this->m_rcvdBuffer[n].resetSer();
         }
     }
 
-    void TlmChanImplTester::dumpTlmEntry(TlmChanImpl::TlmEntry* entry) {
-        printf(
-                "Entry "
-                " Ptr: %p"
-                " id: 0x%08X"
-                " bucket: %d"
-                " next: %p\n",
-                entry,entry->id,entry->bucketNo,entry->next
-                );
-    }
-
     void TlmChanImplTester::dumpHash(void) {
-//        printf("**Buffer 0\n");
-        for (NATIVE_INT_TYPE slot = 0; slot < TLMCHAN_NUM_TLM_HASH_SLOTS; slot++) {
-            printf("Slot: %d\n",slot);
-            if (m_impl.m_tlmEntries[0].slots[slot]) {
-                TlmChanImpl::TlmEntry* entry = m_impl.m_tlmEntries[0].slots[slot];
-                for (NATIVE_INT_TYPE bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-                    dumpTlmEntry(entry);
-                    if (entry->next == 0) {
-                        break;
-                    } else {
-                        entry = entry->next;
-                    }
-                }
-            } else {
-                printf("EMPTY\n");
+        for (NATIVE_INT_TYPE slot = 0; slot < TLMCHAN_INDEX_SLOTS; slot++) {
+            if (m_impl.m_index[slot]) {
+                NATIVE_UINT_TYPE entry = m_impl.m_index[slot] - 1;
+                printf(
+                        "Slot: %d"
+                        " id: 0x%08X"
+                        " entry: %d"
+                        " home: %d\n",
+                        slot,m_impl.m_channels[entry].id,entry,m_impl.doHash(m_impl.m_channels[entry].id)
+                        );
             }
         }
         printf("\n");
-//        for (NATIVE_INT_TYPE bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-//            printf("Bucket: %d ",bucket);
-//            dumpTlmEntry(&m_impl.m_tlmEntries[0].buckets[bucket]);
-//        }
-//        printf("**Buffer 1\n");
-//        for (NATIVE_INT_TYPE slot = 0; slot < TLMCHAN_NUM_TLM_HASH_SLOTS; slot++) {
-//            printf("Slot: %d\n",slot);
-//            if (m_impl.m_tlmEntries[1].slots[slot]) {
-//                TlmChanImpl::TlmEntry* entry = m_impl.m_tlmEntries[1].slots[slot];
-//                for (NATIVE_INT_TYPE bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-//                    dumpTlmEntry(entry);
-//                    if (entry->next == 0) {
-//                        break;
-//                    } else {
-//                        entry = entry->next;
-//                    }
-//                }
-//            } else {
-//                printf("EMPTY\n");
-//            }
-//        }
-//        printf("\n");
-//        for (NATIVE_INT_TYPE bucket = 0; bucket < TLMCHAN_HASH_BUCKETS; bucket++) {
-//            printf("Bucket: %d\n",bucket);
-//            dumpTlmEntry(&m_impl.m_tlmEntries[1].buckets[bucket]);
-//        }
     }
     void TlmChanImplTester ::
       from_pingOut_handler(
@@ -24,6 +24,11 @@ namespace Svc {
             void runMultiChannel(void);
             void runOffNominal(void);
             void runTooManyChannels(void);
+            void runPacketized(void);
+            void runChannelIds(void);
+            void runConcurrent(void);
+            void runFilter(void);
+            void runStats(void);
 
         private:
             Svc::TlmChanImpl& m_impl;
@@ -34,16 +39,39 @@ namespace Svc {
             void sendBuff(FwChanIdType id, U32 val, NATIVE_INT_TYPE instance);
             bool doRun(bool check);
             void checkBuff(FwChanIdType id, U32 val, NATIVE_INT_TYPE instance);
+            void checkPacket(FwTlmPacketizeIdType id, const U32* vals, NATIVE_UINT_TYPE numVals);
+            void sendF32(FwChanIdType id, F32 val);
 
             // Keep a history
             NATIVE_UINT_TYPE m_numBuffs;
-            Fw::ComBuffer m_rcvdBuffer[TLMCHAN_HASH_BUCKETS];
+            Fw::ComBuffer m_rcvdBuffer[TLMCHAN_MAX_CHANNELS];
             bool m_bufferRecv;
             void clearBuffs(void);
 
+            // concurrency test
+            enum {
+                STRESS_WRITERS = 2, //!< number of tasks writing channels
+                STRESS_READERS = 2, //!< number of tasks reading channels
+                STRESS_CHANNELS = 4, //!< number of channels written
+                STRESS_WORDS = 16, //!< number of words in each value
+                STRESS_ITERATIONS = 100000, //!< number of times each writer writes each channel
+                STRESS_BASE_ID = 0x100 //!< first channel ID
+            };
+            struct StressArgs {
+                TlmChanImplTester* tester;
+                U32 index;
+            };
+            static void writerTask(void* ptr);
+            static void readerTask(void* ptr);
+            static bool checkStressValue(Fw::SerializeBufferBase& buff, const Fw::Time& timeTag);
+            volatile bool m_stressDone;
+            volatile U32 m_writersDone;
+            volatile U32 m_tornValues;
+            volatile U32 m_goodReads;
+            U32 m_sentValues;
+
             // dump functions
             void dumpHash(void);
-            static void dumpTlmEntry(TlmChanImpl::TlmEntry* entry);
             //! Handler for from_pingOut
             //!
             void from_pingOut_handler(
@@ -22,6 +22,15 @@ void connectPorts(Svc::TlmChanImpl& impl, Svc::TlmChanImplTester& tester) {
     tester.connect_to_TlmGet(0,impl.get_TlmGet_InputPort(0));
     tester.connect_to_Run(0,impl.get_Run_InputPort(0));
     impl.set_PktSend_OutputPort(0,tester.get_from_PktSend(0));
+    impl.set_Log_OutputPort(0,tester.get_from_Log(0));
+    impl.set_LogText_OutputPort(0,tester.get_from_LogText(0));
+    impl.set_Tlm_OutputPort(0,tester.get_from_Tlm(0));
+    impl.set_Time_OutputPort(0,tester.get_from_Time(0));
+    tester.connect_to_CmdDisp(0,impl.get_CmdDisp_InputPort(0));
+    impl.set_CmdStatus_OutputPort(0,tester.get_from_CmdStatus(0));
+    impl.set_CmdReg_OutputPort(0,tester.get_from_CmdReg(0));
+    impl.set_ParamGet_OutputPort(0,tester.get_from_ParamGet(0));
+    impl.set_ParamSet_OutputPort(0,tester.get_from_ParamSet(0));
 
 #if FW_PORT_TRACING
     //Fw::PortBase::setTrace(true);
@@ -74,6 +83,106 @@ TEST(TlmChanTest,MultiChannelTest) {
 }
 
 
+TEST(TlmChanTest,PacketizedTest) {
+
+    COMMENT("Write channels in a packet list and verify they are sent as packetized telemetry.");
+
+    Svc::TlmChanImpl impl("TlmChanImpl");
+
+    impl.init(10,0);
+
+    Svc::TlmChanImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    // run test
+    tester.runPacketized();
+
+}
+
+TEST(TlmChanTest,ChannelIdsTest) {
+
+    COMMENT("Load the deployment channel IDs and verify each gets its own index slot.");
+
+    Svc::TlmChanImpl impl("TlmChanImpl");
+
+    impl.init(10,0);
+
+    Svc::TlmChanImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    // run test
+    tester.runChannelIds();
+
+}
+
+TEST(TlmChanTest,FilterTest) {
+
+    COMMENT("Set deadband and on change filters by command and parameter and verify unchanged values are suppressed.");
+
+    Svc::TlmChanImpl impl("TlmChanImpl");
+
+    impl.init(10,0);
+
+    Svc::TlmChanImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    // run test
+    tester.runFilter();
+
+}
+
+TEST(TlmChanTest,StatsTest) {
+
+    COMMENT("Collect channel statistics over a window and verify only the aggregates are sent.");
+
+    Svc::TlmChanImpl impl("TlmChanImpl");
+
+    impl.init(10,0);
+
+    Svc::TlmChanImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    // run test
+    tester.runStats();
+
+}
+
+TEST(TlmChanTest,ConcurrentTest) {
+
+    COMMENT("Write and read channels from several tasks at once.");
+
+    Svc::TlmChanImpl impl("TlmChanImpl");
+
+    impl.init(10,0);
+
+    Svc::TlmChanImplTester tester(impl);
+
+    tester.init();
+
+    // connect ports
+    connectPorts(impl,tester);
+
+    // run test
+    tester.runConcurrent();
+
+}
+
 TEST(TlmChanTest,OffNominal) {
 
     TEST_CASE(107.2.1,"Off-nominal channelized telemetry");
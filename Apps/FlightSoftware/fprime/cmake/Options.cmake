@@ -84,6 +84,38 @@ option(LINK_AS_SHARED_LIBS "Link F prime with shared libraries." OFF)
 ####
 option(GENERATE_HERITAGE_PY_DICT "Generate F prime python dictionaries instead of XML based dictionaries." OFF)
 
+####
+# `OS_RING_QUEUE:`
+#
+# This option switches the Os::Queue implementation from the pthread queue, which takes a mutex on
+# every send and receive, to the ring queue in Os/Linux/RingQueue.cpp. The ring queue takes no lock
+# and only makes a system call when a thread has to sleep on an empty or full queue. A queue holds
+# up to FW_QUEUE_RING_PRIORITIES different message priorities. Linux only.
+#
+# **Values:**
+# - ON: use the ring queue.
+# - OFF: (default) use the pthread queue.
+#
+# e.g. `-DOS_RING_QUEUE=ON`
+####
+option(OS_RING_QUEUE "Build Os::Queue from the lock-free ring queue." OFF)
+
+####
+# `OS_LOCKLESS_QUEUE:`
+#
+# This option switches the Os::Queue implementation to Os/Posix/LocklessOsQueue.cpp, built on
+# Os::LocklessQueue. Any number of threads can send and receive without taking a lock; the mutex is
+# only taken to sleep on an empty or full queue, or to wake a sleeping thread. Messages are received
+# in the order they were sent and the priority is ignored. Cannot be set with OS_RING_QUEUE.
+#
+# **Values:**
+# - ON: use the lockless queue.
+# - OFF: (default) use the pthread queue.
+#
+# e.g. `-DOS_LOCKLESS_QUEUE=ON`
+####
+option(OS_LOCKLESS_QUEUE "Build Os::Queue from the lockless first in, first out queue." OFF)
+
 # Note: document other system options here.
 
 ####
@@ -40,6 +40,7 @@ SVC_MODULES := \
 	Svc/BufferAccumulator \
 	Svc/BufferLogger \
 	Svc/BufferManager \
+	Svc/BufferSplitter \
 	Svc/CmdDispatcher \
 	Svc/CmdSequencer \
 	Svc/Seq \
@@ -53,6 +54,7 @@ SVC_MODULES := \
 	Svc/TlmChan \
 	Svc/PassiveTextLogger \
 	Svc/PassiveConsoleTextLogger \
+	Svc/DeferredTextLogger \
 	Svc/Time \
 	Svc/Cycle \
 	Svc/LinuxTime \
@@ -62,6 +64,7 @@ SVC_MODULES := \
 	Svc/PolyIf \
 	Svc/PolyDb \
 	Svc/PrmDb \
+	Svc/QueueMonitor \
 	Svc/Ping \
 	Svc/Health \
 	Svc/WatchDog \